@@ -0,0 +1,98 @@
+/**
+ * Benchmark Runner for Harmonic IoT Protocol
+ *
+ *   harmonic_bench [--filter TEXT] [--samples N] [--sample-ms MS] [--perf] [--out FILE] [--list]
+ *
+ * Results go to stdout (or FILE) as JSON; progress goes to stderr.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "bench/benchmarks.h"
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using harmonic_iot::bench::BenchOptions;
+using harmonic_iot::bench::BenchRegistry;
+
+namespace {
+
+void usage() {
+    std::cerr << "Usage: harmonic_bench [--filter TEXT] [--samples N] [--sample-ms MS] [--perf] [--out FILE] [--list]\n"
+              << "  --filter TEXT   Only cases whose name contains TEXT (e.g. dsp/fft)\n"
+              << "  --samples N     Timed samples per case (default 25)\n"
+              << "  --sample-ms MS  Target duration of one sample (default 2)\n"
+              << "  --perf          Read hardware counters (IPC, cache and branch misses; Linux)\n"
+              << "  --out FILE      Write the JSON report to FILE instead of stdout\n"
+              << "  --list          Print the case names and exit\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    std::string out_path;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.samples = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--sample-ms" && i + 1 < argc) {
+            options.sample_ms = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--perf") {
+            options.perf_counters = true;
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--list") {
+            list = true;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (options.samples == 0 || !(options.sample_ms > 0.0)) {
+        usage();
+        return 2;
+    }
+
+    BenchRegistry registry;
+    harmonic_iot::bench::registerCoreBenchmarks(registry);
+#if HARMONIC_IOT_BENCH_PIPELINE
+    harmonic_iot::bench::registerPipelineBenchmarks(registry);
+#endif
+
+    if (list) {
+        for (const auto& bench_case : registry.cases()) {
+            std::cout << bench_case.name() << '\n';
+        }
+        return 0;
+    }
+
+    try {
+        auto results = registry.run(options, &std::cerr);
+        if (out_path.empty()) {
+            harmonic_iot::bench::writeJson(std::cout, results);
+        } else {
+            std::ofstream out(out_path);
+            if (!out) {
+                std::cerr << "Cannot open " << out_path << '\n';
+                return 1;
+            }
+            harmonic_iot::bench::writeJson(out, results);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
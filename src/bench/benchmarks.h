@@ -0,0 +1,28 @@
+/**
+ * Benchmark Suites for Harmonic IoT Protocol
+ *
+ * Each suite adds its parameter sweep to the registry; harmonic_bench
+ * registers the ones compiled into this build.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_BENCH_BENCHMARKS_H
+#define HARMONIC_IOT_BENCH_BENCHMARKS_H
+
+#include "bench/harness.h"
+
+namespace harmonic_iot {
+namespace bench {
+
+/** Codec, synthesis, FFT, peak detection and integrity verification */
+void registerCoreBenchmarks(BenchRegistry& registry);
+
+/** Receive chain throughput across thread pool sizes (native engine builds) */
+void registerPipelineBenchmarks(BenchRegistry& registry);
+
+} // namespace bench
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_BENCH_BENCHMARKS_H
@@ -0,0 +1,613 @@
+/**
+ * Monte-Carlo Error-Rate Curves for Harmonic IoT Protocol
+ *
+ * Sweeps SNR × receiver configuration over the channel simulator and
+ * measures bit, symbol and frame error rates of the native receive path
+ * (symbol synthesis → ChannelSimulator → per-slot peak detection, as in
+ * the receive chain's detect stage):
+ *
+ *   harmonic_ber [--channels 2,8] [--symbol-samples 256,1024] [--threshold -40,-30]
+ *                [--rician-k inf,4,0] [--snr -10:20:2] [--clock-ppm PPM]
+ *                [--symbols N] [--batch N] [--min-errors N] [--precision R]
+ *                [--max-frames N] [--floor BER] [--threads N] [--seed N]
+ *                [--csv FILE] [--json FILE]
+ *
+ * Every point is split into batches of frames, and batch b of point p
+ * draws its payload and its noise from stream (p, b) of the seed. Worker
+ * threads claim batches in any order, but tallies are only merged as a
+ * contiguous prefix, so results depend on the seed and not on the thread
+ * count. A point stops when the 95% Wilson interval of its BER is within
+ * ±precision with at least min-errors bit errors ("converged"), when the
+ * interval lies wholly below the floor ("floor"; higher SNRs of that
+ * configuration are then skipped), or after max-frames ("limit").
+ *
+ * A slot decodes to its strongest peak's harmonic number. Slots without a
+ * peak or outside the channel's range count as erasures with every bit of
+ * the symbol wrong, so the BER is an upper bound at low SNR.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "dsp/channel_model.h"
+#include "dsp/peak_detector.h"
+#include "dsp/synthesizer.h"
+#include "protocol/codec.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace harmonic_iot;
+
+namespace {
+
+constexpr int BITS_PER_SYMBOL = 5;          // Offsets 0..MAX_SYMBOL_OFFSET
+constexpr double Z_95 = 1.959963984540054;  // Two-sided 95% normal quantile
+
+/** Set bits in x (std::popcount is C++20) */
+inline int bitCount(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0f0f0f0fu;
+    return static_cast<int>((x * 0x01010101u) >> 24);
+}
+
+struct BerOptions {
+    std::vector<int> channels = {2};
+    std::vector<size_t> symbol_samples = {1024};
+    std::vector<double> thresholds = {-40.0};
+    std::vector<double> rician_k = {std::numeric_limits<double>::infinity()};
+    double snr_from = -10.0;
+    double snr_to = 20.0;
+    double snr_step = 2.0;
+    double clock_ppm = 0.0;
+    double sample_rate = 96000.0;       ///< Receive chain default
+    size_t symbols = 16;                ///< Slots per frame
+    size_t batch = 32;                  ///< Frames per work unit
+    uint64_t min_errors = 100;
+    double precision = 0.1;             ///< Relative CI half-width to stop at
+    uint64_t max_frames = 20000;
+    double floor = 1e-5;
+    size_t threads = 0;                 ///< 0: one per CPU
+    uint64_t seed = 1;
+    std::string csv_path;
+    std::string json_path;
+};
+
+/**
+ * One configuration at one SNR
+ */
+struct Point {
+    int channel = 2;
+    size_t symbol_samples = 1024;
+    double threshold_db = -40.0;
+    double rician_k = std::numeric_limits<double>::infinity();
+    double snr_db = 0.0;
+};
+
+struct Tally {
+    uint64_t frames = 0;
+    uint64_t symbols = 0;
+    uint64_t symbol_errors = 0;
+    uint64_t erasures = 0;
+    uint64_t bit_errors = 0;
+    uint64_t frame_errors = 0;
+
+    void add(const Tally& other) {
+        frames += other.frames;
+        symbols += other.symbols;
+        symbol_errors += other.symbol_errors;
+        erasures += other.erasures;
+        bit_errors += other.bit_errors;
+        frame_errors += other.frame_errors;
+    }
+
+    uint64_t bits() const { return symbols * BITS_PER_SYMBOL; }
+};
+
+/**
+ * 95% Wilson score interval of k successes in n trials
+ */
+struct Interval {
+    double low = 0.0;
+    double high = 1.0;
+
+    static Interval wilson(uint64_t k, uint64_t n) {
+        Interval interval;
+        if (n == 0) {
+            return interval;
+        }
+        const double count = static_cast<double>(n);
+        const double p = static_cast<double>(k) / count;
+        const double z2 = Z_95 * Z_95;
+        const double denominator = 1.0 + z2 / count;
+        const double centre = (p + z2 / (2.0 * count)) / denominator;
+        const double half = Z_95 * std::sqrt(p * (1.0 - p) / count + z2 / (4.0 * count * count)) / denominator;
+        interval.low = std::max(0.0, centre - half);
+        interval.high = std::min(1.0, centre + half);
+        return interval;
+    }
+};
+
+enum class Stop { CONVERGED, FLOOR, LIMIT };
+
+const char* stopName(Stop stop) {
+    switch (stop) {
+        case Stop::CONVERGED: return "converged";
+        case Stop::FLOOR:     return "floor";
+        case Stop::LIMIT:     return "limit";
+    }
+    return "?";
+}
+
+struct PointResult {
+    Point point;
+    Tally tally;
+    Interval ber;
+    Stop stop = Stop::LIMIT;
+    double seconds = 0.0;
+
+    double rate(uint64_t count, uint64_t total) const {
+        return total > 0 ? static_cast<double>(count) / static_cast<double>(total) : 0.0;
+    }
+    double berValue() const { return rate(tally.bit_errors, tally.bits()); }
+    double ser() const { return rate(tally.symbol_errors, tally.symbols); }
+    double erasureRate() const { return rate(tally.erasures, tally.symbols); }
+    double fer() const { return rate(tally.frame_errors, tally.frames); }
+};
+
+/** Raw link rate: BITS_PER_SYMBOL per slot */
+double rawBitRate(const BerOptions& options, const Point& point) {
+    return BITS_PER_SYMBOL * options.sample_rate / static_cast<double>(point.symbol_samples);
+}
+
+/**
+ * Eb/N0 of a unit tone at the given per-sample SNR
+ *
+ * Noise of variance σ² over fs/2 has N₀ = 2σ²/fs, a slot carries
+ * Es = ½ · N/fs, so Es/N₀ = SNR · N/2 and Eb = Es / BITS_PER_SYMBOL.
+ */
+double ebN0Db(const Point& point) {
+    return point.snr_db + 10.0 * std::log10(static_cast<double>(point.symbol_samples) / 2.0 / BITS_PER_SYMBOL);
+}
+
+// ─── Trials ──────────────────────────────────────────────────────────────
+
+/**
+ * Per-thread transmitter, channel and scratch space for one point
+ */
+class Trial {
+public:
+    Trial(const BerOptions& options, const Point& point, const dsp::PeakDetector& detector)
+        : options_(options),
+          point_(point),
+          detector_(detector),
+          synth_(options.sample_rate, point.symbol_samples, HarmonicProtocol::FUNDAMENTAL_FREQUENCY),
+          channel_(channelConfig(options, point)),
+          tx_(options.symbols),
+          samples_(synth_.samplesFor(options.symbols)) {}
+
+    /** Run `frames` frames as batch b of the point whose streams start at stream_base */
+    Tally run(uint64_t stream_base, uint64_t b, size_t frames) {
+        channel_.reseed(options_.seed, stream_base + b);
+        std::seed_seq seeds{static_cast<uint32_t>(options_.seed), static_cast<uint32_t>(options_.seed >> 32),
+                            static_cast<uint32_t>(stream_base >> 32), static_cast<uint32_t>(b)};
+        std::mt19937_64 rng(seeds);
+        std::uniform_int_distribution<int> offsets(0, HarmonicProtocol::MAX_SYMBOL_OFFSET);
+
+        const int base = point_.channel;
+        const double f0 = HarmonicProtocol::FUNDAMENTAL_FREQUENCY;
+        const size_t slot = point_.symbol_samples;
+        Tally tally;
+        for (size_t f = 0; f < frames; ++f) {
+            for (int& symbol : tx_) {
+                symbol = base + offsets(rng);
+            }
+            synth_.render(tx_.data(), tx_.size(), samples_.data());
+            channel_.process(samples_.data(), samples_.size());
+
+            uint64_t frame_errors = 0;
+            for (size_t s = 0; s < tx_.size(); ++s) {
+                detector_.detect(dsp::SampleSpan(samples_.data() + s * slot, slot), found_);
+                const int rx = found_.empty() ? 0 : static_cast<int>(std::lround(found_.front().frequency / f0));
+                const int offset = rx - base;
+                if (offset < 0 || offset > HarmonicProtocol::MAX_SYMBOL_OFFSET) {
+                    ++tally.erasures;
+                    tally.bit_errors += BITS_PER_SYMBOL;
+                    ++frame_errors;
+                } else if (rx != tx_[s]) {
+                    tally.bit_errors += static_cast<uint64_t>(
+                        bitCount(static_cast<uint32_t>(offset ^ (tx_[s] - base))));
+                    ++frame_errors;
+                }
+            }
+            tally.symbols += tx_.size();
+            tally.symbol_errors += frame_errors;
+            tally.frame_errors += frame_errors > 0 ? 1 : 0;
+            ++tally.frames;
+        }
+        return tally;
+    }
+
+private:
+    static dsp::ChannelConfig channelConfig(const BerOptions& options, const Point& point) {
+        dsp::ChannelConfig config;
+        config.sample_rate = options.sample_rate;
+        config.snr_db = point.snr_db;
+        config.rician_k = point.rician_k;
+        config.clock_offset_ppm = options.clock_ppm;
+        config.seed = options.seed;
+        return config;
+    }
+
+    const BerOptions& options_;
+    Point point_;
+    const dsp::PeakDetector& detector_;
+    dsp::SymbolSynthesizer synth_;
+    dsp::ChannelSimulator channel_;
+    std::vector<int> tx_;
+    std::vector<dsp::Sample> samples_;
+    std::vector<dsp::DetectedComponent> found_;
+};
+
+/**
+ * Run one point on all threads until its stopping rule fires
+ */
+PointResult runPoint(const BerOptions& options, const Point& point, uint64_t point_index) {
+    const auto started = std::chrono::steady_clock::now();
+    dsp::PeakDetectorConfig detector_config;
+    detector_config.sample_rate = options.sample_rate;
+    detector_config.f0 = HarmonicProtocol::FUNDAMENTAL_FREQUENCY;
+    detector_config.threshold_db = static_cast<float>(point.threshold_db);
+    const dsp::PeakDetector detector(point.symbol_samples, detector_config);
+
+    const uint64_t stream_base = point_index << 32;
+    const size_t max_batches = static_cast<size_t>((options.max_frames + options.batch - 1) / options.batch);
+    std::vector<Tally> batches(max_batches);
+    std::vector<char> ready(max_batches, 0);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> done{false};
+    std::mutex mutex;
+    size_t prefix = 0;
+    PointResult result;
+    result.point = point;
+
+    // Called with the mutex held: fold finished batches in order, then test the rules
+    auto advance = [&] {
+        while (!done.load(std::memory_order_relaxed) && prefix < max_batches && ready[prefix]) {
+            result.tally.add(batches[prefix++]);
+            const Tally& t = result.tally;
+            const Interval ci = Interval::wilson(t.bit_errors, t.bits());
+            const double ber = result.berValue();
+            if (t.bit_errors >= options.min_errors && ci.high - ber <= options.precision * ber &&
+                ber - ci.low <= options.precision * ber) {
+                result.stop = Stop::CONVERGED;
+                done = true;
+            } else if (ci.high < options.floor) {
+                result.stop = Stop::FLOOR;
+                done = true;
+            } else if (prefix == max_batches) {
+                done = true;
+            }
+        }
+    };
+
+    auto work = [&] {
+        Trial trial(options, point, detector);
+        while (!done.load(std::memory_order_relaxed)) {
+            const size_t b = next.fetch_add(1, std::memory_order_relaxed);
+            if (b >= max_batches) {
+                break;
+            }
+            // The last batch is cut short so a point never exceeds max_frames
+            const size_t frames = static_cast<size_t>(
+                std::min<uint64_t>(options.batch, options.max_frames - b * options.batch));
+            Tally tally = trial.run(stream_base, b, frames);
+            std::lock_guard<std::mutex> lock(mutex);
+            batches[b] = tally;
+            ready[b] = 1;
+            advance();
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < options.threads; ++t) {
+        helpers.emplace_back(work);
+    }
+    work();
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    result.ber = Interval::wilson(result.tally.bit_errors, result.tally.bits());
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+// ─── Command line ────────────────────────────────────────────────────────
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        items.push_back(item);
+    }
+    if (items.empty()) {
+        throw std::invalid_argument("Empty list");
+    }
+    return items;
+}
+
+double parseDouble(const std::string& text) {
+    if (text == "inf") {
+        return std::numeric_limits<double>::infinity();
+    }
+    size_t used = 0;
+    double value = std::stod(text, &used);
+    if (used != text.size()) {
+        throw std::invalid_argument("Not a number: " + text);
+    }
+    return value;
+}
+
+void parseSnrRange(const std::string& range, BerOptions& options) {
+    std::vector<double> parts;
+    std::stringstream in(range);
+    std::string item;
+    while (std::getline(in, item, ':')) {
+        parts.push_back(parseDouble(item));
+    }
+    if (parts.size() == 1) {
+        parts = {parts[0], parts[0], 1.0};
+    }
+    if (parts.size() != 3 || parts[2] <= 0.0 || parts[1] < parts[0]) {
+        throw std::invalid_argument("SNR range must be FROM:TO:STEP with STEP > 0: " + range);
+    }
+    options.snr_from = parts[0];
+    options.snr_to = parts[1];
+    options.snr_step = parts[2];
+}
+
+void usage() {
+    std::cerr << "Usage: harmonic_ber [options]\n"
+              << "  --channels LIST        Harmonic channels (default 2)\n"
+              << "  --symbol-samples LIST  FFT sizes, powers of two (default 1024)\n"
+              << "  --threshold LIST       Detector thresholds in dB (default -40)\n"
+              << "  --rician-k LIST        Fading K factors, inf = none, 0 = Rayleigh (default inf)\n"
+              << "  --snr FROM:TO:STEP     SNR sweep in dB (default -10:20:2)\n"
+              << "  --clock-ppm PPM        Transmitter clock offset (default 0)\n"
+              << "  --symbols N            Slots per frame (default 16)\n"
+              << "  --batch N              Frames per work unit (default 32)\n"
+              << "  --min-errors N         Bit errors before a point may converge (default 100)\n"
+              << "  --precision R          Relative 95% CI half-width to stop at (default 0.1)\n"
+              << "  --max-frames N         Frame budget per point (default 20000)\n"
+              << "  --floor BER            Stop once the BER is surely below this (default 1e-5)\n"
+              << "  --threads N            Worker threads, 0 = one per CPU (default 0)\n"
+              << "  --seed N               Payload and channel seed (default 1)\n"
+              << "  --csv FILE             Write the curves as CSV\n"
+              << "  --json FILE            Write the curves as JSON\n";
+}
+
+bool parseArgs(int argc, char** argv, BerOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (!has_value) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--channels") {
+            options.channels.clear();
+            for (const std::string& item : splitList(value)) {
+                options.channels.push_back(std::stoi(item));
+            }
+        } else if (arg == "--symbol-samples") {
+            options.symbol_samples.clear();
+            for (const std::string& item : splitList(value)) {
+                options.symbol_samples.push_back(std::stoul(item));
+            }
+        } else if (arg == "--threshold") {
+            options.thresholds.clear();
+            for (const std::string& item : splitList(value)) {
+                options.thresholds.push_back(parseDouble(item));
+            }
+        } else if (arg == "--rician-k") {
+            options.rician_k.clear();
+            for (const std::string& item : splitList(value)) {
+                options.rician_k.push_back(parseDouble(item));
+            }
+        } else if (arg == "--snr") {
+            parseSnrRange(value, options);
+        } else if (arg == "--clock-ppm") {
+            options.clock_ppm = parseDouble(value);
+        } else if (arg == "--symbols") {
+            options.symbols = std::stoul(value);
+        } else if (arg == "--batch") {
+            options.batch = std::stoul(value);
+        } else if (arg == "--min-errors") {
+            options.min_errors = std::stoull(value);
+        } else if (arg == "--precision") {
+            options.precision = parseDouble(value);
+        } else if (arg == "--max-frames") {
+            options.max_frames = std::stoull(value);
+        } else if (arg == "--floor") {
+            options.floor = parseDouble(value);
+        } else if (arg == "--threads") {
+            options.threads = std::stoul(value);
+        } else if (arg == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (arg == "--csv") {
+            options.csv_path = value;
+        } else if (arg == "--json") {
+            options.json_path = value;
+        } else {
+            return false;
+        }
+    }
+
+    const double nyquist = options.sample_rate / 2.0;
+    for (int channel : options.channels) {
+        const double top = (channel + HarmonicProtocol::MAX_SYMBOL_OFFSET) * HarmonicProtocol::FUNDAMENTAL_FREQUENCY;
+        if (channel < 1 || top >= nyquist) {
+            throw std::invalid_argument("Channel " + std::to_string(channel) + " does not fit below Nyquist");
+        }
+    }
+    for (double k : options.rician_k) {
+        if (k < 0.0) {
+            throw std::invalid_argument("Rician K must be non-negative");
+        }
+    }
+    return options.symbols > 0 && options.batch > 0 && options.max_frames > 0 && options.precision > 0.0;
+}
+
+// ─── Output ──────────────────────────────────────────────────────────────
+
+void writeNumber(std::ostream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+void writeCsv(std::ostream& out, const BerOptions& options, const std::vector<PointResult>& results) {
+    out << "channel,symbol_samples,threshold_db,rician_k,snr_db,ebn0_db,frames,bits,bit_errors,"
+           "ber,ber_low,ber_high,ser,erasure_rate,fer,raw_bps,goodput_bps,stop,seconds\n";
+    out.precision(6);
+    for (const PointResult& r : results) {
+        const double raw = rawBitRate(options, r.point);
+        out << r.point.channel << ',' << r.point.symbol_samples << ',' << r.point.threshold_db << ','
+            << r.point.rician_k << ',' << r.point.snr_db << ',' << ebN0Db(r.point) << ','
+            << r.tally.frames << ',' << r.tally.bits() << ',' << r.tally.bit_errors << ','
+            << r.berValue() << ',' << r.ber.low << ',' << r.ber.high << ',' << r.ser() << ','
+            << r.erasureRate() << ',' << r.fer() << ',' << raw << ',' << raw * (1.0 - r.fer()) << ','
+            << stopName(r.stop) << ',' << r.seconds << '\n';
+    }
+}
+
+void writeJson(std::ostream& out, const BerOptions& options, const std::vector<PointResult>& results) {
+    out.precision(6);
+    out << "{\n  \"config\": {\"sample_rate\": " << options.sample_rate
+        << ", \"symbols_per_frame\": " << options.symbols
+        << ", \"clock_ppm\": " << options.clock_ppm
+        << ", \"min_errors\": " << options.min_errors
+        << ", \"precision\": " << options.precision
+        << ", \"max_frames\": " << options.max_frames
+        << ", \"floor\": " << options.floor
+        << ", \"seed\": " << options.seed << "},\n"
+        << "  \"points\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const PointResult& r = results[i];
+        const double raw = rawBitRate(options, r.point);
+        out << (i ? ",\n" : "\n")
+            << "    {\"channel\": " << r.point.channel
+            << ", \"symbol_samples\": " << r.point.symbol_samples
+            << ", \"threshold_db\": " << r.point.threshold_db
+            << ", \"rician_k\": ";
+        writeNumber(out, r.point.rician_k);
+        out << ", \"snr_db\": " << r.point.snr_db
+            << ", \"ebn0_db\": " << ebN0Db(r.point)
+            << ", \"frames\": " << r.tally.frames
+            << ", \"bits\": " << r.tally.bits()
+            << ", \"bit_errors\": " << r.tally.bit_errors
+            << ", \"ber\": " << r.berValue()
+            << ", \"ber_ci\": [" << r.ber.low << ", " << r.ber.high << "]"
+            << ", \"ser\": " << r.ser()
+            << ", \"erasure_rate\": " << r.erasureRate()
+            << ", \"fer\": " << r.fer()
+            << ", \"raw_bps\": " << raw
+            << ", \"goodput_bps\": " << raw * (1.0 - r.fer())
+            << ", \"stop\": \"" << stopName(r.stop) << "\""
+            << ", \"seconds\": " << r.seconds << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+bool writeFile(const std::string& path, const BerOptions& options, const std::vector<PointResult>& results,
+               void (*writer)(std::ostream&, const BerOptions&, const std::vector<PointResult>&)) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot open " << path << '\n';
+        return false;
+    }
+    writer(out, options, results);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BerOptions options;
+    try {
+        if (!parseArgs(argc, argv, options)) {
+            usage();
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        usage();
+        return 2;
+    }
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    try {
+        std::vector<PointResult> results;
+        uint64_t point_index = 0;
+        std::printf("%-4s %6s %7s %6s %7s %9s %11s %11s %11s %11s %-9s\n", "ch", "N", "thr dB", "K",
+                    "SNR dB", "frames", "BER", "SER", "FER", "goodput", "stop");
+        for (int channel : options.channels) {
+            for (size_t symbol_samples : options.symbol_samples) {
+                for (double threshold : options.thresholds) {
+                    for (double k : options.rician_k) {
+                        for (size_t step = 0;; ++step) {
+                            const double snr = options.snr_from + static_cast<double>(step) * options.snr_step;
+                            if (snr > options.snr_to + 1e-9) {
+                                break;
+                            }
+                            Point point{channel, symbol_samples, threshold, k, snr};
+                            PointResult result = runPoint(options, point, point_index++);
+                            std::printf("H%-3d %6zu %7.1f %6g %7.1f %9llu %11.3e %11.3e %11.3e %9.0f/s %-9s\n",
+                                        channel, symbol_samples, threshold, k, snr,
+                                        static_cast<unsigned long long>(result.tally.frames), result.berValue(),
+                                        result.ser(), result.fer(),
+                                        rawBitRate(options, point) * (1.0 - result.fer()), stopName(result.stop));
+                            std::fflush(stdout);
+                            const bool below_floor = result.stop == Stop::FLOOR;
+                            results.push_back(result);
+                            if (below_floor) {
+                                break;    // Higher SNRs only get better
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!options.csv_path.empty() && !writeFile(options.csv_path, options, results, writeCsv)) {
+            return 1;
+        }
+        if (!options.json_path.empty() && !writeFile(options.json_path, options, results, writeJson)) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * Core Benchmark Suite for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "benchmarks.h"
+#include "dsp/channel_model.h"
+#include "dsp/fft.h"
+#include "dsp/peak_detector.h"
+#include "dsp/spectral_verification.h"
+#include "dsp/synthesizer.h"
+#include "protocol/codec.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace harmonic_iot {
+namespace bench {
+
+namespace {
+
+using HarmonicProtocol::HarmonicChannel;
+
+constexpr double SYMBOL_RATE = 96000.0;     // Receive chain defaults
+constexpr size_t SYMBOL_SAMPLES = 1024;
+
+/** Printable text of the given length, the same on every run */
+std::string sampleMessage(size_t length) {
+    static const char alphabet[] = "The quick brown fox jumps over the lazy dog 0123456789";
+    std::string message(length, ' ');
+    for (size_t i = 0; i < length; ++i) {
+        message[i] = alphabet[i % (sizeof(alphabet) - 1)];
+    }
+    return message;
+}
+
+/**
+ * Components of decode_fft's default scenario, cycled to the given count
+ * (all below Nyquist at 44.1 kHz)
+ */
+std::vector<dsp::ToneComponent> sampleComponents(size_t count) {
+    static const dsp::HarmonicRatio ratios[] = {{1, 2}, {2, 3}, {3, 4}, {1, 1}, {5, 4}, {1, 3},
+                                                {4, 5}, {5, 6}, {6, 7}, {7, 8}, {1, 4}, {3, 5}};
+    std::vector<dsp::ToneComponent> components(count);
+    for (size_t i = 0; i < count; ++i) {
+        components[i].ratio = ratios[i % (sizeof(ratios) / sizeof(ratios[0]))];
+        components[i].amplitude = 1.0f / static_cast<float>(1 + i % 4);
+        components[i].phase = 0.1 * static_cast<double>(i);
+    }
+    return components;
+}
+
+std::vector<dsp::Sample> compositeSignal(size_t n, size_t components) {
+    const dsp::PeakDetectorConfig defaults;
+    std::vector<dsp::ToneComponent> tones = sampleComponents(components);
+    std::vector<dsp::Sample> signal(n);
+    dsp::synthesizeComposite(tones.data(), tones.size(), defaults.f0, defaults.sample_rate,
+                             signal.data(), n);
+    return signal;
+}
+
+// ─── Codec ───────────────────────────────────────────────────────────────
+
+void registerCodec(BenchRegistry& registry) {
+    const HarmonicChannel channels[] = {HarmonicChannel::CONTROL, HarmonicChannel::DATA_STREAM};
+
+    for (size_t length : {8, 64, 256, 4096}) {
+        for (HarmonicChannel channel : channels) {
+            const int64_t channel_number = static_cast<int>(channel);
+            const double items = static_cast<double>(length);
+
+            registry.add({"codec/encode", {{"length", length}, {"channel", channel_number}}, items, items,
+                          [length, channel] {
+                              std::string message = sampleMessage(length);
+                              return BenchBody([message, channel](size_t iterations) {
+                                  for (size_t i = 0; i < iterations; ++i) {
+                                      keep(HarmonicProtocol::encodeMessage(message, channel));
+                                  }
+                              });
+                          }});
+
+            registry.add({"codec/decode", {{"length", length}, {"channel", channel_number}}, items, items,
+                          [length, channel] {
+                              auto frame = std::make_shared<HarmonicProtocol::EncodedFrame>(
+                                  HarmonicProtocol::encodeMessage(sampleMessage(length), channel));
+                              return BenchBody([frame, channel](size_t iterations) {
+                                  for (size_t i = 0; i < iterations; ++i) {
+                                      keep(HarmonicProtocol::decodeMessage(frame->data(), frame->size(), channel));
+                                  }
+                              });
+                          }});
+        }
+    }
+
+    for (size_t count : {64, 4096, 65536}) {
+        registry.add({"codec/harmonic_frequencies", {{"count", count}}, static_cast<double>(count),
+                      static_cast<double>(count * sizeof(double)), [count] {
+                          auto harmonics = std::make_shared<std::vector<int>>(count);
+                          auto frequencies = std::make_shared<std::vector<double>>(count);
+                          for (size_t i = 0; i < count; ++i) {
+                              (*harmonics)[i] = 2 + static_cast<int>(i % 38);
+                          }
+                          return BenchBody([harmonics, frequencies](size_t iterations) {
+                              for (size_t i = 0; i < iterations; ++i) {
+                                  HarmonicProtocol::calculateHarmonicFrequencies(
+                                      harmonics->data(), harmonics->size(), frequencies->data());
+                                  clobber();
+                              }
+                          });
+                      }});
+    }
+}
+
+// ─── Synthesis ───────────────────────────────────────────────────────────
+
+void registerSynthesis(BenchRegistry& registry) {
+    for (size_t components : {6, 32}) {
+        for (size_t n : {1024, 16384}) {
+            registry.add({"dsp/synthesize_composite", {{"components", components}, {"n", n}},
+                          static_cast<double>(n), 0.0, [components, n] {
+                              auto tones = std::make_shared<std::vector<dsp::ToneComponent>>(
+                                  sampleComponents(components));
+                              auto out = std::make_shared<std::vector<dsp::Sample>>(n);
+                              const dsp::PeakDetectorConfig defaults;
+                              return BenchBody([tones, out, defaults](size_t iterations) {
+                                  for (size_t i = 0; i < iterations; ++i) {
+                                      dsp::synthesizeComposite(tones->data(), tones->size(), defaults.f0,
+                                                               defaults.sample_rate, out->data(), out->size(),
+                                                               i * out->size());
+                                      clobber();
+                                  }
+                              });
+                          }});
+        }
+    }
+
+    for (size_t length : {16, 256}) {
+        registry.add({"dsp/synthesize_symbols", {{"length", length}},
+                      static_cast<double>(length * SYMBOL_SAMPLES), 0.0, [length] {
+                          auto frame = std::make_shared<HarmonicProtocol::EncodedFrame>(
+                              HarmonicProtocol::encodeMessage(sampleMessage(length),
+                                                              HarmonicChannel::DATA_STREAM));
+                          auto synth = std::make_shared<dsp::SymbolSynthesizer>(
+                              SYMBOL_RATE, SYMBOL_SAMPLES, HarmonicProtocol::FUNDAMENTAL_FREQUENCY);
+                          auto out = std::make_shared<std::vector<dsp::Sample>>(synth->samplesFor(length));
+                          return BenchBody([frame, synth, out](size_t iterations) {
+                              for (size_t i = 0; i < iterations; ++i) {
+                                  synth->render(frame->data(), frame->size(), out->data());
+                                  clobber();
+                              }
+                          });
+                      }});
+    }
+}
+
+// ─── Channel simulation ──────────────────────────────────────────────────
+
+void registerChannel(BenchRegistry& registry) {
+    registry.add({"dsp/gaussian", {{"n", 4096}}, 4096.0, 0.0, [] {
+                      auto rng = std::make_shared<dsp::GaussianGenerator>(1);
+                      auto out = std::make_shared<std::vector<dsp::Sample>>(4096);
+                      return BenchBody([rng, out](size_t iterations) {
+                          for (size_t i = 0; i < iterations; ++i) {
+                              rng->fill(out->data(), out->size());
+                              clobber();
+                          }
+                      });
+                  }});
+
+    // full: AWGN, Rician fading, clock error, two echoes and one interferer
+    for (int64_t full : {0, 1}) {
+        registry.add({"dsp/channel", {{"full", full}, {"n", 16384}}, 16384.0, 0.0, [full] {
+                          dsp::ChannelConfig config;
+                          config.sample_rate = SYMBOL_RATE;
+                          config.snr_db = 10.0;
+                          if (full) {
+                              config.rician_k = 4.0;
+                              config.clock_offset_ppm = 20.0;
+                              config.clock_drift_ppm_per_s = 1.0;
+                              config.taps = {{0, 1.0f}, {5, 0.4f}, {23, 0.1f}};
+                              config.interferers = {{12345.0, 0.1f, 0.0}};
+                          }
+                          auto channel = std::make_shared<dsp::ChannelSimulator>(config);
+                          auto in = std::make_shared<std::vector<dsp::Sample>>(compositeSignal(16384, 6));
+                          auto out = std::make_shared<std::vector<dsp::Sample>>(16384);
+                          return BenchBody([channel, in, out](size_t iterations) {
+                              for (size_t i = 0; i < iterations; ++i) {
+                                  channel->process(in->data(), out->data(), in->size());
+                                  clobber();
+                              }
+                          });
+                      }});
+    }
+}
+
+// ─── Spectral analysis ───────────────────────────────────────────────────
+
+void registerSpectral(BenchRegistry& registry) {
+    for (size_t n : {256, 1024, 4096, 16384}) {
+        registry.add({"dsp/fft", {{"n", n}}, static_cast<double>(n), 0.0, [n] {
+                          auto plan = std::make_shared<dsp::FftPlan>(n);
+                          auto in = std::make_shared<std::vector<dsp::Sample>>(compositeSignal(n, 6));
+                          auto out = std::make_shared<std::vector<dsp::Complex>>(plan->bins());
+                          return BenchBody([plan, in, out](size_t iterations) {
+                              for (size_t i = 0; i < iterations; ++i) {
+                                  plan->forward(in->data(), out->data());
+                                  clobber();
+                              }
+                          });
+                      }});
+    }
+
+    for (size_t n : {1024, 4096}) {
+        for (size_t threads : {1, 2, 4}) {
+            BenchCase detect{"dsp/detect", {{"n", n}}, static_cast<double>(n), 0.0, [n] {
+                                 auto detector = std::make_shared<dsp::PeakDetector>(n);
+                                 auto in = std::make_shared<std::vector<dsp::Sample>>(compositeSignal(n, 6));
+                                 auto peaks = std::make_shared<std::vector<dsp::DetectedComponent>>();
+                                 return BenchBody([detector, in, peaks](size_t iterations) {
+                                     for (size_t i = 0; i < iterations; ++i) {
+                                         detector->detect(dsp::SampleSpan(in->data(), in->size()), *peaks);
+                                         clobber();
+                                     }
+                                 });
+                             }};
+            detect.threads = threads;
+            registry.add(std::move(detect));
+        }
+    }
+
+    for (size_t count : {16, 256}) {
+        for (uint32_t max_denominator : {32u, 64u}) {
+            registry.add({"dsp/verify", {{"components", count}, {"max_denominator", max_denominator}},
+                          static_cast<double>(count), 0.0, [count, max_denominator] {
+                              dsp::IntegrityConfig config;
+                              config.max_denominator = max_denominator;
+                              auto verifier = std::make_shared<dsp::IntegrityVerifier>(config);
+                              auto report = std::make_shared<dsp::SpectralReport>();
+
+                              // Mostly valid ratios, one in eight off-grid
+                              std::mt19937 rng(42);
+                              std::uniform_int_distribution<uint32_t> pick(1, max_denominator);
+                              auto frequencies = std::make_shared<std::vector<double>>(count);
+                              for (size_t i = 0; i < count; ++i) {
+                                  double ratio = static_cast<double>(pick(rng)) / pick(rng);
+                                  (*frequencies)[i] = config.f0 * ratio + (i % 8 == 7 ? 37.0 * (1 + i % 5) : 0.0);
+                              }
+                              return BenchBody([verifier, report, frequencies](size_t iterations) {
+                                  for (size_t i = 0; i < iterations; ++i) {
+                                      verifier->verify(frequencies->data(), frequencies->size(), *report);
+                                      keep(report->integrity_score);
+                                  }
+                              });
+                          }});
+        }
+    }
+}
+
+} // namespace
+
+void registerCoreBenchmarks(BenchRegistry& registry) {
+    registerCodec(registry);
+    registerSynthesis(registry);
+    registerChannel(registry);
+    registerSpectral(registry);
+}
+
+} // namespace bench
+} // namespace harmonic_iot
@@ -0,0 +1,276 @@
+/**
+ * DftPlan Accuracy Check for Harmonic IoT Protocol
+ *
+ * Regression check for dsp::DftPlan. It compares magnitudes against a
+ * long-double direct DFT for lengths on each path (radix-2, mixed-radix
+ * with radices up to 13, and Bluestein for lengths with a larger prime),
+ * in double and float input. It then builds and runs plans from several
+ * threads at once, over more FFT sizes than the shared table cache holds,
+ * and requires every result to match the single-threaded one bit for bit:
+ *
+ *   harmonic_dft_check [--threads N] [--seed N]
+ *
+ * Registered with CTest. Exits with 1 on any mismatch.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "dsp/dft.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace harmonic_iot;
+
+namespace {
+
+/** Allowed |X[k]| error, relative to sqrt(N) for unit-variance input */
+constexpr double DOUBLE_TOLERANCE = 1e-12;
+constexpr double FLOAT_TOLERANCE = 1e-5;
+
+/** Bins checked per length above this size, to keep the direct DFT cheap */
+constexpr size_t FULL_CHECK_SIZE = 4096;
+constexpr size_t SPOT_BINS = 48;
+
+struct Options {
+    size_t threads = 8;
+    uint32_t seed = 1;
+};
+
+void usage() {
+    std::cerr << "usage: harmonic_dft_check [--threads N] [--seed N]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return options.threads > 0;
+}
+
+struct Case {
+    const char* path;
+    size_t size;
+    bool direct;        // Expected DftPlan::direct()
+};
+
+/** e^(-2πij/N), j < N, in long double */
+struct Twiddles {
+    std::vector<long double> cos;
+    std::vector<long double> sin;
+
+    explicit Twiddles(size_t n) : cos(n), sin(n) {
+        const long double pi = 3.141592653589793238462643383279502884L;
+        for (size_t j = 0; j < n; ++j) {
+            const long double angle = -2.0L * pi * static_cast<long double>(j) / static_cast<long double>(n);
+            cos[j] = std::cos(angle);
+            sin[j] = std::sin(angle);
+        }
+    }
+};
+
+/** |X[k]| of a real signal by direct summation in long double */
+double directMagnitude(const std::vector<double>& x, const Twiddles& w, size_t k) {
+    const size_t n = x.size();
+    long double re = 0.0L;
+    long double im = 0.0L;
+    size_t index = 0;   // j·k mod N
+    for (size_t j = 0; j < n; ++j) {
+        re += x[j] * w.cos[index];
+        im += x[j] * w.sin[index];
+        index += k;
+        if (index >= n) {
+            index -= n;
+        }
+    }
+    return static_cast<double>(std::sqrt(re * re + im * im));
+}
+
+/**
+ * Compare one length against the direct DFT
+ *
+ * @return Worst normalized error in double input, or -1 on a failure
+ */
+double checkLength(const Case& c, std::mt19937& rng) {
+    dsp::DftPlan plan(c.size);
+    if (plan.direct() != c.direct) {
+        std::cerr << c.path << " N=" << c.size << ": expected the "
+                  << (c.direct ? "direct" : "Bluestein") << " path\n";
+        return -1.0;
+    }
+
+    std::normal_distribution<double> noise;
+    std::vector<double> x(c.size);
+    for (double& v : x) {
+        v = noise(rng);
+    }
+    const std::vector<float> xf(x.begin(), x.end());
+    const std::vector<double> xw(xf.begin(), xf.end());
+
+    std::vector<double> mags(plan.bins());
+    std::vector<double> mags_f(plan.bins());
+    plan.magnitudes(x.data(), mags.data());
+    plan.magnitudes(xf.data(), mags_f.data());
+
+    std::vector<size_t> bins;
+    if (c.size <= FULL_CHECK_SIZE) {
+        for (size_t k = 0; k < plan.bins(); ++k) {
+            bins.push_back(k);
+        }
+    } else {
+        std::uniform_int_distribution<size_t> pick(1, plan.bins() - 2);
+        bins = {0, plan.bins() - 1};
+        for (size_t i = 0; i < SPOT_BINS; ++i) {
+            bins.push_back(pick(rng));
+        }
+    }
+
+    const Twiddles w(c.size);
+    const double scale = std::sqrt(static_cast<double>(c.size));
+    double worst = 0.0;
+    for (size_t k : bins) {
+        const double error = std::fabs(mags[k] - directMagnitude(x, w, k)) / scale;
+        const double error_f = std::fabs(mags_f[k] - directMagnitude(xw, w, k)) / scale;
+        worst = std::max(worst, error);
+        if (!(error <= DOUBLE_TOLERANCE) || !(error_f <= FLOAT_TOLERANCE)) {
+            std::cerr << c.path << " N=" << c.size << " bin " << k << ": error " << error
+                      << " (double), " << error_f << " (float)\n";
+            return -1.0;
+        }
+    }
+    return worst;
+}
+
+/** Deterministic test signal for the concurrent pass */
+std::vector<double> signalFor(size_t n) {
+    std::vector<double> x(n);
+    for (size_t j = 0; j < n; ++j) {
+        x[j] = std::sin(0.37 * static_cast<double>(j)) + 0.25 * std::cos(1.91 * static_cast<double>(j * j % 977));
+    }
+    return x;
+}
+
+/**
+ * Build and run plans from many threads over sizes that overflow the shared
+ * FFT table cache, so lookups race with inserts and clears
+ */
+bool checkConcurrent(size_t threads, uint32_t seed) {
+    std::vector<size_t> sizes;
+    for (size_t n = 200; n < 400; ++n) {
+        sizes.push_back(n);
+    }
+    for (size_t n : {1024u, 4096u, 11025u, 44100u, 10007u, 20014u}) {
+        sizes.push_back(n);
+    }
+
+    std::vector<std::vector<double>> expected(sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        dsp::DftPlan plan(sizes[i]);
+        expected[i].resize(plan.bins());
+        plan.magnitudes(signalFor(sizes[i]).data(), expected[i].data());
+    }
+
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<size_t> order(sizes.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::mt19937 rng(seed + static_cast<uint32_t>(t));
+            std::shuffle(order.begin(), order.end(), rng);
+            for (size_t i : order) {
+                dsp::DftPlan plan(sizes[i]);
+                std::vector<double> mags(plan.bins());
+                plan.magnitudes(signalFor(sizes[i]).data(), mags.data());
+                if (mags != expected[i]) {
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (mismatches.load() != 0) {
+        std::cerr << mismatches.load() << " concurrent transforms differ from the single-threaded result\n";
+        return false;
+    }
+    std::cout << "concurrent: " << threads << " threads x " << sizes.size() << " sizes, identical\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        std::vector<Case> cases;
+        for (size_t n = 1; n <= 300; ++n) {
+            size_t m = n;
+            for (size_t p = 2; p <= 13; ++p) {
+                while (m % p == 0) {
+                    m /= p;
+                }
+            }
+            cases.push_back({m == 1 ? "mixed-radix" : "bluestein", n, m == 1});
+        }
+        for (size_t n : {512u, 1024u, 4096u, 65536u}) {
+            cases.push_back({"radix-2", n, true});
+        }
+        for (size_t n : {1000u, 5000u, 11025u, 13u * 13u * 8u, 44100u, 48000u}) {
+            cases.push_back({"mixed-radix", n, true});
+        }
+        for (size_t n : {17u * 19u, 1009u, 5003u, 10007u, 20014u}) {
+            cases.push_back({"bluestein", n, false});
+        }
+
+        std::mt19937 rng(options.seed);
+        double worst = 0.0;
+        for (const Case& c : cases) {
+            const double error = checkLength(c, rng);
+            if (error < 0.0) {
+                std::cout << "FAILED\n";
+                return 1;
+            }
+            worst = std::max(worst, error);
+        }
+        std::cout << cases.size() << " lengths, worst normalized error " << worst << "\n";
+
+        if (!checkConcurrent(options.threads, options.seed)) {
+            std::cout << "FAILED\n";
+            return 1;
+        }
+        std::cout << "OK\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
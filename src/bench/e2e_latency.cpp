@@ -0,0 +1,351 @@
+/**
+ * End-to-End Latency Harness for Harmonic IoT Protocol
+ *
+ * Drives the full native path for every message
+ *
+ *   encodeMessage → symbol synthesis → simulated channel → ReceiveChain
+ *   (detect → decode → verify) → sink
+ *
+ * with one receive chain per harmonic channel on a shared thread pool:
+ *
+ *   harmonic_e2e [--channels 2,3,8] [--rate MSG/S] [--duration S] [--length N]
+ *                [--snr DB] [--rician-k K] [--clock-ppm PPM] [--workers N]
+ *                [--symbol-samples N] [--seed N] [--json FILE]
+ *
+ * The source is open loop: message i of the run is due at t₀ + i / offered
+ * rate and its latency is measured from that due time, not from when the
+ * source got to it, so a saturated chain shows up as growing latency rather
+ * than a silently lower send rate. --rate 0 sends as fast as the frame
+ * pools allow (closed loop). The channel is a dsp::ChannelSimulator per
+ * harmonic channel, each on its own noise stream of the seed.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "dsp/channel_model.h"
+#include "dsp/synthesizer.h"
+#include "pipeline/receive_chain.h"
+#include "protocol/codec.h"
+#include "runtime/thread_pool.h"
+#include "telemetry/hdr_histogram.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace harmonic_iot;
+using HarmonicProtocol::HarmonicChannel;
+
+namespace {
+
+/** Distinct messages cycled per channel */
+constexpr size_t MESSAGE_VARIANTS = 16;
+
+struct E2eOptions {
+    std::vector<int> channels = {2, 3, 4, 5, 7, 8};
+    double rate = 50.0;                 ///< Offered messages per second per channel (0: closed loop)
+    double duration = 5.0;              ///< Seconds of injection
+    size_t length = 16;                 ///< Characters per message
+    double snr_db = std::numeric_limits<double>::infinity();
+    double rician_k = std::numeric_limits<double>::infinity();
+    double clock_ppm = 0.0;
+    size_t workers = 0;                 ///< Pool threads (0: one per CPU)
+    size_t symbol_samples = 1024;
+    uint64_t seed = 1;
+    std::string json_path;
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Everything belonging to one harmonic channel
+ */
+struct ChannelRun {
+    HarmonicChannel channel = HarmonicChannel::CONTROL;
+    std::vector<std::string> messages;     // Sent text, by variant
+    std::vector<std::string> expected;     // decodeMessage(encodeMessage(text))
+    std::unique_ptr<dsp::ChannelSimulator> link;
+    std::unique_ptr<pipeline::ReceiveChain> chain;
+    telemetry::HdrHistogram latency;       // Due time → sink, ns (written by the sink only)
+    uint64_t sent = 0;                     // Written by the source only
+    std::atomic<uint64_t> delivered{0};
+    std::atomic<uint64_t> corrupted{0};
+
+    void onFrame(const pipeline::ReceiveFrame& frame) {
+        const int64_t now = nowNs();
+        latency.record(static_cast<uint64_t>(std::max<int64_t>(0, now - frame.received_ns)));
+        const std::string& want = expected[frame.sequence % MESSAGE_VARIANTS];
+        if (frame.message.size() != want.size() ||
+            !std::equal(want.begin(), want.end(), frame.message.begin())) {
+            corrupted.fetch_add(1, std::memory_order_relaxed);
+        }
+        delivered.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+std::vector<int> parseChannels(const std::string& list) {
+    std::vector<int> channels;
+    std::stringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int channel = std::atoi(item.c_str());
+        if (channel < 1 || channel + HarmonicProtocol::MAX_SYMBOL_OFFSET > HarmonicProtocol::MAX_HARMONICS) {
+            throw std::invalid_argument("Invalid channel: " + item);
+        }
+        channels.push_back(channel);
+    }
+    if (channels.empty()) {
+        throw std::invalid_argument("No channels given");
+    }
+    return channels;
+}
+
+void usage() {
+    std::cerr << "Usage: harmonic_e2e [options]\n"
+              << "  --channels LIST      Harmonic channels, comma separated (default 2,3,4,5,7,8)\n"
+              << "  --rate MSG/S         Offered load per channel; 0 = as fast as possible (default 50)\n"
+              << "  --duration S         Seconds of injection (default 5)\n"
+              << "  --length N           Characters per message (default 16)\n"
+              << "  --snr DB             Additive white Gaussian noise at this SNR (default: none)\n"
+              << "  --rician-k K         Flat fading with this K factor, 0 = Rayleigh (default: none)\n"
+              << "  --clock-ppm PPM      Transmitter clock offset (default 0)\n"
+              << "  --workers N          Receive pool threads, 0 = one per CPU (default 0)\n"
+              << "  --symbol-samples N   Samples per symbol slot, power of two (default 1024)\n"
+              << "  --seed N             Message and noise seed (default 1)\n"
+              << "  --json FILE          Also write the report as JSON\n";
+}
+
+bool parseArgs(int argc, char** argv, E2eOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--channels" && has_value) {
+            options.channels = parseChannels(argv[++i]);
+        } else if (arg == "--rate" && has_value) {
+            options.rate = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--duration" && has_value) {
+            options.duration = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--length" && has_value) {
+            options.length = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--snr" && has_value) {
+            options.snr_db = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--rician-k" && has_value) {
+            options.rician_k = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--clock-ppm" && has_value) {
+            options.clock_ppm = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--workers" && has_value) {
+            options.workers = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--symbol-samples" && has_value) {
+            options.symbol_samples = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.rate >= 0.0 && options.duration > 0.0 && options.length > 0 && options.rician_k >= 0.0;
+}
+
+double ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+void writeJson(std::ostream& out, const E2eOptions& options, const std::vector<std::unique_ptr<ChannelRun>>& runs,
+               double elapsed_s, const telemetry::HdrHistogram& lag) {
+    out << "{\n  \"config\": {\"rate_per_channel\": " << options.rate
+        << ", \"duration_s\": " << options.duration
+        << ", \"length\": " << options.length
+        << ", \"snr_db\": ";
+    if (std::isfinite(options.snr_db)) {
+        out << options.snr_db;
+    } else {
+        out << "null";
+    }
+    out << ", \"rician_k\": ";
+    if (std::isfinite(options.rician_k)) {
+        out << options.rician_k;
+    } else {
+        out << "null";
+    }
+    out << ", \"clock_ppm\": " << options.clock_ppm
+        << ", \"symbol_samples\": " << options.symbol_samples
+        << ", \"seed\": " << options.seed << "},\n"
+        << "  \"elapsed_s\": " << elapsed_s << ",\n"
+        << "  \"source_lag_ms\": {\"p50\": " << ms(lag.valueAtPercentile(50))
+        << ", \"p99\": " << ms(lag.valueAtPercentile(99))
+        << ", \"max\": " << ms(lag.max()) << "},\n"
+        << "  \"channels\": [";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const ChannelRun& run = *runs[i];
+        const uint64_t delivered = run.delivered.load();
+        const uint64_t corrupted = run.corrupted.load();
+        out << (i ? ",\n" : "\n")
+            << "    {\"channel\": " << static_cast<int>(run.channel)
+            << ", \"sent\": " << run.sent
+            << ", \"delivered\": " << delivered
+            << ", \"corrupted\": " << corrupted
+            << ", \"lost\": " << (run.sent - delivered)
+            << ", \"loss_rate\": " << (run.sent ? static_cast<double>(run.sent - delivered + corrupted) / run.sent : 0.0)
+            << ", \"throughput_msg_s\": " << static_cast<double>(delivered - corrupted) / elapsed_s
+            << ",\n     \"latency_ms\": {\"mean\": " << run.latency.mean() / 1e6
+            << ", \"min\": " << ms(run.latency.min())
+            << ", \"p50\": " << ms(run.latency.valueAtPercentile(50))
+            << ", \"p90\": " << ms(run.latency.valueAtPercentile(90))
+            << ", \"p99\": " << ms(run.latency.valueAtPercentile(99))
+            << ", \"p999\": " << ms(run.latency.valueAtPercentile(99.9))
+            << ", \"max\": " << ms(run.latency.max()) << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    E2eOptions options;
+    try {
+        if (!parseArgs(argc, argv, options)) {
+            usage();
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        usage();
+        return 2;
+    }
+
+    try {
+        runtime::ThreadPoolConfig pool_config;
+        pool_config.workers = options.workers;
+        runtime::ThreadPool pool(pool_config);
+
+        pipeline::ReceiveChainConfig chain_config;
+        chain_config.symbol_samples = options.symbol_samples;
+        chain_config.metrics = nullptr;
+        const dsp::SymbolSynthesizer synth(chain_config.sample_rate, chain_config.symbol_samples,
+                                           chain_config.integrity.f0);
+
+        std::mt19937_64 rng(options.seed);
+        std::uniform_int_distribution<int> printable(32, 126);
+        // Unit-amplitude tones carry 0.5 of power, the simulator's default reference
+        dsp::ChannelConfig link_config;
+        link_config.sample_rate = chain_config.sample_rate;
+        link_config.snr_db = options.snr_db;
+        link_config.rician_k = options.rician_k;
+        link_config.clock_offset_ppm = options.clock_ppm;
+        link_config.seed = options.seed;
+
+        std::vector<std::unique_ptr<ChannelRun>> runs;
+        for (int channel : options.channels) {
+            std::unique_ptr<ChannelRun> run(new ChannelRun());
+            run->channel = static_cast<HarmonicChannel>(channel);
+            link_config.stream = runs.size();
+            run->link.reset(new dsp::ChannelSimulator(link_config));
+            for (size_t v = 0; v < MESSAGE_VARIANTS; ++v) {
+                std::string text(options.length, ' ');
+                for (char& c : text) {
+                    c = static_cast<char>(printable(rng));
+                }
+                run->expected.push_back(HarmonicProtocol::decodeMessage(
+                    HarmonicProtocol::encodeMessage(text, run->channel), run->channel));
+                run->messages.push_back(std::move(text));
+            }
+            chain_config.channel = run->channel;
+            chain_config.name = "e2e-h" + std::to_string(channel);
+            ChannelRun* target = run.get();
+            run->chain.reset(new pipeline::ReceiveChain(
+                chain_config, [target](const pipeline::ReceiveFrame& frame) { target->onFrame(frame); }, pool));
+            runs.push_back(std::move(run));
+        }
+
+        const size_t channel_count = runs.size();
+        const double interval_ns = options.rate > 0.0 ? 1e9 / (options.rate * channel_count) : 0.0;
+        telemetry::HdrHistogram lag;
+        const int64_t start = nowNs();
+        const int64_t end = start + static_cast<int64_t>(options.duration * 1e9);
+
+        for (uint64_t i = 0;; ++i) {
+            int64_t due = options.rate > 0.0 ? start + static_cast<int64_t>(static_cast<double>(i) * interval_ns)
+                                             : nowNs();
+            if (due >= end) {
+                break;
+            }
+            for (int64_t now = nowNs(); now < due; now = nowNs()) {
+                if (due - now > 200000) {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(due - now - 100000));
+                } else if (!pool.runPendingTask()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            ChannelRun& run = *runs[i % channel_count];
+            pipeline::ReceiveFrame* frame = run.chain->acquire();
+            frame->sequence = run.sent;
+            frame->received_ns = due;
+            lag.record(static_cast<uint64_t>(std::max<int64_t>(0, nowNs() - due)));
+
+            const std::string& text = run.messages[run.sent % MESSAGE_VARIANTS];
+            HarmonicProtocol::EncodedFrame symbols = HarmonicProtocol::encodeMessage(text, run.channel);
+            frame->samples.resize(synth.samplesFor(symbols.size()));
+            synth.render(symbols.data(), symbols.size(), frame->samples.data());
+            run.link->process(frame->samples.data(), frame->samples.size());
+            run.chain->submit(frame);
+            ++run.sent;
+        }
+        for (auto& run : runs) {
+            run->chain->drain();
+        }
+        const double elapsed_s = static_cast<double>(nowNs() - start) / 1e9;
+
+        std::printf("%-8s %8s %9s %9s %8s %9s %10s %10s %10s %10s\n", "channel", "sent", "delivered",
+                    "corrupted", "lost", "msg/s", "p50 ms", "p99 ms", "p99.9 ms", "max ms");
+        uint64_t total_sent = 0;
+        uint64_t total_good = 0;
+        for (const auto& run : runs) {
+            const uint64_t delivered = run->delivered.load();
+            const uint64_t corrupted = run->corrupted.load();
+            total_sent += run->sent;
+            total_good += delivered - corrupted;
+            std::printf("H%-7d %8llu %9llu %9llu %8llu %9.1f %10.3f %10.3f %10.3f %10.3f\n",
+                        static_cast<int>(run->channel), static_cast<unsigned long long>(run->sent),
+                        static_cast<unsigned long long>(delivered), static_cast<unsigned long long>(corrupted),
+                        static_cast<unsigned long long>(run->sent - delivered),
+                        static_cast<double>(delivered - corrupted) / elapsed_s,
+                        ms(run->latency.valueAtPercentile(50)), ms(run->latency.valueAtPercentile(99)),
+                        ms(run->latency.valueAtPercentile(99.9)), ms(run->latency.max()));
+        }
+        std::printf("offered %.1f msg/s, injected %.1f msg/s, decoded %.1f msg/s, source lag p99 %.3f ms\n",
+                    options.rate * channel_count, static_cast<double>(total_sent) / options.duration,
+                    static_cast<double>(total_good) / elapsed_s, ms(lag.valueAtPercentile(99)));
+
+        if (!options.json_path.empty()) {
+            std::ofstream out(options.json_path);
+            if (!out) {
+                std::cerr << "Cannot open " << options.json_path << '\n';
+                return 1;
+            }
+            writeJson(out, options, runs, elapsed_s, lag);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
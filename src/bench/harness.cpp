@@ -0,0 +1,440 @@
+/**
+ * Benchmark Harness for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "harness.h"
+#include "telemetry/alloc_accounting.h"
+#include "telemetry/latency.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace harmonic_iot {
+namespace bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * Threads 1..n-1 of a multi-threaded case, released together per sample
+ *
+ * The calling thread runs body 0 itself, so a sample's wall time covers
+ * every body from release to the last one finishing.
+ */
+class Gang {
+public:
+    explicit Gang(std::vector<BenchBody>& bodies) : bodies_(bodies) {
+        for (size_t i = 1; i < bodies_.size(); ++i) {
+            threads_.emplace_back([this, i] { worker(i); });
+        }
+    }
+
+    ~Gang() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    Gang(const Gang&) = delete;
+    Gang& operator=(const Gang&) = delete;
+
+    /** Wall time of one concurrent batch */
+    double sample(size_t iterations) {
+        const Clock::time_point begin = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            iterations_ = iterations;
+            pending_ = threads_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+        bodies_[0](iterations);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        return elapsedNs(begin, Clock::now());
+    }
+
+private:
+    void worker(size_t index) {
+        uint64_t seen = 0;
+        for (;;) {
+            size_t iterations;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                iterations = iterations_;
+            }
+            bodies_[index](iterations);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<BenchBody>& bodies_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;
+    size_t iterations_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+};
+
+/** Linear interpolation between closest ranks of sorted values */
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const double rank = q * static_cast<double>(sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(rank);
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    const double fraction = rank - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+void writeString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+void writeNumber(std::ostream& out, double value) {
+    if (!std::isfinite(value)) {
+        out << "null";
+        return;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    out << buffer;
+}
+
+std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string utcTimestamp() {
+    const std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#if defined(_WIN32)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buffer;
+}
+
+} // namespace
+
+std::string BenchCase::name() const {
+    std::string result = group;
+    for (const auto& param : params) {
+        result += '/';
+        result += param.first;
+        result += '=';
+        result += std::to_string(param.second);
+    }
+    if (threads > 1) {
+        result += "/threads=" + std::to_string(threads);
+    }
+    return result;
+}
+
+double BenchResult::perOp(PerfEvent event) const {
+    if (!perf.has(event) || perf_ops == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(perf[event]) / static_cast<double>(perf_ops);
+}
+
+double BenchResult::ipc() const {
+    if (!perf.has(PerfEvent::Cycles) || !perf.has(PerfEvent::Instructions) || perf[PerfEvent::Cycles] == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(perf[PerfEvent::Instructions]) / static_cast<double>(perf[PerfEvent::Cycles]);
+}
+
+std::string BenchResult::bound() const {
+    if (!perf.has(PerfEvent::Instructions) || perf[PerfEvent::Instructions] == 0) {
+        return std::string();
+    }
+    auto mpki = [this](PerfEvent event) {
+        return perf.has(event) ? 1000.0 * static_cast<double>(perf[event]) /
+                                     static_cast<double>(perf[PerfEvent::Instructions])
+                               : 0.0;
+    };
+    if (mpki(PerfEvent::LlcMisses) > 1.0) {
+        return "memory";
+    }
+    if (mpki(PerfEvent::L1dMisses) > 20.0) {
+        return "cache";
+    }
+    if (mpki(PerfEvent::BranchMisses) > 5.0) {
+        return "branch";
+    }
+    return "compute";
+}
+
+// ─── Running ─────────────────────────────────────────────────────────────
+
+BenchResult runCase(const BenchCase& bench_case, const BenchOptions& options) {
+    if (!bench_case.setup) {
+        throw std::invalid_argument("Benchmark " + bench_case.name() + " has no setup");
+    }
+    if (bench_case.threads == 0) {
+        throw std::invalid_argument("Benchmark " + bench_case.name() + " needs at least one thread");
+    }
+
+    std::vector<BenchBody> bodies;
+    for (size_t i = 0; i < bench_case.threads; ++i) {
+        bodies.push_back(bench_case.setup());
+    }
+
+    // Calibrate on one thread: grow the batch until it fills a sample
+    const double target_ns = options.sample_ms * 1e6;
+    size_t iterations = 1;
+    for (;;) {
+        const Clock::time_point begin = Clock::now();
+        bodies[0](iterations);
+        const double elapsed = elapsedNs(begin, Clock::now());
+        if (elapsed >= target_ns || iterations >= (size_t(1) << 40)) {
+            break;
+        }
+        const double scale = elapsed > target_ns / 16 ? target_ns / elapsed * 1.1 : 8.0;
+        iterations = std::max(iterations + 1, static_cast<size_t>(static_cast<double>(iterations) * scale));
+    }
+
+    std::unique_ptr<Gang> gang;
+    if (bodies.size() > 1) {
+        gang.reset(new Gang(bodies));
+    }
+    auto sample = [&]() {
+        if (gang) {
+            return gang->sample(iterations);
+        }
+        const Clock::time_point begin = Clock::now();
+        bodies[0](iterations);
+        return elapsedNs(begin, Clock::now());
+    };
+
+    for (size_t i = 0; i < options.warmup_samples; ++i) {
+        sample();
+    }
+    const double ops = static_cast<double>(iterations) * static_cast<double>(bodies.size());
+    std::unique_ptr<PerfCounters> counters;
+    if (options.perf_counters) {
+        counters.reset(new PerfCounters());
+    }
+    PerfSample perf;
+    std::vector<double> ns_per_op;
+    ns_per_op.reserve(options.samples);
+    for (size_t i = 0; i < std::max<size_t>(options.samples, 1); ++i) {
+        if (counters) {
+            counters->start();
+        }
+        const double elapsed = sample();
+        if (counters) {
+            perf.accumulate(counters->stop());
+        }
+        ns_per_op.push_back(elapsed / ops);
+    }
+    gang.reset();
+
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+    BenchResult result;
+    result.name = bench_case.name();
+    result.group = bench_case.group;
+    result.params = bench_case.params;
+    result.threads = bench_case.threads;
+    result.iterations = iterations;
+    result.samples = ns_per_op.size();
+
+    double sum = 0.0;
+    for (double v : ns_per_op) {
+        sum += v;
+    }
+    result.mean_ns = sum / static_cast<double>(ns_per_op.size());
+    double squares = 0.0;
+    for (double v : ns_per_op) {
+        squares += (v - result.mean_ns) * (v - result.mean_ns);
+    }
+    result.stddev_ns = ns_per_op.size() > 1 ? std::sqrt(squares / static_cast<double>(ns_per_op.size() - 1)) : 0.0;
+    result.min_ns = ns_per_op.front();
+    result.p50_ns = percentile(ns_per_op, 0.50);
+    result.p90_ns = percentile(ns_per_op, 0.90);
+    result.p99_ns = percentile(ns_per_op, 0.99);
+    result.max_ns = ns_per_op.back();
+    if (result.p50_ns > 0.0) {
+        result.items_per_second = bench_case.items_per_op * 1e9 / result.p50_ns;
+        result.bytes_per_second = bench_case.bytes_per_op * 1e9 / result.p50_ns;
+    }
+    result.items_per_op = bench_case.items_per_op;
+    result.perf = perf;
+    result.perf_ops = static_cast<uint64_t>(iterations) * ns_per_op.size();
+    return result;
+}
+
+std::vector<BenchResult> BenchRegistry::run(const BenchOptions& options, std::ostream* progress) const {
+    std::vector<BenchResult> results;
+    if (options.perf_counters && progress) {
+        PerfCounters probe;
+        if (!probe.available()) {
+            *progress << "Hardware counters unavailable, timing only: " << probe.reason() << '\n';
+        }
+    }
+    for (const BenchCase& bench_case : cases_) {
+        const std::string name = bench_case.name();
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(runCase(bench_case, options));
+        if (progress) {
+            const BenchResult& r = results.back();
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-48s %12.1f ns/op  p99 %12.1f  %12.4g items/s",
+                          name.c_str(), r.p50_ns, r.p99_ns, r.items_per_second);
+            *progress << line;
+            if (std::isfinite(r.ipc())) {
+                std::snprintf(line, sizeof(line), "  IPC %5.2f  %s", r.ipc(), r.bound().c_str());
+                *progress << line;
+            }
+            *progress << '\n' << std::flush;
+        }
+    }
+    return results;
+}
+
+// ─── JSON ────────────────────────────────────────────────────────────────
+
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": ";
+    writeString(out, utcTimestamp());
+    out << ",\n    \"compiler\": ";
+    writeString(out, compilerName());
+#ifdef NDEBUG
+    out << ",\n    \"optimized\": true";
+#else
+    out << ",\n    \"optimized\": false";
+#endif
+    out << ",\n    \"hardware_threads\": " << std::thread::hardware_concurrency();
+    out << ",\n    \"telemetry\": " << (HARMONIC_IOT_TELEMETRY ? "true" : "false");
+    out << ",\n    \"alloc_accounting\": "
+        << (telemetry::allocationAccountingEnabled() ? "true" : "false");
+    bool counted = false;
+    for (const BenchResult& r : results) {
+        counted = counted || std::isfinite(r.ipc());
+    }
+    out << ",\n    \"perf_counters\": " << (counted ? "true" : "false");
+    out << "\n  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(out, r.name);
+        out << ", \"group\": ";
+        writeString(out, r.group);
+        out << ", \"params\": {";
+        for (size_t p = 0; p < r.params.size(); ++p) {
+            out << (p ? ", " : "");
+            writeString(out, r.params[p].first);
+            out << ": " << r.params[p].second;
+        }
+        out << "}, \"threads\": " << r.threads
+            << ", \"iterations\": " << r.iterations
+            << ", \"samples\": " << r.samples
+            << ",\n     \"ns_per_op\": {\"mean\": ";
+        writeNumber(out, r.mean_ns);
+        out << ", \"stddev\": ";
+        writeNumber(out, r.stddev_ns);
+        out << ", \"min\": ";
+        writeNumber(out, r.min_ns);
+        out << ", \"p50\": ";
+        writeNumber(out, r.p50_ns);
+        out << ", \"p90\": ";
+        writeNumber(out, r.p90_ns);
+        out << ", \"p99\": ";
+        writeNumber(out, r.p99_ns);
+        out << ", \"max\": ";
+        writeNumber(out, r.max_ns);
+        out << "},\n     \"items_per_second\": ";
+        writeNumber(out, r.items_per_second);
+        out << ", \"bytes_per_second\": ";
+        writeNumber(out, r.bytes_per_second);
+        if (r.perf_ops && std::isfinite(r.ipc())) {
+            out << ",\n     \"counters\": {\"ipc\": ";
+            writeNumber(out, r.ipc());
+            out << ", \"bound\": ";
+            writeString(out, r.bound());
+            out << ", \"multiplexed\": " << (r.perf.multiplexed ? "true" : "false");
+            for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+                const PerfEvent event = static_cast<PerfEvent>(e);
+                if (!r.perf.has(event)) {
+                    continue;
+                }
+                out << ", \"" << perfEventName(event) << "_per_op\": ";
+                writeNumber(out, r.perOp(event));
+                out << ", \"" << perfEventName(event) << "_per_item\": ";
+                writeNumber(out, r.perItem(event));
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace bench
+} // namespace harmonic_iot
@@ -0,0 +1,168 @@
+/**
+ * Benchmark Harness for Harmonic IoT Protocol
+ *
+ * Minimal self-contained micro-benchmark runner used by harmonic_bench.
+ * A case is a named, parameterized body that performs a given number of
+ * operations; the runner calibrates the batch size to a target sample
+ * time, collects samples and reports ns/op percentiles and throughput:
+ *
+ *   registry.add({"codec/encode", {{"length", 64}}, 64.0, 64.0, [] {
+ *       std::string message(64, 'x');
+ *       return BenchBody([message](size_t iterations) {
+ *           for (size_t i = 0; i < iterations; ++i) {
+ *               keep(encodeMessage(message, HarmonicChannel::CONTROL));
+ *           }
+ *       });
+ *   }});
+ *
+ * Setup runs once per case and per thread, outside the timed region.
+ * With threads > 1 every thread runs its own body concurrently and
+ * ns/op is wall time divided by the operations of all threads.
+ *
+ * With perf_counters set, hardware counters of the calling thread (which
+ * runs body 0) are read around every timed sample and reported per
+ * operation and per item, together with IPC and a rough bottleneck class.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_BENCH_HARNESS_H
+#define HARMONIC_IOT_BENCH_HARNESS_H
+
+#include "bench/perf_counters.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace harmonic_iot {
+namespace bench {
+
+/** Runs the given number of operations */
+using BenchBody = std::function<void(size_t iterations)>;
+
+/**
+ * One benchmark configuration
+ */
+struct BenchCase {
+    std::string group;                                    ///< e.g. "dsp/fft"
+    std::vector<std::pair<std::string, int64_t>> params;  ///< Sweep point, e.g. {"n", 1024}
+    double items_per_op = 1.0;                            ///< Elements processed per operation
+    double bytes_per_op = 0.0;                            ///< Payload bytes per operation (0: none)
+    std::function<BenchBody()> setup;                     ///< Builds the body outside timing
+    size_t threads = 1;                                   ///< Concurrent bodies
+
+    /** group/param=value/... */
+    std::string name() const;
+};
+
+/**
+ * Runner settings
+ */
+struct BenchOptions {
+    std::string filter;           ///< Substring of the case name; empty runs all
+    size_t samples = 25;          ///< Timed samples per case
+    double sample_ms = 2.0;       ///< Target duration of one sample
+    size_t warmup_samples = 2;    ///< Untimed samples before measuring
+    bool perf_counters = false;   ///< Read hardware counters around each sample
+};
+
+/**
+ * Distribution of one case's per-sample ns/op
+ */
+struct BenchResult {
+    std::string name;
+    std::string group;
+    std::vector<std::pair<std::string, int64_t>> params;
+    size_t threads = 1;
+    uint64_t iterations = 0;      ///< Operations per sample and thread
+    size_t samples = 0;
+    double mean_ns = 0.0;
+    double stddev_ns = 0.0;
+    double min_ns = 0.0;
+    double p50_ns = 0.0;
+    double p90_ns = 0.0;
+    double p99_ns = 0.0;
+    double max_ns = 0.0;
+    double items_per_second = 0.0;    ///< At the median
+    double bytes_per_second = 0.0;    ///< At the median (0 if the case has no payload)
+
+    double items_per_op = 1.0;
+    PerfSample perf;                  ///< Thread 0 over all timed samples
+    uint64_t perf_ops = 0;            ///< Operations perf covers
+
+    /** Counter value per operation, or NaN if the event is unavailable */
+    double perOp(PerfEvent event) const;
+
+    /** Counter value per item (element, sample or symbol) */
+    double perItem(PerfEvent event) const { return perOp(event) / items_per_op; }
+
+    /** Instructions per cycle, or NaN */
+    double ipc() const;
+
+    /**
+     * Rough bottleneck from misses per thousand instructions: "memory"
+     * (LLC > 1), "cache" (L1D > 20), "branch" (branch > 5), otherwise
+     * "compute"; empty without counters
+     */
+    std::string bound() const;
+};
+
+/**
+ * Ordered set of cases
+ */
+class BenchRegistry {
+public:
+    void add(BenchCase bench_case) { cases_.push_back(std::move(bench_case)); }
+
+    const std::vector<BenchCase>& cases() const { return cases_; }
+
+    /**
+     * Run every case matching the filter
+     *
+     * @param progress If set, receives one human-readable line per case
+     */
+    std::vector<BenchResult> run(const BenchOptions& options, std::ostream* progress = nullptr) const;
+
+private:
+    std::vector<BenchCase> cases_;
+};
+
+/**
+ * Measure one case
+ *
+ * @throws std::invalid_argument if the case has no setup or zero threads
+ */
+BenchResult runCase(const BenchCase& bench_case, const BenchOptions& options);
+
+/**
+ * Write results as a JSON document with a build/host context block
+ */
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results);
+
+/** Keep a value alive so the computation producing it is not optimized away */
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/** Compiler barrier: memory written before it counts as used */
+inline void clobber() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace bench
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_BENCH_HARNESS_H
@@ -0,0 +1,403 @@
+#!/usr/bin/env python3
+"""Differential accuracy and speed harness: hpg_native vs. hpg_core.
+
+Generates randomized channel sets and signals, runs every hpg_core
+function and its hpg_native counterpart on the same inputs, and checks
+that they agree:
+
+    generate_composite_signal   time axis and samples within --signal-tol
+    decode_fft                  same peaks (frequency, ratio a/b), amplitudes
+                                within --db-tol, deviations within 1e-6 Hz
+    decode_fft[float32]         as above, native on a float32 copy against the
+                                reference on the same values widened to float64
+    verify_rational_integrity   same counts, score, pass/fail and violations
+    compute_hn                  identical sets
+
+and reports the time each side took and the speedup per function:
+
+    PYTHONPATH=build/python python3 src/bench/hpg_differential.py \\
+        [--cases N] [--seed N] [--repeat N] [--max-duration S] [--json FILE]
+
+Signal lengths cycle through the three dsp::DftPlan paths (radix-2,
+mixed-radix, Bluestein), and the report shows how many cases took each.
+Peaks within --db-tol of the detection threshold may be found by one side
+only; they are counted as borderline, not as mismatches. Needs numpy.
+Exits with 1 if any comparison fails.
+
+Copyright (c) 2025 Guilherme Gonçalves Machado
+Licensed under CC BY-NC-SA 4.0
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import os
+import random
+import sys
+import time
+from dataclasses import dataclass, field
+from typing import Callable, Dict, List, Optional
+
+# hpg_core lives at the repository root, two levels above this file
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+SAMPLE_RATES = [44100.0, 48000.0, 96000.0]
+F0_CHOICES = [16384.0, 8000.0, 4096.0, 1000.0]
+HN_SIZES = [8, 16, 32, 64]
+MIN_LENGTH = 256
+
+# dsp::DftPlan transforms by one of three paths depending on the length
+FFT_PATHS = ["radix-2", "mixed-radix", "bluestein"]
+MAX_RADIX = 13
+
+
+@dataclass
+class Case:
+    f0: float
+    sample_rate: float
+    duration: float
+    threshold_db: float
+    harmonics: List[Dict]
+    fft_path: str
+
+
+@dataclass
+class FunctionResult:
+    name: str
+    cases: int = 0
+    mismatches: int = 0
+    borderline: int = 0
+    max_error: float = 0.0
+    error_unit: str = ""
+    reference_s: float = 0.0
+    native_s: float = 0.0
+    failures: List[str] = field(default_factory=list)
+    fft_paths: Dict[str, int] = field(default_factory=dict)   # Cases per DftPlan path
+
+    def fail(self, message: str) -> None:
+        self.mismatches += 1
+        if len(self.failures) < 5:
+            self.failures.append(message)
+
+    def error(self, value: float) -> None:
+        self.max_error = max(self.max_error, value)
+
+    @property
+    def speedup(self) -> float:
+        return self.reference_s / self.native_s if self.native_s > 0 else float("inf")
+
+
+def parse_args(argv: List[str]) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Compare hpg_native against the hpg_core reference"
+    )
+    parser.add_argument("--cases", type=int, default=200, help="Random signals (default 200)")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed (default 1)")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="Timing runs per function, best kept (default 3)")
+    parser.add_argument("--max-duration", type=float, default=0.25,
+                        help="Longest signal in seconds (default 0.25)")
+    parser.add_argument("--signal-tol", type=float, default=1e-9,
+                        help="Max sample error relative to the summed amplitudes (default 1e-9)")
+    parser.add_argument("--db-tol", type=float, default=1e-6,
+                        help="Max amplitude_db difference for float64 input (default 1e-6)")
+    parser.add_argument("--json", metavar="FILE", help="Also write the report as JSON")
+    args = parser.parse_args(argv)
+    if args.cases < 1 or args.repeat < 1 or args.max_duration <= 0:
+        parser.error("--cases and --repeat must be >= 1 and --max-duration > 0")
+    return args
+
+
+# ─── Case generation ─────────────────────────────────────────────────────────
+
+def largest_prime_factor(n: int) -> int:
+    largest, p = 1, 2
+    while p * p <= n:
+        while n % p == 0:
+            largest, n = p, n // p
+        p += 1
+    return max(largest, n)
+
+
+def fft_path(n: int) -> str:
+    """The dsp::DftPlan path for an n-point real transform (mirrors dsp/dft.cpp).
+
+    Even lengths run a complex FFT of n/2 points. Lengths whose primes are
+    all <= 13 run the mixed-radix FFT (radix-2/4 only for powers of two);
+    any larger prime factor means Bluestein.
+    """
+    m = n // 2 if n % 2 == 0 else n
+    if m & (m - 1) == 0:
+        return "radix-2"
+    if largest_prime_factor(m) <= MAX_RADIX:
+        return "mixed-radix"
+    return "bluestein"
+
+
+def pick_length(rng: random.Random, path: str, max_length: int) -> int:
+    """A random length in [MIN_LENGTH, max_length] (about) taking the given path."""
+    if path == "radix-2":
+        return 1 << rng.randint(8, max(8, int(math.log2(max_length))))
+    n = rng.randint(MIN_LENGTH, max(MIN_LENGTH, max_length))
+    if path == "bluestein":
+        # A large prime, or twice one so the even split is tried and rejected
+        while largest_prime_factor(n) != n or n <= MAX_RADIX:
+            n += 1
+        return 2 * n if rng.random() < 0.5 and 2 * n <= max_length else n
+    while fft_path(n) != path:
+        n += 1
+    return n
+
+
+def make_cases(count: int, seed: int, max_duration: float) -> List[Case]:
+    """Random channel sets over random f0, rates and lengths.
+
+    Lengths cycle through the three DftPlan paths: powers of two (radix-2),
+    other 13-smooth lengths (mixed-radix Stockham) and lengths with a prime
+    factor above 13 (Bluestein). Some cases add an off-grid tone so that
+    the integrity check also sees failing reports.
+    """
+    rng = random.Random(seed)
+    cases = []
+    for i in range(count):
+        sample_rate = rng.choice(SAMPLE_RATES)
+        f0 = rng.choice(F0_CHOICES)
+        path = FFT_PATHS[i % len(FFT_PATHS)]
+        n = pick_length(rng, path, int(max_duration * sample_rate))
+        duration = (n + 0.5) / sample_rate      # int(sample_rate * duration) == n
+
+        nyquist = 0.45 * sample_rate
+        members = [(a, b) for b in range(1, 9) for a in range(1, 17)
+                   if math.gcd(a, b) == 1 and f0 * a / b < nyquist]
+        chosen = rng.sample(members, min(len(members), rng.randint(1, 8)))
+        harmonics = [
+            {"a": a, "b": b, "amplitude": rng.uniform(0.1, 1.0), "phase": rng.uniform(0.0, 2 * math.pi)}
+            for a, b in chosen
+        ]
+        if rng.random() < 0.3:
+            # Off-grid intruder: an irreducible a/b with a large denominator
+            b = rng.choice([37, 41, 43, 47])
+            a = rng.randint(b // 2, 2 * b)
+            if math.gcd(a, b) == 1 and f0 * a / b < nyquist:
+                harmonics.append({"a": a, "b": b, "amplitude": rng.uniform(0.1, 1.0), "phase": 0.0})
+
+        cases.append(Case(f0, sample_rate, duration, rng.choice([-40.0, -30.0, -60.0]), harmonics, path))
+    return cases
+
+
+# ─── Comparisons ─────────────────────────────────────────────────────────────
+
+def compare_signals(result: FunctionResult, case: Case, ref, nat, np, tol: float) -> None:
+    result.cases += 1
+    t_ref, s_ref, _ = ref
+    t_nat, s_nat, _ = nat
+    if len(s_ref) != len(s_nat) or len(t_ref) != len(t_nat):
+        result.fail(f"length {len(s_ref)} vs {len(s_nat)} (f0={case.f0}, rate={case.sample_rate})")
+        return
+    if len(s_ref) == 0:
+        return
+    scale = sum(h["amplitude"] for h in case.harmonics)
+    error = float(np.max(np.abs(np.asarray(s_ref) - np.asarray(s_nat)))) / scale
+    t_error = float(np.max(np.abs(np.asarray(t_ref) - np.asarray(t_nat))))
+    result.error(error)
+    if error > tol or t_error > 1e-12:
+        result.fail(f"signal error {error:.3g}, time error {t_error:.3g} (n={len(s_ref)}, f0={case.f0})")
+
+
+def compare_peaks(result: FunctionResult, case: Case, ref: List[Dict], nat: List[Dict], tol: float) -> None:
+    result.cases += 1
+    by_freq = {round(p["frequency"], 6): p for p in nat}
+    matched = set()
+    problems = []
+
+    for p in ref:
+        key = round(p["frequency"], 6)
+        q = by_freq.get(key)
+        if q is None:
+            if p["amplitude_db"] - case.threshold_db <= tol:
+                result.borderline += 1
+            else:
+                problems.append(f"missing {p['frequency']:.3f} Hz ({p['amplitude_db']:.2f} dB)")
+            continue
+        matched.add(key)
+        diff = abs(p["amplitude_db"] - q["amplitude_db"])
+        result.error(diff)
+        if (p["ratio_a"], p["ratio_b"]) != (q["ratio_a"], q["ratio_b"]) or p["closest_ratio"] != q["closest_ratio"]:
+            problems.append(f"{p['frequency']:.3f} Hz labelled {p['closest_ratio']} vs {q['closest_ratio']}")
+        if diff > tol:
+            problems.append(f"{p['frequency']:.3f} Hz at {p['amplitude_db']:.6f} vs {q['amplitude_db']:.6f} dB")
+        if abs(p["deviation_hz"] - q["deviation_hz"]) > 1e-6:
+            problems.append(f"{p['frequency']:.3f} Hz deviation {p['deviation_hz']} vs {q['deviation_hz']}")
+
+    for key, q in by_freq.items():
+        if key not in matched:
+            if q["amplitude_db"] - case.threshold_db <= tol:
+                result.borderline += 1
+            else:
+                problems.append(f"extra {q['frequency']:.3f} Hz ({q['amplitude_db']:.2f} dB)")
+
+    if problems:
+        result.fail(f"n={int(case.sample_rate * case.duration)} f0={case.f0}: " + "; ".join(problems[:3]))
+
+
+def compare_reports(result: FunctionResult, ref, nat) -> None:
+    result.cases += 1
+    fields = ("total_components", "valid_components", "invalid_components", "passed")
+    for name in fields:
+        if getattr(ref, name) != getattr(nat, name):
+            result.fail(f"{name} {getattr(ref, name)} vs {getattr(nat, name)}")
+            return
+    if abs(ref.integrity_score - nat.integrity_score) > 1e-9:
+        result.fail(f"integrity_score {ref.integrity_score} vs {nat.integrity_score}")
+        return
+    if len(ref.violations) != len(nat.violations):
+        result.fail(f"{len(ref.violations)} vs {len(nat.violations)} violations")
+        return
+    for v, w in zip(ref.violations, nat.violations):
+        diff = abs(v["deviation_hz"] - w["deviation_hz"])
+        result.error(diff)
+        if v["frequency"] != w["frequency"] or diff > 1e-6:
+            result.fail(f"violation {v} vs {w}")
+            return
+
+
+# ─── Timing ──────────────────────────────────────────────────────────────────
+
+def best_time(fn: Callable[[], None], repeat: int) -> float:
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        fn()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def run(args: argparse.Namespace) -> List[FunctionResult]:
+    import numpy as np
+    import hpg_core as ref
+    import hpg_native as nat
+
+    cases = make_cases(args.cases, args.seed, args.max_duration)
+    synth = FunctionResult("generate_composite_signal", error_unit="rel")
+    decode = FunctionResult("decode_fft", error_unit="dB")
+    decode32 = FunctionResult("decode_fft[float32]", error_unit="dB")
+    verify = FunctionResult("verify_rational_integrity", error_unit="Hz")
+    hn = FunctionResult("compute_hn")
+
+    def synth_args(case: Case) -> Dict:
+        return {"f0": case.f0, "harmonics": case.harmonics, "duration": case.duration,
+                "sample_rate": case.sample_rate}
+
+    signals = []
+    peaks = []
+    for case in cases:
+        r = ref.generate_composite_signal(**synth_args(case))
+        n = nat.generate_composite_signal(**synth_args(case))
+        compare_signals(synth, case, r, n, np, args.signal_tol)
+        signal = r[1]
+        path = fft_path(len(signal))
+        if path != case.fft_path:
+            decode.fail(f"length {len(signal)} takes the {path} path, not {case.fft_path}")
+        for result in (decode, decode32):
+            result.fft_paths[path] = result.fft_paths.get(path, 0) + 1
+        s32 = signal.astype(np.float32)
+        signals.append((signal, s32, s32.astype(np.float64)))
+
+        kwargs = {"sample_rate": case.sample_rate, "f0": case.f0, "threshold_db": case.threshold_db}
+        p_ref = ref.decode_fft(signal, **kwargs)
+        compare_peaks(decode, case, p_ref, nat.decode_fft(signal, **kwargs), args.db_tol)
+        compare_peaks(decode32, case, ref.decode_fft(signals[-1][2], **kwargs),
+                      nat.decode_fft(s32, **kwargs), args.db_tol)
+        peaks.append(p_ref)
+
+        compare_reports(verify, ref.verify_rational_integrity(p_ref, f0=case.f0),
+                        nat.verify_rational_integrity(p_ref, f0=case.f0))
+
+    for size in HN_SIZES:
+        hn.cases += 1
+        if ref.compute_hn(size) != nat.compute_hn(size):
+            hn.fail(f"H_{size} differs")
+
+    # Same inputs, whole case set per timing run
+    for result, module_fn in (
+        (synth, lambda m: [m.generate_composite_signal(**synth_args(c)) for c in cases]),
+        (decode, lambda m: [m.decode_fft(s, c.sample_rate, c.f0, c.threshold_db)
+                            for c, (s, _, _) in zip(cases, signals)]),
+        (verify, lambda m: [m.verify_rational_integrity(p, f0=c.f0) for c, p in zip(cases, peaks)]),
+        (hn, lambda m: [m.compute_hn(size) for size in HN_SIZES]),
+    ):
+        result.reference_s = best_time(lambda: module_fn(ref), args.repeat)
+        result.native_s = best_time(lambda: module_fn(nat), args.repeat)
+    decode32.reference_s = best_time(
+        lambda: [ref.decode_fft(s, c.sample_rate, c.f0, c.threshold_db)
+                 for c, (_, _, s) in zip(cases, signals)], args.repeat)
+    decode32.native_s = best_time(
+        lambda: [nat.decode_fft(s, c.sample_rate, c.f0, c.threshold_db)
+                 for c, (_, s, _) in zip(cases, signals)], args.repeat)
+
+    return [synth, decode, decode32, verify, hn]
+
+
+def print_report(results: List[FunctionResult], args: argparse.Namespace) -> None:
+    print(f"{args.cases} cases, seed {args.seed}, best of {args.repeat}")
+    print(f"{'function':<28} {'cases':>6} {'mismatch':>9} {'border':>7} {'max error':>12} "
+          f"{'ref ms':>10} {'native ms':>10} {'speedup':>8}")
+    for r in results:
+        error = f"{r.max_error:.3g} {r.error_unit}".strip() if r.error_unit else "-"
+        print(f"{r.name:<28} {r.cases:>6} {r.mismatches:>9} {r.borderline:>7} {error:>12} "
+              f"{r.reference_s * 1e3:>10.2f} {r.native_s * 1e3:>10.2f} {r.speedup:>7.1f}x")
+    for r in results:
+        if r.fft_paths:
+            paths = ", ".join(f"{p} {r.fft_paths.get(p, 0)}" for p in FFT_PATHS)
+            print(f"  {r.name} lengths: {paths}")
+    for r in results:
+        for failure in r.failures:
+            print(f"  {r.name}: {failure}")
+
+
+def write_json(path: str, results: List[FunctionResult], args: argparse.Namespace) -> None:
+    report = {
+        "cases": args.cases,
+        "seed": args.seed,
+        "repeat": args.repeat,
+        "passed": all(r.mismatches == 0 for r in results),
+        "functions": [
+            {
+                "name": r.name,
+                "cases": r.cases,
+                "mismatches": r.mismatches,
+                "borderline": r.borderline,
+                "max_error": r.max_error,
+                "error_unit": r.error_unit,
+                "reference_ms": r.reference_s * 1e3,
+                "native_ms": r.native_s * 1e3,
+                "speedup": r.speedup,
+                "failures": r.failures,
+                "fft_paths": r.fft_paths,
+            }
+            for r in results
+        ],
+    }
+    with open(path, "w") as f:
+        json.dump(report, f, indent=2)
+        f.write("\n")
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    args = parse_args(sys.argv[1:] if argv is None else argv)
+    try:
+        results = run(args)
+    except ImportError as e:
+        print(f"Error: {e} (hpg_native needs PYTHONPATH=<build>/python; hpg_core needs numpy)",
+              file=sys.stderr)
+        return 2
+    print_report(results, args)
+    if args.json:
+        write_json(args.json, results, args)
+    return 0 if all(r.mismatches == 0 for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,761 @@
+/**
+ * Device Fleet Load Generator for Harmonic IoT Protocol
+ *
+ * Simulates a fleet of devices sending readings to the native UDP gateway
+ * and reports achieved against offered load:
+ *
+ *   harmonic_loadgen [--devices N] [--period S] [--jitter F] [--duration S]
+ *                    [--threads N] [--batch N] [--channels LIST] [--token-ttl S]
+ *                    [--target HOST:PORT] [--liveness S] [--silent F]
+ *                    [--virtual-time] [--seed N] [--json FILE]
+ *
+ * Every device has its own channel assignment, sequence number, JWT and
+ * reading cadence (period ± jitter, random phase). Devices are sharded
+ * over sender threads; each shard keeps its devices in a TimerWheel with
+ * 1 ms ticks, one re-armed reading timer and one token-expiry timer per
+ * device, so a million idle devices cost nothing between their readings.
+ * Due datagrams are serialized into a batch and sent with one sendmmsg().
+ *
+ * Load is open loop: a reading's lag is measured from its due time, and a
+ * shard that falls behind sends late rather than less often. Without
+ * --target, an in-process gateway on an ephemeral loopback port receives
+ * the traffic, so received, shed (kernel drops) and sequence gaps are
+ * reported too.
+ *
+ * With --virtual-time the run follows a VirtualClock instead of wall time.
+ * Shards sleep until their wheel's next deadline, the clock jumps there
+ * as soon as every shard is waiting, and datagrams are delivered to the
+ * in-process gateway directly. Hours of fleet behavior (token refreshes,
+ * liveness timeouts of --silent devices) run in seconds, and a given seed
+ * always produces the same counts.
+ *
+ * Tokens are compact JWTs ({"alg":"HS256"} header, sub/ch/exp claims) with
+ * random signature bytes; they are re-issued when they expire. The gateway
+ * checks them structurally, so no signing key is needed.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "gateway/datagram.h"
+#include "gateway/device_registry.h"
+#include "gateway/timer_wheel.h"
+#include "gateway/udp_gateway.h"
+#include "protocol/codec.h"
+#include "runtime/clock.h"
+#include "telemetry/hdr_histogram.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace harmonic_iot;
+
+namespace {
+
+/** Distinct encoded readings per channel */
+constexpr size_t READING_VARIANTS = 16;
+
+/** base64url({"alg":"HS256","typ":"JWT"}) */
+constexpr char JWT_HEADER[] = "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9";
+
+constexpr size_t SIGNATURE_BYTES = 32;
+
+/** Virtual runs start at 2025-01-01T00:00:00Z so token contents repeat too */
+constexpr int64_t VIRTUAL_EPOCH_NS = 1735689600ll * 1000000000;
+
+struct LoadOptions {
+    size_t devices = 100000;
+    double period = 10.0;               ///< Mean seconds between readings per device
+    double jitter = 0.2;                ///< Period spread, ± fraction
+    double duration = 10.0;
+    size_t threads = 1;
+    size_t batch = 64;                  ///< Datagrams per sendmmsg
+    std::vector<int> channels = {2, 3, 4, 5, 7, 8};
+    double token_ttl = 900.0;           ///< Seconds; matches the server's access tokens
+    std::string target;                 ///< HOST:PORT; empty: in-process gateway
+    double liveness = 0.0;              ///< In-process gateway offline timeout, s (0: off)
+    double silent = 0.0;                ///< Fraction of devices that stop reporting mid-run
+    bool virtual_time = false;
+    uint64_t seed = 1;
+    std::string json_path;
+};
+
+int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Append base64url (no padding) of data to out; returns the end */
+char* base64Url(const uint8_t* data, size_t size, char* out) {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        const uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        *out++ = ALPHABET[(v >> 18) & 63];
+        *out++ = ALPHABET[(v >> 12) & 63];
+        *out++ = ALPHABET[(v >> 6) & 63];
+        *out++ = ALPHABET[v & 63];
+    }
+    if (i < size) {
+        const uint32_t v = (uint32_t(data[i]) << 16) | (i + 1 < size ? uint32_t(data[i + 1]) << 8 : 0);
+        *out++ = ALPHABET[(v >> 18) & 63];
+        *out++ = ALPHABET[(v >> 12) & 63];
+        if (i + 1 < size) {
+            *out++ = ALPHABET[(v >> 6) & 63];
+        }
+    }
+    return out;
+}
+
+/** "dev-" and eight or more digits */
+size_t formatDeviceId(uint64_t index, char* out) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + index % 10);
+        index /= 10;
+    } while (index > 0);
+    while (n < 8) {
+        digits[n++] = '0';
+    }
+    std::memcpy(out, "dev-", 4);
+    for (size_t i = 0; i < n; ++i) {
+        out[4 + i] = digits[n - 1 - i];
+    }
+    return 4 + n;
+}
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Per-device state; about 50 bytes, so a million devices fit in ~50 MB
+ */
+struct Device {
+    uint32_t sequence = 0;
+    uint32_t due_ms = 0;                ///< Next reading, ms after the run started
+    uint32_t period_ms = 0;
+    uint32_t token_exp = 0;             ///< Unix seconds
+    uint32_t silent_ms = UINT32_MAX;    ///< No readings from here on (simulated failure)
+    uint8_t channel = 0;
+    uint8_t signature[SIGNATURE_BYTES];
+};
+
+struct ShardResult {
+    uint64_t scheduled = 0;             ///< Readings due within the run
+    uint64_t sent = 0;
+    uint64_t send_errors = 0;
+    uint64_t batches = 0;
+    uint64_t token_refreshes = 0;
+    telemetry::HdrHistogram lag;        ///< Due time → sendmmsg, ns
+};
+
+/**
+ * In-process delivery for virtual time: datagrams skip the socket
+ */
+struct DirectSink {
+    gateway::UdpGateway& gateway;
+    std::mutex mutex;                   ///< Shards deliver concurrently; the gateway is single-threaded
+};
+
+/**
+ * One sender thread and its slice of the fleet
+ */
+class Shard {
+public:
+    /**
+     * @param sink Deliver to this gateway instead of sending to target
+     */
+    Shard(const LoadOptions& options, runtime::Clock& clock, const sockaddr_in& target, DirectSink* sink,
+          size_t first, size_t count, const std::vector<std::vector<std::vector<uint8_t>>>& readings, uint64_t seed)
+        : options_(options),
+          clock_(clock),
+          sink_(sink),
+          first_(first),
+          devices_(count),
+          timers_(count),
+          readings_(readings),
+          buffer_(options.batch * gateway::MAX_DATAGRAM_BYTES),
+          messages_(options.batch),
+          vectors_(options.batch),
+          rng_state_(seed) {
+        wheel_.setHandler(gateway::TimerKind::Custom, [this](gateway::TimerId, uint64_t device) {
+            enqueue(static_cast<size_t>(device));
+        });
+        wheel_.setHandler(gateway::TimerKind::TokenExpiry, [this](gateway::TimerId, uint64_t device) {
+            issueToken(static_cast<size_t>(device), clock_.wallSeconds());
+            ++result_.token_refreshes;
+        });
+        if (sink_) {
+            return;
+        }
+
+        fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0 || ::connect(fd_, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+            const int error = errno;
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+            throw std::runtime_error(std::string("Cannot open sender socket: ") + std::strerror(error));
+        }
+        int buffer_bytes = 4 << 20;
+        ::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buffer_bytes, sizeof(buffer_bytes));
+    }
+
+    ~Shard() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    /**
+     * Assign channels, cadences and tokens; arm every device's timers
+     */
+    void populate(int64_t start_wall_s) {
+        start_wall_s_ = start_wall_s;
+        const double duration_ms = options_.duration * 1000.0;
+        const uint64_t ttl = static_cast<uint64_t>(std::max(1.0, options_.token_ttl));
+        for (size_t i = 0; i < devices_.size(); ++i) {
+            Device& device = devices_[i];
+            device.channel = static_cast<uint8_t>(options_.channels[(first_ + i) % options_.channels.size()]);
+            const double spread = options_.jitter * (2.0 * uniform() - 1.0);
+            device.period_ms = std::max<uint32_t>(1, static_cast<uint32_t>(options_.period * 1000.0 * (1.0 + spread)));
+            device.due_ms = static_cast<uint32_t>(uniform() * device.period_ms);
+            device.sequence = static_cast<uint32_t>(splitMix64(rng_state_));
+            if (uniform() < options_.silent) {
+                device.silent_ms = static_cast<uint32_t>(uniform() * duration_ms);
+            }
+
+            // Tokens were issued at random points of their lifetime before the run
+            issueToken(i, start_wall_s - static_cast<int64_t>(splitMix64(rng_state_) % ttl));
+
+            timers_[i] = wheel_.create(gateway::TimerKind::Custom, i);
+            wheel_.arm(timers_[i], device.due_ms);
+            const double end_ms = std::min(duration_ms, static_cast<double>(device.silent_ms));
+            if (device.due_ms < end_ms) {
+                result_.scheduled += 1 + static_cast<uint64_t>((end_ms - 1 - device.due_ms) / device.period_ms);
+            }
+        }
+    }
+
+    /** Send until the end of the run, sleeping until the wheel's next deadline */
+    void run(int64_t start_ns) {
+        start_ns_ = start_ns;
+        const uint64_t end_tick = static_cast<uint64_t>(options_.duration * 1000.0);
+        for (;;) {
+            const uint64_t tick = static_cast<uint64_t>((clock_.monotonicNs() - start_ns_) / 1000000);
+            if (tick >= end_tick) {
+                break;
+            }
+            wheel_.advance(tick);
+            flush();
+            const uint64_t next = std::max(tick + 1, std::min(wheel_.nextDue(), end_tick));
+            clock_.sleepUntil(start_ns_ + static_cast<int64_t>(next) * 1000000);
+        }
+    }
+
+    ShardResult& result() { return result_; }
+
+private:
+    double uniform() {
+        return static_cast<double>(splitMix64(rng_state_) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    void issueToken(size_t index, int64_t issued_s) {
+        Device& device = devices_[index];
+        device.token_exp = static_cast<uint32_t>(issued_s + static_cast<int64_t>(options_.token_ttl));
+        for (size_t b = 0; b < SIGNATURE_BYTES; b += 8) {
+            const uint64_t bits = splitMix64(rng_state_);
+            std::memcpy(device.signature + b, &bits, 8);
+        }
+        // Wheel ticks are ms since the run started; expired tokens refresh on the first tick
+        const int64_t expires_ms = (static_cast<int64_t>(device.token_exp) - start_wall_s_) * 1000;
+        wheel_.schedule(gateway::TimerKind::TokenExpiry, index, static_cast<uint64_t>(std::max<int64_t>(0, expires_ms)));
+    }
+
+    /** Serialize the device's reading into the next batch slot and re-arm it */
+    void enqueue(size_t index) {
+        Device& device = devices_[index];
+        if (device.due_ms >= device.silent_ms) {
+            return;
+        }
+        const int64_t now = clock_.monotonicNs();
+        const int64_t due_ns = start_ns_ + static_cast<int64_t>(device.due_ms) * 1000000;
+        result_.lag.record(static_cast<uint64_t>(std::max<int64_t>(0, now - due_ns)));
+
+        char id[24];
+        const size_t id_length = formatDeviceId(first_ + index, id);
+
+        // header.claims.signature
+        char token[256];
+        char* end = token;
+        std::memcpy(end, JWT_HEADER, sizeof(JWT_HEADER) - 1);
+        end += sizeof(JWT_HEADER) - 1;
+        *end++ = '.';
+        char claims[96];
+        const int claims_length = std::snprintf(claims, sizeof(claims), "{\"sub\":\"%.*s\",\"ch\":%d,\"exp\":%u}",
+                                                static_cast<int>(id_length), id, device.channel, device.token_exp);
+        end = base64Url(reinterpret_cast<const uint8_t*>(claims), static_cast<size_t>(claims_length), end);
+        *end++ = '.';
+        end = base64Url(device.signature, SIGNATURE_BYTES, end);
+
+        const size_t channel_index = static_cast<size_t>(
+            std::find(options_.channels.begin(), options_.channels.end(), device.channel) - options_.channels.begin());
+        const std::vector<uint8_t>& reading = readings_[channel_index][device.sequence % READING_VARIANTS];
+
+        gateway::Datagram datagram;
+        datagram.type = gateway::DatagramType::Reading;
+        datagram.channel = device.channel;
+        datagram.sequence = device.sequence++;
+        datagram.sent_ns = now;
+        datagram.device_id = std::string_view(id, id_length);
+        datagram.token = std::string_view(token, static_cast<size_t>(end - token));
+        datagram.payload = reading.data();
+        datagram.payload_size = reading.size();
+
+        uint8_t* slot = buffer_.data() + pending_ * gateway::MAX_DATAGRAM_BYTES;
+        const size_t size = gateway::encodeDatagram(datagram, slot, gateway::MAX_DATAGRAM_BYTES);
+        if (size > 0) {
+            vectors_[pending_] = {slot, size};
+            ++pending_;
+        } else {
+            ++result_.send_errors;
+        }
+
+        device.due_ms += device.period_ms;
+        wheel_.arm(timers_[index], device.due_ms);
+        if (pending_ == options_.batch) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (sink_ && pending_ > 0) {
+            std::lock_guard<std::mutex> lock(sink_->mutex);
+            for (size_t i = 0; i < pending_; ++i) {
+                sink_->gateway.deliver(static_cast<const uint8_t*>(vectors_[i].iov_base), vectors_[i].iov_len);
+            }
+            ++result_.batches;
+            result_.sent += pending_;
+            pending_ = 0;
+            return;
+        }
+        size_t done = 0;
+        while (done < pending_) {
+            for (size_t i = done; i < pending_; ++i) {
+                messages_[i] = mmsghdr{};
+                messages_[i].msg_hdr.msg_iov = &vectors_[i];
+                messages_[i].msg_hdr.msg_iovlen = 1;
+            }
+            const int sent = ::sendmmsg(fd_, messages_.data() + done, static_cast<unsigned>(pending_ - done), 0);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // e.g. ECONNREFUSED from an earlier ICMP error: count the datagram and move on
+                ++result_.send_errors;
+                ++done;
+                continue;
+            }
+            ++result_.batches;
+            result_.sent += static_cast<uint64_t>(sent);
+            done += static_cast<size_t>(sent);
+        }
+        pending_ = 0;
+    }
+
+    const LoadOptions& options_;
+    runtime::Clock& clock_;
+    DirectSink* sink_;
+    size_t first_;                      // Global index of devices_[0]
+    std::vector<Device> devices_;
+    std::vector<gateway::TimerId> timers_;
+    const std::vector<std::vector<std::vector<uint8_t>>>& readings_;
+    gateway::TimerWheel wheel_;
+    std::vector<uint8_t> buffer_;       // batch × MAX_DATAGRAM_BYTES
+    std::vector<mmsghdr> messages_;
+    std::vector<iovec> vectors_;
+    size_t pending_ = 0;
+    uint64_t rng_state_;
+    int fd_ = -1;
+    int64_t start_ns_ = 0;
+    int64_t start_wall_s_ = 0;
+    ShardResult result_;
+};
+
+// ─── Command line ────────────────────────────────────────────────────────
+
+std::vector<int> parseChannels(const std::string& list) {
+    std::vector<int> channels;
+    std::stringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int channel = std::atoi(item.c_str());
+        if (channel < 1 || channel + HarmonicProtocol::MAX_SYMBOL_OFFSET > 255) {
+            throw std::invalid_argument("Invalid channel: " + item);
+        }
+        channels.push_back(channel);
+    }
+    if (channels.empty()) {
+        throw std::invalid_argument("No channels given");
+    }
+    return channels;
+}
+
+sockaddr_in parseTarget(const std::string& target) {
+    const size_t colon = target.rfind(':');
+    if (colon == std::string::npos) {
+        throw std::invalid_argument("Target must be HOST:PORT: " + target);
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(std::atoi(target.c_str() + colon + 1)));
+    if (::inet_pton(AF_INET, target.substr(0, colon).c_str(), &address.sin_addr) != 1) {
+        throw std::invalid_argument("Target host must be an IPv4 address: " + target);
+    }
+    return address;
+}
+
+void usage() {
+    std::cerr << "Usage: harmonic_loadgen [options]\n"
+              << "  --devices N          Simulated devices (default 100000)\n"
+              << "  --period S           Mean seconds between readings per device (default 10)\n"
+              << "  --jitter F           Period spread, plus or minus this fraction (default 0.2)\n"
+              << "  --duration S         Seconds of load (default 10)\n"
+              << "  --threads N          Sender threads (default 1)\n"
+              << "  --batch N            Datagrams per sendmmsg (default 64)\n"
+              << "  --channels LIST      Harmonic channels assigned round robin (default 2,3,4,5,7,8)\n"
+              << "  --token-ttl S        JWT lifetime; expired tokens are re-issued (default 900)\n"
+              << "  --target HOST:PORT   External gateway (default: in-process gateway on loopback)\n"
+              << "  --liveness S         In-process gateway reports devices silent for S seconds (default: off)\n"
+              << "  --silent F           Fraction of devices that stop reporting mid-run (default 0)\n"
+              << "  --virtual-time       Simulated time: run as fast as the CPU allows, repeatably\n"
+              << "  --seed N             Fleet seed (default 1)\n"
+              << "  --json FILE          Also write the report as JSON\n";
+}
+
+bool parseArgs(int argc, char** argv, LoadOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--devices" && has_value) {
+            options.devices = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--period" && has_value) {
+            options.period = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--jitter" && has_value) {
+            options.jitter = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--duration" && has_value) {
+            options.duration = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--threads" && has_value) {
+            options.threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--batch" && has_value) {
+            options.batch = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--channels" && has_value) {
+            options.channels = parseChannels(argv[++i]);
+        } else if (arg == "--token-ttl" && has_value) {
+            options.token_ttl = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--target" && has_value) {
+            options.target = argv[++i];
+        } else if (arg == "--liveness" && has_value) {
+            options.liveness = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--silent" && has_value) {
+            options.silent = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--virtual-time") {
+            options.virtual_time = true;
+        } else if (arg == "--seed" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.devices > 0 && options.period > 0.0 && options.jitter >= 0.0 && options.jitter < 1.0 &&
+           options.duration > 0.0 && options.threads > 0 && options.batch > 0 && options.token_ttl > 0.0 &&
+           options.liveness >= 0.0 && options.silent >= 0.0 && options.silent <= 1.0 &&
+           !(options.virtual_time && !options.target.empty());
+}
+
+/** READING_VARIANTS encoded readings per channel, as datagram payload bytes */
+std::vector<std::vector<std::vector<uint8_t>>> encodeReadings(const LoadOptions& options) {
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> temperature(15.0, 30.0);
+    std::uniform_real_distribution<double> humidity(30.0, 70.0);
+    std::vector<std::vector<std::vector<uint8_t>>> readings;
+    for (int channel : options.channels) {
+        std::vector<std::vector<uint8_t>> variants;
+        for (size_t v = 0; v < READING_VARIANTS; ++v) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "t=%.1f;h=%.0f", temperature(rng), humidity(rng));
+            HarmonicProtocol::EncodedFrame frame =
+                HarmonicProtocol::encodeMessage(text, static_cast<HarmonicProtocol::HarmonicChannel>(channel));
+            variants.emplace_back(frame.begin(), frame.end());
+        }
+        readings.push_back(std::move(variants));
+    }
+    return readings;
+}
+
+double ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LoadOptions options;
+    try {
+        if (!parseArgs(argc, argv, options)) {
+            usage();
+            return 2;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        usage();
+        return 2;
+    }
+
+    try {
+        std::unique_ptr<runtime::VirtualClock> virtual_clock;
+        if (options.virtual_time) {
+            virtual_clock.reset(new runtime::VirtualClock(VIRTUAL_EPOCH_NS));
+        }
+        runtime::Clock& clock = virtual_clock ? *virtual_clock : runtime::Clock::system();
+
+        // The in-process gateway sizes its registry for the whole fleet
+        std::unique_ptr<gateway::DeviceRegistry> registry;
+        std::unique_ptr<gateway::UdpGateway> gw;
+        std::unique_ptr<DirectSink> sink;
+        sockaddr_in target{};
+        if (options.target.empty()) {
+            registry.reset(new gateway::DeviceRegistry(options.devices));
+            gateway::UdpGatewayConfig gateway_config;
+            gateway_config.port = 0;
+            gateway_config.receive_buffer_bytes = 32 << 20;
+            gateway_config.metrics = nullptr;
+            gateway_config.clock = &clock;
+            gateway_config.liveness_timeout = std::chrono::milliseconds(static_cast<int64_t>(options.liveness * 1000.0));
+            gw.reset(new gateway::UdpGateway(gateway_config, *registry));
+            target = parseTarget("127.0.0.1:" + std::to_string(gw->port()));
+            if (virtual_clock) {
+                sink.reset(new DirectSink{*gw, {}});
+            }
+        } else {
+            target = parseTarget(options.target);
+        }
+
+        const auto readings = encodeReadings(options);
+        const int64_t start_wall_s = clock.wallSeconds();
+        std::vector<std::unique_ptr<Shard>> shards;
+        const size_t per_shard = (options.devices + options.threads - 1) / options.threads;
+        double offered = 0.0;
+        uint64_t scheduled = 0;
+        const int64_t populate_start = steadyNs();
+        for (size_t s = 0; s < options.threads; ++s) {
+            const size_t first = s * per_shard;
+            const size_t count = std::min(per_shard, options.devices - std::min(first, options.devices));
+            std::unique_ptr<Shard> shard(new Shard(options, clock, target, sink.get(), first, count, readings,
+                                                   options.seed * 1000003 + s));
+            shard->populate(start_wall_s);
+            scheduled += shard->result().scheduled;
+            shards.push_back(std::move(shard));
+        }
+        offered = static_cast<double>(scheduled) / options.duration;
+        std::fprintf(stderr, "%zu devices ready in %.2f s; offering %.0f readings/s to %s%s\n", options.devices,
+                     static_cast<double>(steadyNs() - populate_start) / 1e9, offered,
+                     options.target.empty() ? ("in-process gateway on 127.0.0.1:" + std::to_string(gw->port())).c_str()
+                                            : options.target.c_str(),
+                     virtual_clock ? " in virtual time" : "");
+
+        if (gw && !virtual_clock) {
+            gw->start();
+        }
+        // Every participant attaches before time may move
+        if (virtual_clock) {
+            virtual_clock->hold();
+        }
+        std::atomic<size_t> attached{0};
+        auto participate = [&](auto&& body) {
+            return [&, body] {
+                std::unique_ptr<runtime::VirtualClock::Participant> participant;
+                if (virtual_clock) {
+                    participant.reset(new runtime::VirtualClock::Participant(*virtual_clock));
+                }
+                attached.fetch_add(1);
+                body();
+            };
+        };
+
+        const int64_t start_ns = clock.monotonicNs();
+        const int64_t real_start_ns = steadyNs();
+        std::vector<std::thread> senders;
+        for (auto& shard : shards) {
+            Shard* s = shard.get();
+            senders.emplace_back(participate([s, start_ns] { s->run(start_ns); }));
+        }
+        // In virtual time nothing polls the socket, so liveness is ticked here,
+        // 1 ns after each tick so every reading due at that instant is in
+        std::thread liveness_driver;
+        if (virtual_clock && options.liveness > 0.0) {
+            const gateway::UdpGatewayConfig& config = gw->config();
+            const int64_t tick_ns = std::max<int64_t>(1, config.liveness_tick.count()) * 1000000;
+            const int64_t end_ns = start_ns + static_cast<int64_t>(options.duration * 1e9);
+            liveness_driver = std::thread(participate([&, tick_ns, end_ns] {
+                for (int64_t t = start_ns + tick_ns; t <= end_ns; t += tick_ns) {
+                    clock.sleepUntil(t + 1);
+                    std::lock_guard<std::mutex> lock(sink->mutex);
+                    gw->advanceTimers();
+                }
+            }));
+        }
+        if (virtual_clock) {
+            const size_t participants = senders.size() + (liveness_driver.joinable() ? 1 : 0);
+            while (attached.load() < participants) {
+                std::this_thread::yield();
+            }
+            virtual_clock->release();
+        }
+        for (std::thread& sender : senders) {
+            sender.join();
+        }
+        if (liveness_driver.joinable()) {
+            liveness_driver.join();
+        }
+        const double elapsed_s = static_cast<double>(steadyNs() - real_start_ns) / 1e9;
+        const double simulated_s = static_cast<double>(clock.monotonicNs() - start_ns) / 1e9;
+
+        ShardResult total;
+        for (auto& shard : shards) {
+            const ShardResult& r = shard->result();
+            total.scheduled += r.scheduled;
+            total.sent += r.sent;
+            total.send_errors += r.send_errors;
+            total.batches += r.batches;
+            total.token_refreshes += r.token_refreshes;
+            total.lag.merge(r.lag);
+        }
+
+        gateway::GatewayStats received;
+        telemetry::HdrHistogram transit;
+        if (gw) {
+            // Let the gateway empty its socket buffer
+            uint64_t last = ~uint64_t(0);
+            for (int i = 0; i < 50 && !virtual_clock && gw->stats().datagrams != last; ++i) {
+                last = gw->stats().datagrams;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            gw->stop();
+            received = gw->stats();
+            transit = gw->transitLatency();
+        }
+
+        // Rates are per simulated second in virtual time
+        const double rate_s = virtual_clock ? simulated_s : elapsed_s;
+        if (virtual_clock) {
+            std::printf("clock      %.0f s simulated in %.2f s (%.0fx real time, %llu jumps)\n", simulated_s,
+                        elapsed_s, elapsed_s > 0.0 ? simulated_s / elapsed_s : 0.0,
+                        static_cast<unsigned long long>(virtual_clock->advances()));
+        }
+        std::printf("offered    %12.0f readings/s  (%llu due in %.1f s from %zu devices)\n", offered,
+                    static_cast<unsigned long long>(total.scheduled), options.duration, options.devices);
+        std::printf("sent       %12.0f readings/s  (%llu, %llu send errors, %.1f per sendmmsg)\n",
+                    static_cast<double>(total.sent) / rate_s, static_cast<unsigned long long>(total.sent),
+                    static_cast<unsigned long long>(total.send_errors),
+                    total.batches ? static_cast<double>(total.sent) / static_cast<double>(total.batches) : 0.0);
+        std::printf("send lag   p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", ms(total.lag.valueAtPercentile(50)),
+                    ms(total.lag.valueAtPercentile(99)), ms(total.lag.max()));
+        std::printf("tokens     %llu refreshed\n", static_cast<unsigned long long>(total.token_refreshes));
+        if (gw) {
+            std::printf("received   %12.0f readings/s  (%llu accepted, %llu shed, %llu gaps, %llu malformed, "
+                        "%llu unauthorized, %llu devices registered)\n",
+                        static_cast<double>(received.accepted) / rate_s,
+                        static_cast<unsigned long long>(received.accepted),
+                        static_cast<unsigned long long>(received.shed),
+                        static_cast<unsigned long long>(received.sequence_gaps),
+                        static_cast<unsigned long long>(received.malformed),
+                        static_cast<unsigned long long>(received.unauthorized),
+                        static_cast<unsigned long long>(received.registered));
+            if (options.liveness > 0.0) {
+                std::printf("liveness   %llu offline after %.0f s of silence\n",
+                            static_cast<unsigned long long>(received.offline), options.liveness);
+            }
+            std::printf("transit    p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", ms(transit.valueAtPercentile(50)),
+                        ms(transit.valueAtPercentile(99)), ms(transit.max()));
+            std::printf("achieved   %.1f%% of offered\n",
+                        total.scheduled ? 100.0 * static_cast<double>(received.accepted) /
+                                              static_cast<double>(total.scheduled) : 0.0);
+        }
+
+        if (!options.json_path.empty()) {
+            std::ofstream out(options.json_path);
+            if (!out) {
+                std::cerr << "Cannot open " << options.json_path << '\n';
+                return 1;
+            }
+            out << "{\n  \"config\": {\"devices\": " << options.devices
+                << ", \"period_s\": " << options.period
+                << ", \"jitter\": " << options.jitter
+                << ", \"duration_s\": " << options.duration
+                << ", \"threads\": " << options.threads
+                << ", \"batch\": " << options.batch
+                << ", \"token_ttl_s\": " << options.token_ttl
+                << ", \"target\": \"" << (options.target.empty() ? "in-process" : options.target) << "\""
+                << ", \"liveness_s\": " << options.liveness
+                << ", \"silent\": " << options.silent
+                << ", \"virtual_time\": " << (options.virtual_time ? "true" : "false")
+                << ", \"seed\": " << options.seed << "},\n"
+                << "  \"elapsed_s\": " << elapsed_s << ",\n"
+                << "  \"simulated_s\": " << simulated_s << ",\n"
+                << "  \"offered_per_s\": " << offered << ",\n"
+                << "  \"scheduled\": " << total.scheduled << ",\n"
+                << "  \"sent\": " << total.sent << ",\n"
+                << "  \"send_errors\": " << total.send_errors << ",\n"
+                << "  \"token_refreshes\": " << total.token_refreshes << ",\n"
+                << "  \"send_lag_ms\": {\"p50\": " << ms(total.lag.valueAtPercentile(50))
+                << ", \"p99\": " << ms(total.lag.valueAtPercentile(99))
+                << ", \"max\": " << ms(total.lag.max()) << "}";
+            if (gw) {
+                out << ",\n  \"gateway\": {\"accepted\": " << received.accepted
+                    << ", \"shed\": " << received.shed
+                    << ", \"sequence_gaps\": " << received.sequence_gaps
+                    << ", \"malformed\": " << received.malformed
+                    << ", \"unauthorized\": " << received.unauthorized
+                    << ", \"registered\": " << received.registered
+                    << ", \"offline\": " << received.offline
+                    << ", \"transit_ms\": {\"p50\": " << ms(transit.valueAtPercentile(50))
+                    << ", \"p99\": " << ms(transit.valueAtPercentile(99))
+                    << ", \"max\": " << ms(transit.max()) << "}}";
+            }
+            out << "\n}\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * Hardware Performance Counters for Harmonic IoT Protocol Benchmarks
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "perf_counters.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace harmonic_iot {
+namespace bench {
+
+const char* perfEventName(PerfEvent event) {
+    switch (event) {
+    case PerfEvent::Cycles: return "cycles";
+    case PerfEvent::Instructions: return "instructions";
+    case PerfEvent::L1dMisses: return "l1d_misses";
+    case PerfEvent::LlcMisses: return "llc_misses";
+    case PerfEvent::BranchMisses: return "branch_misses";
+    }
+    return "unknown";
+}
+
+void PerfSample::accumulate(const PerfSample& other) {
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        values[i] += other.values[i];
+        valid[i] = valid[i] || other.valid[i];
+    }
+    multiplexed = multiplexed || other.multiplexed;
+}
+
+#if defined(__linux__)
+
+namespace {
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+const EventSpec EVENT_SPECS[PERF_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openEvent(const EventSpec& spec, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;     // The leader gates the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+    int first_errno = 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        int fd = openEvent(EVENT_SPECS[i], group_fd_);
+        if (fd < 0) {
+            if (!first_errno) {
+                first_errno = errno;
+            }
+            continue;
+        }
+        if (group_fd_ < 0) {
+            group_fd_ = fd;
+        }
+        fds_[i] = fd;
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &ids_[i]) != 0) {
+            ids_[i] = 0;
+        }
+    }
+    if (group_fd_ < 0) {
+        reason_ = std::string("perf_event_open: ") + std::strerror(first_errno);
+        if (first_errno == EACCES || first_errno == EPERM) {
+            reason_ += " (lower /proc/sys/kernel/perf_event_paranoid or grant CAP_PERFMON)";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (group_fd_ < 0) {
+        return;
+    }
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    if (group_fd_ < 0) {
+        return sample;
+    }
+    ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // { nr, time_enabled, time_running, { value, id } × nr }
+    uint64_t buffer[3 + 2 * PERF_EVENT_COUNT];
+    ssize_t bytes = read(group_fd_, buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+        return sample;
+    }
+    const uint64_t count = buffer[0];
+    const uint64_t enabled = buffer[1];
+    const uint64_t running = buffer[2];
+    double scale = 1.0;
+    if (running == 0) {
+        return sample;     // Never scheduled on a PMU
+    }
+    if (running < enabled) {
+        scale = static_cast<double>(enabled) / static_cast<double>(running);
+        sample.multiplexed = true;
+    }
+
+    for (uint64_t n = 0; n < count && n < PERF_EVENT_COUNT; ++n) {
+        const uint64_t value = buffer[3 + 2 * n];
+        const uint64_t id = buffer[4 + 2 * n];
+        for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+            if (fds_[i] >= 0 && ids_[i] == id) {
+                sample.values[i] = static_cast<uint64_t>(static_cast<double>(value) * scale);
+                sample.valid[i] = true;
+            }
+        }
+    }
+    return sample;
+}
+
+#else // !__linux__
+
+PerfCounters::PerfCounters() : reason_("hardware counters need Linux perf_event_open") {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfSample PerfCounters::stop() {
+    return PerfSample();
+}
+
+#endif
+
+} // namespace bench
+} // namespace harmonic_iot
@@ -0,0 +1,95 @@
+/**
+ * Hardware Performance Counters for Harmonic IoT Protocol Benchmarks
+ *
+ * Thin wrapper over Linux perf_event_open(2): cycles, instructions, L1D
+ * read misses, last-level cache misses and branch misses of the calling
+ * thread, opened as one group so they cover exactly the same region.
+ *
+ * Events the CPU or hypervisor does not expose are skipped. If none can
+ * be opened (other platforms, perf_event_paranoid, containers without
+ * CAP_PERFMON) available() is false, reason() says why, and start()/stop()
+ * do nothing, so callers need no special case.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_BENCH_PERF_COUNTERS_H
+#define HARMONIC_IOT_BENCH_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace harmonic_iot {
+namespace bench {
+
+enum class PerfEvent : size_t {
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    BranchMisses,
+};
+
+constexpr size_t PERF_EVENT_COUNT = 5;
+
+/** JSON/report name of an event, e.g. "l1d_misses" */
+const char* perfEventName(PerfEvent event);
+
+/**
+ * Counts accumulated over one or more regions
+ */
+struct PerfSample {
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+    std::array<bool, PERF_EVENT_COUNT> valid{};   ///< Event was opened
+    bool multiplexed = false;                     ///< Some region was scaled for time sharing
+
+    bool has(PerfEvent event) const { return valid[static_cast<size_t>(event)]; }
+    uint64_t operator[](PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+
+    /** Add another sample's counts */
+    void accumulate(const PerfSample& other);
+};
+
+/**
+ * Counter group of the calling thread
+ *
+ * Not thread-safe; create it on the thread whose work is measured.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return group_fd_ >= 0; }
+
+    /** Why no counter could be opened (empty when available) */
+    const std::string& reason() const { return reason_; }
+
+    /** Reset and enable the group */
+    void start();
+
+    /**
+     * Disable the group and return what it counted since start()
+     *
+     * Counts of a group that was time-shared with other perf users are
+     * scaled by enabled/running time.
+     */
+    PerfSample stop();
+
+private:
+    int group_fd_ = -1;
+    std::array<int, PERF_EVENT_COUNT> fds_;
+    std::array<uint64_t, PERF_EVENT_COUNT> ids_{};
+    std::string reason_;
+};
+
+} // namespace bench
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_BENCH_PERF_COUNTERS_H
@@ -0,0 +1,81 @@
+/**
+ * Receive Chain Benchmark Suite for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "benchmarks.h"
+#include "dsp/synthesizer.h"
+#include "pipeline/receive_chain.h"
+#include "runtime/thread_pool.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace harmonic_iot {
+namespace bench {
+
+namespace {
+
+/**
+ * Chain, its private pool and one pre-rendered frame of samples
+ */
+struct ChainFixture {
+    ChainFixture(size_t workers, size_t length) {
+        runtime::ThreadPoolConfig pool_config;
+        pool_config.workers = workers;
+        pool.reset(new runtime::ThreadPool(pool_config));
+
+        pipeline::ReceiveChainConfig config;
+        config.name = "bench";
+        config.metrics = nullptr;
+        chain.reset(new pipeline::ReceiveChain(config, [this](const pipeline::ReceiveFrame&) {
+            frames.fetch_add(1, std::memory_order_relaxed);
+        }, *pool));
+
+        std::string message(length, 'h');
+        for (size_t i = 0; i < length; ++i) {
+            message[i] = static_cast<char>('a' + i % 26);
+        }
+        HarmonicProtocol::EncodedFrame symbols = HarmonicProtocol::encodeMessage(message, config.channel);
+        dsp::SymbolSynthesizer synth(config.sample_rate, config.symbol_samples, config.integrity.f0);
+        samples.resize(synth.samplesFor(symbols.size()));
+        synth.render(symbols.data(), symbols.size(), samples.data());
+    }
+
+    ~ChainFixture() {
+        chain.reset();      // Drains before the pool goes away
+    }
+
+    std::unique_ptr<runtime::ThreadPool> pool;
+    std::unique_ptr<pipeline::ReceiveChain> chain;
+    std::vector<dsp::Sample> samples;
+    std::atomic<uint64_t> frames{0};
+};
+
+} // namespace
+
+void registerPipelineBenchmarks(BenchRegistry& registry) {
+    for (size_t length : {16, 64}) {
+        for (size_t workers : {1, 2, 4}) {
+            registry.add({"pipeline/receive_chain", {{"length", length}, {"workers", workers}}, 1.0,
+                          static_cast<double>(length), [length, workers] {
+                              auto fixture = std::make_shared<ChainFixture>(workers, length);
+                              return BenchBody([fixture](size_t iterations) {
+                                  for (size_t i = 0; i < iterations; ++i) {
+                                      pipeline::ReceiveFrame* frame = fixture->chain->acquire();
+                                      frame->sequence = i;
+                                      frame->samples.assign(fixture->samples.begin(), fixture->samples.end());
+                                      fixture->chain->submit(frame);
+                                  }
+                                  fixture->chain->drain();
+                              });
+                          }});
+        }
+    }
+}
+
+} // namespace bench
+} // namespace harmonic_iot
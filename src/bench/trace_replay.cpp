@@ -0,0 +1,353 @@
+/**
+ * Datagram Trace Replay for Harmonic IoT Protocol
+ *
+ * Plays a trace recorded by harmonic_gateway --record back to a gateway,
+ * turning a production traffic shape into a repeatable benchmark:
+ *
+ *   harmonic_replay TRACE [--speed X|max] [--target HOST:PORT] [--batch N]
+ *                   [--keep-timestamps] [--json FILE]
+ *
+ * Datagram i is due at start + offset_i / speed, so bursts and idle gaps
+ * keep their shape at any speed; --speed max sends back to back. All
+ * datagrams due at the same moment go out in one sendmmsg(). Lag from
+ * each datagram's due time is reported (except at max speed), so a
+ * replay that could not keep up is visible rather than silently slower.
+ *
+ * Datagrams are sent byte for byte as recorded, including malformed
+ * ones, except that the sender timestamp is set to the replay time
+ * (unless --keep-timestamps) so gateway transit latency stays meaningful.
+ * Without --target, a fresh in-process gateway on loopback receives the
+ * replay and its counters are reported.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "gateway/datagram.h"
+#include "gateway/datagram_trace.h"
+#include "gateway/device_registry.h"
+#include "gateway/udp_gateway.h"
+#include "telemetry/hdr_histogram.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace harmonic_iot;
+
+namespace {
+
+struct ReplayOptions {
+    std::string trace_path;
+    double speed = 1.0;                 ///< 0: as fast as possible
+    std::string target;                 ///< HOST:PORT; empty: in-process gateway
+    size_t batch = 64;                  ///< Datagrams per sendmmsg
+    bool restamp = true;
+    std::string json_path;
+};
+
+struct ReplayResult {
+    uint64_t sent = 0;
+    uint64_t send_errors = 0;
+    uint64_t batches = 0;
+    telemetry::HdrHistogram lag;        ///< Due time → sendmmsg, ns
+};
+
+int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+sockaddr_in parseTarget(const std::string& target) {
+    const size_t colon = target.rfind(':');
+    if (colon == std::string::npos) {
+        throw std::invalid_argument("Target must be HOST:PORT: " + target);
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(std::atoi(target.c_str() + colon + 1)));
+    if (::inet_pton(AF_INET, target.substr(0, colon).c_str(), &address.sin_addr) != 1) {
+        throw std::invalid_argument("Target host must be an IPv4 address: " + target);
+    }
+    return address;
+}
+
+/** Distinct device IDs among the well-formed datagrams */
+size_t countDevices(const gateway::TraceReader& trace) {
+    std::unordered_set<std::string_view> ids;
+    gateway::Datagram datagram;
+    for (size_t i = 0; i < trace.size(); ++i) {
+        const gateway::TraceRecord record = trace[i];
+        if (gateway::parseDatagram(record.data, record.size, datagram)) {
+            ids.insert(datagram.device_id);
+        }
+    }
+    return ids.size();
+}
+
+/**
+ * Send every record of the trace on its schedule
+ */
+ReplayResult replay(const gateway::TraceReader& trace, const ReplayOptions& options, const sockaddr_in& target) {
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("Failed to connect: ") + std::strerror(error));
+    }
+    const int send_buffer = 4 << 20;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer));
+
+    // Records are copied into slots because the timestamp is rewritten
+    std::vector<uint8_t> buffer(options.batch * gateway::MAX_DATAGRAM_BYTES);
+    std::vector<mmsghdr> messages(options.batch);
+    std::vector<iovec> vectors(options.batch);
+
+    ReplayResult result;
+    const int64_t start_ns = steadyNs();
+    auto dueNs = [&](size_t i) {
+        return options.speed > 0.0
+                   ? start_ns + static_cast<int64_t>(static_cast<double>(trace[i].offset_ns) / options.speed)
+                   : start_ns;
+    };
+
+    size_t next = 0;
+    while (next < trace.size()) {
+        const int64_t wait_ns = dueNs(next) - steadyNs();
+        if (wait_ns > 0) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+        }
+
+        const int64_t now = steadyNs();
+        size_t pending = 0;
+        while (next < trace.size() && pending < options.batch) {
+            const int64_t due = dueNs(next);
+            if (due > now) {
+                break;
+            }
+            const gateway::TraceRecord record = trace[next++];
+            result.lag.record(static_cast<uint64_t>(now - due));
+            const size_t size = std::min(record.size, gateway::MAX_DATAGRAM_BYTES);
+            uint8_t* slot = buffer.data() + pending * gateway::MAX_DATAGRAM_BYTES;
+            std::memcpy(slot, record.data, size);
+            if (options.restamp) {
+                gateway::restampDatagram(slot, size, now);
+            }
+            vectors[pending] = {slot, size};
+            messages[pending] = mmsghdr{};
+            messages[pending].msg_hdr.msg_iov = &vectors[pending];
+            messages[pending].msg_hdr.msg_iovlen = 1;
+            ++pending;
+        }
+
+        size_t done = 0;
+        while (done < pending) {
+            const int sent = ::sendmmsg(fd, messages.data() + done, static_cast<unsigned>(pending - done), 0);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // e.g. ECONNREFUSED from an earlier ICMP error: count the datagram and move on
+                ++result.send_errors;
+                ++done;
+                continue;
+            }
+            ++result.batches;
+            result.sent += static_cast<uint64_t>(sent);
+            done += static_cast<size_t>(sent);
+        }
+    }
+    ::close(fd);
+    return result;
+}
+
+void usage() {
+    std::cerr << "Usage: harmonic_replay TRACE [options]\n"
+              << "  --speed X|max        Playback speed; max sends back to back (default 1)\n"
+              << "  --target HOST:PORT   External gateway (default: in-process gateway on loopback)\n"
+              << "  --batch N            Datagrams per sendmmsg at most (default 64)\n"
+              << "  --keep-timestamps    Send recorded sender timestamps unchanged\n"
+              << "  --json FILE          Also write the report as JSON\n";
+}
+
+bool parseArgs(int argc, char** argv, ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--speed" && has_value) {
+            const std::string value = argv[++i];
+            options.speed = value == "max" ? 0.0 : std::strtod(value.c_str(), nullptr);
+            if (options.speed <= 0.0 && value != "max") {
+                return false;
+            }
+        } else if (arg == "--target" && has_value) {
+            options.target = argv[++i];
+        } else if (arg == "--batch" && has_value) {
+            options.batch = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--keep-timestamps") {
+            options.restamp = false;
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else if (options.trace_path.empty() && !arg.empty() && arg[0] != '-') {
+            options.trace_path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.trace_path.empty() && options.batch > 0;
+}
+
+double ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        gateway::TraceReader trace(options.trace_path);
+        const size_t devices = countDevices(trace);
+        const double trace_s = static_cast<double>(trace.durationNs()) / 1e9;
+        if (trace.truncated()) {
+            std::fprintf(stderr, "Warning: %s is truncated; replaying the %zu complete records\n",
+                         options.trace_path.c_str(), trace.size());
+        }
+
+        // A fresh gateway per replay, so every run starts from the same state
+        std::unique_ptr<gateway::DeviceRegistry> registry;
+        std::unique_ptr<gateway::UdpGateway> gw;
+        sockaddr_in target{};
+        if (options.target.empty()) {
+            registry.reset(new gateway::DeviceRegistry(std::max<size_t>(devices, 1)));
+            gateway::UdpGatewayConfig gateway_config;
+            gateway_config.port = 0;
+            gateway_config.receive_buffer_bytes = 32 << 20;
+            gateway_config.metrics = nullptr;
+            gw.reset(new gateway::UdpGateway(gateway_config, *registry));
+            target = parseTarget("127.0.0.1:" + std::to_string(gw->port()));
+            gw->start();
+        } else {
+            target = parseTarget(options.target);
+        }
+
+        char speed[32] = "max speed";
+        if (options.speed > 0.0) {
+            std::snprintf(speed, sizeof(speed), "%gx", options.speed);
+        }
+        std::fprintf(stderr, "Replaying %zu datagrams from %zu devices (%.3f s of traffic) at %s to %s\n",
+                     trace.size(), devices, trace_s, speed,
+                     options.target.empty() ? ("in-process gateway on 127.0.0.1:" + std::to_string(gw->port())).c_str()
+                                            : options.target.c_str());
+
+        const int64_t start_ns = steadyNs();
+        ReplayResult result = replay(trace, options, target);
+        const double elapsed_s = static_cast<double>(steadyNs() - start_ns) / 1e9;
+
+        gateway::GatewayStats received;
+        telemetry::HdrHistogram transit;
+        if (gw) {
+            // Let the gateway empty its socket buffer
+            uint64_t last = ~uint64_t(0);
+            for (int i = 0; i < 50 && gw->stats().datagrams != last; ++i) {
+                last = gw->stats().datagrams;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            gw->stop();
+            received = gw->stats();
+            transit = gw->transitLatency();
+        }
+
+        const double rate = elapsed_s > 0.0 ? static_cast<double>(result.sent) / elapsed_s : 0.0;
+        std::printf("trace      %zu datagrams, %zu devices, %.3f s\n", trace.size(), devices, trace_s);
+        std::printf("replayed   %12.0f datagrams/s  (%llu sent, %llu send errors, %.1f per sendmmsg) in %.3f s "
+                    "(%.2fx)\n",
+                    rate, static_cast<unsigned long long>(result.sent),
+                    static_cast<unsigned long long>(result.send_errors),
+                    result.batches ? static_cast<double>(result.sent) / static_cast<double>(result.batches) : 0.0,
+                    elapsed_s, elapsed_s > 0.0 ? trace_s / elapsed_s : 0.0);
+        if (options.speed > 0.0) {
+            std::printf("lag        p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", ms(result.lag.valueAtPercentile(50)),
+                        ms(result.lag.valueAtPercentile(99)), ms(result.lag.max()));
+        }
+        if (gw) {
+            std::printf("received   %llu datagrams  (%llu accepted, %llu shed, %llu gaps, %llu stale, "
+                        "%llu malformed, %llu unauthorized)\n",
+                        static_cast<unsigned long long>(received.datagrams),
+                        static_cast<unsigned long long>(received.accepted),
+                        static_cast<unsigned long long>(received.shed),
+                        static_cast<unsigned long long>(received.sequence_gaps),
+                        static_cast<unsigned long long>(received.stale),
+                        static_cast<unsigned long long>(received.malformed),
+                        static_cast<unsigned long long>(received.unauthorized));
+            std::printf("transit    p50 %.3f ms  p99 %.3f ms  max %.3f ms\n", ms(transit.valueAtPercentile(50)),
+                        ms(transit.valueAtPercentile(99)), ms(transit.max()));
+        }
+
+        if (!options.json_path.empty()) {
+            std::ofstream out(options.json_path);
+            if (!out) {
+                std::cerr << "Cannot open " << options.json_path << '\n';
+                return 1;
+            }
+            out << "{\n  \"config\": {\"trace\": \"" << options.trace_path << "\""
+                << ", \"speed\": " << (options.speed > 0.0 ? std::to_string(options.speed) : "\"max\"")
+                << ", \"batch\": " << options.batch
+                << ", \"restamp\": " << (options.restamp ? "true" : "false")
+                << ", \"target\": \"" << (options.target.empty() ? "in-process" : options.target) << "\"},\n"
+                << "  \"trace\": {\"datagrams\": " << trace.size() << ", \"devices\": " << devices
+                << ", \"duration_s\": " << trace_s << ", \"truncated\": " << (trace.truncated() ? "true" : "false")
+                << "},\n"
+                << "  \"elapsed_s\": " << elapsed_s << ",\n"
+                << "  \"sent\": " << result.sent << ",\n"
+                << "  \"send_errors\": " << result.send_errors << ",\n"
+                << "  \"rate_per_s\": " << rate;
+            if (options.speed > 0.0) {
+                out << ",\n  \"lag_ms\": {\"p50\": " << ms(result.lag.valueAtPercentile(50))
+                    << ", \"p99\": " << ms(result.lag.valueAtPercentile(99))
+                    << ", \"max\": " << ms(result.lag.max()) << "}";
+            }
+            if (gw) {
+                out << ",\n  \"gateway\": {\"datagrams\": " << received.datagrams
+                    << ", \"accepted\": " << received.accepted
+                    << ", \"shed\": " << received.shed
+                    << ", \"sequence_gaps\": " << received.sequence_gaps
+                    << ", \"stale\": " << received.stale
+                    << ", \"malformed\": " << received.malformed
+                    << ", \"unauthorized\": " << received.unauthorized
+                    << ", \"transit_ms\": {\"p50\": " << ms(transit.valueAtPercentile(50))
+                    << ", \"p99\": " << ms(transit.valueAtPercentile(99))
+                    << ", \"max\": " << ms(transit.max()) << "}}";
+            }
+            out << "\n}\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
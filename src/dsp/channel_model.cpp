@@ -0,0 +1,324 @@
+/**
+ * Channel Simulator for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "channel_model.h"
+#include "dsp/synthesizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+constexpr float HALF_PI = 1.57079632679489661923f;
+constexpr float LN2 = 0.69314718055994530942f;
+constexpr float SQRT2 = 1.41421356237309504880f;
+constexpr float UNIT_24 = 1.0f / 16777216.0f;     // 2^-24
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline uint32_t rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// The helpers below are inlined into the Box–Muller loop, which only
+// vectorizes if it has no branches and no libm calls: selects are done on
+// bit masks, and std::sqrt is avoided because, with errno semantics, it
+// keeps a call for negative inputs.
+
+inline uint32_t floatBits(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline float bitsFloat(uint32_t bits) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+/** mask ? a : b for a mask of all ones or all zeros */
+inline float selectFloat(uint32_t mask, float a, float b) {
+    return bitsFloat((floatBits(a) & mask) | (floatBits(b) & ~mask));
+}
+
+/**
+ * ln(x) for x in (0, 1] (|error| < 2e-6 absolute, < 4e-7 relative)
+ *
+ * x = 2^e · m with m in [√½, √2); ln m = 2 atanh((m − 1)/(m + 1)).
+ */
+inline float fastLog(float x) {
+    const uint32_t bits = floatBits(x);
+    int exponent = static_cast<int>((bits >> 23) & 0xffu) - 127;
+    float m = bitsFloat((bits & 0x7fffffu) | 0x3f800000u);
+    const uint32_t high = 0u - static_cast<uint32_t>(m > SQRT2);
+    m = selectFloat(high, m * 0.5f, m);
+    exponent += static_cast<int>(high & 1u);
+
+    const float s = (m - 1.0f) / (m + 1.0f);
+    const float s2 = s * s;
+    const float series = 1.0f + s2 * (1.0f / 3 + s2 * (1.0f / 5 + s2 * (1.0f / 7 + s2 * (1.0f / 9))));
+    return static_cast<float>(exponent) * LN2 + 2.0f * s * series;
+}
+
+/**
+ * √x for x ≥ 0 (relative error < 3e-7; exactly 0 for x = 0)
+ *
+ * 1/√x from the bit-level estimate refined by three Newton steps, times x.
+ */
+inline float fastSqrt(float x) {
+    const float half = 0.5f * x;
+    float y = bitsFloat(0x5f3759dfu - (floatBits(x) >> 1));
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return x * y;
+}
+
+/**
+ * sin(2πu) and cos(2πu) for u in [0, 1) (|error| < 3e-7)
+ *
+ * Quarter-wave reduction and Taylor polynomials on [0, π/2], through
+ * t¹¹ and t¹²; the quadrant swaps and negates them with bit masks.
+ */
+inline void fastSinCos2Pi(float u, float& sine, float& cosine) {
+    const float v = u * 4.0f;
+    const int quadrant = static_cast<int>(v);
+    const float t = (v - static_cast<float>(quadrant)) * HALF_PI;
+    const float t2 = t * t;
+    const float s = t * (1.0f - t2 * (1.0f / 6 - t2 * (1.0f / 120 - t2 * (1.0f / 5040 - t2 * (1.0f / 362880 -
+                    t2 * (1.0f / 39916800))))));
+    const float c = 1.0f - t2 * (0.5f - t2 * (1.0f / 24 - t2 * (1.0f / 720 - t2 * (1.0f / 40320 -
+                    t2 * (1.0f / 3628800 - t2 * (1.0f / 479001600))))));
+
+    const uint32_t q = static_cast<uint32_t>(quadrant);
+    const uint32_t swap = 0u - (q & 1u);
+    const uint32_t sine_sign = (q & 2u) << 30;              // Quadrants 2 and 3
+    const uint32_t cosine_sign = ((q + 1u) & 2u) << 30;     // Quadrants 1 and 2
+    sine = bitsFloat(floatBits(selectFloat(swap, c, s)) ^ sine_sign);
+    cosine = bitsFloat(floatBits(selectFloat(swap, s, c)) ^ cosine_sign);
+}
+
+} // namespace
+
+// ─── GaussianGenerator ───────────────────────────────────────────────────
+
+GaussianGenerator::GaussianGenerator(uint64_t seed, uint64_t stream) {
+    reseed(seed, stream);
+}
+
+void GaussianGenerator::reseed(uint64_t seed, uint64_t stream) {
+    uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    // Burn one output so nearby (seed, stream) pairs diverge immediately
+    splitMix64(state);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        const uint64_t a = splitMix64(state);
+        const uint64_t b = splitMix64(state);
+        s0_[lane] = static_cast<uint32_t>(a);
+        s1_[lane] = static_cast<uint32_t>(a >> 32);
+        s2_[lane] = static_cast<uint32_t>(b);
+        s3_[lane] = static_cast<uint32_t>(b >> 32) | 1u;    // Never all zero
+    }
+    cached_ = 0;
+}
+
+void GaussianGenerator::nextUniforms(float* u) {
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        const uint32_t result = s0_[lane] + s3_[lane];
+        const uint32_t t = s1_[lane] << 9;
+        s2_[lane] ^= s0_[lane];
+        s3_[lane] ^= s1_[lane];
+        s1_[lane] ^= s2_[lane];
+        s0_[lane] ^= s3_[lane];
+        s2_[lane] ^= t;
+        s3_[lane] = rotl(s3_[lane], 11);
+        u[lane] = static_cast<float>((result >> 8) + 1) * UNIT_24;     // (0, 1]
+    }
+}
+
+void GaussianGenerator::nextBlock(float* out) {
+    float u1[LANES];
+    float u2[LANES];
+    nextUniforms(u1);
+    nextUniforms(u2);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        const float radius = fastSqrt(-2.0f * fastLog(u1[lane]));
+        float sine;
+        float cosine;
+        fastSinCos2Pi(u2[lane] - UNIT_24, sine, cosine);     // [0, 1)
+        out[lane] = radius * cosine;
+        out[lane + LANES] = radius * sine;
+    }
+}
+
+template <bool Accumulate>
+void GaussianGenerator::emit(Sample* out, size_t n, float sigma) {
+    size_t i = 0;
+    for (; i < n && cached_ > 0; ++i, --cached_) {
+        const float value = sigma * cache_[BLOCK - cached_];
+        out[i] = Accumulate ? out[i] + value : value;
+    }
+    float block[BLOCK];
+    for (; n - i >= BLOCK; i += BLOCK) {
+        nextBlock(block);
+        for (size_t j = 0; j < BLOCK; ++j) {
+            out[i + j] = Accumulate ? out[i + j] + sigma * block[j] : sigma * block[j];
+        }
+    }
+    if (i < n) {
+        nextBlock(cache_);
+        cached_ = BLOCK;
+        for (; i < n; ++i, --cached_) {
+            const float value = sigma * cache_[BLOCK - cached_];
+            out[i] = Accumulate ? out[i] + value : value;
+        }
+    }
+}
+
+void GaussianGenerator::fill(Sample* out, size_t n, float sigma) {
+    emit<false>(out, n, sigma);
+}
+
+void GaussianGenerator::add(Sample* out, size_t n, float sigma) {
+    emit<true>(out, n, sigma);
+}
+
+// ─── ChannelSimulator ────────────────────────────────────────────────────
+
+ChannelSimulator::ChannelSimulator(const ChannelConfig& config) : config_(config) {
+    if (config_.sample_rate <= 0.0) {
+        throw std::invalid_argument("Sample rate must be positive");
+    }
+    if (config_.coherence_samples == 0) {
+        throw std::invalid_argument("Fading coherence must be at least one sample");
+    }
+    if (std::isfinite(config_.snr_db)) {
+        noise_sigma_ = static_cast<float>(std::sqrt(config_.reference_power / std::pow(10.0, config_.snr_db / 10.0)));
+    }
+    reseed(config_.seed, config_.stream);
+}
+
+void ChannelSimulator::reseed(uint64_t seed, uint64_t stream) {
+    config_.seed = seed;
+    config_.stream = stream;
+    noise_.reseed(seed, 2 * stream);
+    fading_rng_.reseed(seed, 2 * stream + 1);
+    position_ = 0;
+    if (std::isfinite(config_.rician_k)) {
+        fade_from_ = nextFadingGain();
+        fade_to_ = nextFadingGain();
+    }
+}
+
+float ChannelSimulator::nextFadingGain() {
+    // |h| with E|h|² = 1: line of sight √(K/(K+1)) plus CN(0, 1/(K+1)) scatter
+    const double k = config_.rician_k;
+    const double line_of_sight = std::sqrt(k / (k + 1.0));
+    const double scatter = std::sqrt(0.5 / (k + 1.0));
+    float g[2];
+    fading_rng_.fill(g, 2);
+    const double re = line_of_sight + scatter * g[0];
+    const double im = scatter * g[1];
+    return static_cast<float>(std::sqrt(re * re + im * im));
+}
+
+void ChannelSimulator::process(const Sample* in, Sample* out, size_t n) {
+    const bool clock = config_.clock_offset_ppm != 0.0 || config_.clock_drift_ppm_per_s != 0.0;
+    const bool multipath = !config_.taps.empty();
+
+    if (clock || multipath) {
+        scratch_.assign(in, in + n);    // Also makes in == out safe
+        if (clock) {
+            applyClockError(scratch_.data(), out, n);
+            if (multipath) {
+                scratch_.assign(out, out + n);
+            }
+        }
+        if (multipath) {
+            applyMultipath(scratch_.data(), out, n);
+        }
+    } else if (in != out) {
+        std::copy(in, in + n, out);
+    }
+
+    if (std::isfinite(config_.rician_k)) {
+        applyFading(out, n);
+    }
+    for (const InterferingTone& tone : config_.interferers) {
+        addTone(tone.frequency, tone.amplitude, tone.phase, config_.sample_rate, out, n, position_);
+    }
+    if (noise_sigma_ > 0.0f) {
+        noise_.add(out, n, noise_sigma_);
+    }
+    position_ += n;
+}
+
+void ChannelSimulator::applyClockError(const Sample* in, Sample* out, size_t n) const {
+    // A transmitter clock fast by ε(t) compresses time: out[i] = in(i + ∫ε)
+    const double offset = config_.clock_offset_ppm * 1e-6;
+    const double drift = config_.clock_drift_ppm_per_s * 1e-6 / (2.0 * config_.sample_rate);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = static_cast<double>(i);
+        const double position = x + offset * x + drift * x * x;
+        const double floor_position = std::floor(position);
+        const size_t index = static_cast<size_t>(std::max(0.0, floor_position));
+        const float fraction = static_cast<float>(position - floor_position);
+        const Sample a = index < n ? in[index] : Sample(0);
+        const Sample b = index + 1 < n ? in[index + 1] : Sample(0);
+        out[i] = position < 0.0 ? Sample(0) : a + (b - a) * fraction;
+    }
+}
+
+void ChannelSimulator::applyMultipath(const Sample* in, Sample* out, size_t n) const {
+    std::fill(out, out + n, Sample(0));
+    for (const MultipathTap& tap : config_.taps) {
+        if (tap.delay_samples >= n) {
+            continue;
+        }
+        const float gain = tap.gain;
+        const Sample* src = in;
+        Sample* dst = out + tap.delay_samples;
+        const size_t count = n - tap.delay_samples;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] += gain * src[i];
+        }
+    }
+}
+
+void ChannelSimulator::applyFading(Sample* samples, size_t n) {
+    const size_t coherence = config_.coherence_samples;
+    const float inverse = 1.0f / static_cast<float>(coherence);
+    uint64_t position = position_;
+    size_t i = 0;
+    while (i < n) {
+        const size_t offset = static_cast<size_t>(position % coherence);
+        const size_t count = std::min(n - i, coherence - offset);
+        const float from = fade_from_;
+        const float slope = (fade_to_ - fade_from_) * inverse;
+        for (size_t j = 0; j < count; ++j) {
+            samples[i + j] *= from + slope * static_cast<float>(offset + j);
+        }
+        i += count;
+        position += count;
+        if (offset + count == coherence) {
+            fade_from_ = fade_to_;
+            fade_to_ = nextFadingGain();
+        }
+    }
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
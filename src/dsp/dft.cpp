@@ -0,0 +1,433 @@
+/**
+ * Arbitrary-Length DFT for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "dft.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+using Cplx = std::complex<double>;
+
+constexpr double PI = 3.14159265358979323846;
+
+/** Largest prime factor transformed directly; above it Bluestein is cheaper */
+constexpr uint32_t MAX_RADIX = 13;
+
+/** FFT tables kept for reuse by later plans */
+constexpr size_t FFT_CACHE_ENTRIES = 64;
+
+/** a · b without std::complex's NaN/inf recovery, which costs more than a butterfly */
+inline Cplx mul(Cplx a, Cplx b) {
+    return Cplx(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+inline Cplx add(Cplx a, Cplx b) { return Cplx(a.real() + b.real(), a.imag() + b.imag()); }
+inline Cplx sub(Cplx a, Cplx b) { return Cplx(a.real() - b.real(), a.imag() - b.imag()); }
+inline Cplx scale(double s, Cplx a) { return Cplx(s * a.real(), s * a.imag()); }
+
+/** −i · a */
+inline Cplx rotate(Cplx a) { return Cplx(a.imag(), -a.real()); }
+
+inline double magnitude(Cplx z) {
+    return std::sqrt(z.real() * z.real() + z.imag() * z.imag());
+}
+
+/**
+ * Radices of n in transform order (4s first), or empty if n has a prime
+ * factor above MAX_RADIX
+ */
+std::vector<uint32_t> factorize(size_t n) {
+    std::vector<uint32_t> radices;
+    while (n % 4 == 0) {
+        radices.push_back(4);
+        n /= 4;
+    }
+    for (uint32_t p = 2; p <= MAX_RADIX && n > 1; ++p) {
+        while (n % p == 0) {
+            radices.push_back(p);
+            n /= p;
+        }
+    }
+    if (n > 1) {
+        radices.clear();
+    }
+    return radices;
+}
+
+/** Smallest 2^a · 3^b · 5^c ≥ n */
+size_t nextSmooth(size_t n) {
+    size_t best = SIZE_MAX;
+    for (size_t p5 = 1; p5 < best; p5 *= 5) {
+        for (size_t p35 = p5; p35 < best; p35 *= 3) {
+            size_t candidate = p35;
+            while (candidate < n) {
+                candidate *= 2;
+            }
+            best = std::min(best, candidate);
+        }
+    }
+    return best;
+}
+
+// Stockham pass: the L-point transforms of the r residue classes in `in`
+// (k-major, in[k·r + j]) become (L·p)-point ones in `out`. Each butterfly
+// reads v_q = in[k·r + j + q·r/p] · ω_{Lp}^{qk} and writes output q2 to
+// out[(k + L·q2)·r/p + j].
+
+template <uint32_t P>
+void butterfly(const Cplx* v, Cplx* out, size_t stride);
+
+template <>
+inline void butterfly<2>(const Cplx* v, Cplx* out, size_t stride) {
+    out[0] = add(v[0], v[1]);
+    out[stride] = sub(v[0], v[1]);
+}
+
+template <>
+inline void butterfly<3>(const Cplx* v, Cplx* out, size_t stride) {
+    constexpr double S3 = 0.86602540378443864676;   // sin(2π/3)
+    const Cplx t1 = add(v[1], v[2]);
+    const Cplx t2 = sub(v[0], scale(0.5, t1));
+    const Cplx t3 = rotate(scale(S3, sub(v[1], v[2])));
+    out[0] = add(v[0], t1);
+    out[stride] = add(t2, t3);
+    out[2 * stride] = sub(t2, t3);
+}
+
+template <>
+inline void butterfly<4>(const Cplx* v, Cplx* out, size_t stride) {
+    const Cplx a = add(v[0], v[2]);
+    const Cplx b = sub(v[0], v[2]);
+    const Cplx c = add(v[1], v[3]);
+    const Cplx d = rotate(sub(v[1], v[3]));
+    out[0] = add(a, c);
+    out[stride] = add(b, d);
+    out[2 * stride] = sub(a, c);
+    out[3 * stride] = sub(b, d);
+}
+
+template <>
+inline void butterfly<5>(const Cplx* v, Cplx* out, size_t stride) {
+    constexpr double C1 = 0.30901699437494742410;    // cos(2π/5)
+    constexpr double C2 = -0.80901699437494742410;   // cos(4π/5)
+    constexpr double S1 = 0.95105651629515357212;    // sin(2π/5)
+    constexpr double S2 = 0.58778525229247312917;    // sin(4π/5)
+    const Cplx a1 = add(v[1], v[4]);
+    const Cplx b1 = sub(v[1], v[4]);
+    const Cplx a2 = add(v[2], v[3]);
+    const Cplx b2 = sub(v[2], v[3]);
+    const Cplx r1 = add(v[0], add(scale(C1, a1), scale(C2, a2)));
+    const Cplx r2 = add(v[0], add(scale(C2, a1), scale(C1, a2)));
+    const Cplx i1 = rotate(add(scale(S1, b1), scale(S2, b2)));
+    const Cplx i2 = rotate(sub(scale(S2, b1), scale(S1, b2)));
+    out[0] = add(v[0], add(a1, a2));
+    out[stride] = add(r1, i1);
+    out[2 * stride] = add(r2, i2);
+    out[3 * stride] = sub(r2, i2);
+    out[4 * stride] = sub(r1, i1);
+}
+
+template <uint32_t P>
+void pass(const Cplx* in, Cplx* out, size_t l, size_t r, const Cplx* twiddles) {
+    const size_t rp = r / P;
+    const size_t stride = l * rp;
+    for (size_t k = 0; k < l; ++k) {
+        const Cplx* w = twiddles + k * (P - 1);
+        const Cplx* src = in + k * r;
+        Cplx* dst = out + k * rp;
+        for (size_t j = 0; j < rp; ++j) {
+            Cplx v[P];
+            v[0] = src[j];
+            for (uint32_t q = 1; q < P; ++q) {
+                v[q] = mul(src[j + q * rp], w[q - 1]);
+            }
+            butterfly<P>(v, dst + j, stride);
+        }
+    }
+}
+
+/**
+ * Pass for a prime radix ≤ MAX_RADIX by direct p-point DFT; P fixes the
+ * radix at compile time (so the loops unroll), 0 takes it from p
+ */
+template <uint32_t P>
+void primePass(uint32_t radix, const Cplx* in, Cplx* out, size_t l, size_t r, const Cplx* twiddles,
+               const Cplx* roots) {
+    const uint32_t p = P != 0 ? P : radix;
+    const size_t rp = r / p;
+    const size_t stride = l * rp;
+    for (size_t k = 0; k < l; ++k) {
+        const Cplx* w = twiddles + k * (p - 1);
+        const Cplx* src = in + k * r;
+        Cplx* dst = out + k * rp;
+        for (size_t j = 0; j < rp; ++j) {
+            Cplx v[MAX_RADIX];
+            v[0] = src[j];
+            for (uint32_t q = 1; q < p; ++q) {
+                v[q] = mul(src[j + q * rp], w[q - 1]);
+            }
+            // Outputs q2 and p − q2 share their cosine and sine sums:
+            // u = v₀ + Σ (v_q + v_{p−q})·cos ∓ i·Σ (v_q − v_{p−q})·sin
+            const uint32_t half = (p - 1) / 2;
+            Cplx a[MAX_RADIX];
+            Cplx b[MAX_RADIX];
+            Cplx dc = v[0];
+            for (uint32_t q = 1; q <= half; ++q) {
+                a[q] = add(v[q], v[p - q]);
+                b[q] = sub(v[q], v[p - q]);
+                dc = add(dc, a[q]);
+            }
+            dst[j] = dc;
+            for (uint32_t q2 = 1; q2 <= half; ++q2) {
+                Cplx re = v[0];
+                Cplx im(0.0, 0.0);
+                uint32_t m = 0;
+                for (uint32_t q = 1; q <= half; ++q) {
+                    m += q2;
+                    if (m >= p) {
+                        m -= p;
+                    }
+                    re = add(re, scale(roots[m].real(), a[q]));
+                    im = add(im, scale(roots[m].imag(), b[q]));
+                }
+                dst[j + q2 * stride] = add(re, rotate(im));
+                dst[j + (p - q2) * stride] = sub(re, rotate(im));
+            }
+        }
+    }
+}
+
+thread_local std::vector<Cplx> work;
+thread_local std::vector<Cplx> scratch;
+
+} // namespace
+
+// ─── Mixed-radix FFT ─────────────────────────────────────────────────────────
+
+/**
+ * Stockham autosort FFT
+ *
+ * Stage s combines L-point transforms of the r = N/L residue classes into
+ * L·p-point ones. Reads and writes both run along the residue index, so
+ * every inner loop is unit-stride and no bit reversal pass is needed.
+ */
+struct DftPlan::Fft {
+    struct Stage {
+        uint32_t radix;
+        size_t twiddles;   // Offset of ω_{Lp}^{qk} at [k(p−1) + q − 1]
+        size_t roots;      // Offset of (cos, sin)(2πm/p), m < p (radices above 5)
+    };
+
+    size_t size;
+    std::vector<Stage> stages;
+    std::vector<Cplx> twiddles;
+    std::vector<Cplx> roots;
+
+    Fft(size_t n, const std::vector<uint32_t>& radices);
+
+    /** Forward transform of data in place; scratch holds size points */
+    void transform(Cplx* data, Cplx* scratch) const;
+
+    static std::shared_ptr<const Fft> get(size_t n, const std::vector<uint32_t>& radices);
+};
+
+DftPlan::Fft::Fft(size_t n, const std::vector<uint32_t>& radices) : size(n) {
+    size_t l = 1;
+    for (uint32_t p : radices) {
+        Stage stage{p, twiddles.size(), roots.size()};
+        const size_t lp = l * p;
+        for (size_t k = 0; k < l; ++k) {
+            for (uint32_t q = 1; q < p; ++q) {
+                const uint64_t e = (static_cast<uint64_t>(q) * k) % lp;
+                twiddles.push_back(std::polar(1.0, -2.0 * PI * static_cast<double>(e) / static_cast<double>(lp)));
+            }
+        }
+        if (p > 5) {
+            for (uint32_t m = 0; m < p; ++m) {
+                const double angle = 2.0 * PI * static_cast<double>(m) / static_cast<double>(p);
+                roots.push_back(Cplx(std::cos(angle), std::sin(angle)));
+            }
+        }
+        stages.push_back(stage);
+        l = lp;
+    }
+}
+
+std::shared_ptr<const DftPlan::Fft> DftPlan::Fft::get(size_t n, const std::vector<uint32_t>& radices) {
+    static std::mutex mutex;
+    static std::map<size_t, std::shared_ptr<const Fft>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(n);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    if (cache.size() >= FFT_CACHE_ENTRIES) {
+        cache.clear();   // Plans keep their own reference
+    }
+    auto fft = std::make_shared<const Fft>(n, radices);
+    cache.emplace(n, fft);
+    return fft;
+}
+
+void DftPlan::Fft::transform(Cplx* data, Cplx* scratch) const {
+    const Cplx* in = data;
+    Cplx* out = scratch;
+    size_t l = 1;
+    size_t r = size;
+
+    for (const Stage& stage : stages) {
+        const Cplx* w = twiddles.data() + stage.twiddles;
+        switch (stage.radix) {
+        case 2: pass<2>(in, out, l, r, w); break;
+        case 3: pass<3>(in, out, l, r, w); break;
+        case 4: pass<4>(in, out, l, r, w); break;
+        case 5: pass<5>(in, out, l, r, w); break;
+        case 7: primePass<7>(7, in, out, l, r, w, roots.data() + stage.roots); break;
+        default: primePass<0>(stage.radix, in, out, l, r, w, roots.data() + stage.roots); break;
+        }
+        in = out;
+        out = out == scratch ? data : scratch;
+        l *= stage.radix;
+        r /= stage.radix;
+    }
+
+    if (in != data) {
+        std::copy(in, in + size, data);
+    }
+}
+
+// ─── DftPlan ─────────────────────────────────────────────────────────────────
+
+DftPlan::DftPlan(size_t size) : size_(size) {
+    if (size == 0) {
+        throw std::invalid_argument("DFT size must be positive");
+    }
+    if (size == 1) {
+        return;
+    }
+
+    // Even lengths: N/2-point complex FFT of the sample pairs plus a split
+    const size_t direct_size = size % 2 == 0 ? size / 2 : size;
+    std::vector<uint32_t> radices = factorize(direct_size);
+    if (!radices.empty() || direct_size == 1) {
+        fft_ = Fft::get(direct_size, radices);
+        if (size % 2 == 0) {
+            split_.resize(size / 4 + 1);
+            for (size_t k = 0; k < split_.size(); ++k) {
+                split_[k] = std::polar(1.0, -2.0 * PI * static_cast<double>(k) / static_cast<double>(size));
+            }
+        }
+        return;
+    }
+
+    const size_t m = nextSmooth(2 * size - 1);
+    fft_ = Fft::get(m, factorize(m));
+
+    // jk = (j² + k² − (k − j)²) / 2 turns the DFT into a convolution with
+    // e^(iπm²/N). m² is reduced mod 2N first so large m keep full precision.
+    chirp_.resize(size_);
+    const uint64_t period = 2 * static_cast<uint64_t>(size_);
+    for (size_t j = 0; j < size_; ++j) {
+        const uint64_t sq = (static_cast<uint64_t>(j) * j) % period;
+        chirp_[j] = std::polar(1.0, -PI * static_cast<double>(sq) / static_cast<double>(size_));
+    }
+
+    filter_.assign(m, Cplx(0.0, 0.0));
+    filter_[0] = std::conj(chirp_[0]);
+    for (size_t j = 1; j < size_; ++j) {
+        filter_[j] = std::conj(chirp_[j]);
+        filter_[m - j] = filter_[j];
+    }
+    scratch.resize(m);
+    fft_->transform(filter_.data(), scratch.data());
+}
+
+DftPlan::~DftPlan() = default;
+
+template <typename T>
+void DftPlan::magnitudesOf(const T* in, double* magnitudes) const {
+    if (size_ == 1) {
+        magnitudes[0] = std::fabs(static_cast<double>(in[0]));
+        return;
+    }
+    const size_t m = fft_->size;
+    work.resize(m);
+    scratch.resize(m);
+    Cplx* w = work.data();
+
+    if (chirp_.empty() && !split_.empty()) {
+        // Pack x[2k] + i·x[2k+1], transform at half size and split
+        // X[k] = E[k] + W^k·O[k], E = (Z[k] + Z*[M-k])/2, O = -i(Z[k] - Z*[M-k])/2
+        for (size_t k = 0; k < m; ++k) {
+            w[k] = Cplx(static_cast<double>(in[2 * k]), static_cast<double>(in[2 * k + 1]));
+        }
+        fft_->transform(w, scratch.data());
+        magnitudes[0] = std::fabs(w[0].real() + w[0].imag());
+        magnitudes[m] = std::fabs(w[0].real() - w[0].imag());
+        for (size_t k = 1; k <= m / 2; ++k) {
+            const Cplx a = w[k];
+            const Cplx b = std::conj(w[m - k]);
+            const Cplx even = scale(0.5, add(a, b));
+            const Cplx odd = rotate(scale(0.5, sub(a, b)));
+            const Cplx t = mul(split_[k], odd);
+            magnitudes[k] = magnitude(add(even, t));
+            // X[M-k] = conj(E[k] − W^k·O[k])
+            magnitudes[m - k] = magnitude(sub(even, t));
+        }
+        return;
+    }
+
+    if (chirp_.empty()) {
+        for (size_t j = 0; j < size_; ++j) {
+            w[j] = Cplx(static_cast<double>(in[j]), 0.0);
+        }
+        fft_->transform(w, scratch.data());
+        const size_t n = bins();
+        for (size_t k = 0; k < n; ++k) {
+            magnitudes[k] = magnitude(w[k]);
+        }
+        return;
+    }
+
+    for (size_t j = 0; j < size_; ++j) {
+        w[j] = scale(static_cast<double>(in[j]), chirp_[j]);
+    }
+    std::fill(w + size_, w + m, Cplx(0.0, 0.0));
+    fft_->transform(w, scratch.data());
+
+    // Inverse transform as conj(FFT(conj(x))) / M. The output chirp has
+    // unit modulus and the outer conj does not change |·|, so both drop out.
+    for (size_t k = 0; k < m; ++k) {
+        w[k] = std::conj(mul(w[k], filter_[k]));
+    }
+    fft_->transform(w, scratch.data());
+    const double norm = 1.0 / static_cast<double>(m);
+    const size_t n = bins();
+    for (size_t k = 0; k < n; ++k) {
+        magnitudes[k] = magnitude(w[k]) * norm;
+    }
+}
+
+void DftPlan::magnitudes(const double* in, double* magnitudes) const {
+    magnitudesOf(in, magnitudes);
+}
+
+void DftPlan::magnitudes(const float* in, double* magnitudes) const {
+    magnitudesOf(in, magnitudes);
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
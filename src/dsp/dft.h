@@ -0,0 +1,89 @@
+/**
+ * Arbitrary-Length DFT for Harmonic IoT Protocol
+ *
+ * FftPlan is single precision and power-of-two only, which suits the
+ * streaming receive chain. Offline analysis (decode_fft on a whole
+ * capture, the Python backend) takes signals of any length in double
+ * precision, and zero-padding them to a power of two would move every
+ * bin. DftPlan computes the same N-point spectrum as numpy.fft.rfft.
+ *
+ * Lengths whose prime factors are all ≤ 13 (44100 = 2²3²5²7², 48000, any
+ * power of two) run a mixed-radix Stockham FFT, at half size plus a split
+ * step when N is even, as FftPlan does. Other lengths use Bluestein's
+ * chirp-z convolution at the next 5-smooth size ≥ 2N − 1. FFT tables are
+ * shared between plans of the same size.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_DFT_H
+#define HARMONIC_IOT_DSP_DFT_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Precomputed real DFT of a fixed length, double precision
+ *
+ * A plan is immutable after construction and transforms use thread-local
+ * scratch space, so one plan can be shared by any number of threads.
+ */
+class DftPlan {
+public:
+    /**
+     * @param size Transform length N ≥ 1
+     * @throws std::invalid_argument if size is 0
+     */
+    explicit DftPlan(size_t size);
+
+    ~DftPlan();
+
+    size_t size() const { return size_; }
+
+    /** Number of output bins, N/2 + 1 (DC through Nyquist) */
+    size_t bins() const { return size_ / 2 + 1; }
+
+    /** Bin spacing in Hz, computed as numpy.fft.rfftfreq does */
+    double binSpacing(double sample_rate) const {
+        return 1.0 / (static_cast<double>(size_) * (1.0 / sample_rate));
+    }
+
+    /** True if the length is transformed directly rather than by Bluestein */
+    bool direct() const { return chirp_.empty(); }
+
+    /**
+     * Forward transform returning |X[k]|
+     *
+     * @param in N samples
+     * @param magnitudes bins() magnitudes (unnormalized)
+     */
+    void magnitudes(const double* in, double* magnitudes) const;
+    void magnitudes(const float* in, double* magnitudes) const;
+
+    /** Complex mixed-radix FFT of one size, shared by all plans of that size */
+    struct Fft;
+
+private:
+    using Cplx = std::complex<double>;
+
+    template <typename T>
+    void magnitudesOf(const T* in, double* magnitudes) const;
+
+    size_t size_;
+    std::shared_ptr<const Fft> fft_;     // N/2 points (even N), N (odd N) or the convolution length
+    std::vector<Cplx> split_;            // e^(-2πik/N), k ≤ N/4 (even N only)
+    std::vector<Cplx> chirp_;            // e^(-iπj²/N), j < N (Bluestein only)
+    std::vector<Cplx> filter_;           // Transformed conj(chirp) filter (Bluestein only)
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_DFT_H
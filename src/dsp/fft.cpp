@@ -0,0 +1,133 @@
+/**
+ * Fast Fourier Transform for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "fft.h"
+#include "telemetry/latency.h"
+#include "telemetry/probes.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+bool isPowerOfTwo(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+} // namespace
+
+FftPlan::FftPlan(size_t size) : size_(size), half_(size / 2) {
+    if (size < 4 || !isPowerOfTwo(size)) {
+        throw std::invalid_argument("FFT size must be a power of two >= 4");
+    }
+
+    unsigned bits = 0;
+    while ((size_t(1) << bits) < half_) {
+        ++bits;
+    }
+
+    bit_reverse_.resize(half_);
+    for (size_t i = 0; i < half_; ++i) {
+        uint32_t r = 0;
+        for (unsigned b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bit_reverse_[i] = r;
+    }
+
+    twiddles_.resize(half_ / 2 > 0 ? half_ / 2 : 1);
+    for (size_t j = 0; j < twiddles_.size(); ++j) {
+        double angle = -2.0 * PI * static_cast<double>(j) / static_cast<double>(half_);
+        twiddles_[j] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    split_.resize(half_ / 2 + 1);
+    for (size_t k = 0; k < split_.size(); ++k) {
+        double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(size_);
+        split_[k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+void FftPlan::complexForward(Complex* data) const {
+    for (size_t i = 0; i < half_; ++i) {
+        size_t j = bit_reverse_[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Iterative radix-2 decimation in time
+    for (size_t len = 2; len <= half_; len <<= 1) {
+        size_t span = len / 2;
+        size_t stride = half_ / len;
+        for (size_t i = 0; i < half_; i += len) {
+            for (size_t j = 0; j < span; ++j) {
+                Complex t = twiddles_[j * stride] * data[i + j + span];
+                Complex u = data[i + j];
+                data[i + j] = u + t;
+                data[i + j + span] = u - t;
+            }
+        }
+    }
+}
+
+void FftPlan::forward(const Sample* in, Complex* out) const {
+    HIOT_LATENCY_SCOPE(Fft);
+    HIOT_PROBE1(fft_start, size_);
+
+    // Pack x[2k] + i·x[2k+1] and transform at half size
+    for (size_t k = 0; k < half_; ++k) {
+        out[k] = Complex(in[2 * k], in[2 * k + 1]);
+    }
+    complexForward(out);
+
+    // Split: X[k] = E[k] + W^k·O[k], E = (Z[k] + Z*[M-k])/2, O = -i(Z[k] - Z*[M-k])/2
+    const Complex z0 = out[0];
+    out[0] = Complex(z0.real() + z0.imag(), 0.0f);
+    out[half_] = Complex(z0.real() - z0.imag(), 0.0f);
+
+    const Complex minus_i(0.0f, -1.0f);
+    for (size_t k = 1; k <= half_ / 2; ++k) {
+        const size_t m = half_ - k;
+        const Complex a = out[k];
+        const Complex b = out[m];
+
+        Complex even_k = 0.5f * (a + std::conj(b));
+        Complex odd_k = 0.5f * minus_i * (a - std::conj(b));
+        Complex even_m = 0.5f * (b + std::conj(a));
+        Complex odd_m = 0.5f * minus_i * (b - std::conj(a));
+
+        // W^(M-k) = -conj(W^k)
+        out[k] = even_k + split_[k] * odd_k;
+        out[m] = even_m - std::conj(split_[k]) * odd_m;
+    }
+    HIOT_PROBE1(fft_end, size_);
+}
+
+void FftPlan::magnitudes(const Sample* in, float* magnitudes, Complex* scratch) const {
+    forward(in, scratch);
+    const size_t n = bins();
+    for (size_t k = 0; k < n; ++k) {
+        magnitudes[k] = std::abs(scratch[k]);
+    }
+}
+
+std::vector<float> hannWindow(size_t n) {
+    std::vector<float> window(n);
+    for (size_t i = 0; i < n; ++i) {
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI * static_cast<double>(i) / static_cast<double>(n)));
+    }
+    return window;
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
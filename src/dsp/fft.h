@@ -0,0 +1,88 @@
+/**
+ * Fast Fourier Transform for Harmonic IoT Protocol
+ *
+ * Radix-2 FFT of real signals, used for spectral analysis of composite
+ * harmonic signals s(t) = Σ Aₖ sin(2π(aₖ/bₖ)f₀t + φₖ).
+ *
+ * A real N-point transform is computed as an N/2-point complex FFT of the
+ * even/odd sample pairs followed by a split step, halving the work of a
+ * naive complex transform.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_FFT_H
+#define HARMONIC_IOT_DSP_FFT_H
+
+#include "dsp/sample.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+using Complex = std::complex<float>;
+
+/**
+ * Precomputed real FFT of a fixed power-of-two size
+ *
+ * A plan is immutable after construction, so one plan can be shared by
+ * any number of threads.
+ */
+class FftPlan {
+public:
+    /**
+     * @param size Transform size N, a power of two ≥ 4
+     * @throws std::invalid_argument otherwise
+     */
+    explicit FftPlan(size_t size);
+
+    size_t size() const { return size_; }
+
+    /** Number of output bins, N/2 + 1 (DC through Nyquist) */
+    size_t bins() const { return size_ / 2 + 1; }
+
+    /** Frequency in Hz of bin k at the given sample rate */
+    double binFrequency(size_t k, double sample_rate) const {
+        return static_cast<double>(k) * sample_rate / static_cast<double>(size_);
+    }
+
+    /**
+     * Forward transform
+     *
+     * @param in N real samples
+     * @param out bins() complex coefficients (unnormalized)
+     */
+    void forward(const Sample* in, Complex* out) const;
+
+    /**
+     * Forward transform returning |X[k]|
+     *
+     * @param in N real samples
+     * @param magnitudes bins() magnitudes
+     * @param scratch bins() complex values of working space
+     */
+    void magnitudes(const Sample* in, float* magnitudes, Complex* scratch) const;
+
+private:
+    size_t size_;
+    size_t half_;                        // M = N/2, size of the inner complex FFT
+    std::vector<uint32_t> bit_reverse_;  // Permutation for the M-point FFT
+    std::vector<Complex> twiddles_;      // e^(-2πij/M), j < M/2
+    std::vector<Complex> split_;         // e^(-2πik/N), k ≤ M/2
+
+    void complexForward(Complex* data) const;
+};
+
+/**
+ * Hann window of length n (periodic form, suited to overlapping STFT frames)
+ */
+std::vector<float> hannWindow(size_t n);
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_FFT_H
@@ -0,0 +1,76 @@
+/**
+ * Goertzel Tone Detection for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "goertzel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+constexpr double TWO_PI = 6.28318530717958647692;
+
+/** Filters run together per pass over the samples */
+constexpr size_t GOERTZEL_LANES = 4;
+
+} // namespace
+
+GoertzelBank::GoertzelBank(const double* frequencies, size_t count, double sample_rate) {
+    if (!(sample_rate > 0.0)) {
+        throw std::invalid_argument("Sample rate must be positive");
+    }
+    coefficients_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        coefficients_[i] = 2.0 * std::cos(TWO_PI * frequencies[i] / sample_rate);
+    }
+}
+
+template <typename T>
+void GoertzelBank::magnitudesOf(const T* in, size_t n, double* magnitudes) const {
+    const size_t count = coefficients_.size();
+
+    // Several independent recurrences per sample pass: each filter's
+    // s[n] depends on s[n-1], so one filter alone is latency-bound.
+    for (size_t first = 0; first < count; first += GOERTZEL_LANES) {
+        const size_t lanes = std::min(GOERTZEL_LANES, count - first);
+        double c[GOERTZEL_LANES] = {};
+        double s1[GOERTZEL_LANES] = {};
+        double s2[GOERTZEL_LANES] = {};
+        for (size_t l = 0; l < lanes; ++l) {
+            c[l] = coefficients_[first + l];
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const double x = static_cast<double>(in[i]);
+            for (size_t l = 0; l < GOERTZEL_LANES; ++l) {
+                const double s = x + c[l] * s1[l] - s2[l];
+                s2[l] = s1[l];
+                s1[l] = s;
+            }
+        }
+
+        // |s[N-1] − e^(−iω)·s[N-2]|² = s1² + s2² − 2cos(ω)·s1·s2
+        for (size_t l = 0; l < lanes; ++l) {
+            const double power = s1[l] * s1[l] + s2[l] * s2[l] - c[l] * s1[l] * s2[l];
+            magnitudes[first + l] = std::sqrt(std::max(power, 0.0));
+        }
+    }
+}
+
+void GoertzelBank::magnitudes(const double* in, size_t n, double* magnitudes) const {
+    magnitudesOf(in, n, magnitudes);
+}
+
+void GoertzelBank::magnitudes(const float* in, size_t n, double* magnitudes) const {
+    magnitudesOf(in, n, magnitudes);
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
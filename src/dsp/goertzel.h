@@ -0,0 +1,60 @@
+/**
+ * Goertzel Tone Detection for Harmonic IoT Protocol
+ *
+ * Evaluates |X(f)| at a handful of chosen frequencies in O(N) each. When
+ * only the channels of interest matter (f₀ · a/b for the assigned H_N
+ * members) this is cheaper than a full transform, and the frequencies do
+ * not have to fall on bin centres. At a bin centre the result equals the
+ * corresponding |rfft| bin.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_GOERTZEL_H
+#define HARMONIC_IOT_DSP_GOERTZEL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Fixed set of Goertzel filters
+ *
+ * Immutable after construction and safe to share between threads.
+ */
+class GoertzelBank {
+public:
+    /**
+     * @param frequencies Frequencies to evaluate, Hz
+     * @param count Number of frequencies
+     * @param sample_rate Sampling rate in Hz
+     * @throws std::invalid_argument if sample_rate is not positive
+     */
+    GoertzelBank(const double* frequencies, size_t count, double sample_rate);
+
+    size_t size() const { return coefficients_.size(); }
+
+    /**
+     * Magnitude of the DTFT of in[0, n) at each frequency (unnormalized)
+     *
+     * @param in n samples
+     * @param n Number of samples
+     * @param magnitudes size() magnitudes, in constructor order
+     */
+    void magnitudes(const double* in, size_t n, double* magnitudes) const;
+    void magnitudes(const float* in, size_t n, double* magnitudes) const;
+
+private:
+    template <typename T>
+    void magnitudesOf(const T* in, size_t n, double* magnitudes) const;
+
+    std::vector<double> coefficients_;   // 2·cos(ω) per filter
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_GOERTZEL_H
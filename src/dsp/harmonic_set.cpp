@@ -0,0 +1,77 @@
+/**
+ * Rational Harmonic Set H_N for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "harmonic_set.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+std::vector<HarmonicRatio> computeHarmonicSet(uint32_t n) {
+    std::vector<HarmonicRatio> set;
+    for (uint32_t b = 1; b <= n; ++b) {
+        for (uint32_t a = 1; a <= n; ++a) {
+            if (std::gcd(a, b) == 1) {
+                set.push_back(HarmonicRatio{a, b});
+            }
+        }
+    }
+    // Exact comparison of a1/b1 < a2/b2
+    std::sort(set.begin(), set.end(), [](const HarmonicRatio& x, const HarmonicRatio& y) {
+        return static_cast<uint64_t>(x.a) * y.b < static_cast<uint64_t>(y.a) * x.b;
+    });
+    return set;
+}
+
+HarmonicRatio nearestRatio(double ratio, uint32_t max_denominator, uint32_t max_numerator) {
+    HarmonicRatio best{1, 1};
+    double best_deviation = std::fabs(ratio - 1.0);
+    for (uint32_t b = 1; b <= max_denominator; ++b) {
+        // nearbyint rounds half to even, like Python's round()
+        double a = std::nearbyint(ratio * b);
+        if (a > 0.0 && a <= max_numerator) {
+            double deviation = std::fabs(ratio - a / b);
+            if (deviation < best_deviation) {
+                best = HarmonicRatio{static_cast<uint32_t>(a), b};
+                best_deviation = deviation;
+            }
+        }
+    }
+    return best;
+}
+
+RatioMatcher::RatioMatcher(double f0, uint32_t max_denominator) : f0_(f0) {
+    if (max_denominator == 0) {
+        throw std::invalid_argument("H_N requires N >= 1");
+    }
+    ratios_ = computeHarmonicSet(max_denominator);
+    frequencies_.reserve(ratios_.size());
+    for (const HarmonicRatio& r : ratios_) {
+        frequencies_.push_back(r.value() * f0_);
+    }
+}
+
+RatioMatcher::Match RatioMatcher::match(double frequency) const {
+    auto it = std::lower_bound(frequencies_.begin(), frequencies_.end(), frequency);
+    size_t index = static_cast<size_t>(it - frequencies_.begin());
+    if (index == frequencies_.size() ||
+        (index > 0 && frequency - frequencies_[index - 1] <= frequencies_[index] - frequency)) {
+        --index;
+    }
+
+    Match result;
+    result.ratio = ratios_[index];
+    result.frequency = frequencies_[index];
+    result.deviation_hz = std::fabs(frequency - frequencies_[index]);
+    return result;
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
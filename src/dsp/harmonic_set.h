@@ -0,0 +1,85 @@
+/**
+ * Rational Harmonic Set H_N for Harmonic IoT Protocol
+ *
+ * H_N = {a/b ∈ Q⁺ : gcd(a, b) = 1, a ≤ N, b ≤ N} is the set of valid
+ * channel ratios; a component at frequency f is legitimate when f/f₀ is
+ * (close to) a member. Native counterpart of hpg_core.omnigrid.compute_hn
+ * and the ratio search in hpg_core.signal_processing.decode_fft.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_HARMONIC_SET_H
+#define HARMONIC_IOT_DSP_HARMONIC_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Reduced fraction a/b
+ */
+struct HarmonicRatio {
+    uint32_t a = 1;
+    uint32_t b = 1;
+
+    double value() const { return static_cast<double>(a) / static_cast<double>(b); }
+};
+
+/**
+ * Members of H_N in ascending order
+ *
+ * @param n Maximum numerator and denominator
+ */
+std::vector<HarmonicRatio> computeHarmonicSet(uint32_t n);
+
+/**
+ * Closest a/b to ratio with b ≤ max_denominator and 0 < a ≤ max_numerator
+ *
+ * Same search (and tie-breaking) as decode_fft: denominators are tried in
+ * increasing order and a candidate replaces the best only if strictly
+ * closer, starting from 1/1.
+ */
+HarmonicRatio nearestRatio(double ratio, uint32_t max_denominator, uint32_t max_numerator);
+
+/**
+ * Nearest-member lookup of frequencies against f₀ · H_N
+ *
+ * Frequencies are precomputed and sorted, so a lookup is a binary search
+ * instead of the linear scan over |H_N| candidates done in Python.
+ * Immutable after construction and safe to share between threads.
+ */
+class RatioMatcher {
+public:
+    struct Match {
+        HarmonicRatio ratio;      ///< Nearest member of H_N
+        double frequency = 0.0;   ///< f₀ · a/b
+        double deviation_hz = 0.0;
+    };
+
+    /**
+     * @param f0 Fundamental frequency in Hz
+     * @param max_denominator N of H_N
+     */
+    RatioMatcher(double f0, uint32_t max_denominator);
+
+    double fundamental() const { return f0_; }
+    size_t size() const { return frequencies_.size(); }
+
+    /** Nearest valid frequency to the given one */
+    Match match(double frequency) const;
+
+private:
+    double f0_;
+    std::vector<double> frequencies_;      // Ascending, one per member
+    std::vector<HarmonicRatio> ratios_;    // Parallel to frequencies_
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_HARMONIC_SET_H
@@ -0,0 +1,108 @@
+/**
+ * Harmonic Peak Detector for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "peak_detector.h"
+#include "telemetry/latency.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+struct Scratch {
+    std::vector<Sample> padded;
+    std::vector<float> magnitudes;
+    std::vector<Complex> spectrum;
+};
+
+thread_local Scratch scratch;
+
+template <typename T>
+void pickPeaksOf(const T* mag, size_t bins, double bin_hz, const PeakDetectorConfig& config,
+                 std::vector<DetectedComponent>& out) {
+    out.clear();
+    if (bins < 3) {
+        return;
+    }
+    const T max_mag = *std::max_element(mag, mag + bins);
+    if (!(max_mag > T(0))) {
+        return;
+    }
+
+    // Compare in the linear domain: dB(m) > threshold ⇔ m > max · 10^(threshold/20).
+    // Only peaks pay for the log.
+    const T floor = max_mag * std::pow(T(10), static_cast<T>(config.threshold_db) / T(20));
+    for (size_t k = 1; k + 1 < bins; ++k) {
+        const T m = mag[k];
+        if (m > floor && m > mag[k - 1] && m > mag[k + 1]) {
+            DetectedComponent c;
+            c.frequency = static_cast<double>(k) * bin_hz;
+            c.amplitude_db = T(20) * std::log10(m / max_mag + T(1e-12));
+            double ratio = config.f0 > 0.0 ? c.frequency / config.f0 : 0.0;
+            c.ratio = nearestRatio(ratio, config.max_denominator, config.max_numerator);
+            c.deviation_hz = std::fabs(ratio - c.ratio.value()) * config.f0;
+            out.push_back(c);
+        }
+    }
+
+    // Strongest first, ties in frequency order. Peaks are few, and unlike
+    // std::stable_sort an insertion sort needs no temporary buffer.
+    for (size_t i = 1; i < out.size(); ++i) {
+        DetectedComponent c = out[i];
+        size_t j = i;
+        while (j > 0 && out[j - 1].amplitude_db < c.amplitude_db) {
+            out[j] = out[j - 1];
+            --j;
+        }
+        out[j] = c;
+    }
+}
+
+} // namespace
+
+PeakDetector::PeakDetector(size_t fft_size, const PeakDetectorConfig& config)
+    : plan_(fft_size), config_(config) {}
+
+void PeakDetector::detect(SampleSpan window, std::vector<DetectedComponent>& out) const {
+    HIOT_LATENCY_SCOPE(Detect);
+
+    const size_t n = plan_.size();
+    if (window.size() > n) {
+        throw std::length_error("Window longer than the detector FFT");
+    }
+
+    const size_t bins = plan_.bins();
+    scratch.magnitudes.resize(bins);
+    scratch.spectrum.resize(bins);
+
+    const Sample* input = window.data();
+    if (window.size() < n) {
+        scratch.padded.assign(n, 0.0f);
+        std::memcpy(scratch.padded.data(), window.data(), window.size() * sizeof(Sample));
+        input = scratch.padded.data();
+    }
+    plan_.magnitudes(input, scratch.magnitudes.data(), scratch.spectrum.data());
+
+    pickPeaks(scratch.magnitudes.data(), bins, plan_.binFrequency(1, config_.sample_rate), config_, out);
+}
+
+void pickPeaks(const float* magnitudes, size_t bins, double bin_hz, const PeakDetectorConfig& config,
+               std::vector<DetectedComponent>& out) {
+    pickPeaksOf(magnitudes, bins, bin_hz, config, out);
+}
+
+void pickPeaks(const double* magnitudes, size_t bins, double bin_hz, const PeakDetectorConfig& config,
+               std::vector<DetectedComponent>& out) {
+    pickPeaksOf(magnitudes, bins, bin_hz, config, out);
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
@@ -0,0 +1,101 @@
+/**
+ * Harmonic Peak Detector for Harmonic IoT Protocol
+ *
+ * Native counterpart of hpg_core.signal_processing.decode_fft: transforms
+ * a window, keeps local spectral maxima above a threshold relative to the
+ * strongest bin, and labels each with its closest small-denominator
+ * ratio to f₀.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_PEAK_DETECTOR_H
+#define HARMONIC_IOT_DSP_PEAK_DETECTOR_H
+
+#include "dsp/fft.h"
+#include "dsp/harmonic_set.h"
+#include "dsp/sample.h"
+#include <cstdint>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * One spectral peak (fields match the dicts returned by decode_fft)
+ */
+struct DetectedComponent {
+    double frequency = 0.0;       ///< Bin centre frequency in Hz
+    double amplitude_db = 0.0;    ///< Relative to the strongest bin (≤ 0)
+    HarmonicRatio ratio;          ///< Closest a/b to frequency / f₀
+    double deviation_hz = 0.0;    ///< |frequency − f₀ · a/b|
+};
+
+/**
+ * Detector parameters (defaults match decode_fft)
+ */
+struct PeakDetectorConfig {
+    double sample_rate = 44100.0;
+    double f0 = 16384.0;
+    float threshold_db = -40.0f;
+    uint32_t max_denominator = 32;
+    uint32_t max_numerator = 100;
+};
+
+/**
+ * FFT peak picker
+ *
+ * Immutable after construction; detect() uses thread-local scratch space,
+ * so one detector can serve every worker of a pipeline stage.
+ */
+class PeakDetector {
+public:
+    /**
+     * @param fft_size Transform size (power of two); shorter windows are zero-padded
+     * @throws std::invalid_argument if fft_size is not a power of two ≥ 4
+     */
+    PeakDetector(size_t fft_size, const PeakDetectorConfig& config = PeakDetectorConfig());
+
+    size_t fftSize() const { return plan_.size(); }
+    const PeakDetectorConfig& config() const { return config_; }
+
+    /**
+     * Detect peaks in one window, strongest first
+     *
+     * With window.size() == fftSize() the result equals decode_fft on the
+     * same samples (up to float precision).
+     *
+     * @param window Up to fftSize() samples
+     * @param out Replaced with the detected components
+     * @throws std::length_error if the window is longer than the FFT
+     */
+    void detect(SampleSpan window, std::vector<DetectedComponent>& out) const;
+
+private:
+    FftPlan plan_;
+    PeakDetectorConfig config_;
+};
+
+/**
+ * Peak picking and ratio labelling on a magnitude spectrum
+ *
+ * The part of PeakDetector::detect() after the transform, for spectra
+ * computed elsewhere (DftPlan for window lengths that are not a power of
+ * two).
+ *
+ * @param magnitudes |X[k]| for bins k in [0, bins)
+ * @param bins Number of bins
+ * @param bin_hz Bin spacing in Hz
+ * @param config Detection parameters (sample_rate is not used)
+ * @param out Replaced with the detected components, strongest first
+ */
+void pickPeaks(const float* magnitudes, size_t bins, double bin_hz, const PeakDetectorConfig& config,
+               std::vector<DetectedComponent>& out);
+void pickPeaks(const double* magnitudes, size_t bins, double bin_hz, const PeakDetectorConfig& config,
+               std::vector<DetectedComponent>& out);
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_PEAK_DETECTOR_H
@@ -0,0 +1,82 @@
+/**
+ * Sample Types for Harmonic IoT Protocol DSP
+ *
+ * Common sample type and non-owning views shared by the signal
+ * processing, capture and I/O modules.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_SAMPLE_H
+#define HARMONIC_IOT_DSP_SAMPLE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Native sample type used by all DSP kernels.
+ *
+ * Signals are normalized to [-1.0, 1.0]; 32-bit float keeps twice as many
+ * samples per cache line as double while giving ~144 dB of dynamic range.
+ */
+using Sample = float;
+
+/**
+ * Non-owning view over a contiguous run of elements
+ *
+ * Minimal stand-in for C++20 std::span. Views never own memory; the
+ * producer (a buffer, a mapped capture file, a ring) must outlive them.
+ */
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    /** Allow Span<T> to bind to Span<const T> */
+    template <typename U,
+              typename = std::enable_if_t<std::is_same<const U, T>::value &&
+                                          !std::is_same<U, T>::value>>
+    Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    T& operator[](size_t i) const { return data_[i]; }
+
+    /**
+     * Sub-view of [offset, offset + count)
+     *
+     * @param offset First element of the sub-view
+     * @param count Number of elements
+     * @return View into the same memory
+     */
+    Span subspan(size_t offset, size_t count) const {
+        if (offset > size_ || count > size_ - offset) {
+            throw std::out_of_range("Span::subspan out of range");
+        }
+        return Span(data_ + offset, count);
+    }
+
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+using SampleSpan = Span<const Sample>;
+using MutableSampleSpan = Span<Sample>;
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_SAMPLE_H
@@ -0,0 +1,81 @@
+/**
+ * Spectral Integrity Verification for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "spectral_verification.h"
+#include "telemetry/latency.h"
+#include "telemetry/probes.h"
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+void resetReport(SpectralReport& report, size_t total, double threshold) {
+    report.total_components = total;
+    report.valid_components = 0;
+    report.invalid_components = 0;
+    report.integrity_score = 0.0;
+    report.threshold = threshold;
+    report.violations.clear();
+}
+
+void finishReport(SpectralReport& report) {
+    if (report.total_components > 0) {
+        report.integrity_score = static_cast<double>(report.valid_components) /
+                                 static_cast<double>(report.total_components) * 100.0;
+    }
+}
+
+} // namespace
+
+IntegrityVerifier::IntegrityVerifier(const IntegrityConfig& config)
+    : config_(config), matcher_(config.f0, config.max_denominator) {}
+
+void IntegrityVerifier::account(double frequency, SpectralReport& report) const {
+    RatioMatcher::Match nearest = matcher_.match(frequency);
+    if (nearest.deviation_hz <= config_.tolerance_hz) {
+        ++report.valid_components;
+        return;
+    }
+    ++report.invalid_components;
+    HIOT_PROBE2(integrity_violation, static_cast<long long>(frequency * 1000.0),
+                static_cast<long long>(nearest.deviation_hz * 1000.0));
+    IntegrityViolation violation;
+    violation.frequency = frequency;
+    violation.ratio = config_.f0 > 0.0 ? frequency / config_.f0 : 0.0;
+    violation.deviation_hz = nearest.deviation_hz;
+    report.violations.push_back(violation);
+}
+
+void IntegrityVerifier::verify(const double* frequencies, size_t count, SpectralReport& report) const {
+    HIOT_LATENCY_SCOPE(Verify);
+    resetReport(report, count, config_.threshold);
+    for (size_t i = 0; i < count; ++i) {
+        account(frequencies[i], report);
+    }
+    finishReport(report);
+}
+
+void IntegrityVerifier::verify(const DetectedComponent* components, size_t count,
+                               SpectralReport& report) const {
+    HIOT_LATENCY_SCOPE(Verify);
+    resetReport(report, count, config_.threshold);
+    for (size_t i = 0; i < count; ++i) {
+        account(components[i].frequency, report);
+    }
+    finishReport(report);
+}
+
+SpectralReport verifyRationalIntegrity(const std::vector<DetectedComponent>& components,
+                                       const IntegrityConfig& config) {
+    SpectralReport report;
+    IntegrityVerifier(config).verify(components.data(), components.size(), report);
+    return report;
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
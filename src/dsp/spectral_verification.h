@@ -0,0 +1,90 @@
+/**
+ * Spectral Integrity Verification for Harmonic IoT Protocol
+ *
+ * Native counterpart of hpg_core.spectral_verification: every detected
+ * component must lie within a tolerance of f₀ · a/b for some a/b in H_N,
+ * otherwise it is reported as a violation (unauthorized or corrupted
+ * channel).
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_SPECTRAL_VERIFICATION_H
+#define HARMONIC_IOT_DSP_SPECTRAL_VERIFICATION_H
+
+#include "dsp/harmonic_set.h"
+#include "dsp/peak_detector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Verification parameters (defaults match verify_rational_integrity)
+ */
+struct IntegrityConfig {
+    double f0 = 16384.0;
+    uint32_t max_denominator = 32;
+    double tolerance_hz = 50.0;
+    double threshold = 100.0;       ///< Minimum integrity score to pass (percent)
+};
+
+struct IntegrityViolation {
+    double frequency = 0.0;
+    double ratio = 0.0;             ///< frequency / f₀
+    double deviation_hz = 0.0;      ///< Distance to the nearest valid frequency
+};
+
+/**
+ * Result of one verification (mirrors the Python SpectralReport)
+ */
+struct SpectralReport {
+    size_t total_components = 0;
+    size_t valid_components = 0;
+    size_t invalid_components = 0;
+    double integrity_score = 0.0;   ///< Percentage of valid components
+    double threshold = 100.0;
+    std::vector<IntegrityViolation> violations;
+
+    bool passed() const { return integrity_score >= threshold; }
+};
+
+/**
+ * Reusable verifier; builds f₀ · H_N once
+ *
+ * Immutable after construction and safe to share between threads.
+ */
+class IntegrityVerifier {
+public:
+    explicit IntegrityVerifier(const IntegrityConfig& config = IntegrityConfig());
+
+    const IntegrityConfig& config() const { return config_; }
+
+    /**
+     * @param frequencies Component frequencies in Hz
+     * @param report Overwritten (its violation buffer is reused)
+     */
+    void verify(const double* frequencies, size_t count, SpectralReport& report) const;
+
+    void verify(const DetectedComponent* components, size_t count, SpectralReport& report) const;
+
+private:
+    void account(double frequency, SpectralReport& report) const;
+
+    IntegrityConfig config_;
+    RatioMatcher matcher_;
+};
+
+/**
+ * One-shot verification, equivalent to verify_rational_integrity()
+ */
+SpectralReport verifyRationalIntegrity(const std::vector<DetectedComponent>& components,
+                                       const IntegrityConfig& config = IntegrityConfig());
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_SPECTRAL_VERIFICATION_H
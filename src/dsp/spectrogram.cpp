@@ -0,0 +1,85 @@
+/**
+ * Short-Time Fourier Analysis for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "spectrogram.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+struct Scratch {
+    std::vector<Sample> windowed;
+    std::vector<Complex> spectrum;
+    std::vector<float> magnitudes;
+};
+
+thread_local Scratch scratch;
+
+} // namespace
+
+Spectrogram::Spectrogram(size_t fft_size, size_t hop)
+    : plan_(fft_size), hop_(hop), window_(hannWindow(fft_size)) {
+    if (hop == 0 || hop > fft_size) {
+        throw std::invalid_argument("Spectrogram hop must be in [1, fft_size]");
+    }
+
+    // A unit sine on bin k gives |X[k]| = Σ w[n] / 2 (coherent gain)
+    double gain = 0.0;
+    for (float w : window_) {
+        gain += w;
+    }
+    reference_ = static_cast<float>(gain / 2.0);
+
+    frame_db_.resize(binsPerFrame());
+    history_.reserve(2 * fft_size);
+}
+
+void Spectrogram::computeFrame(const Sample* window, float* db) const {
+    const size_t n = plan_.size();
+    if (scratch.windowed.size() < n) {
+        scratch.windowed.resize(n);
+        scratch.spectrum.resize(plan_.bins());
+        scratch.magnitudes.resize(plan_.bins());
+    }
+    for (size_t i = 0; i < n; ++i) {
+        scratch.windowed[i] = window[i] * window_[i];
+    }
+    plan_.magnitudes(scratch.windowed.data(), scratch.magnitudes.data(), scratch.spectrum.data());
+
+    const float inv_reference = 1.0f / reference_;
+    const size_t bins = binsPerFrame();
+    for (size_t k = 0; k < bins; ++k) {
+        db[k] = 20.0f * std::log10(scratch.magnitudes[k] * inv_reference + 1e-12f);
+    }
+}
+
+void Spectrogram::push(const Sample* samples, size_t count, const FrameCallback& callback) {
+    const size_t n = plan_.size();
+
+    history_.insert(history_.end(), samples, samples + count);
+
+    size_t offset = 0;
+    while (history_.size() - offset >= n) {
+        computeFrame(history_.data() + offset, frame_db_.data());
+        callback(frames_++, frame_db_.data());
+        offset += hop_;
+    }
+
+    history_.erase(history_.begin(), history_.begin() + static_cast<std::ptrdiff_t>(std::min(offset, history_.size())));
+}
+
+void Spectrogram::reset() {
+    history_.clear();
+    frames_ = 0;
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
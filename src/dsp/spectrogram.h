@@ -0,0 +1,82 @@
+/**
+ * Short-Time Fourier Analysis for Harmonic IoT Protocol
+ *
+ * Turns a sample stream into Hann-windowed magnitude frames in dBFS,
+ * the input of the spectrogram tile pyramid and of live dashboards.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_SPECTROGRAM_H
+#define HARMONIC_IOT_DSP_SPECTROGRAM_H
+
+#include "dsp/fft.h"
+#include "dsp/sample.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * Streaming STFT
+ *
+ * Frame j covers samples [j·hop, j·hop + fft_size). Each frame reports
+ * fft_size/2 bins (DC up to, excluding, Nyquist) so frame height is a
+ * power of two. 0 dBFS is a full-scale sine centred on a bin.
+ *
+ * push() and reset() need a single caller. computeFrame() uses
+ * thread-local scratch space, so any number of threads may call it,
+ * concurrently with push().
+ */
+class Spectrogram {
+public:
+    /** Receives frame index and fft_size/2 dBFS values */
+    using FrameCallback = std::function<void(uint64_t frame, const float* db)>;
+
+    /**
+     * @param fft_size Window length, a power of two ≥ 4
+     * @param hop Samples between consecutive frames (1..fft_size)
+     * @throws std::invalid_argument on invalid parameters
+     */
+    Spectrogram(size_t fft_size, size_t hop);
+
+    size_t fftSize() const { return plan_.size(); }
+    size_t hop() const { return hop_; }
+    size_t binsPerFrame() const { return plan_.size() / 2; }
+
+    /** Frames emitted so far */
+    uint64_t frameCount() const { return frames_; }
+
+    /**
+     * Feed samples; invokes callback once per completed frame
+     */
+    void push(const Sample* samples, size_t count, const FrameCallback& callback);
+
+    /**
+     * Compute a single frame from fft_size samples, independent of stream state
+     *
+     * @param window fft_size samples
+     * @param db binsPerFrame() outputs
+     */
+    void computeFrame(const Sample* window, float* db) const;
+
+    /** Reset the stream to frame 0 */
+    void reset();
+
+private:
+    FftPlan plan_;
+    size_t hop_;
+    std::vector<float> window_;
+    std::vector<Sample> history_;  // Samples not yet consumed by a frame
+    uint64_t frames_ = 0;
+    float reference_;              // |X[k]| of a full-scale windowed sine
+    std::vector<float> frame_db_;
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_SPECTROGRAM_H
@@ -0,0 +1,268 @@
+/**
+ * Spectrogram Tile Pyramid for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "spectrogram_tiles.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+// ─── SpectrogramTileCache ────────────────────────────────────────────────────
+
+SpectrogramTileCache::SpectrogramTileCache(size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Tile cache capacity must be positive");
+    }
+    map_.reserve(capacity_);
+}
+
+uint64_t SpectrogramTileCache::key(uint32_t level, uint64_t tx, uint32_t ty) {
+    // 6 bits of level, 18 bits of frequency tile, 40 bits of time tile
+    return (static_cast<uint64_t>(level & 0x3F) << 58) |
+           (static_cast<uint64_t>(ty & 0x3FFFF) << 40) |
+           (tx & 0xFFFFFFFFFFull);
+}
+
+SpectrogramTilePtr SpectrogramTileCache::find(uint64_t key) {
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+void SpectrogramTileCache::insert(uint64_t key, SpectrogramTilePtr tile) {
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+        it->second->second = std::move(tile);
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+
+    if (map_.size() >= capacity_) {
+        map_.erase(lru_.back().first);
+        lru_.pop_back();
+        ++evictions_;
+    }
+
+    lru_.emplace_front(key, std::move(tile));
+    map_[key] = lru_.begin();
+}
+
+// ─── SpectrogramTileService ──────────────────────────────────────────────────
+
+SpectrogramTileService::SpectrogramTileService(const SpectrogramTileConfig& config, SampleSource source)
+    : config_(config),
+      source_(std::move(source)),
+      stft_(config.fft_size, config.hop),
+      cache_(config.cache_tiles) {
+    const size_t bins = stft_.binsPerFrame();
+    if (config_.tile_width == 0 || config_.tile_height == 0) {
+        throw std::invalid_argument("Tile dimensions must be positive");
+    }
+    if (config_.levels == 0 || config_.levels > 32 || (bins >> (config_.levels - 1)) == 0) {
+        throw std::invalid_argument("Too many pyramid levels for the FFT size");
+    }
+    if (config_.db_ceiling <= config_.db_floor) {
+        throw std::invalid_argument("db_ceiling must be above db_floor");
+    }
+
+    column_.resize(bins);
+    levels_.resize(config_.levels);
+    for (uint32_t l = 0; l < config_.levels; ++l) {
+        levels_[l].rows = static_cast<uint32_t>(bins >> l);
+        levels_[l].pending.assign(levels_[l].rows, 0);
+    }
+}
+
+uint32_t SpectrogramTileService::tilesPerColumn(uint32_t level) const {
+    if (level >= config_.levels) {
+        return 0;
+    }
+    uint32_t rows = levels_[level].rows;
+    return (rows + config_.tile_height - 1) / config_.tile_height;
+}
+
+uint64_t SpectrogramTileService::frameCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return levels_[0].columns;
+}
+
+SpectrogramTileStats SpectrogramTileService::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SpectrogramTileStats s = stats_;
+    s.evictions = cache_.evictions();
+    return s;
+}
+
+uint8_t SpectrogramTileService::quantize(float db) const {
+    const float scale = 255.0f / (config_.db_ceiling - config_.db_floor);
+    float q = (db - config_.db_floor) * scale + 0.5f;
+    q = std::min(255.0f, std::max(0.0f, q));
+    return static_cast<uint8_t>(q);
+}
+
+void SpectrogramTileService::pushSamples(const Sample* samples, size_t count) {
+    stft_.push(samples, count, [this](uint64_t, const float* db) { pushFrame(db); });
+}
+
+void SpectrogramTileService::pushFrame(const float* db) {
+    // Quantize outside the lock; max-pooling commutes with the monotonic mapping
+    for (size_t k = 0; k < column_.size(); ++k) {
+        column_[k] = quantize(db[k]);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    addColumn(0, column_.data());
+}
+
+std::shared_ptr<SpectrogramTile> SpectrogramTileService::makeTile(uint32_t level, uint64_t tx, uint32_t ty) const {
+    auto tile = std::make_shared<SpectrogramTile>();
+    tile->level = level;
+    tile->tx = tx;
+    tile->ty = ty;
+    tile->width = config_.tile_width;
+    tile->height = config_.tile_height;
+    tile->db_floor = config_.db_floor;
+    tile->db_ceiling = config_.db_ceiling;
+    tile->pixels.assign(static_cast<size_t>(tile->width) * tile->height, 0);
+    return tile;
+}
+
+void SpectrogramTileService::addColumn(uint32_t level, const uint8_t* column) {
+    Level& l = levels_[level];
+    const uint32_t width = config_.tile_width;
+    const uint32_t height = config_.tile_height;
+    const uint64_t tx = l.columns / width;
+    const uint32_t c = static_cast<uint32_t>(l.columns % width);
+    const uint32_t tiles = tilesPerColumn(level);
+
+    if (c == 0) {
+        l.open.clear();
+        for (uint32_t ty = 0; ty < tiles; ++ty) {
+            l.open.push_back(makeTile(level, tx, ty));
+        }
+    }
+
+    for (uint32_t ty = 0; ty < tiles; ++ty) {
+        SpectrogramTile& tile = *l.open[ty];
+        uint32_t first_row = ty * height;
+        uint32_t rows = std::min(height, l.rows - first_row);
+        for (uint32_t r = 0; r < rows; ++r) {
+            tile.pixels[static_cast<size_t>(r) * width + c] = column[first_row + r];
+        }
+        tile.valid_columns = c + 1;
+    }
+    ++l.columns;
+
+    if (c + 1 == width) {
+        for (uint32_t ty = 0; ty < tiles; ++ty) {
+            cache_.insert(SpectrogramTileCache::key(level, tx, ty), std::move(l.open[ty]));
+        }
+        l.open.clear();
+    }
+
+    // Max-pool 2 columns × 2 rows into the next level
+    if (level + 1 < config_.levels) {
+        Level& next = levels_[level + 1];
+        for (uint32_t r = 0; r < next.rows; ++r) {
+            uint8_t v = std::max(column[2 * r], column[2 * r + 1]);
+            next.pending[r] = std::max(next.pending[r], v);
+        }
+        if (++next.pending_count == 2) {
+            std::vector<uint8_t> pooled;
+            pooled.swap(next.pending);
+            next.pending.assign(next.rows, 0);
+            next.pending_count = 0;
+            addColumn(level + 1, pooled.data());
+        }
+    }
+}
+
+std::vector<std::shared_ptr<SpectrogramTile>> SpectrogramTileService::rebuild(uint32_t level, uint64_t tx) const {
+    const uint32_t width = config_.tile_width;
+    const uint32_t height = config_.tile_height;
+    const uint64_t frames = static_cast<uint64_t>(width) << level;
+    const uint64_t first_frame = tx * frames;
+    const size_t hop = config_.hop;
+    const size_t fft_size = config_.fft_size;
+
+    std::vector<std::shared_ptr<SpectrogramTile>> tiles;
+    for (uint32_t ty = 0; ty < tilesPerColumn(level); ++ty) {
+        tiles.push_back(makeTile(level, tx, ty));
+        tiles.back()->valid_columns = width;
+    }
+
+    // computeFrame() keeps its scratch per thread, so the live analyzer is shared
+    const size_t bins = stft_.binsPerFrame();
+    const size_t chunk_frames = 64;
+    std::vector<Sample> samples((chunk_frames - 1) * hop + fft_size);
+    std::vector<float> db(bins);
+
+    for (uint64_t f = 0; f < frames; f += chunk_frames) {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(chunk_frames, frames - f));
+        size_t need = (n - 1) * hop + fft_size;
+        size_t got = source_((first_frame + f) * hop, need, samples.data());
+        std::fill(samples.begin() + static_cast<std::ptrdiff_t>(std::min(got, need)), samples.end(), 0.0f);
+
+        for (size_t i = 0; i < n; ++i) {
+            stft_.computeFrame(samples.data() + i * hop, db.data());
+            const size_t col = static_cast<size_t>((f + i) >> level);
+            for (size_t k = 0; k < bins; ++k) {
+                const size_t row = k >> level;
+                uint8_t& pixel = tiles[row / height]->pixels[(row % height) * width + col];
+                pixel = std::max(pixel, quantize(db[k]));
+            }
+        }
+    }
+
+    return tiles;
+}
+
+SpectrogramTilePtr SpectrogramTileService::tile(uint32_t level, uint64_t tx, uint32_t ty) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (level >= config_.levels || ty >= tilesPerColumn(level)) {
+            return nullptr;
+        }
+
+        if (SpectrogramTilePtr cached = cache_.find(SpectrogramTileCache::key(level, tx, ty))) {
+            ++stats_.hits;
+            return cached;
+        }
+
+        const Level& l = levels_[level];
+        const uint64_t live_tx = l.columns / config_.tile_width;
+        if (tx == live_tx && !l.open.empty()) {
+            ++stats_.live_hits;
+            return std::make_shared<const SpectrogramTile>(*l.open[ty]);
+        }
+        if (tx >= live_tx) {
+            return nullptr;  // Not recorded yet
+        }
+        if (!source_) {
+            ++stats_.misses;
+            return nullptr;
+        }
+    }
+
+    // Rebuild without holding the lock so the live path is never stalled
+    std::vector<std::shared_ptr<SpectrogramTile>> tiles = rebuild(level, tx);
+    SpectrogramTilePtr result = tiles[ty];
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.rebuilt += tiles.size();
+    for (uint32_t i = 0; i < tiles.size(); ++i) {
+        cache_.insert(SpectrogramTileCache::key(level, tx, i), std::move(tiles[i]));
+    }
+    return result;
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
@@ -0,0 +1,192 @@
+/**
+ * Spectrogram Tile Pyramid for Harmonic IoT Protocol
+ *
+ * Serves live and historical spectrograms to dashboards as small 8-bit
+ * tiles instead of full FFT frames. Level 0 holds one STFT frame per
+ * column and one bin per row; each level above max-pools 2×2 cells of the
+ * level below, so a dashboard zoomed out over hours touches as few tiles
+ * as one zoomed in over seconds.
+ *
+ * The pyramid is built incrementally as frames are computed. Completed
+ * tiles go to an LRU cache; on a miss, tiles are rebuilt from the sample
+ * source (e.g. a CaptureReader) for just the requested time span.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_SPECTROGRAM_TILES_H
+#define HARMONIC_IOT_DSP_SPECTROGRAM_TILES_H
+
+#include "dsp/sample.h"
+#include "dsp/spectrogram.h"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * One quantized spectrogram tile
+ *
+ * pixels holds height rows of width columns; row 0 is the lowest
+ * frequency. A pixel p maps back to db_floor + p/255 · (db_ceiling - db_floor).
+ */
+struct SpectrogramTile {
+    uint32_t level = 0;
+    uint64_t tx = 0;              // Time tile index at this level
+    uint32_t ty = 0;              // Frequency tile index at this level
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t valid_columns = 0;   // < width only for the live edge tile
+    float db_floor = 0.0f;
+    float db_ceiling = 0.0f;
+    std::vector<uint8_t> pixels;
+};
+
+using SpectrogramTilePtr = std::shared_ptr<const SpectrogramTile>;
+
+/**
+ * Spectrogram pyramid parameters
+ */
+struct SpectrogramTileConfig {
+    size_t fft_size = 1024;
+    size_t hop = 512;
+    uint32_t tile_width = 256;     // STFT frames (columns) per tile at level 0
+    uint32_t tile_height = 256;    // Bins (rows) per tile at level 0
+    uint32_t levels = 8;
+    float db_floor = -120.0f;      // Maps to pixel 0
+    float db_ceiling = 0.0f;       // Maps to pixel 255
+    size_t cache_tiles = 1024;     // LRU capacity (tiles)
+};
+
+/**
+ * Cache effectiveness counters
+ */
+struct SpectrogramTileStats {
+    uint64_t hits = 0;         // Served from the LRU cache
+    uint64_t live_hits = 0;    // Served from the tile being built
+    uint64_t misses = 0;       // Not cached and not rebuildable
+    uint64_t rebuilt = 0;      // Tiles recomputed from the sample source
+    uint64_t evictions = 0;
+};
+
+/**
+ * LRU cache of completed tiles
+ *
+ * Not synchronized; SpectrogramTileService serializes access.
+ */
+class SpectrogramTileCache {
+public:
+    explicit SpectrogramTileCache(size_t capacity);
+
+    /** Look up a tile and mark it most recently used */
+    SpectrogramTilePtr find(uint64_t key);
+
+    /** Insert or replace a tile, evicting the least recently used */
+    void insert(uint64_t key, SpectrogramTilePtr tile);
+
+    size_t size() const { return map_.size(); }
+    uint64_t evictions() const { return evictions_; }
+
+    /** Pack (level, tx, ty) into a cache key */
+    static uint64_t key(uint32_t level, uint64_t tx, uint32_t ty);
+
+private:
+    using Entry = std::pair<uint64_t, SpectrogramTilePtr>;
+
+    size_t capacity_;
+    std::list<Entry> lru_;  // Front = most recently used
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> map_;
+    uint64_t evictions_ = 0;
+};
+
+/**
+ * Incremental spectrogram pyramid with tile cache
+ *
+ * pushSamples() is called by the DSP thread; tile() may be called
+ * concurrently from any number of dashboard threads.
+ */
+class SpectrogramTileService {
+public:
+    /**
+     * Reads count samples starting at sample index first into out and
+     * returns how many were available. Used to rebuild evicted tiles.
+     *
+     * Called from tile() on the dashboard threads without the service
+     * lock. It may run on several threads at once and while pushSamples()
+     * runs, so it must be thread-safe.
+     */
+    using SampleSource = std::function<size_t(uint64_t first, size_t count, Sample* out)>;
+
+    /**
+     * @param config Pyramid parameters
+     * @param source Optional sample source indexed from the first pushed sample
+     * @throws std::invalid_argument on inconsistent parameters
+     */
+    explicit SpectrogramTileService(const SpectrogramTileConfig& config, SampleSource source = {});
+
+    const SpectrogramTileConfig& config() const { return config_; }
+
+    /**
+     * Analyze new samples and extend the pyramid
+     */
+    void pushSamples(const Sample* samples, size_t count);
+
+    /**
+     * Add an externally computed frame of fft_size/2 dBFS values
+     */
+    void pushFrame(const float* db);
+
+    /**
+     * Fetch a tile
+     *
+     * @param level Pyramid level (0 = full resolution)
+     * @param tx Time tile index at that level
+     * @param ty Frequency tile index at that level
+     * @return The tile, or nullptr if it is in the future or cannot be rebuilt
+     */
+    SpectrogramTilePtr tile(uint32_t level, uint64_t tx, uint32_t ty);
+
+    /** Number of frequency tiles at a level */
+    uint32_t tilesPerColumn(uint32_t level) const;
+
+    /** STFT frames analyzed so far */
+    uint64_t frameCount() const;
+
+    SpectrogramTileStats stats() const;
+
+private:
+    struct Level {
+        uint32_t rows = 0;                 // Column height at this level
+        uint64_t columns = 0;              // Columns emitted so far
+        std::vector<uint8_t> pending;      // Max of up to 2 columns from the level below
+        uint32_t pending_count = 0;
+        std::vector<std::shared_ptr<SpectrogramTile>> open;  // Live tiles, one per ty
+    };
+
+    SpectrogramTileConfig config_;
+    SampleSource source_;
+    Spectrogram stft_;
+    std::vector<uint8_t> column_;
+
+    mutable std::mutex mutex_;
+    std::vector<Level> levels_;
+    SpectrogramTileCache cache_;
+    SpectrogramTileStats stats_;
+
+    uint8_t quantize(float db) const;
+    void addColumn(uint32_t level, const uint8_t* column);
+    std::shared_ptr<SpectrogramTile> makeTile(uint32_t level, uint64_t tx, uint32_t ty) const;
+    std::vector<std::shared_ptr<SpectrogramTile>> rebuild(uint32_t level, uint64_t tx) const;
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_SPECTROGRAM_TILES_H
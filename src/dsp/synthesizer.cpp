@@ -0,0 +1,102 @@
+/**
+ * Harmonic Signal Synthesis for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "synthesizer.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace dsp {
+
+namespace {
+
+constexpr double TWO_PI = 6.28318530717958647692;
+
+/** Samples between exact phase re-derivations */
+constexpr size_t OSCILLATOR_BLOCK = 256;
+
+/**
+ * Add amplitude · sin(step · (first + i) + phase) to out[0, n)
+ */
+template <typename T>
+void addRotatingTone(double step, double phase, double amplitude, T* out, size_t n, uint64_t first) {
+    const double rot_re = std::cos(step);
+    const double rot_im = std::sin(step);
+
+    for (size_t start = 0; start < n; start += OSCILLATOR_BLOCK) {
+        const size_t end = std::min(n, start + OSCILLATOR_BLOCK);
+        const double angle = std::fmod(step * static_cast<double>(first + start), TWO_PI) + phase;
+        double re = std::cos(angle);
+        double im = std::sin(angle);
+        for (size_t i = start; i < end; ++i) {
+            out[i] += static_cast<T>(amplitude) * static_cast<T>(im);
+            const double next_re = re * rot_re - im * rot_im;
+            im = re * rot_im + im * rot_re;
+            re = next_re;
+        }
+    }
+}
+
+template <typename T>
+void renderComposite(const ToneComponent* components, size_t count, double f0, double sample_rate,
+                     T* out, size_t n, uint64_t first_sample) {
+    if (sample_rate <= 0.0) {
+        throw std::invalid_argument("Sample rate must be positive");
+    }
+    std::fill(out, out + n, T(0));
+    for (size_t k = 0; k < count; ++k) {
+        const double frequency = f0 * components[k].ratio.value();
+        addRotatingTone(TWO_PI * frequency / sample_rate, components[k].phase, components[k].amplitude,
+                        out, n, first_sample);
+    }
+}
+
+} // namespace
+
+void addTone(double frequency, float amplitude, double phase, double sample_rate,
+             Sample* out, size_t n, uint64_t first_sample) {
+    if (sample_rate <= 0.0) {
+        throw std::invalid_argument("Sample rate must be positive");
+    }
+    addRotatingTone(TWO_PI * frequency / sample_rate, phase, amplitude, out, n, first_sample);
+}
+
+void synthesizeComposite(const ToneComponent* components, size_t count, double f0, double sample_rate,
+                         Sample* out, size_t n, uint64_t first_sample) {
+    renderComposite(components, count, f0, sample_rate, out, n, first_sample);
+}
+
+void synthesizeComposite(const ToneComponent* components, size_t count, double f0, double sample_rate,
+                         double* out, size_t n, uint64_t first_sample) {
+    renderComposite(components, count, f0, sample_rate, out, n, first_sample);
+}
+
+// ─── SymbolSynthesizer ───────────────────────────────────────────────────
+
+SymbolSynthesizer::SymbolSynthesizer(double sample_rate, size_t symbol_samples, double f0)
+    : sample_rate_(sample_rate), symbol_samples_(symbol_samples), f0_(f0) {
+    if (symbol_samples == 0) {
+        throw std::invalid_argument("Symbol slots need at least one sample");
+    }
+    if (sample_rate <= 0.0 || f0 <= 0.0) {
+        throw std::invalid_argument("Sample rate and f0 must be positive");
+    }
+}
+
+void SymbolSynthesizer::render(const int* harmonics, size_t count, Sample* out, float amplitude) const {
+    std::fill(out, out + samplesFor(count), Sample(0));
+    for (size_t s = 0; s < count; ++s) {
+        if (harmonics[s] != 0) {
+            const double step = TWO_PI * f0_ * harmonics[s] / sample_rate_;
+            addRotatingTone(step, 0.0, amplitude, out + s * symbol_samples_, symbol_samples_, 0);
+        }
+    }
+}
+
+} // namespace dsp
+} // namespace harmonic_iot
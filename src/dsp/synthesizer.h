@@ -0,0 +1,113 @@
+/**
+ * Harmonic Signal Synthesis for Harmonic IoT Protocol
+ *
+ * Native counterpart of hpg_core.signal_processing.generate_composite_signal
+ *
+ *   s(t) = Σ Aₖ sin(2π(aₖ/bₖ)f₀t + φₖ)
+ *
+ * and of the transmit side of the receive chain: one tone per symbol slot
+ * at the slot's harmonic number times f₀.
+ *
+ * Oscillators advance by complex rotation instead of calling sin() per
+ * sample; the phasor is re-derived from the exact phase at every block so
+ * rounding does not accumulate.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_DSP_SYNTHESIZER_H
+#define HARMONIC_IOT_DSP_SYNTHESIZER_H
+
+#include "dsp/harmonic_set.h"
+#include "dsp/sample.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace harmonic_iot {
+namespace dsp {
+
+/**
+ * One component of a composite signal (fields match generate_composite_signal)
+ */
+struct ToneComponent {
+    HarmonicRatio ratio;          ///< Frequency is f₀ · a/b
+    double amplitude = 1.0;
+    double phase = 0.0;           ///< Radians at t = 0
+};
+
+/**
+ * Render s(t) for samples [first_sample, first_sample + n)
+ *
+ * @param components Components to superpose
+ * @param count Number of components
+ * @param f0 Fundamental frequency in Hz
+ * @param sample_rate Sampling rate in Hz
+ * @param out n samples, overwritten
+ * @param n Number of samples
+ * @param first_sample Index of out[0] on the signal's time axis
+ */
+void synthesizeComposite(const ToneComponent* components, size_t count, double f0, double sample_rate,
+                         Sample* out, size_t n, uint64_t first_sample = 0);
+
+/**
+ * Double-precision synthesizeComposite, for offline analysis that compares
+ * against numpy (the Python backend, accuracy harnesses)
+ */
+void synthesizeComposite(const ToneComponent* components, size_t count, double f0, double sample_rate,
+                         double* out, size_t n, uint64_t first_sample = 0);
+
+/**
+ * Add amplitude · sin(2π · frequency · t + phase) to out
+ *
+ * @param frequency Tone frequency in Hz
+ * @param amplitude Peak amplitude
+ * @param phase Radians at t = 0
+ * @param sample_rate Sampling rate in Hz
+ * @param out n samples, accumulated into
+ * @param n Number of samples
+ * @param first_sample Index of out[0] on the signal's time axis
+ */
+void addTone(double frequency, float amplitude, double phase, double sample_rate,
+             Sample* out, size_t n, uint64_t first_sample = 0);
+
+/**
+ * Renders encoded frames as the receive chain expects them
+ *
+ * Immutable after construction and safe to share between threads.
+ */
+class SymbolSynthesizer {
+public:
+    /**
+     * @param sample_rate Sampling rate in Hz
+     * @param symbol_samples Samples per symbol slot
+     * @param f0 Fundamental frequency in Hz
+     * @throws std::invalid_argument if symbol_samples is 0 or the rates are not positive
+     */
+    SymbolSynthesizer(double sample_rate, size_t symbol_samples, double f0);
+
+    size_t symbolSamples() const { return symbol_samples_; }
+
+    /** Samples needed for a frame of the given number of symbols */
+    size_t samplesFor(size_t symbols) const { return symbols * symbol_samples_; }
+
+    /**
+     * Write samplesFor(count) samples, one slot per harmonic (0 = silence)
+     *
+     * @param harmonics Harmonic number of each slot
+     * @param count Number of slots
+     * @param out samplesFor(count) samples, overwritten
+     * @param amplitude Peak amplitude of each tone
+     */
+    void render(const int* harmonics, size_t count, Sample* out, float amplitude = 1.0f) const;
+
+private:
+    double sample_rate_;
+    size_t symbol_samples_;
+    double f0_;
+};
+
+} // namespace dsp
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_DSP_SYNTHESIZER_H
@@ -0,0 +1,129 @@
+/**
+ * Device Datagram Format for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "datagram.h"
+#include "gateway/device_registry.h"
+#include <cstring>
+
+namespace harmonic_iot {
+namespace gateway {
+
+namespace {
+
+constexpr uint8_t MAGIC_0 = 'H';
+constexpr uint8_t MAGIC_1 = 'I';
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+inline void put64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+inline uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t get64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+bool knownType(uint8_t type) {
+    return type == static_cast<uint8_t>(DatagramType::Reading) ||
+           type == static_cast<uint8_t>(DatagramType::Heartbeat);
+}
+
+} // namespace
+
+size_t encodeDatagram(const Datagram& datagram, uint8_t* out, size_t capacity) {
+    const size_t size = datagram.encodedSize();
+    if (datagram.device_id.empty() || datagram.device_id.size() > MAX_DEVICE_ID_LENGTH ||
+        datagram.token.size() > UINT16_MAX || datagram.payload_size > UINT16_MAX ||
+        size > MAX_DATAGRAM_BYTES || size > capacity) {
+        return 0;
+    }
+
+    out[0] = MAGIC_0;
+    out[1] = MAGIC_1;
+    out[2] = DATAGRAM_VERSION;
+    out[3] = static_cast<uint8_t>(datagram.type);
+    out[4] = datagram.channel;
+    out[5] = static_cast<uint8_t>(datagram.device_id.size());
+    put16(out + 6, static_cast<uint16_t>(datagram.token.size()));
+    put32(out + 8, datagram.sequence);
+    put64(out + 12, static_cast<uint64_t>(datagram.sent_ns));
+    put16(out + 20, static_cast<uint16_t>(datagram.payload_size));
+    put16(out + 22, 0);
+
+    uint8_t* p = out + DATAGRAM_HEADER_BYTES;
+    std::memcpy(p, datagram.device_id.data(), datagram.device_id.size());
+    p += datagram.device_id.size();
+    std::memcpy(p, datagram.token.data(), datagram.token.size());
+    p += datagram.token.size();
+    if (datagram.payload_size > 0) {
+        std::memcpy(p, datagram.payload, datagram.payload_size);
+    }
+    return size;
+}
+
+bool parseDatagram(const uint8_t* data, size_t size, Datagram& out) {
+    if (size < DATAGRAM_HEADER_BYTES || data[0] != MAGIC_0 || data[1] != MAGIC_1 ||
+        data[2] != DATAGRAM_VERSION || !knownType(data[3])) {
+        return false;
+    }
+    const size_t id_length = data[5];
+    const size_t token_length = get16(data + 6);
+    const size_t payload_length = get16(data + 20);
+    if (id_length == 0 || id_length > MAX_DEVICE_ID_LENGTH ||
+        DATAGRAM_HEADER_BYTES + id_length + token_length + payload_length != size) {
+        return false;
+    }
+
+    const char* text = reinterpret_cast<const char*>(data + DATAGRAM_HEADER_BYTES);
+    out.type = static_cast<DatagramType>(data[3]);
+    out.channel = data[4];
+    out.sequence = get32(data + 8);
+    out.sent_ns = static_cast<int64_t>(get64(data + 12));
+    out.device_id = std::string_view(text, id_length);
+    out.token = std::string_view(text + id_length, token_length);
+    out.payload = data + DATAGRAM_HEADER_BYTES + id_length + token_length;
+    out.payload_size = payload_length;
+    return true;
+}
+
+bool restampDatagram(uint8_t* data, size_t size, int64_t sent_ns) {
+    if (size < DATAGRAM_HEADER_BYTES || data[0] != MAGIC_0 || data[1] != MAGIC_1 || data[2] != DATAGRAM_VERSION) {
+        return false;
+    }
+    put64(data + 12, static_cast<uint64_t>(sent_ns));
+    return true;
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
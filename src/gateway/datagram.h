@@ -0,0 +1,94 @@
+/**
+ * Device Datagram Format for Harmonic IoT Protocol
+ *
+ * Compact binary uplink message a device sends to the native gateway over
+ * UDP: a fixed 24-byte little-endian header followed by the device ID,
+ * the device's bearer token (JWT) and the encoded reading (one harmonic
+ * number per byte, as produced by encodeMessage()).
+ *
+ *   0  'H' 'I'            magic
+ *   2  version            DATAGRAM_VERSION
+ *   3  type               DatagramType
+ *   4  channel            base harmonic of the device's channel
+ *   5  device ID length   1..MAX_DEVICE_ID_LENGTH
+ *   6  token length       u16
+ *   8  sequence           u32, per device, wraps
+ *  12  sent_ns            i64, sender's steady clock
+ *  20  payload length     u16
+ *  22  reserved           0
+ *  24  device ID, token, payload
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_GATEWAY_DATAGRAM_H
+#define HARMONIC_IOT_GATEWAY_DATAGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace harmonic_iot {
+namespace gateway {
+
+constexpr uint8_t DATAGRAM_VERSION = 1;
+constexpr size_t DATAGRAM_HEADER_BYTES = 24;
+
+/** Largest datagram that avoids IP fragmentation on a 1500-byte MTU */
+constexpr size_t MAX_DATAGRAM_BYTES = 1472;
+
+enum class DatagramType : uint8_t {
+    Reading = 1,      // Encoded sensor reading
+    Heartbeat = 2     // Liveness only, empty payload
+};
+
+/**
+ * Decoded view of one datagram; the views point into the receive buffer
+ */
+struct Datagram {
+    DatagramType type = DatagramType::Reading;
+    uint8_t channel = 0;
+    uint32_t sequence = 0;
+    int64_t sent_ns = 0;
+    std::string_view device_id;
+    std::string_view token;
+    const uint8_t* payload = nullptr;
+    size_t payload_size = 0;
+
+    size_t encodedSize() const {
+        return DATAGRAM_HEADER_BYTES + device_id.size() + token.size() + payload_size;
+    }
+};
+
+/**
+ * Serialize a datagram
+ *
+ * @param datagram Fields to write
+ * @param out Destination buffer
+ * @param capacity Bytes available at out
+ * @return Bytes written, or 0 if a field is out of range or out is too small
+ */
+size_t encodeDatagram(const Datagram& datagram, uint8_t* out, size_t capacity);
+
+/**
+ * Validate and decode a received datagram without copying
+ *
+ * @return False for anything malformed (bad magic, version, type or lengths)
+ */
+bool parseDatagram(const uint8_t* data, size_t size, Datagram& out);
+
+/**
+ * Overwrite the sender timestamp of an encoded datagram in place
+ *
+ * Used when replaying recorded traffic so transit latency is measured
+ * from the replay, not the original send.
+ *
+ * @return False if data does not start with a datagram header
+ */
+bool restampDatagram(uint8_t* data, size_t size, int64_t sent_ns);
+
+} // namespace gateway
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_GATEWAY_DATAGRAM_H
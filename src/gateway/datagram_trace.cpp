@@ -0,0 +1,209 @@
+/**
+ * Datagram Trace Files for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "datagram_trace.h"
+#include "gateway/datagram.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace gateway {
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = {'H', 'I', 'O', 'T', 'T', 'R', 'C', '\0'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+/** Two varints of at most 10 bytes each */
+constexpr size_t MAX_RECORD_OVERHEAD = 20;
+
+static_assert(sizeof(TraceHeader) == 32, "Trace header must be packed");
+
+inline size_t putVarint(uint8_t* p, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        p[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+/** @return false if the varint runs past end or exceeds 64 bits */
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ─── TraceWriter ─────────────────────────────────────────────────────────────
+
+TraceWriter::TraceWriter(const std::string& path, size_t buffer_bytes)
+    : path_(path), buffer_(std::max(buffer_bytes, MAX_DATAGRAM_BYTES + MAX_RECORD_OVERHEAD)) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to create " + path + ": " + std::strerror(errno));
+    }
+
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    writeAll(&header, sizeof(header));
+    bytes_ = sizeof(header);
+}
+
+TraceWriter::~TraceWriter() {
+    if (fd_ >= 0) {
+        try {
+            close();
+        } catch (...) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+}
+
+void TraceWriter::append(const uint8_t* data, size_t size, int64_t received_ns) {
+    if (fd_ < 0) {
+        throw std::logic_error("TraceWriter already closed");
+    }
+    if (buffer_.size() - fill_ < size + MAX_RECORD_OVERHEAD) {
+        flush();
+        if (buffer_.size() < size + MAX_RECORD_OVERHEAD) {
+            buffer_.resize(size + MAX_RECORD_OVERHEAD);
+        }
+    }
+
+    if (records_ == 0) {
+        start_ns_ = received_ns;
+        last_ns_ = received_ns;
+    }
+    const int64_t delta = std::max<int64_t>(0, received_ns - last_ns_);
+    last_ns_ += delta;
+
+    uint8_t* p = buffer_.data() + fill_;
+    p += putVarint(p, static_cast<uint64_t>(delta));
+    p += putVarint(p, size);
+    std::memcpy(p, data, size);
+    fill_ = static_cast<size_t>(p + size - buffer_.data());
+    ++records_;
+    ++buffered_records_;
+}
+
+void TraceWriter::flush() {
+    if (fd_ < 0 || buffered_records_ == 0) {
+        return;
+    }
+    writeAll(buffer_.data(), fill_);
+    bytes_ += fill_;
+    fill_ = 0;
+    buffered_records_ = 0;
+
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.start_time_ns = start_ns_;
+    header.record_count = records_;
+    writeAllAt(&header, sizeof(header), 0);
+}
+
+void TraceWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    flush();
+    const int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close " + path_ + ": " + std::strerror(errno));
+    }
+}
+
+void TraceWriter::writeAll(const void* data, size_t length) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t n = ::write(fd_, p, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write " + path_ + ": " + std::strerror(errno));
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+}
+
+void TraceWriter::writeAllAt(const void* data, size_t length, uint64_t offset) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t n = ::pwrite(fd_, p, length, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write " + path_ + ": " + std::strerror(errno));
+        }
+        p += n;
+        offset += static_cast<uint64_t>(n);
+        length -= static_cast<size_t>(n);
+    }
+}
+
+// ─── TraceReader ─────────────────────────────────────────────────────────────
+
+TraceReader::TraceReader(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(TraceHeader)) {
+        throw std::runtime_error("Truncated trace file: " + path);
+    }
+
+    TraceHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        throw std::runtime_error("Not a trace file: " + path);
+    }
+    if (header.version != TRACE_VERSION) {
+        throw std::runtime_error("Unsupported trace version in " + path);
+    }
+    start_time_ns_ = header.start_time_ns;
+
+    // Bytes past the last counted record are an unflushed tail and ignored
+    const size_t expected = static_cast<size_t>(
+        std::min<uint64_t>(header.record_count, (file_.size() - sizeof(TraceHeader)) / 2));
+    offsets_.reserve(expected);
+    positions_.reserve(expected);
+    sizes_.reserve(expected);
+
+    const uint8_t* p = file_.data() + sizeof(TraceHeader);
+    const uint8_t* end = file_.data() + file_.size();
+    int64_t offset = 0;
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+        uint64_t delta;
+        uint64_t size;
+        if (!getVarint(p, end, delta) || !getVarint(p, end, size) || size > UINT32_MAX ||
+            size > static_cast<uint64_t>(end - p)) {
+            truncated_ = true;
+            break;
+        }
+        offset += static_cast<int64_t>(delta);
+        offsets_.push_back(offset);
+        positions_.push_back(static_cast<size_t>(p - file_.data()));
+        sizes_.push_back(static_cast<uint32_t>(size));
+        p += size;
+    }
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
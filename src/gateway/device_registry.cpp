@@ -0,0 +1,410 @@
+/**
+ * Device Registry for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "device_registry.h"
+#include "runtime/cache_line.h"
+#include "telemetry/log.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace gateway {
+
+using runtime::cpuRelax;
+
+/**
+ * One table entry, laid out identically in memory and in snapshot files
+ *
+ * state is 0 (empty), SLOT_BUSY (being claimed) or the tagged key hash.
+ * The key is written once before state is published and never changes.
+ */
+struct alignas(64) DeviceRegistry::Slot {
+    std::atomic<uint64_t> state;
+    std::atomic<uint64_t> seq;            // Seqlock: odd while a writer is active
+    std::atomic<int64_t> last_seen_ms;    // Outside the seqlock, relaxed
+    std::atomic<uint64_t> freq_bits;      // IEEE 754 bits of fundamental_freq
+    std::atomic<uint64_t> channel_mask;
+    uint32_t id_length;
+    uint32_t reserved;
+    char id[MAX_DEVICE_ID_LENGTH];
+};
+
+namespace {
+
+constexpr uint64_t SLOT_BUSY = 1;
+constexpr size_t HEADER_BYTES = 4096;
+constexpr char SNAPSHOT_MAGIC[8] = {'H', 'I', 'O', 'T', 'R', 'E', 'G', '\0'};
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_size;
+    uint64_t capacity;
+    uint64_t count;
+    int64_t created_ms;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Registry needs lock-free 64-bit atomics");
+
+/**
+ * FNV-1a, tagged so a published slot never reads as empty or busy
+ */
+uint64_t hashId(const char* id, size_t length) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= static_cast<uint8_t>(id[i]);
+        h *= 1099511628211ull;
+    }
+    return h | (1ull << 63);
+}
+
+inline uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t tableSize(size_t capacity) {
+    size_t want = capacity + capacity / 3 + 1;
+    size_t size = 16;
+    while (size < want) {
+        size <<= 1;
+    }
+    return size;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+DeviceRegistry::DeviceRegistry(size_t capacity)
+    : capacity_(tableSize(capacity)), mask_(capacity_ - 1), max_devices_(capacity_ * 3 / 4) {
+    mapped_bytes_ = HEADER_BYTES + capacity_ * sizeof(Slot);
+    void* base = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error(std::string("Failed to allocate device registry: ") + std::strerror(errno));
+    }
+    // Anonymous pages are zero: every slot starts empty
+    slots_ = reinterpret_cast<Slot*>(static_cast<uint8_t*>(base) + HEADER_BYTES);
+}
+
+DeviceRegistry::DeviceRegistry(Slot* slots, size_t capacity, size_t mapped_bytes, size_t count)
+    : slots_(slots), capacity_(capacity), mask_(capacity - 1),
+      max_devices_(capacity * 3 / 4), mapped_bytes_(mapped_bytes), count_(count) {}
+
+DeviceRegistry::~DeviceRegistry() {
+    stopPeriodicSnapshots();
+    ::munmap(reinterpret_cast<uint8_t*>(slots_) - HEADER_BYTES, mapped_bytes_);
+}
+
+std::unique_ptr<DeviceRegistry> DeviceRegistry::restore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open snapshot " + path + ": " + std::strerror(errno));
+    }
+
+    SnapshotHeader header{};
+    struct stat st;
+    if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        ::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to read snapshot " + path);
+    }
+
+    const size_t bytes = HEADER_BYTES + header.capacity * sizeof(Slot);
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != SNAPSHOT_VERSION || header.slot_size != sizeof(Slot) ||
+        header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+        static_cast<size_t>(st.st_size) < bytes) {
+        ::close(fd);
+        throw std::runtime_error("Not a compatible registry snapshot: " + path);
+    }
+
+    // Private mapping: the table is usable immediately and writes never reach the file
+    void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Failed to map snapshot " + path + ": " + std::strerror(err));
+    }
+
+    Slot* slots = reinterpret_cast<Slot*>(static_cast<uint8_t*>(base) + HEADER_BYTES);
+    return std::unique_ptr<DeviceRegistry>(
+        new DeviceRegistry(slots, header.capacity, bytes, header.count));
+}
+
+bool DeviceRegistry::isReady(size_t index) const {
+    uint64_t state = slots_[index].state.load(std::memory_order_acquire);
+    return state != 0 && state != SLOT_BUSY;
+}
+
+void DeviceRegistry::writePayload(Slot& slot, const DeviceRecord& record) {
+    // Writers to the same entry serialize by moving seq from even to odd
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    for (;;) {
+        if (seq & 1) {
+            cpuRelax();
+            seq = slot.seq.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    slot.freq_bits.store(doubleBits(record.fundamental_freq), std::memory_order_relaxed);
+    slot.channel_mask.store(record.channel_mask, std::memory_order_relaxed);
+
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    // A record replayed from an older snapshot must not move last_seen back
+    int64_t seen = slot.last_seen_ms.load(std::memory_order_relaxed);
+    while (record.last_seen_ms > seen &&
+           !slot.last_seen_ms.compare_exchange_weak(seen, record.last_seen_ms, std::memory_order_relaxed)) {
+    }
+}
+
+DeviceRegistry::Handle DeviceRegistry::upsert(const DeviceRecord& record) {
+    const std::string& id = record.device_id;
+    if (id.empty() || id.size() > MAX_DEVICE_ID_LENGTH) {
+        throw std::invalid_argument("Device ID must be 1-128 characters");
+    }
+
+    const uint64_t tag = hashId(id.data(), id.size());
+    for (size_t probe = 0; probe < capacity_; ++probe) {
+        const size_t index = (tag + probe) & mask_;
+        Slot& slot = slots_[index];
+        uint64_t state = slot.state.load(std::memory_order_acquire);
+
+        if (state == 0) {
+            if (count_.load(std::memory_order_relaxed) >= max_devices_) {
+                throw std::length_error("Device registry is full");
+            }
+            uint64_t expected = 0;
+            if (slot.state.compare_exchange_strong(expected, SLOT_BUSY, std::memory_order_acq_rel)) {
+                slot.id_length = static_cast<uint32_t>(id.size());
+                std::memcpy(slot.id, id.data(), id.size());
+                writePayload(slot, record);
+                slot.state.store(tag, std::memory_order_release);
+                count_.fetch_add(1, std::memory_order_relaxed);
+                return index;
+            }
+            state = expected;
+        }
+
+        // Another thread is claiming this slot, possibly for the same ID
+        while (state == SLOT_BUSY) {
+            cpuRelax();
+            state = slot.state.load(std::memory_order_acquire);
+        }
+
+        if (state == tag && slot.id_length == id.size() &&
+            std::memcmp(slot.id, id.data(), id.size()) == 0) {
+            writePayload(slot, record);
+            return index;
+        }
+    }
+
+    throw std::length_error("Device registry is full");
+}
+
+DeviceRegistry::Handle DeviceRegistry::find(std::string_view device_id) const {
+    if (device_id.empty() || device_id.size() > MAX_DEVICE_ID_LENGTH) {
+        return NOT_FOUND;
+    }
+
+    const uint64_t tag = hashId(device_id.data(), device_id.size());
+    for (size_t probe = 0; probe < capacity_; ++probe) {
+        const size_t index = (tag + probe) & mask_;
+        const Slot& slot = slots_[index];
+        uint64_t state = slot.state.load(std::memory_order_acquire);
+
+        while (state == SLOT_BUSY) {
+            cpuRelax();
+            state = slot.state.load(std::memory_order_acquire);
+        }
+        if (state == 0) {
+            return NOT_FOUND;
+        }
+        if (state == tag && slot.id_length == device_id.size() &&
+            std::memcmp(slot.id, device_id.data(), device_id.size()) == 0) {
+            return index;
+        }
+    }
+    return NOT_FOUND;
+}
+
+DeviceRecord DeviceRegistry::read(Handle handle) const {
+    if (handle >= capacity_ || !isReady(handle)) {
+        throw std::out_of_range("Invalid device handle");
+    }
+
+    const Slot& slot = slots_[handle];
+    DeviceRecord record;
+    record.device_id.assign(slot.id, slot.id_length);
+
+    uint64_t before, after;
+    uint64_t freq_bits, channel_mask;
+    do {
+        before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            cpuRelax();
+            after = before + 1;
+            continue;
+        }
+        freq_bits = slot.freq_bits.load(std::memory_order_relaxed);
+        channel_mask = slot.channel_mask.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.seq.load(std::memory_order_relaxed);
+    } while (before != after);
+
+    record.fundamental_freq = bitsDouble(freq_bits);
+    record.channel_mask = channel_mask;
+    record.last_seen_ms = slot.last_seen_ms.load(std::memory_order_relaxed);
+    return record;
+}
+
+bool DeviceRegistry::get(const std::string& device_id, DeviceRecord& out) const {
+    Handle handle = find(device_id);
+    if (handle == NOT_FOUND) {
+        return false;
+    }
+    out = read(handle);
+    return true;
+}
+
+void DeviceRegistry::touch(Handle handle, int64_t now_ms) {
+    slots_[handle].last_seen_ms.store(now_ms, std::memory_order_relaxed);
+}
+
+int64_t DeviceRegistry::lastSeen(Handle handle) const {
+    return slots_[handle].last_seen_ms.load(std::memory_order_relaxed);
+}
+
+size_t DeviceRegistry::saveSnapshot(const std::string& path) const {
+    const std::string tmp = path + ".tmp";
+    const size_t bytes = HEADER_BYTES + capacity_ * sizeof(Slot);
+
+    int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create snapshot " + tmp + ": " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to size snapshot " + tmp + ": " + std::strerror(err));
+    }
+
+    void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to map snapshot " + tmp + ": " + std::strerror(err));
+    }
+
+    // ftruncate() zero-fills, so untouched slots are already empty
+    Slot* out = reinterpret_cast<Slot*>(static_cast<uint8_t*>(base) + HEADER_BYTES);
+    size_t written = 0;
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (!isReady(i)) {
+            continue;
+        }
+        DeviceRecord record = read(i);
+        Slot& slot = out[i];
+        slot.id_length = slots_[i].id_length;
+        std::memcpy(slot.id, slots_[i].id, slots_[i].id_length);
+        slot.freq_bits.store(doubleBits(record.fundamental_freq), std::memory_order_relaxed);
+        slot.channel_mask.store(record.channel_mask, std::memory_order_relaxed);
+        slot.last_seen_ms.store(record.last_seen_ms, std::memory_order_relaxed);
+        slot.state.store(slots_[i].state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        ++written;
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.slot_size = sizeof(Slot);
+    header.capacity = capacity_;
+    header.count = written;
+    header.created_ms = nowMs();
+    std::memcpy(base, &header, sizeof(header));
+
+    int rc = ::msync(base, bytes, MS_SYNC);
+    int err = errno;
+    ::munmap(base, bytes);
+    ::close(fd);
+    if (rc != 0) {
+        throw std::runtime_error("Failed to sync snapshot " + tmp + ": " + std::strerror(err));
+    }
+
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to publish snapshot " + path + ": " + std::strerror(errno));
+    }
+
+    // The rename is only durable once the directory entry is synced
+    const size_t slash = path.find_last_of('/');
+    const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int dir_fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        throw std::runtime_error("Failed to open snapshot directory " + dir + ": " + std::strerror(errno));
+    }
+    rc = ::fsync(dir_fd);
+    err = errno;
+    ::close(dir_fd);
+    if (rc != 0) {
+        throw std::runtime_error("Failed to sync snapshot directory " + dir + ": " + std::strerror(err));
+    }
+    return written;
+}
+
+void DeviceRegistry::startPeriodicSnapshots(const std::string& path, std::chrono::milliseconds interval) {
+    stopPeriodicSnapshots();
+    snapshot_stop_ = false;
+    snapshot_thread_ = std::thread([this, path, interval] {
+        std::unique_lock<std::mutex> lock(snapshot_mutex_);
+        while (!snapshot_cv_.wait_for(lock, interval, [this] { return snapshot_stop_; })) {
+            lock.unlock();
+            try {
+                saveSnapshot(path);
+            } catch (const std::exception& e) {
+                HIOT_LOG_ERROR("Registry snapshot failed: {}", e.what());
+            }
+            lock.lock();
+        }
+    });
+}
+
+void DeviceRegistry::stopPeriodicSnapshots() {
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        snapshot_stop_ = true;
+    }
+    snapshot_cv_.notify_all();
+    if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+    }
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
@@ -0,0 +1,190 @@
+/**
+ * Device Registry for Harmonic IoT Protocol
+ *
+ * Native, in-memory counterpart of the Prisma `Device` model (deviceId,
+ * fundamentalFreq, harmonicChannels, lastSeen), consulted on every
+ * received message without a database round trip.
+ *
+ * The table is an open-addressing hash map with linear probing. Each
+ * entry carries a seqlock, so readers never take a lock: they retry only
+ * if a writer updated that same entry mid-read. lastSeen lives outside the
+ * seqlock and is updated with a single relaxed atomic store.
+ *
+ * Snapshots copy the slot array into a file. Restoring maps that file
+ * MAP_PRIVATE and uses it as the table directly, so a warm restart with
+ * millions of devices is instant: pages fault in on first touch and are
+ * copied-on-write only when modified.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_GATEWAY_DEVICE_REGISTRY_H
+#define HARMONIC_IOT_GATEWAY_DEVICE_REGISTRY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace harmonic_iot {
+namespace gateway {
+
+/**
+ * Maximum device ID length, matching the server's registration schema
+ */
+constexpr size_t MAX_DEVICE_ID_LENGTH = 128;
+
+/**
+ * Consistent copy of one registry entry
+ */
+struct DeviceRecord {
+    std::string device_id;
+    double fundamental_freq = 1000.0;  // f₀ used by the device, Hz
+    uint64_t channel_mask = 0;         // Bit h set = harmonic channel H_h assigned (h < 64)
+    int64_t last_seen_ms = 0;          // Unix epoch milliseconds
+};
+
+/**
+ * Concurrent device table
+ *
+ * Entries are never removed; size the capacity for the fleet. Any number
+ * of threads may call any method concurrently.
+ */
+class DeviceRegistry {
+public:
+    /** Stable reference to an entry, valid for the registry's lifetime */
+    using Handle = uint64_t;
+    static constexpr Handle NOT_FOUND = UINT64_MAX;
+
+    /**
+     * Create an empty registry
+     *
+     * @param capacity Maximum number of devices; rounded up so the table
+     *        stays below 75% load
+     */
+    explicit DeviceRegistry(size_t capacity);
+
+    ~DeviceRegistry();
+
+    DeviceRegistry(const DeviceRegistry&) = delete;
+    DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+    /**
+     * Warm-restart from a snapshot written by saveSnapshot()
+     *
+     * The file is mapped copy-on-write and used as the table in place.
+     *
+     * @param path Snapshot file
+     * @throws std::runtime_error if the file is missing or not a snapshot
+     */
+    static std::unique_ptr<DeviceRegistry> restore(const std::string& path);
+
+    /**
+     * Insert or update a device
+     *
+     * last_seen_ms only moves forward: an update carrying an older time
+     * (e.g. replayed from a snapshot) keeps the newer one.
+     *
+     * @return Handle of the entry
+     * @throws std::invalid_argument if the ID is empty or too long
+     * @throws std::length_error if the registry is full
+     */
+    Handle upsert(const DeviceRecord& record);
+
+    /**
+     * Look up a device
+     *
+     * @return Handle, or NOT_FOUND
+     */
+    Handle find(std::string_view device_id) const;
+
+    /**
+     * Read a consistent copy of an entry (lock-free, retries on concurrent update)
+     */
+    DeviceRecord read(Handle handle) const;
+
+    /**
+     * Look up and read in one step
+     *
+     * @return True if the device exists
+     */
+    bool get(const std::string& device_id, DeviceRecord& out) const;
+
+    /**
+     * Record activity; a single relaxed store, safe from any thread
+     */
+    void touch(Handle handle, int64_t now_ms);
+
+    int64_t lastSeen(Handle handle) const;
+
+    /** Number of registered devices */
+    size_t size() const { return count_.load(std::memory_order_relaxed); }
+
+    /** Number of slots in the table */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * Write a snapshot of all entries
+     *
+     * Entries are copied one at a time under their seqlocks while the table
+     * stays live; the file is written to path + ".tmp", synced, and renamed
+     * over path so a crash never leaves a torn snapshot. The directory is
+     * synced after the rename so the published snapshot survives a crash.
+     *
+     * @return Number of devices written
+     */
+    size_t saveSnapshot(const std::string& path) const;
+
+    /**
+     * Start a background thread that snapshots every interval
+     */
+    void startPeriodicSnapshots(const std::string& path, std::chrono::milliseconds interval);
+
+    /**
+     * Stop periodic snapshots; waits for an in-flight snapshot
+     */
+    void stopPeriodicSnapshots();
+
+    /**
+     * Visit a consistent copy of every entry
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (isReady(i)) {
+                visit(static_cast<Handle>(i), read(i));
+            }
+        }
+    }
+
+private:
+    struct Slot;
+
+    DeviceRegistry(Slot* slots, size_t capacity, size_t mapped_bytes, size_t count);
+
+    Slot* slots_;
+    size_t capacity_;
+    size_t mask_;
+    size_t max_devices_;    // Load-factor limit
+    size_t mapped_bytes_;   // Bytes to munmap, including the snapshot header page
+    std::atomic<size_t> count_{0};
+
+    std::thread snapshot_thread_;
+    std::mutex snapshot_mutex_;
+    std::condition_variable snapshot_cv_;
+    bool snapshot_stop_ = false;
+
+    bool isReady(size_t index) const;
+    void writePayload(Slot& slot, const DeviceRecord& record);
+};
+
+} // namespace gateway
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_GATEWAY_DEVICE_REGISTRY_H
@@ -0,0 +1,86 @@
+/**
+ * Device Liveness Tracking for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "liveness_tracker.h"
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace gateway {
+
+LivenessTracker::LivenessTracker(DeviceRegistry& registry,
+                                 std::chrono::milliseconds timeout,
+                                 std::chrono::milliseconds tick,
+                                 int64_t now_ms)
+    : registry_(registry),
+      timeout_ms_(timeout.count()),
+      tick_ms_(tick.count()),
+      epoch_ms_(now_ms),
+      timers_(registry.capacity(), TimerWheel::INVALID_TIMER) {
+    if (tick_ms_ <= 0 || timeout_ms_ <= 0) {
+        throw std::invalid_argument("Liveness timeout and tick must be positive");
+    }
+
+    wheel_.setHandler(TimerKind::Liveness, [this](TimerId, uint64_t device) {
+        --online_;
+        if (on_offline_) {
+            on_offline_(device, registry_.lastSeen(device));
+        }
+    });
+}
+
+uint64_t LivenessTracker::toTick(int64_t ms) const {
+    if (ms <= epoch_ms_) {
+        return 0;
+    }
+    return static_cast<uint64_t>((ms - epoch_ms_ + tick_ms_ - 1) / tick_ms_);
+}
+
+void LivenessTracker::onFrame(DeviceRegistry::Handle device, int64_t now_ms) {
+    registry_.touch(device, now_ms);
+
+    TimerId& timer = timers_[device];
+    if (timer == TimerWheel::INVALID_TIMER) {
+        timer = wheel_.create(TimerKind::Liveness, device);
+    }
+    if (!wheel_.isArmed(timer)) {
+        ++online_;
+    }
+    wheel_.arm(timer, toTick(now_ms + timeout_ms_));
+}
+
+void LivenessTracker::forget(DeviceRegistry::Handle device) {
+    TimerId& timer = timers_[device];
+    if (timer == TimerWheel::INVALID_TIMER) {
+        return;
+    }
+    if (wheel_.isArmed(timer)) {
+        --online_;
+    }
+    wheel_.destroy(timer);
+    timer = TimerWheel::INVALID_TIMER;
+}
+
+size_t LivenessTracker::advance(int64_t now_ms) {
+    // Floor, so nothing fires before its deadline has fully elapsed
+    uint64_t tick = now_ms <= epoch_ms_ ? 0 : static_cast<uint64_t>((now_ms - epoch_ms_) / tick_ms_);
+    return wheel_.advance(tick);
+}
+
+bool LivenessTracker::isOnline(DeviceRegistry::Handle device) const {
+    TimerId timer = timers_[device];
+    return timer != TimerWheel::INVALID_TIMER && wheel_.isArmed(timer);
+}
+
+TimerId LivenessTracker::scheduleExpiry(TimerKind kind, uint64_t cookie, int64_t expires_at_ms) {
+    if (kind == TimerKind::Liveness) {
+        throw std::invalid_argument("Liveness timers are managed by onFrame()");
+    }
+    return wheel_.schedule(kind, cookie, toTick(expires_at_ms));
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
@@ -0,0 +1,104 @@
+/**
+ * Device Liveness Tracking for Harmonic IoT Protocol
+ *
+ * Couples the device registry with a timer wheel: every received frame
+ * updates lastSeen and pushes the device's liveness timer back in O(1);
+ * devices that stay silent for the timeout fire an offline callback. No
+ * periodic scan of the registry is needed.
+ *
+ * The wheel is exposed so the gateway can also schedule token-expiry and
+ * lease-expiry timers on the same tick.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_GATEWAY_LIVENESS_TRACKER_H
+#define HARMONIC_IOT_GATEWAY_LIVENESS_TRACKER_H
+
+#include "gateway/device_registry.h"
+#include "gateway/timer_wheel.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace harmonic_iot {
+namespace gateway {
+
+/**
+ * Offline detection for registered devices
+ *
+ * Not thread-safe; owned by the gateway's event loop. The registry itself
+ * may still be read concurrently by other threads.
+ */
+class LivenessTracker {
+public:
+    /** Receives the silent device and its last activity time */
+    using OfflineCallback = std::function<void(DeviceRegistry::Handle device, int64_t last_seen_ms)>;
+
+    /**
+     * @param registry Device table to update
+     * @param timeout Silence after which a device is reported offline
+     * @param tick Wheel resolution; expiry is reported within one tick
+     * @param now_ms Current time (Unix epoch milliseconds)
+     */
+    LivenessTracker(DeviceRegistry& registry,
+                    std::chrono::milliseconds timeout,
+                    std::chrono::milliseconds tick,
+                    int64_t now_ms);
+
+    void setOfflineCallback(OfflineCallback callback) { on_offline_ = std::move(callback); }
+
+    /**
+     * Record a frame from a device: touch lastSeen and re-arm its timer
+     */
+    void onFrame(DeviceRegistry::Handle device, int64_t now_ms);
+
+    /**
+     * Stop tracking a device (e.g. deregistration)
+     */
+    void forget(DeviceRegistry::Handle device);
+
+    /**
+     * Advance time and fire expired timers of every kind
+     *
+     * @return Timers fired
+     */
+    size_t advance(int64_t now_ms);
+
+    bool isOnline(DeviceRegistry::Handle device) const;
+
+    /** Devices with an armed liveness timer */
+    size_t onlineCount() const { return online_; }
+
+    /**
+     * Schedule a one-shot token or lease expiry on the shared wheel
+     *
+     * @param kind TimerKind::TokenExpiry, TimerKind::LeaseExpiry or Custom
+     * @param cookie Caller data passed to the kind's handler
+     * @param expires_at_ms Absolute expiry time (Unix epoch milliseconds)
+     */
+    TimerId scheduleExpiry(TimerKind kind, uint64_t cookie, int64_t expires_at_ms);
+
+    /** Shared wheel, for handlers of the other timer kinds */
+    TimerWheel& wheel() { return wheel_; }
+
+    /** Convert wall-clock milliseconds to wheel ticks (rounded up) */
+    uint64_t toTick(int64_t ms) const;
+
+private:
+    DeviceRegistry& registry_;
+    int64_t timeout_ms_;
+    int64_t tick_ms_;
+    int64_t epoch_ms_;                 // Wall-clock time of tick 0
+    TimerWheel wheel_;
+    std::vector<TimerId> timers_;      // Indexed by registry handle
+    size_t online_ = 0;
+    OfflineCallback on_offline_;
+};
+
+} // namespace gateway
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_GATEWAY_LIVENESS_TRACKER_H
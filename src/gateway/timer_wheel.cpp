@@ -0,0 +1,296 @@
+/**
+ * Hierarchical Timer Wheel for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "timer_wheel.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace gateway {
+
+TimerWheel::TimerWheel(uint64_t start_tick) : current_(start_tick) {
+    heads_.fill(NIL);
+    for (auto& level : occupied_) {
+        level.fill(0);
+    }
+}
+
+void TimerWheel::setHandler(TimerKind kind, Handler handler) {
+    handlers_[static_cast<size_t>(kind)] = std::move(handler);
+}
+
+TimerId TimerWheel::create(TimerKind kind, uint64_t cookie) {
+    uint32_t index;
+    if (free_head_ != NIL) {
+        index = free_head_;
+        free_head_ = nodes_[index].next;
+        --free_count_;
+    } else {
+        if (nodes_.size() >= NIL - 1) {
+            throw std::length_error("Timer wheel is full");
+        }
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back(Node{});
+        nodes_[index].generation = 0;
+    }
+
+    Node& node = nodes_[index];
+    node.deadline = 0;
+    node.cookie = cookie;
+    node.prev = node.next = NIL;
+    node.generation += 1;
+    node.list = NO_LIST;
+    node.kind = kind;
+    node.one_shot = false;
+
+    return (static_cast<uint64_t>(node.generation) << 32) | (static_cast<uint64_t>(index) + 1);
+}
+
+TimerId TimerWheel::schedule(TimerKind kind, uint64_t cookie, uint64_t deadline) {
+    TimerId id = create(kind, cookie);
+    nodes_[indexOf(id)].one_shot = true;
+    arm(id, deadline);
+    return id;
+}
+
+uint32_t TimerWheel::indexOf(TimerId id) const {
+    uint64_t low = id & 0xFFFFFFFFull;
+    if (low == 0 || low > nodes_.size()) {
+        return NIL;
+    }
+    uint32_t index = static_cast<uint32_t>(low - 1);
+    const Node& node = nodes_[index];
+    if (node.generation != static_cast<uint32_t>(id >> 32) || node.list == FREE_LIST) {
+        return NIL;
+    }
+    return index;
+}
+
+void TimerWheel::link(uint32_t index, uint16_t list) {
+    Node& node = nodes_[index];
+    node.list = list;
+    node.prev = NIL;
+    node.next = heads_[list];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[list] = index;
+
+    if (list < EXPIRING_LIST) {
+        unsigned level = list / SLOTS;
+        unsigned slot = list % SLOTS;
+        occupied_[level][slot / 64] |= 1ull << (slot % 64);
+    }
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.list] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+
+    if (node.list < EXPIRING_LIST && heads_[node.list] == NIL) {
+        unsigned level = node.list / SLOTS;
+        unsigned slot = node.list % SLOTS;
+        occupied_[level][slot / 64] &= ~(1ull << (slot % 64));
+    }
+
+    node.prev = node.next = NIL;
+    node.list = NO_LIST;
+}
+
+void TimerWheel::place(uint32_t index, uint64_t earliest) {
+    Node& node = nodes_[index];
+    uint64_t due = std::max(node.deadline, earliest);
+    uint64_t delta = due - current_;
+
+    unsigned level = 0;
+    while (level < LEVELS && delta >= (1ull << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    if (level == LEVELS) {
+        // Beyond the wheel's horizon: park in the top level and re-place later
+        level = LEVELS - 1;
+        due = current_ + (1ull << (SLOT_BITS * LEVELS)) - 1;
+    }
+
+    unsigned slot = static_cast<unsigned>((due >> (SLOT_BITS * level)) & (SLOTS - 1));
+    link(index, static_cast<uint16_t>(level * SLOTS + slot));
+}
+
+void TimerWheel::arm(TimerId id, uint64_t deadline) {
+    uint32_t index = indexOf(id);
+    if (index == NIL) {
+        throw std::invalid_argument("Stale or invalid timer");
+    }
+
+    Node& node = nodes_[index];
+    if (node.list != NO_LIST) {
+        unlink(index);
+    } else {
+        ++armed_;
+    }
+    node.deadline = deadline;
+    place(index, current_ + 1);
+}
+
+void TimerWheel::disarm(TimerId id) {
+    uint32_t index = indexOf(id);
+    if (index == NIL || nodes_[index].list == NO_LIST) {
+        return;
+    }
+    unlink(index);
+    --armed_;
+}
+
+void TimerWheel::destroy(TimerId id) {
+    uint32_t index = indexOf(id);
+    if (index == NIL) {
+        return;
+    }
+    if (nodes_[index].list != NO_LIST) {
+        unlink(index);
+        --armed_;
+    }
+    release(index);
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.list = FREE_LIST;  // indexOf() rejects free nodes
+    node.next = free_head_;
+    free_head_ = index;
+    ++free_count_;
+}
+
+bool TimerWheel::isArmed(TimerId id) const {
+    uint32_t index = indexOf(id);
+    return index != NIL && nodes_[index].list != NO_LIST;
+}
+
+bool TimerWheel::nextOccupied(unsigned level, unsigned from, unsigned& slot) const {
+    for (unsigned word = from / 64; word < SLOTS / 64; ++word) {
+        uint64_t bits = occupied_[level][word];
+        if (word == from / 64) {
+            bits &= ~0ull << (from % 64);
+        }
+        if (bits != 0) {
+            slot = word * 64 + static_cast<unsigned>(__builtin_ctzll(bits));
+            return true;
+        }
+    }
+    return false;
+}
+
+void TimerWheel::cascade(unsigned level, unsigned slot) {
+    uint16_t list = static_cast<uint16_t>(level * SLOTS + slot);
+    uint32_t index = heads_[list];
+    while (index != NIL) {
+        uint32_t next = nodes_[index].next;
+        unlink(index);
+        place(index, current_);
+        index = next;
+    }
+}
+
+uint64_t TimerWheel::nextDue() const {
+    uint64_t due = UINT64_MAX;
+
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        const unsigned shift = SLOT_BITS * level;
+        const uint64_t rotation_span = 1ull << (shift + SLOT_BITS);
+        const uint64_t rotation = current_ & ~(rotation_span - 1);
+        const unsigned index = static_cast<unsigned>((current_ >> shift) & (SLOTS - 1));
+
+        // A slot is reached when time enters it: later in this rotation, or in the next one
+        unsigned slot;
+        uint64_t tick;
+        if (index + 1 < SLOTS && nextOccupied(level, index + 1, slot)) {
+            tick = rotation + (static_cast<uint64_t>(slot) << shift);
+        } else if (nextOccupied(level, 0, slot)) {
+            tick = rotation + rotation_span + (static_cast<uint64_t>(slot) << shift);
+        } else {
+            continue;
+        }
+        due = std::min(due, tick);
+    }
+
+    return due;
+}
+
+size_t TimerWheel::advance(uint64_t now) {
+    size_t fired = 0;
+
+    while (current_ < now) {
+        const uint64_t next = current_ + 1;
+        current_ = next;
+
+        // Crossing a rotation boundary: pull the due slot of each upper level down
+        if ((next & (SLOTS - 1)) == 0) {
+            for (unsigned level = LEVELS - 1; level >= 1; --level) {
+                uint64_t span = 1ull << (SLOT_BITS * level);
+                if ((next & (span - 1)) == 0) {
+                    cascade(level, static_cast<unsigned>((next >> (SLOT_BITS * level)) & (SLOTS - 1)));
+                }
+            }
+        }
+
+        const unsigned slot = static_cast<unsigned>(next & (SLOTS - 1));
+
+        if (heads_[slot] != NIL) {
+            // Detach the slot so handlers can freely re-arm or cancel timers
+            uint32_t index = heads_[slot];
+            while (index != NIL) {
+                uint32_t following = nodes_[index].next;
+                unlink(index);
+                link(index, EXPIRING_LIST);
+                index = following;
+            }
+
+            while (heads_[EXPIRING_LIST] != NIL) {
+                index = heads_[EXPIRING_LIST];
+                Node& node = nodes_[index];
+                unlink(index);
+
+                if (node.deadline > current_) {
+                    place(index, current_ + 1);
+                    continue;
+                }
+
+                --armed_;
+                ++fired;
+                const TimerId id = (static_cast<uint64_t>(node.generation) << 32) | (static_cast<uint64_t>(index) + 1);
+                const uint64_t cookie = node.cookie;
+                const TimerKind kind = node.kind;
+                if (node.one_shot) {
+                    release(index);
+                }
+
+                const Handler& handler = handlers_[static_cast<size_t>(kind)];
+                if (handler) {
+                    handler(id, cookie);
+                }
+            }
+        }
+
+        // Jump straight to the tick before the next slot that holds timers
+        const uint64_t due = nextDue();
+        if (due > current_ + 1) {
+            current_ = std::min(now, due - 1);
+        }
+    }
+
+    return fired;
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
@@ -0,0 +1,163 @@
+/**
+ * Hierarchical Timer Wheel for Harmonic IoT Protocol
+ *
+ * Hashed hierarchical timing wheel (Varghese & Lauck) for device liveness,
+ * token expiry and lease expiry. Arming, re-arming and cancelling are
+ * O(1) list operations, so a device's liveness timer can be pushed back on
+ * every received frame, and offline detection no longer scans the
+ * registry.
+ *
+ * Four levels of 256 slots cover 2³² ticks; later deadlines are parked in
+ * the top level and re-placed as time advances. Per-level occupancy
+ * bitmaps let advance() jump over empty slots, so idle ticks cost nothing.
+ *
+ * Not thread-safe: a wheel belongs to one event-loop thread.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_GATEWAY_TIMER_WHEEL_H
+#define HARMONIC_IOT_GATEWAY_TIMER_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace harmonic_iot {
+namespace gateway {
+
+/**
+ * Timer categories; each kind has its own expiry handler
+ */
+enum class TimerKind : uint8_t {
+    Liveness = 0,     // Device silent for longer than its timeout
+    TokenExpiry = 1,  // JWT access/refresh token lifetime
+    LeaseExpiry = 2,  // Channel or address lease
+    Custom = 3
+};
+
+constexpr size_t TIMER_KIND_COUNT = 4;
+
+/**
+ * Opaque timer handle; stale handles (destroyed timers) are detected
+ */
+using TimerId = uint64_t;
+
+/**
+ * Hierarchical timing wheel over integer ticks
+ */
+class TimerWheel {
+public:
+    /** Receives the timer and the cookie given when it was created */
+    using Handler = std::function<void(TimerId id, uint64_t cookie)>;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    /**
+     * @param start_tick Current time in ticks
+     */
+    explicit TimerWheel(uint64_t start_tick = 0);
+
+    /**
+     * Install the expiry handler for a timer kind
+     */
+    void setHandler(TimerKind kind, Handler handler);
+
+    /**
+     * Allocate a disarmed, reusable timer
+     *
+     * @param kind Handler to invoke on expiry
+     * @param cookie Caller data passed to the handler (e.g. a registry handle)
+     */
+    TimerId create(TimerKind kind, uint64_t cookie);
+
+    /**
+     * Allocate and arm a timer that is destroyed after it fires
+     */
+    TimerId schedule(TimerKind kind, uint64_t cookie, uint64_t deadline);
+
+    /**
+     * Arm or re-arm a timer, O(1)
+     *
+     * @param deadline Absolute tick; past deadlines fire on the next tick
+     * @throws std::invalid_argument for a stale or invalid timer
+     */
+    void arm(TimerId id, uint64_t deadline);
+
+    /** Stop a timer without releasing it; no-op if not armed */
+    void disarm(TimerId id);
+
+    /** Release a timer; its handle becomes stale */
+    void destroy(TimerId id);
+
+    bool isArmed(TimerId id) const;
+
+    /**
+     * Advance time, firing every timer with deadline ≤ now
+     *
+     * Handlers may arm, disarm or destroy any timer, including their own.
+     *
+     * @return Number of timers fired
+     */
+    size_t advance(uint64_t now);
+
+    uint64_t now() const { return current_; }
+
+    /** Timers currently armed */
+    size_t armedCount() const { return armed_; }
+
+    /** Timers allocated (armed or not) */
+    size_t timerCount() const { return nodes_.size() - free_count_; }
+
+    /**
+     * Earliest tick at which advance() has work to do (fire or cascade)
+     *
+     * A lower bound on the next expiry, so an event loop can sleep until
+     * then instead of ticking; UINT64_MAX when nothing is armed.
+     */
+    uint64_t nextDue() const;
+
+private:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr uint16_t NO_LIST = UINT16_MAX;
+    static constexpr uint16_t EXPIRING_LIST = LEVELS * SLOTS;
+    static constexpr uint16_t FREE_LIST = UINT16_MAX - 1;
+
+    struct Node {
+        uint64_t deadline;
+        uint64_t cookie;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t generation;
+        uint16_t list;      // Slot list index, EXPIRING_LIST, NO_LIST or FREE_LIST
+        TimerKind kind;
+        bool one_shot;
+    };
+
+    uint64_t current_;
+    std::vector<Node> nodes_;
+    uint32_t free_head_ = NIL;      // Free nodes chained through next
+    size_t free_count_ = 0;
+    size_t armed_ = 0;
+    std::array<uint32_t, LEVELS * SLOTS + 1> heads_;
+    std::array<std::array<uint64_t, SLOTS / 64>, LEVELS> occupied_;
+    std::array<Handler, TIMER_KIND_COUNT> handlers_;
+
+    uint32_t indexOf(TimerId id) const;
+    void link(uint32_t index, uint16_t list);
+    void unlink(uint32_t index);
+    void place(uint32_t index, uint64_t earliest);
+    void cascade(unsigned level, unsigned slot);
+    bool nextOccupied(unsigned level, unsigned from, unsigned& slot) const;
+    void release(uint32_t index);
+};
+
+} // namespace gateway
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_GATEWAY_TIMER_WHEEL_H
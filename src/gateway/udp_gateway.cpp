@@ -0,0 +1,405 @@
+/**
+ * Native UDP Gateway for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "udp_gateway.h"
+#include "protocol/codec.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace gateway {
+
+namespace {
+
+/** Bounded so liveness keeps ticking under sustained load */
+constexpr size_t MAX_BATCHES_PER_POLL = 16;
+
+/** SO_RXQ_OVFL counter and SO_TIMESTAMPNS arrival time */
+constexpr size_t CONTROL_BYTES = CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(timespec));
+
+/** header.payload.signature with no empty part */
+bool plausibleJwt(std::string_view token) {
+    const size_t first = token.find('.');
+    if (first == 0 || first == std::string_view::npos) {
+        return false;
+    }
+    const size_t second = token.find('.', first + 1);
+    return second != std::string_view::npos && second > first + 1 && second + 1 < token.size() &&
+           token.find('.', second + 1) == std::string_view::npos;
+}
+
+/** Every slot is silence or a harmonic of the datagram's channel */
+bool symbolsInChannel(const Datagram& datagram) {
+    const int base = datagram.channel;
+    for (size_t i = 0; i < datagram.payload_size; ++i) {
+        const int symbol = datagram.payload[i];
+        if (symbol != 0 && (symbol < base || symbol > base + HarmonicProtocol::MAX_SYMBOL_OFFSET)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t channelBit(uint8_t channel) {
+    return channel < 64 ? (uint64_t(1) << channel) : 0;
+}
+
+} // namespace
+
+struct UdpGateway::Counters {
+    std::atomic<uint64_t> datagrams{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> malformed{0};
+    std::atomic<uint64_t> unauthorized{0};
+    std::atomic<uint64_t> registered{0};
+    std::atomic<uint64_t> sequence_gaps{0};
+    std::atomic<uint64_t> stale{0};
+    std::atomic<uint64_t> shed{0};
+    std::atomic<uint64_t> offline{0};
+    std::atomic<uint64_t> batches{0};
+
+    // Exported counters; null without a registry
+    telemetry::Counter* accepted_total = nullptr;
+    telemetry::Counter* malformed_total = nullptr;
+    telemetry::Counter* unauthorized_total = nullptr;
+    telemetry::Counter* stale_total = nullptr;
+    telemetry::Counter* shed_total = nullptr;
+    telemetry::Counter* shed_registry_total = nullptr;
+    telemetry::Counter* registrations_total = nullptr;
+
+    /** Single writer (the loop thread): a relaxed load/store pair is enough */
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void bump(std::atomic<uint64_t>& counter, telemetry::Counter* exported, uint64_t n = 1) {
+        bump(counter, n);
+        if (exported) {
+            exported->inc(n);
+        }
+    }
+};
+
+struct UdpGateway::ReceiveBatch {
+    std::vector<void*> blocks;         // One slab-pool buffer per slot
+    std::vector<mmsghdr> messages;
+    std::vector<iovec> vectors;
+    std::vector<char> control;         // Ancillary data per slot
+
+    /** Restore the lengths recvmmsg overwrote */
+    void rearm() {
+        for (size_t i = 0; i < messages.size(); ++i) {
+            vectors[i] = {blocks[i], MAX_DATAGRAM_BYTES};
+            messages[i].msg_hdr = msghdr{};
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_control = control.data() + i * CONTROL_BYTES;
+            messages[i].msg_hdr.msg_controllen = CONTROL_BYTES;
+            messages[i].msg_len = 0;
+        }
+    }
+};
+
+UdpGateway::UdpGateway(const UdpGatewayConfig& config, DeviceRegistry& registry)
+    : config_(config),
+      registry_(registry),
+      clock_(config.clock ? *config.clock : runtime::Clock::system()),
+      buffers_(MAX_DATAGRAM_BYTES, std::max<size_t>(config.batch, 1)),
+      receive_(new ReceiveBatch()),
+      devices_(registry.capacity()),
+      counters_(new Counters()) {
+    if (config_.batch == 0) {
+        throw std::invalid_argument("Gateway batch must be at least one datagram");
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1) {
+        throw std::runtime_error("Invalid gateway bind address: " + config_.bind_address);
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        throw std::runtime_error(std::string("Failed to create gateway socket: ") + std::strerror(errno));
+    }
+    int one = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &config_.receive_buffer_bytes, sizeof(config_.receive_buffer_bytes));
+#ifdef SO_RXQ_OVFL
+    ::setsockopt(fd_, SOL_SOCKET, SO_RXQ_OVFL, &one, sizeof(one));
+#endif
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        const int error = errno;
+        ::close(fd_);
+        throw std::runtime_error("Failed to bind gateway to " + config_.bind_address + ":" +
+                                 std::to_string(config_.port) + ": " + std::strerror(error));
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    receive_->messages.resize(config_.batch);
+    receive_->vectors.resize(config_.batch);
+    receive_->control.resize(config_.batch * CONTROL_BYTES);
+    for (size_t i = 0; i < config_.batch; ++i) {
+        receive_->blocks.push_back(buffers_.allocate());
+    }
+
+    if (config_.liveness_timeout.count() > 0) {
+        liveness_.reset(new LivenessTracker(registry_, config_.liveness_timeout, config_.liveness_tick, clock_.wallMs()));
+        liveness_->setOfflineCallback([this](DeviceRegistry::Handle, int64_t) {
+            Counters::bump(counters_->offline);
+        });
+    }
+    if (config_.metrics) {
+        registerMetrics(*config_.metrics);
+    }
+}
+
+UdpGateway::~UdpGateway() {
+    stop();
+    for (void* block : receive_->blocks) {
+        buffers_.deallocate(block);
+    }
+    ::close(fd_);
+}
+
+void UdpGateway::registerMetrics(telemetry::MetricsRegistry& registry) {
+    auto result = [&](const char* value) {
+        return &registry.counter("harmonic_gateway_datagrams_total", "Device datagrams received, by result",
+                                 {{"gateway", config_.name}, {"result", value}});
+    };
+    counters_->accepted_total = result("accepted");
+    counters_->malformed_total = result("malformed");
+    counters_->unauthorized_total = result("unauthorized");
+    counters_->stale_total = result("stale");
+    counters_->shed_total = &registry.counter("harmonic_gateway_shed_total", "Datagrams dropped under load",
+                                              {{"gateway", config_.name}, {"reason", "socket_overflow"}});
+    counters_->shed_registry_total = &registry.counter("harmonic_gateway_shed_total", "Datagrams dropped under load",
+                                                       {{"gateway", config_.name}, {"reason", "registry_full"}});
+    counters_->registrations_total = &registry.counter("harmonic_gateway_registrations_total",
+                                                       "Devices registered on first contact",
+                                                       {{"gateway", config_.name}});
+}
+
+void UdpGateway::setOfflineCallback(LivenessTracker::OfflineCallback callback) {
+    if (!liveness_) {
+        throw std::logic_error("Offline callbacks need a liveness timeout");
+    }
+    liveness_->setOfflineCallback([this, callback](DeviceRegistry::Handle device, int64_t last_seen_ms) {
+        Counters::bump(counters_->offline);
+        callback(device, last_seen_ms);
+    });
+}
+
+void UdpGateway::setDatagramTap(DatagramTap tap) {
+    const int one = 1;
+    if (tap && ::setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one)) != 0) {
+        throw std::runtime_error(std::string("Failed to enable receive timestamps: ") + std::strerror(errno));
+    }
+    tap_ = std::move(tap);
+}
+
+void UdpGateway::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    const int timeout_ms = static_cast<int>(std::max<int64_t>(1, config_.liveness_tick.count()));
+    thread_ = std::thread([this, timeout_ms] {
+        while (running_.load(std::memory_order_relaxed)) {
+            poll(timeout_ms);
+        }
+    });
+}
+
+void UdpGateway::stop() {
+    if (running_.exchange(false) && thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+size_t UdpGateway::poll(int timeout_ms) {
+    pollfd ready{fd_, POLLIN, 0};
+    const int events = ::poll(&ready, 1, timeout_ms);
+
+    size_t processed = 0;
+    if (events > 0) {
+        ReceiveBatch& r = *receive_;
+        const size_t batch = config_.batch;
+        for (size_t round = 0; round < MAX_BATCHES_PER_POLL; ++round) {
+            r.rearm();
+            const int received = ::recvmmsg(fd_, r.messages.data(), static_cast<unsigned>(batch), MSG_DONTWAIT,
+                                            nullptr);
+            if (received <= 0) {
+                break;
+            }
+            Counters::bump(counters_->batches);
+
+            const int64_t now_ms = clock_.wallMs();
+            const int64_t now_ns = clock_.monotonicNs();
+            const int64_t batch_wall_ns = tap_ ? clock_.wallNs() : 0;
+            for (int i = 0; i < received; ++i) {
+                msghdr& header = r.messages[i].msg_hdr;
+                int64_t received_ns = batch_wall_ns;
+                for (cmsghdr* c = CMSG_FIRSTHDR(&header); c != nullptr; c = CMSG_NXTHDR(&header, c)) {
+                    if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS) {
+                        timespec arrival;
+                        std::memcpy(&arrival, CMSG_DATA(c), sizeof(arrival));
+                        received_ns = static_cast<int64_t>(arrival.tv_sec) * 1000000000 + arrival.tv_nsec;
+                    }
+#ifdef SO_RXQ_OVFL
+                    if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+                        uint32_t dropped;
+                        std::memcpy(&dropped, CMSG_DATA(c), sizeof(dropped));
+                        if (dropped != last_overflow_) {
+                            Counters::bump(counters_->shed, counters_->shed_total, dropped - last_overflow_);
+                            last_overflow_ = dropped;
+                        }
+                    }
+#endif
+                }
+                const uint8_t* data = static_cast<const uint8_t*>(r.blocks[i]);
+                if (tap_) {
+                    tap_(data, r.messages[i].msg_len, received_ns);
+                }
+                handle(data, r.messages[i].msg_len, now_ms, now_ns);
+            }
+            processed += static_cast<size_t>(received);
+            if (static_cast<size_t>(received) < batch) {
+                break;
+            }
+        }
+    }
+
+    advanceTimers();
+    return processed;
+}
+
+void UdpGateway::deliver(const uint8_t* data, size_t size) {
+    if (tap_) {
+        tap_(data, size, clock_.wallNs());
+    }
+    handle(data, size, clock_.wallMs(), clock_.monotonicNs());
+}
+
+size_t UdpGateway::advanceTimers() {
+    return liveness_ ? liveness_->advance(clock_.wallMs()) : 0;
+}
+
+void UdpGateway::handle(const uint8_t* data, size_t size, int64_t now_ms, int64_t now_ns) {
+    Counters& c = *counters_;
+    Counters::bump(c.datagrams);
+    Counters::bump(c.bytes, size);
+
+    Datagram datagram;
+    if (!parseDatagram(data, size, datagram) || !symbolsInChannel(datagram) ||
+        (datagram.type == DatagramType::Heartbeat && datagram.payload_size != 0)) {
+        Counters::bump(c.malformed, c.malformed_total);
+        return;
+    }
+    if (config_.require_token && !plausibleJwt(datagram.token)) {
+        Counters::bump(c.unauthorized, c.unauthorized_total);
+        return;
+    }
+    DeviceRegistry::Handle device = DeviceRegistry::NOT_FOUND;
+    switch (resolve(datagram, now_ms, device)) {
+        case Admission::Device:
+            break;
+        case Admission::Unauthorized:
+            Counters::bump(c.unauthorized, c.unauthorized_total);
+            return;
+        case Admission::RegistryFull:
+            Counters::bump(c.shed, c.shed_registry_total);
+            return;
+    }
+
+    // Sequence numbers wrap; compare as a signed distance
+    DeviceState& state = devices_[device];
+    if (state.seen) {
+        const int32_t distance = static_cast<int32_t>(datagram.sequence - state.expected_sequence);
+        if (distance < 0) {
+            Counters::bump(c.stale, c.stale_total);
+            return;
+        }
+        if (distance > 0) {
+            Counters::bump(c.sequence_gaps, static_cast<uint64_t>(distance));
+        }
+    }
+    state.seen = true;
+    state.expected_sequence = datagram.sequence + 1;
+
+    if (liveness_) {
+        liveness_->onFrame(device, now_ms);
+    } else {
+        registry_.touch(device, now_ms);
+    }
+    if (datagram.sent_ns > 0 && datagram.sent_ns <= now_ns) {
+        transit_.record(static_cast<uint64_t>(now_ns - datagram.sent_ns));
+    }
+    Counters::bump(c.accepted, c.accepted_total);
+    if (on_frame_) {
+        on_frame_(datagram, device);
+    }
+}
+
+UdpGateway::Admission UdpGateway::resolve(const Datagram& datagram, int64_t now_ms,
+                                          DeviceRegistry::Handle& device) {
+    device = registry_.find(datagram.device_id);
+    if (device == DeviceRegistry::NOT_FOUND) {
+        if (!config_.auto_register) {
+            return Admission::Unauthorized;
+        }
+        if (registry_.size() >= registry_.capacity() * 3 / 4) {
+            return Admission::RegistryFull;
+        }
+        DeviceRecord record;
+        record.device_id.assign(datagram.device_id.data(), datagram.device_id.size());
+        record.fundamental_freq = HarmonicProtocol::FUNDAMENTAL_FREQUENCY;
+        record.channel_mask = channelBit(datagram.channel);
+        record.last_seen_ms = now_ms;
+        device = registry_.upsert(record);
+        Counters::bump(counters_->registered, counters_->registrations_total);
+    }
+
+    // The channel assignment is read from the registry once per device
+    DeviceState& state = devices_[device];
+    if (!state.resolved) {
+        state.channel_mask = registry_.read(device).channel_mask;
+        state.resolved = true;
+    }
+    return (state.channel_mask & channelBit(datagram.channel)) != 0 ? Admission::Device : Admission::Unauthorized;
+}
+
+GatewayStats UdpGateway::stats() const {
+    const Counters& c = *counters_;
+    GatewayStats stats;
+    stats.datagrams = c.datagrams.load(std::memory_order_relaxed);
+    stats.bytes = c.bytes.load(std::memory_order_relaxed);
+    stats.accepted = c.accepted.load(std::memory_order_relaxed);
+    stats.malformed = c.malformed.load(std::memory_order_relaxed);
+    stats.unauthorized = c.unauthorized.load(std::memory_order_relaxed);
+    stats.registered = c.registered.load(std::memory_order_relaxed);
+    stats.sequence_gaps = c.sequence_gaps.load(std::memory_order_relaxed);
+    stats.stale = c.stale.load(std::memory_order_relaxed);
+    stats.shed = c.shed.load(std::memory_order_relaxed);
+    stats.offline = c.offline.load(std::memory_order_relaxed);
+    stats.batches = c.batches.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace gateway
+} // namespace harmonic_iot
@@ -0,0 +1,73 @@
+/**
+ * Aligned I/O Buffers for Harmonic IoT Protocol
+ *
+ * Page-aligned heap buffer for large-block read(2)/write(2) calls.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_IO_ALIGNED_BUFFER_H
+#define HARMONIC_IOT_IO_ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace harmonic_iot {
+namespace io {
+
+/**
+ * Fixed-size, page-aligned byte buffer
+ */
+class AlignedBuffer {
+public:
+    AlignedBuffer() = default;
+
+    /**
+     * Allocate size bytes aligned to alignment (a power of two)
+     *
+     * @throws std::bad_alloc on failure
+     */
+    explicit AlignedBuffer(size_t size, size_t alignment = 4096) : size_(size) {
+        void* p = nullptr;
+        if (size > 0 && ::posix_memalign(&p, alignment, size) != 0) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<uint8_t*>(p);
+    }
+
+    ~AlignedBuffer() { std::free(data_); }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            std::free(data_);
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace io
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_IO_ALIGNED_BUFFER_H
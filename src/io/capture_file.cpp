@@ -0,0 +1,422 @@
+/**
+ * Raw Capture File Format for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "capture_file.h"
+#include "pcm_convert.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace io {
+
+namespace {
+
+constexpr char CAPTURE_MAGIC[8] = {'H', 'I', 'O', 'T', 'C', 'A', 'P', '\0'};
+constexpr uint32_t CAPTURE_VERSION = 1;
+constexpr uint32_t CAPTURE_BYTE_ORDER = 0x01020304;
+constexpr float INT16_SCALE = 32767.0f;
+
+static_assert(sizeof(CaptureHeader) <= CAPTURE_BLOCK_ALIGNMENT, "Header must fit in the first page");
+static_assert(sizeof(BlockIndexEntry) == 16, "Index entries must be packed");
+static_assert(sizeof(ChannelSummary) == 16, "Summaries must be packed");
+
+inline float int16ToSample(int16_t value) {
+    return static_cast<float>(value) * (1.0f / INT16_SCALE);
+}
+
+ChannelSummary emptySummary() {
+    return {std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(), 0.0};
+}
+
+void accumulate(ChannelSummary& acc, float value) {
+    acc.min = std::min(acc.min, value);
+    acc.max = std::max(acc.max, value);
+    acc.energy += static_cast<double>(value) * value;
+}
+
+void merge(ChannelSummary& acc, const ChannelSummary& other) {
+    acc.min = std::min(acc.min, other.min);
+    acc.max = std::max(acc.max, other.max);
+    acc.energy += other.energy;
+}
+
+} // namespace
+
+size_t sampleTypeSize(SampleType type) {
+    switch (type) {
+        case SampleType::Float32: return sizeof(float);
+        case SampleType::Int16:   return sizeof(int16_t);
+    }
+    throw std::invalid_argument("Unknown sample type");
+}
+
+// ─── CaptureWriter ───────────────────────────────────────────────────────────
+
+CaptureWriter::CaptureWriter(const std::string& path, const CaptureFormat& format)
+    : path_(path), format_(format) {
+    if (format_.channels == 0 || format_.block_frames == 0) {
+        throw std::invalid_argument("Capture needs at least one channel and one frame per block");
+    }
+    if (!(format_.sample_rate > 0.0) || !std::isfinite(format_.sample_rate)) {
+        throw std::invalid_argument("Capture sample rate must be positive");
+    }
+    if (format_.blockBytes() % CAPTURE_BLOCK_ALIGNMENT != 0) {
+        throw std::invalid_argument("Capture block size must be a multiple of 4096 bytes");
+    }
+
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to create " + path + ": " + std::strerror(errno));
+    }
+
+    block_.resize(format_.blockBytes());
+
+    // Reserve the header page; it is rewritten with final counts on close()
+    std::vector<uint8_t> header_page(CAPTURE_BLOCK_ALIGNMENT, 0);
+    writeAll(header_page.data(), header_page.size());
+}
+
+CaptureWriter::~CaptureWriter() {
+    if (fd_ >= 0) {
+        try {
+            close();
+        } catch (...) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+}
+
+void CaptureWriter::append(const dsp::Sample* interleaved, size_t frames) {
+    if (fd_ < 0) {
+        throw std::logic_error("CaptureWriter already closed");
+    }
+
+    const size_t channels = format_.channels;
+    while (frames > 0) {
+        size_t take = std::min(frames, static_cast<size_t>(format_.block_frames) - block_fill_);
+        size_t count = take * channels;
+
+        if (format_.sample_type == SampleType::Float32) {
+            std::memcpy(block_.data() + block_fill_ * format_.frameBytes(),
+                        interleaved, count * sizeof(float));
+        } else {
+            samplesToPcm16(interleaved, block_.data() + block_fill_ * format_.frameBytes(), count);
+        }
+
+        block_fill_ += take;
+        total_frames_ += take;
+        interleaved += count;
+        frames -= take;
+
+        if (block_fill_ == format_.block_frames) {
+            flushBlock();
+        }
+    }
+}
+
+void CaptureWriter::flushBlock() {
+    if (block_fill_ == 0) {
+        return;
+    }
+
+    const size_t channels = format_.channels;
+    std::vector<ChannelSummary> block_summary(channels, emptySummary());
+
+    if (format_.sample_type == SampleType::Float32) {
+        const float* samples = reinterpret_cast<const float*>(block_.data());
+        for (size_t f = 0; f < block_fill_; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                accumulate(block_summary[c], samples[f * channels + c]);
+            }
+        }
+    } else {
+        const int16_t* samples = reinterpret_cast<const int16_t*>(block_.data());
+        for (size_t f = 0; f < block_fill_; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                accumulate(block_summary[c], int16ToSample(samples[f * channels + c]));
+            }
+        }
+    }
+
+    BlockIndexEntry entry{};
+    entry.first_frame = total_frames_ - block_fill_;
+    entry.frames = static_cast<uint32_t>(block_fill_);
+    index_.push_back(entry);
+    summaries_.insert(summaries_.end(), block_summary.begin(), block_summary.end());
+
+    // A short final block is zero padded so the index stays page aligned
+    size_t used = block_fill_ * format_.frameBytes();
+    std::fill(block_.begin() + used, block_.end(), 0);
+    size_t padded = (used + CAPTURE_BLOCK_ALIGNMENT - 1) / CAPTURE_BLOCK_ALIGNMENT * CAPTURE_BLOCK_ALIGNMENT;
+    writeAll(block_.data(), padded);
+
+    block_fill_ = 0;
+}
+
+void CaptureWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    flushBlock();
+
+    uint64_t data_bytes = 0;
+    for (const auto& entry : index_) {
+        uint64_t used = static_cast<uint64_t>(entry.frames) * format_.frameBytes();
+        data_bytes += (used + CAPTURE_BLOCK_ALIGNMENT - 1) / CAPTURE_BLOCK_ALIGNMENT * CAPTURE_BLOCK_ALIGNMENT;
+    }
+
+    CaptureHeader header{};
+    std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+    header.version = CAPTURE_VERSION;
+    header.header_size = static_cast<uint32_t>(CAPTURE_BLOCK_ALIGNMENT);
+    header.sample_rate = format_.sample_rate;
+    header.fundamental_freq = format_.fundamental_freq;
+    header.sample_type = static_cast<uint32_t>(format_.sample_type);
+    header.channels = format_.channels;
+    header.block_frames = format_.block_frames;
+    header.byte_order = CAPTURE_BYTE_ORDER;
+    header.source_id = format_.source_id;
+    header.start_time_ns = format_.start_time_ns;
+    header.total_frames = total_frames_;
+    header.block_count = index_.size();
+    header.data_offset = CAPTURE_BLOCK_ALIGNMENT;
+    header.index_offset = CAPTURE_BLOCK_ALIGNMENT + data_bytes;
+
+    writeAll(index_.data(), index_.size() * sizeof(BlockIndexEntry));
+    writeAll(summaries_.data(), summaries_.size() * sizeof(ChannelSummary));
+    writeAllAt(&header, sizeof(header), 0);
+
+    int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close " + path_ + ": " + std::strerror(errno));
+    }
+}
+
+void CaptureWriter::writeAll(const void* data, size_t length) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t n = ::write(fd_, p, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write " + path_ + ": " + std::strerror(errno));
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+}
+
+void CaptureWriter::writeAllAt(const void* data, size_t length, uint64_t offset) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t n = ::pwrite(fd_, p, length, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write " + path_ + ": " + std::strerror(errno));
+        }
+        p += n;
+        offset += static_cast<uint64_t>(n);
+        length -= static_cast<size_t>(n);
+    }
+}
+
+// ─── CaptureReader ───────────────────────────────────────────────────────────
+
+CaptureReader::CaptureReader(const std::string& path) : file_(path) {
+    if (file_.size() < CAPTURE_BLOCK_ALIGNMENT) {
+        throw std::runtime_error("Truncated capture file: " + path);
+    }
+
+    CaptureHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+        throw std::runtime_error("Not a capture file: " + path);
+    }
+    if (header.byte_order != CAPTURE_BYTE_ORDER) {
+        throw std::runtime_error("Capture byte order does not match this host: " + path);
+    }
+    if (header.version != CAPTURE_VERSION) {
+        throw std::runtime_error("Unsupported capture version in " + path);
+    }
+    if (header.sample_type != static_cast<uint32_t>(SampleType::Float32) &&
+        header.sample_type != static_cast<uint32_t>(SampleType::Int16)) {
+        throw std::runtime_error("Unknown sample type in " + path);
+    }
+    // The index and data regions are read in place, so their offsets must
+    // be aligned for the types mapped over them
+    constexpr uint64_t index_alignment = std::max(alignof(BlockIndexEntry), alignof(ChannelSummary));
+    if (header.channels == 0 || header.block_frames == 0 ||
+        !(header.sample_rate > 0.0) || !std::isfinite(header.sample_rate) ||
+        header.index_offset % index_alignment != 0 ||
+        header.data_offset % sampleTypeSize(static_cast<SampleType>(header.sample_type)) != 0) {
+        throw std::runtime_error("Corrupt capture header in " + path);
+    }
+
+    format_.sample_rate = header.sample_rate;
+    format_.fundamental_freq = header.fundamental_freq;
+    format_.sample_type = static_cast<SampleType>(header.sample_type);
+    format_.channels = header.channels;
+    format_.block_frames = header.block_frames;
+    format_.source_id = header.source_id;
+    format_.start_time_ns = header.start_time_ns;
+    total_frames_ = header.total_frames;
+    block_count_ = header.block_count;
+
+    // Sizes are checked by division so a corrupt header cannot overflow them
+    const uint64_t file_size = file_.size();
+    const uint64_t frame_bytes = format_.frameBytes();
+    const uint64_t entry_bytes = sizeof(BlockIndexEntry) + format_.channels * sizeof(ChannelSummary);
+    if (header.data_offset > header.index_offset || header.index_offset > file_size ||
+        total_frames_ > (header.index_offset - header.data_offset) / frame_bytes ||
+        block_count_ > (file_size - header.index_offset) / entry_bytes) {
+        throw std::runtime_error("Truncated capture file: " + path);
+    }
+    const uint64_t block_frames = format_.block_frames;
+    if (block_count_ != total_frames_ / block_frames + (total_frames_ % block_frames != 0 ? 1 : 0)) {
+        throw std::runtime_error("Corrupt capture index in " + path);
+    }
+
+    data_ = file_.data() + header.data_offset;
+    index_ = reinterpret_cast<const BlockIndexEntry*>(file_.data() + header.index_offset);
+    summaries_ = reinterpret_cast<const ChannelSummary*>(
+        file_.data() + header.index_offset + block_count_ * sizeof(BlockIndexEntry));
+
+    // summarize() maps frame f to entry f / block_frames, so every entry
+    // must describe exactly that block
+    for (uint64_t i = 0; i < block_count_; ++i) {
+        const uint64_t first = i * block_frames;
+        if (index_[i].first_frame != first ||
+            index_[i].frames != std::min(block_frames, total_frames_ - first)) {
+            throw std::runtime_error("Corrupt capture index in " + path);
+        }
+    }
+}
+
+uint64_t CaptureReader::frameAt(double seconds) const {
+    if (seconds <= 0.0 || total_frames_ == 0) {
+        return 0;
+    }
+    double frame = std::floor(seconds * format_.sample_rate + 0.5);
+    return std::min(total_frames_ - 1, static_cast<uint64_t>(frame));
+}
+
+const BlockIndexEntry& CaptureReader::block(uint64_t block) const {
+    if (block >= block_count_) {
+        throw std::out_of_range("Capture block out of range");
+    }
+    return index_[block];
+}
+
+const ChannelSummary& CaptureReader::summary(uint64_t block, uint32_t channel) const {
+    if (block >= block_count_ || channel >= format_.channels) {
+        throw std::out_of_range("Capture summary out of range");
+    }
+    return summaries_[block * format_.channels + channel];
+}
+
+const uint8_t* CaptureReader::frameAddress(uint64_t first, uint64_t count) const {
+    if (first > total_frames_ || count > total_frames_ - first) {
+        throw std::out_of_range("Capture frame range out of range");
+    }
+    // Blocks are whole pages, so frame f lives at f × frameBytes() from the data start
+    return data_ + first * format_.frameBytes();
+}
+
+dsp::SampleSpan CaptureReader::samples(uint64_t first, uint64_t count) const {
+    if (format_.sample_type != SampleType::Float32) {
+        throw std::logic_error("Zero-copy Sample view requires a Float32 capture");
+    }
+    const auto* p = reinterpret_cast<const dsp::Sample*>(frameAddress(first, count));
+    return dsp::SampleSpan(p, count * format_.channels);
+}
+
+dsp::Span<const int16_t> CaptureReader::samplesInt16(uint64_t first, uint64_t count) const {
+    if (format_.sample_type != SampleType::Int16) {
+        throw std::logic_error("Int16 view requires an Int16 capture");
+    }
+    const auto* p = reinterpret_cast<const int16_t*>(frameAddress(first, count));
+    return dsp::Span<const int16_t>(p, count * format_.channels);
+}
+
+void CaptureReader::readChannel(uint64_t first, uint64_t count, uint32_t channel, dsp::Sample* out) const {
+    if (channel >= format_.channels) {
+        throw std::out_of_range("Capture channel out of range");
+    }
+
+    const size_t channels = format_.channels;
+    const uint8_t* base = frameAddress(first, count);
+
+    if (format_.sample_type == SampleType::Float32) {
+        const float* in = reinterpret_cast<const float*>(base) + channel;
+        for (uint64_t i = 0; i < count; ++i) {
+            out[i] = in[i * channels];
+        }
+    } else {
+        const int16_t* in = reinterpret_cast<const int16_t*>(base) + channel;
+        for (uint64_t i = 0; i < count; ++i) {
+            out[i] = int16ToSample(in[i * channels]);
+        }
+    }
+}
+
+ChannelSummary CaptureReader::summarize(uint64_t first, uint64_t count, uint32_t channel) const {
+    if (channel >= format_.channels) {
+        throw std::out_of_range("Capture channel out of range");
+    }
+    frameAddress(first, count);  // Range check
+    if (count == 0) {
+        return {0.0f, 0.0f, 0.0};
+    }
+
+    ChannelSummary acc = emptySummary();
+    const uint64_t end = first + count;
+    const uint64_t block_frames = format_.block_frames;
+    std::vector<dsp::Sample> edge;
+
+    uint64_t frame = first;
+    while (frame < end) {
+        uint64_t block_index = frame / block_frames;
+        const BlockIndexEntry& entry = index_[block_index];
+        uint64_t block_end = entry.first_frame + entry.frames;
+
+        if (frame == entry.first_frame && block_end <= end) {
+            merge(acc, summaries_[block_index * format_.channels + channel]);
+            frame = block_end;
+            continue;
+        }
+
+        // Partial block at an edge of the range: scan the samples
+        uint64_t stop = std::min(block_end, end);
+        edge.resize(stop - frame);
+        readChannel(frame, stop - frame, channel, edge.data());
+        for (dsp::Sample s : edge) {
+            accumulate(acc, s);
+        }
+        frame = stop;
+    }
+
+    return acc;
+}
+
+void CaptureReader::prefetch(uint64_t first, uint64_t count) const {
+    const uint8_t* p = frameAddress(first, count);
+    file_.advise(static_cast<size_t>(p - file_.data()),
+                 static_cast<size_t>(count * format_.frameBytes()),
+                 AccessHint::WillNeed);
+}
+
+} // namespace io
+} // namespace harmonic_iot
@@ -0,0 +1,261 @@
+/**
+ * Raw Capture File Format for Harmonic IoT Protocol
+ *
+ * Native on-disk format for long multi-gateway sample captures. A capture
+ * is read through mmap(2), so any time range can be handed to the DSP as
+ * a zero-copy view without loading the whole file.
+ *
+ * Layout (fields in the writer's byte order, recorded in the header; a
+ * reader on a host with the other byte order rejects the file):
+ *
+ *   [0, 4096)          CaptureHeader, zero padded
+ *   [4096, index)      Sample blocks, interleaved frames, each block a
+ *                      multiple of 4096 bytes so the data region is one
+ *                      contiguous, page-aligned array
+ *   [index, EOF)       BlockIndexEntry[block_count]
+ *                      ChannelSummary[block_count * channels]
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_IO_CAPTURE_FILE_H
+#define HARMONIC_IOT_IO_CAPTURE_FILE_H
+
+#include "dsp/sample.h"
+#include "io/mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace harmonic_iot {
+namespace io {
+
+/**
+ * Alignment of the data region and of every block, in bytes
+ */
+constexpr size_t CAPTURE_BLOCK_ALIGNMENT = 4096;
+
+/**
+ * Sample encodings supported by capture files
+ */
+enum class SampleType : uint32_t {
+    Float32 = 1,  // Native dsp::Sample, served zero-copy
+    Int16 = 2     // Half the disk footprint, full scale = 32767
+};
+
+/**
+ * Size in bytes of one sample of the given type
+ */
+size_t sampleTypeSize(SampleType type);
+
+/**
+ * Capture stream description
+ */
+struct CaptureFormat {
+    double sample_rate = 44100.0;       // Hz
+    double fundamental_freq = 16384.0;  // f₀ of the captured network, Hz
+    SampleType sample_type = SampleType::Float32;
+    uint32_t channels = 1;
+    uint32_t block_frames = 4096;       // Frames per indexed block
+    uint64_t source_id = 0;             // Gateway that produced the capture
+    int64_t start_time_ns = 0;          // Wall-clock time of frame 0 (Unix epoch)
+
+    /** Bytes per interleaved frame */
+    size_t frameBytes() const { return sampleTypeSize(sample_type) * channels; }
+
+    /** Bytes per full block */
+    size_t blockBytes() const { return frameBytes() * block_frames; }
+};
+
+/**
+ * On-disk header, stored at offset 0
+ */
+struct CaptureHeader {
+    char magic[8];            // "HIOTCAP\0"
+    uint32_t version;
+    uint32_t header_size;
+    double sample_rate;
+    double fundamental_freq;
+    uint32_t sample_type;
+    uint32_t channels;
+    uint32_t block_frames;
+    uint32_t byte_order;      // 0x01020304 as written by the host
+    uint64_t source_id;
+    int64_t start_time_ns;
+    uint64_t total_frames;
+    uint64_t block_count;
+    uint64_t data_offset;
+    uint64_t index_offset;
+};
+
+/**
+ * Index entry for one sample block
+ */
+struct BlockIndexEntry {
+    uint64_t first_frame;
+    uint32_t frames;          // block_frames, except possibly the last block
+    uint32_t reserved;
+};
+
+/**
+ * Per-block, per-channel amplitude summary
+ *
+ * Values are in normalized sample units regardless of the stored type.
+ * Energy is Σ x², so RMS over any union of blocks is sqrt(Σ energy / Σ frames).
+ */
+struct ChannelSummary {
+    float min;
+    float max;
+    double energy;
+};
+
+/**
+ * Streaming capture writer
+ *
+ * Frames are accumulated into one block-sized buffer; each full block is
+ * written with a single write(2) and summarized on the way out. The index
+ * is appended and the header finalized by close().
+ */
+class CaptureWriter {
+public:
+    /**
+     * Create (truncate) a capture file
+     *
+     * @param path Output file path
+     * @param format Stream description; block_frames × frameBytes() must be
+     *        a multiple of CAPTURE_BLOCK_ALIGNMENT
+     * @throws std::invalid_argument on an invalid format
+     * @throws std::runtime_error if the file cannot be created
+     */
+    CaptureWriter(const std::string& path, const CaptureFormat& format);
+
+    /** Closes the file if close() was not called; errors are swallowed */
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * Append interleaved frames, converting to the stored sample type
+     *
+     * @param interleaved frames × channels samples in [-1.0, 1.0]
+     * @param frames Number of frames
+     */
+    void append(const dsp::Sample* interleaved, size_t frames);
+
+    /**
+     * Finish the last block, write the index and finalize the header
+     */
+    void close();
+
+    uint64_t framesWritten() const { return total_frames_; }
+
+private:
+    int fd_ = -1;
+    std::string path_;
+    CaptureFormat format_;
+    std::vector<uint8_t> block_;
+    size_t block_fill_ = 0;  // Frames buffered in block_
+    uint64_t total_frames_ = 0;
+    std::vector<BlockIndexEntry> index_;
+    std::vector<ChannelSummary> summaries_;
+
+    void flushBlock();
+    void writeAll(const void* data, size_t length);
+    void writeAllAt(const void* data, size_t length, uint64_t offset);
+};
+
+/**
+ * Memory-mapped capture reader
+ *
+ * All accessors return views into the mapping; they stay valid for the
+ * lifetime of the reader.
+ */
+class CaptureReader {
+public:
+    /**
+     * Map and validate a capture file
+     *
+     * @param path Capture file path
+     * @throws std::runtime_error if the file is missing, truncated, corrupt, not a
+     *         capture, or written with the other byte order
+     */
+    explicit CaptureReader(const std::string& path);
+
+    const CaptureFormat& format() const { return format_; }
+    uint64_t frameCount() const { return total_frames_; }
+    uint64_t blockCount() const { return block_count_; }
+
+    /** Duration of the capture in seconds */
+    double duration() const { return static_cast<double>(total_frames_) / format_.sample_rate; }
+
+    /** Frame index nearest to a time offset (seconds from start), clamped */
+    uint64_t frameAt(double seconds) const;
+
+    const BlockIndexEntry& block(uint64_t block) const;
+    const ChannelSummary& summary(uint64_t block, uint32_t channel) const;
+
+    /**
+     * Zero-copy view of interleaved frames [first, first + count)
+     *
+     * Only valid for Float32 captures.
+     *
+     * @param first First frame
+     * @param count Number of frames
+     * @return View of count × channels samples
+     * @throws std::out_of_range if the range exceeds the capture
+     * @throws std::logic_error if the capture is not Float32
+     */
+    dsp::SampleSpan samples(uint64_t first, uint64_t count) const;
+
+    /**
+     * Zero-copy view of Int16 interleaved frames [first, first + count)
+     *
+     * @throws std::logic_error if the capture is not Int16
+     */
+    dsp::Span<const int16_t> samplesInt16(uint64_t first, uint64_t count) const;
+
+    /**
+     * Copy one channel of a frame range into a Sample buffer
+     *
+     * Works for every sample type; for mono Float32 captures prefer the
+     * zero-copy samples() view.
+     *
+     * @param first First frame
+     * @param count Number of frames (out must hold count samples)
+     * @param channel Channel to extract
+     * @param out Destination buffer
+     */
+    void readChannel(uint64_t first, uint64_t count, uint32_t channel, dsp::Sample* out) const;
+
+    /**
+     * Summarize a frame range using the block index
+     *
+     * Whole blocks are answered from the index; only the partial blocks at
+     * the edges of the range touch sample data. An empty range summarizes
+     * to all zeros.
+     */
+    ChannelSummary summarize(uint64_t first, uint64_t count, uint32_t channel) const;
+
+    /**
+     * Hint that a frame range is about to be processed
+     */
+    void prefetch(uint64_t first, uint64_t count) const;
+
+private:
+    MappedFile file_;
+    CaptureFormat format_;
+    uint64_t total_frames_ = 0;
+    uint64_t block_count_ = 0;
+    const uint8_t* data_ = nullptr;
+    const BlockIndexEntry* index_ = nullptr;
+    const ChannelSummary* summaries_ = nullptr;
+
+    const uint8_t* frameAddress(uint64_t first, uint64_t count) const;
+};
+
+} // namespace io
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_IO_CAPTURE_FILE_H
@@ -0,0 +1,104 @@
+/**
+ * Memory-Mapped Files for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "mapped_file.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace io {
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path + ": " + std::strerror(err));
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map empty file " + path);
+    }
+
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        size_ = 0;
+        throw std::runtime_error("Failed to mmap " + path + ": " + std::strerror(err));
+    }
+
+    data_ = static_cast<const uint8_t*>(addr);
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void MappedFile::advise(size_t offset, size_t length, AccessHint hint) const {
+    if (!data_ || offset >= size_ || length == 0) {
+        return;
+    }
+
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t begin = offset - (offset % page);
+    size_t end = std::min(size_, offset + length);
+
+    int advice = MADV_NORMAL;
+    switch (hint) {
+        case AccessHint::Normal:     advice = MADV_NORMAL; break;
+        case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+        case AccessHint::Random:     advice = MADV_RANDOM; break;
+        case AccessHint::WillNeed:   advice = MADV_WILLNEED; break;
+        case AccessHint::DontNeed:   advice = MADV_DONTNEED; break;
+    }
+
+    ::madvise(const_cast<uint8_t*>(data_) + begin, end - begin, advice);
+}
+
+void MappedFile::release() {
+    if (data_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace io
+} // namespace harmonic_iot
@@ -0,0 +1,83 @@
+/**
+ * Memory-Mapped Files for Harmonic IoT Protocol
+ *
+ * RAII wrapper around a read-only mmap(2) mapping, used to serve
+ * zero-copy sample views from capture and recording files.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_IO_MAPPED_FILE_H
+#define HARMONIC_IOT_IO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace harmonic_iot {
+namespace io {
+
+/**
+ * Access pattern hints forwarded to madvise(2)
+ */
+enum class AccessHint {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+    DontNeed
+};
+
+/**
+ * Read-only memory mapping of a whole file
+ *
+ * The mapping is private and read-only; pages are faulted in lazily, so
+ * opening a multi-GB file costs nothing until the data is touched.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /**
+     * Map a file read-only
+     *
+     * @param path File to map
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return data_ != nullptr; }
+
+    /**
+     * Advise the kernel about the access pattern of a byte range
+     *
+     * The range is widened to page boundaries. Failures are ignored since
+     * advice is only a hint.
+     *
+     * @param offset First byte of the range
+     * @param length Length of the range in bytes
+     * @param hint Expected access pattern
+     */
+    void advise(size_t offset, size_t length, AccessHint hint) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+    void release();
+};
+
+} // namespace io
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_IO_MAPPED_FILE_H
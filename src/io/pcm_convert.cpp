@@ -0,0 +1,111 @@
+/**
+ * PCM Sample Conversion for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "pcm_convert.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace io {
+
+namespace {
+
+constexpr float PCM16_SCALE = 32767.0f;
+constexpr float PCM24_SCALE = 8388607.0f;
+
+/**
+ * Clamp, scale and round half away from zero; NaN quantizes to 0
+ *
+ * Written with selects instead of lrint() so the enclosing loop vectorizes.
+ * NaN fails both clamp comparisons, and converting it to int32_t is
+ * undefined, so it is replaced first.
+ */
+inline int32_t quantize(float value, float scale) {
+    float finite = value == value ? value : 0.0f;
+    float clamped = finite < -1.0f ? -1.0f : (finite > 1.0f ? 1.0f : finite);
+    float scaled = clamped * scale;
+    return static_cast<int32_t>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+} // namespace
+
+size_t pcmBytesPerSample(PcmEncoding encoding) {
+    switch (encoding) {
+        case PcmEncoding::Pcm16:   return 2;
+        case PcmEncoding::Pcm24:   return 3;
+        case PcmEncoding::Float32: return 4;
+    }
+    throw std::invalid_argument("Unknown PCM encoding");
+}
+
+void pcmToSamples(PcmEncoding encoding, const uint8_t* in, dsp::Sample* out, size_t count) {
+    switch (encoding) {
+        case PcmEncoding::Pcm16:   pcm16ToSamples(in, out, count); return;
+        case PcmEncoding::Pcm24:   pcm24ToSamples(in, out, count); return;
+        case PcmEncoding::Float32: float32ToSamples(in, out, count); return;
+    }
+    throw std::invalid_argument("Unknown PCM encoding");
+}
+
+void samplesToPcm(PcmEncoding encoding, const dsp::Sample* in, uint8_t* out, size_t count) {
+    switch (encoding) {
+        case PcmEncoding::Pcm16:   samplesToPcm16(in, out, count); return;
+        case PcmEncoding::Pcm24:   samplesToPcm24(in, out, count); return;
+        case PcmEncoding::Float32: samplesToFloat32(in, out, count); return;
+    }
+    throw std::invalid_argument("Unknown PCM encoding");
+}
+
+void pcm16ToSamples(const uint8_t* in, dsp::Sample* out, size_t count) {
+    constexpr float inv = 1.0f / PCM16_SCALE;
+    for (size_t i = 0; i < count; ++i) {
+        int16_t v;
+        std::memcpy(&v, in + 2 * i, sizeof(v));
+        out[i] = static_cast<float>(v) * inv;
+    }
+}
+
+void pcm24ToSamples(const uint8_t* in, dsp::Sample* out, size_t count) {
+    constexpr float inv = 1.0f / PCM24_SCALE;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = in + 3 * i;
+        // Assemble into the top 24 bits, then arithmetic shift to sign-extend
+        uint32_t u = (static_cast<uint32_t>(p[0]) << 8) |
+                     (static_cast<uint32_t>(p[1]) << 16) |
+                     (static_cast<uint32_t>(p[2]) << 24);
+        int32_t v = static_cast<int32_t>(u) >> 8;
+        out[i] = static_cast<float>(v) * inv;
+    }
+}
+
+void float32ToSamples(const uint8_t* in, dsp::Sample* out, size_t count) {
+    std::memcpy(out, in, count * sizeof(float));
+}
+
+void samplesToPcm16(const dsp::Sample* in, uint8_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        int16_t v = static_cast<int16_t>(quantize(in[i], PCM16_SCALE));
+        std::memcpy(out + 2 * i, &v, sizeof(v));
+    }
+}
+
+void samplesToPcm24(const dsp::Sample* in, uint8_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t u = static_cast<uint32_t>(quantize(in[i], PCM24_SCALE));
+        uint8_t* p = out + 3 * i;
+        p[0] = static_cast<uint8_t>(u);
+        p[1] = static_cast<uint8_t>(u >> 8);
+        p[2] = static_cast<uint8_t>(u >> 16);
+    }
+}
+
+void samplesToFloat32(const dsp::Sample* in, uint8_t* out, size_t count) {
+    std::memcpy(out, in, count * sizeof(float));
+}
+
+} // namespace io
+} // namespace harmonic_iot
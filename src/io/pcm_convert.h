@@ -0,0 +1,60 @@
+/**
+ * PCM Sample Conversion for Harmonic IoT Protocol
+ *
+ * Bulk conversion between little-endian PCM encodings and the native
+ * dsp::Sample type. The loops are branch-free and use memcpy loads so the
+ * compiler can auto-vectorize them at -O2/-O3.
+ *
+ * Integer encodings are scaled symmetrically (full scale = 2^(bits-1) - 1),
+ * so Sample → PCM → Sample round trips are exact for in-range values.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_IO_PCM_CONVERT_H
+#define HARMONIC_IOT_IO_PCM_CONVERT_H
+
+#include "dsp/sample.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace harmonic_iot {
+namespace io {
+
+/**
+ * PCM sample encodings
+ */
+enum class PcmEncoding {
+    Pcm16,    // Signed 16-bit integer
+    Pcm24,    // Signed 24-bit integer, packed in 3 bytes
+    Float32   // IEEE 754 single precision
+};
+
+/**
+ * Bytes per sample of an encoding
+ */
+size_t pcmBytesPerSample(PcmEncoding encoding);
+
+/**
+ * Decode count samples of the given encoding into Samples
+ */
+void pcmToSamples(PcmEncoding encoding, const uint8_t* in, dsp::Sample* out, size_t count);
+
+/**
+ * Encode count Samples into the given encoding, clamping to [-1.0, 1.0]
+ */
+void samplesToPcm(PcmEncoding encoding, const dsp::Sample* in, uint8_t* out, size_t count);
+
+void pcm16ToSamples(const uint8_t* in, dsp::Sample* out, size_t count);
+void pcm24ToSamples(const uint8_t* in, dsp::Sample* out, size_t count);
+void float32ToSamples(const uint8_t* in, dsp::Sample* out, size_t count);
+
+void samplesToPcm16(const dsp::Sample* in, uint8_t* out, size_t count);
+void samplesToPcm24(const dsp::Sample* in, uint8_t* out, size_t count);
+void samplesToFloat32(const dsp::Sample* in, uint8_t* out, size_t count);
+
+} // namespace io
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_IO_PCM_CONVERT_H
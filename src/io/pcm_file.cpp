@@ -0,0 +1,400 @@
+/**
+ * WAV and Raw PCM Streams for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "pcm_file.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace io {
+
+namespace {
+
+constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+constexpr size_t WAV_HEADER_BYTES = 44;
+
+inline uint16_t loadLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t loadLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline void storeLE16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void storeLE32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+/**
+ * Round the buffer down to whole frames so a full buffer never splits one
+ */
+size_t frameAlignedCapacity(size_t buffer_bytes, size_t frame_bytes) {
+    size_t capacity = buffer_bytes - buffer_bytes % frame_bytes;
+    if (capacity == 0) {
+        throw std::invalid_argument("I/O buffer smaller than one frame");
+    }
+    return capacity;
+}
+
+void validateFormat(const PcmFormat& format) {
+    if (format.channels == 0) {
+        throw std::invalid_argument("PCM stream needs at least one channel");
+    }
+    if (!(format.sample_rate > 0.0) || !std::isfinite(format.sample_rate)) {
+        throw std::invalid_argument("PCM sample rate must be positive");
+    }
+}
+
+} // namespace
+
+// ─── PcmReader ───────────────────────────────────────────────────────────────
+
+PcmReader::PcmReader(const std::string& path, size_t buffer_bytes)
+    : path_(path), buffer_(buffer_bytes) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+}
+
+PcmReader::PcmReader(const std::string& path, const PcmFormat& format, size_t buffer_bytes)
+    : PcmReader(path, buffer_bytes) {
+    open(format, 0, fileSize());
+}
+
+PcmReader::~PcmReader() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void PcmReader::open(const PcmFormat& format, uint64_t data_offset, uint64_t data_bytes) {
+    validateFormat(format);
+    frameAlignedCapacity(buffer_.size(), format.frameBytes());
+
+    format_ = format;
+    data_offset_ = data_offset;
+    // Ignore a trailing partial frame
+    data_bytes_ = data_bytes - data_bytes % format.frameBytes();
+    file_pos_ = 0;
+    buffer_pos_ = buffer_len_ = 0;
+    position_ = 0;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd_, static_cast<off_t>(data_offset_), static_cast<off_t>(data_bytes_),
+                    POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+uint64_t PcmReader::fileSize() const {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        throw std::runtime_error("Failed to stat " + path_ + ": " + std::strerror(errno));
+    }
+    return static_cast<uint64_t>(st.st_size);
+}
+
+size_t PcmReader::readAt(void* out, size_t length, uint64_t offset) const {
+    uint8_t* p = static_cast<uint8_t*>(out);
+    size_t total = 0;
+    while (total < length) {
+        ssize_t n = ::pread(fd_, p + total, length - total, static_cast<off_t>(offset + total));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to read " + path_ + ": " + std::strerror(errno));
+        }
+        if (n == 0) break;
+        total += static_cast<size_t>(n);
+    }
+    return total;
+}
+
+bool PcmReader::fill() {
+    const size_t capacity = frameAlignedCapacity(buffer_.size(), format_.frameBytes());
+    uint64_t remaining = data_bytes_ - file_pos_;
+    if (remaining == 0) {
+        return false;
+    }
+
+    size_t want = static_cast<size_t>(std::min<uint64_t>(capacity, remaining));
+    size_t got = readAt(buffer_.data(), want, data_offset_ + file_pos_);
+    if (got < want) {
+        // File shrank underneath us; stop at the last whole frame
+        data_bytes_ = file_pos_ + (got - got % format_.frameBytes());
+        got -= got % format_.frameBytes();
+    }
+
+    file_pos_ += got;
+    buffer_pos_ = 0;
+    buffer_len_ = got;
+    return got > 0;
+}
+
+size_t PcmReader::read(dsp::Sample* out, size_t frames) {
+    const size_t frame_bytes = format_.frameBytes();
+    const size_t channels = format_.channels;
+    size_t done = 0;
+
+    while (done < frames) {
+        if (buffer_pos_ == buffer_len_ && !fill()) {
+            break;
+        }
+        size_t available = (buffer_len_ - buffer_pos_) / frame_bytes;
+        size_t take = std::min(frames - done, available);
+        pcmToSamples(format_.encoding, buffer_.data() + buffer_pos_,
+                     out + done * channels, take * channels);
+        buffer_pos_ += take * frame_bytes;
+        done += take;
+    }
+
+    position_ += done;
+    return done;
+}
+
+void PcmReader::seek(uint64_t frame) {
+    frame = std::min(frame, frameCount());
+    file_pos_ = frame * format_.frameBytes();
+    buffer_pos_ = buffer_len_ = 0;
+    position_ = frame;
+}
+
+// ─── WavReader ───────────────────────────────────────────────────────────────
+
+WavReader::WavReader(const std::string& path, size_t buffer_bytes)
+    : PcmReader(path, buffer_bytes) {
+    uint8_t riff[12];
+    if (readAt(riff, sizeof(riff), 0) != sizeof(riff) ||
+        std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("Not a WAV file: " + path);
+    }
+
+    const uint64_t file_size = fileSize();
+    uint64_t offset = sizeof(riff);
+    bool have_fmt = false;
+    PcmFormat format;
+
+    while (offset + 8 <= file_size) {
+        uint8_t chunk[8];
+        readAt(chunk, sizeof(chunk), offset);
+        uint32_t chunk_size = loadLE32(chunk + 4);
+        uint64_t body = offset + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            if (chunk_size < 16) {
+                throw std::runtime_error("Malformed fmt chunk in " + path);
+            }
+            readAt(fmt, std::min<size_t>(chunk_size, sizeof(fmt)), body);
+
+            uint16_t tag = loadLE16(fmt);
+            uint16_t channels = loadLE16(fmt + 2);
+            uint32_t rate = loadLE32(fmt + 4);
+            uint16_t bits = loadLE16(fmt + 14);
+            if (tag == WAVE_FORMAT_EXTENSIBLE && chunk_size >= 40) {
+                // The first two bytes of the SubFormat GUID carry the real tag
+                tag = loadLE16(fmt + 24);
+            }
+
+            if (tag == WAVE_FORMAT_PCM && bits == 16) {
+                format.encoding = PcmEncoding::Pcm16;
+            } else if (tag == WAVE_FORMAT_PCM && bits == 24) {
+                format.encoding = PcmEncoding::Pcm24;
+            } else if (tag == WAVE_FORMAT_IEEE_FLOAT && bits == 32) {
+                format.encoding = PcmEncoding::Float32;
+            } else {
+                throw std::runtime_error("Unsupported WAV encoding in " + path +
+                                         " (tag " + std::to_string(tag) +
+                                         ", " + std::to_string(bits) + " bits)");
+            }
+            // Checked here so a bad file reports runtime_error, not the
+            // invalid_argument open() raises for a caller's format
+            if (channels == 0 || rate == 0) {
+                throw std::runtime_error("Malformed fmt chunk in " + path);
+            }
+            format.channels = channels;
+            format.sample_rate = rate;
+            if (format.frameBytes() > buffer_bytes) {
+                throw std::runtime_error("WAV frame larger than the I/O buffer in " + path);
+            }
+            have_fmt = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) {
+                throw std::runtime_error("WAV data chunk precedes fmt chunk in " + path);
+            }
+            // Streams cut short while recording report a bigger size than exists
+            uint64_t data_bytes = std::min<uint64_t>(chunk_size, file_size - body);
+            open(format, body, data_bytes);
+            return;
+        }
+
+        // Chunks are word aligned
+        offset = body + chunk_size + (chunk_size & 1);
+    }
+
+    throw std::runtime_error("WAV file has no data chunk: " + path);
+}
+
+// ─── PcmWriter ───────────────────────────────────────────────────────────────
+
+PcmWriter::PcmWriter(const std::string& path, const PcmFormat& format, size_t buffer_bytes)
+    : PcmWriter(path, format, buffer_bytes, 0) {}
+
+PcmWriter::PcmWriter(const std::string& path, const PcmFormat& format,
+                     size_t buffer_bytes, size_t header_bytes)
+    : path_(path), format_(format), buffer_(buffer_bytes), file_pos_(header_bytes) {
+    validateFormat(format_);
+    frameAlignedCapacity(buffer_.size(), format_.frameBytes());
+
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to create " + path + ": " + std::strerror(errno));
+    }
+}
+
+PcmWriter::~PcmWriter() {
+    if (fd_ >= 0) {
+        try {
+            close();
+        } catch (...) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+}
+
+void PcmWriter::write(const dsp::Sample* in, size_t frames) {
+    if (fd_ < 0) {
+        throw std::logic_error("PcmWriter already closed");
+    }
+
+    const size_t frame_bytes = format_.frameBytes();
+    const size_t channels = format_.channels;
+    const size_t capacity = frameAlignedCapacity(buffer_.size(), frame_bytes);
+
+    // Divided, not multiplied, so a huge frame count cannot wrap the check
+    if (frames > (max_data_bytes_ - data_bytes_) / frame_bytes) {
+        throw std::length_error("Stream size limit exceeded for " + path_);
+    }
+
+    while (frames > 0) {
+        size_t take = std::min(frames, (capacity - buffer_len_) / frame_bytes);
+        samplesToPcm(format_.encoding, in, buffer_.data() + buffer_len_, take * channels);
+        buffer_len_ += take * frame_bytes;
+        data_bytes_ += take * frame_bytes;
+        in += take * channels;
+        frames -= take;
+
+        if (buffer_len_ == capacity) {
+            flush();
+        }
+    }
+}
+
+void PcmWriter::flush() {
+    if (buffer_len_ == 0) {
+        return;
+    }
+    writeAt(buffer_.data(), buffer_len_, file_pos_);
+    file_pos_ += buffer_len_;
+    buffer_len_ = 0;
+}
+
+void PcmWriter::writeAt(const void* data, size_t length, uint64_t offset) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t n = ::pwrite(fd_, p, length, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write " + path_ + ": " + std::strerror(errno));
+        }
+        p += n;
+        offset += static_cast<uint64_t>(n);
+        length -= static_cast<size_t>(n);
+    }
+}
+
+void PcmWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    flush();
+    finalize();
+
+    int fd = fd_;
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to close " + path_ + ": " + std::strerror(errno));
+    }
+}
+
+// ─── WavWriter ───────────────────────────────────────────────────────────────
+
+WavWriter::WavWriter(const std::string& path, const PcmFormat& format, size_t buffer_bytes)
+    : PcmWriter(path, format, buffer_bytes, WAV_HEADER_BYTES) {
+    max_data_bytes_ = UINT32_MAX - WAV_HEADER_BYTES;
+    // Write a provisional header so the file is valid even if never closed
+    finalize();
+}
+
+WavWriter::~WavWriter() {
+    // finalize() is virtual, so the header must be patched before ~PcmWriter
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void WavWriter::finalize() {
+    const PcmFormat& fmt = format();
+    const uint16_t bits = static_cast<uint16_t>(pcmBytesPerSample(fmt.encoding) * 8);
+    const uint16_t block_align = static_cast<uint16_t>(fmt.frameBytes());
+    const uint32_t rate = static_cast<uint32_t>(fmt.sample_rate);
+    const uint32_t data_size = static_cast<uint32_t>(data_bytes_);
+    const uint32_t pad = data_size & 1;  // RIFF chunks are word aligned
+
+    uint8_t header[WAV_HEADER_BYTES];
+    std::memcpy(header, "RIFF", 4);
+    storeLE32(header + 4, static_cast<uint32_t>(WAV_HEADER_BYTES - 8) + data_size + pad);
+    std::memcpy(header + 8, "WAVE", 4);
+    std::memcpy(header + 12, "fmt ", 4);
+    storeLE32(header + 16, 16);
+    storeLE16(header + 20, fmt.encoding == PcmEncoding::Float32 ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM);
+    storeLE16(header + 22, static_cast<uint16_t>(fmt.channels));
+    storeLE32(header + 24, rate);
+    storeLE32(header + 28, rate * block_align);
+    storeLE16(header + 32, block_align);
+    storeLE16(header + 34, bits);
+    std::memcpy(header + 36, "data", 4);
+    storeLE32(header + 40, data_size);
+
+    writeAt(header, sizeof(header), 0);
+    if (pad) {
+        const uint8_t zero = 0;
+        writeAt(&zero, 1, WAV_HEADER_BYTES + data_bytes_);
+    }
+}
+
+} // namespace io
+} // namespace harmonic_iot
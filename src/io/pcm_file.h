@@ -0,0 +1,224 @@
+/**
+ * WAV and Raw PCM Streams for Harmonic IoT Protocol
+ *
+ * Streaming readers and writers for recordings and synthesized test
+ * signals. All I/O goes through one fixed, page-aligned buffer with
+ * large read(2)/write(2) calls, so memory use is constant regardless of
+ * file size and multi-GB recordings stream at disk speed.
+ *
+ * Supported encodings: PCM16, PCM24 and IEEE float32, any channel count.
+ *
+ * Errors: a format or buffer size passed by the caller that cannot work
+ * throws std::invalid_argument. Anything that comes from the file, from
+ * failed I/O to malformed or unsupported headers, throws
+ * std::runtime_error.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_IO_PCM_FILE_H
+#define HARMONIC_IOT_IO_PCM_FILE_H
+
+#include "dsp/sample.h"
+#include "io/aligned_buffer.h"
+#include "io/pcm_convert.h"
+#include <cstdint>
+#include <string>
+
+namespace harmonic_iot {
+namespace io {
+
+/**
+ * Default size of the I/O buffer (1 MiB)
+ */
+constexpr size_t DEFAULT_IO_BUFFER_BYTES = 1 << 20;
+
+/**
+ * PCM stream description
+ */
+struct PcmFormat {
+    PcmEncoding encoding = PcmEncoding::Pcm16;
+    uint32_t channels = 1;
+    double sample_rate = 44100.0;
+
+    /** Bytes per interleaved frame */
+    size_t frameBytes() const { return pcmBytesPerSample(encoding) * channels; }
+};
+
+/**
+ * Streaming reader for headerless little-endian PCM
+ *
+ * Base class of WavReader; the raw form needs the format supplied by the
+ * caller since the file carries none.
+ */
+class PcmReader {
+public:
+    /**
+     * Open a raw PCM file
+     *
+     * @param path File path
+     * @param format Encoding, channel count and sample rate of the data
+     * @param buffer_bytes Size of the I/O buffer
+     * @throws std::invalid_argument on a format with no channels or a non-positive
+     *         rate, or a buffer smaller than one frame
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    PcmReader(const std::string& path, const PcmFormat& format,
+              size_t buffer_bytes = DEFAULT_IO_BUFFER_BYTES);
+
+    virtual ~PcmReader();
+
+    PcmReader(const PcmReader&) = delete;
+    PcmReader& operator=(const PcmReader&) = delete;
+
+    const PcmFormat& format() const { return format_; }
+
+    /** Total frames in the stream */
+    uint64_t frameCount() const { return data_bytes_ / format_.frameBytes(); }
+
+    /** Next frame to be returned by read() */
+    uint64_t position() const { return position_; }
+
+    /**
+     * Read and convert up to frames interleaved frames
+     *
+     * @param out Destination, frames × channels Samples
+     * @param frames Maximum frames to read
+     * @return Frames read; 0 at end of stream
+     */
+    size_t read(dsp::Sample* out, size_t frames);
+
+    /**
+     * Reposition the stream
+     *
+     * @param frame Frame index, clamped to frameCount()
+     */
+    void seek(uint64_t frame);
+
+protected:
+    /** For subclasses that parse a header before calling open() */
+    PcmReader(const std::string& path, size_t buffer_bytes);
+
+    /** Start streaming a data region once the format is known */
+    void open(const PcmFormat& format, uint64_t data_offset, uint64_t data_bytes);
+
+    /** Positional read used by subclasses for header parsing */
+    size_t readAt(void* out, size_t length, uint64_t offset) const;
+
+    uint64_t fileSize() const;
+
+    std::string path_;
+
+private:
+    int fd_ = -1;
+    PcmFormat format_;
+    AlignedBuffer buffer_;
+    size_t buffer_pos_ = 0;   // Next unconsumed byte in buffer_
+    size_t buffer_len_ = 0;   // Valid bytes in buffer_
+    uint64_t data_offset_ = 0;
+    uint64_t data_bytes_ = 0;
+    uint64_t file_pos_ = 0;   // Bytes of the data region already buffered
+    uint64_t position_ = 0;
+
+    bool fill();
+};
+
+/**
+ * Streaming WAV (RIFF/WAVE) reader
+ *
+ * Accepts WAVE_FORMAT_PCM (16/24-bit), WAVE_FORMAT_IEEE_FLOAT (32-bit)
+ * and their WAVE_FORMAT_EXTENSIBLE forms; unknown chunks are skipped.
+ */
+class WavReader : public PcmReader {
+public:
+    /**
+     * @throws std::runtime_error on malformed or unsupported files
+     */
+    explicit WavReader(const std::string& path, size_t buffer_bytes = DEFAULT_IO_BUFFER_BYTES);
+};
+
+/**
+ * Streaming writer for headerless little-endian PCM
+ */
+class PcmWriter {
+public:
+    /**
+     * Create (truncate) a raw PCM file
+     *
+     * @throws std::invalid_argument on a format with no channels or a non-positive
+     *         rate, or a buffer smaller than one frame
+     * @throws std::runtime_error if the file cannot be created
+     */
+    PcmWriter(const std::string& path, const PcmFormat& format,
+              size_t buffer_bytes = DEFAULT_IO_BUFFER_BYTES);
+
+    /** Closes the stream if close() was not called; errors are swallowed */
+    virtual ~PcmWriter();
+
+    PcmWriter(const PcmWriter&) = delete;
+    PcmWriter& operator=(const PcmWriter&) = delete;
+
+    const PcmFormat& format() const { return format_; }
+    uint64_t framesWritten() const { return data_bytes_ / format_.frameBytes(); }
+
+    /**
+     * Convert and append interleaved frames
+     *
+     * @param in frames × channels Samples; values are clamped to [-1.0, 1.0]
+     * @param frames Number of frames
+     * @throws std::length_error past the format's size limit (4 GiB of data for WAV)
+     */
+    void write(const dsp::Sample* in, size_t frames);
+
+    /**
+     * Flush buffered data and close the file
+     */
+    void close();
+
+protected:
+    /** Bytes reserved before the data region (header) */
+    PcmWriter(const std::string& path, const PcmFormat& format,
+              size_t buffer_bytes, size_t header_bytes);
+
+    /** Called by close() before the file is closed, to patch headers */
+    virtual void finalize() {}
+
+    void writeAt(const void* data, size_t length, uint64_t offset);
+
+    uint64_t data_bytes_ = 0;
+    uint64_t max_data_bytes_ = UINT64_MAX;
+
+private:
+    int fd_ = -1;
+    std::string path_;
+    PcmFormat format_;
+    AlignedBuffer buffer_;
+    size_t buffer_len_ = 0;
+    uint64_t file_pos_ = 0;
+
+    void flush();
+};
+
+/**
+ * Streaming WAV writer
+ *
+ * Writes a canonical 44-byte header whose sizes are patched on close().
+ * WAV sizes are 32-bit, so the data region is limited to 4 GiB; use
+ * PcmWriter or CaptureWriter for longer recordings.
+ */
+class WavWriter : public PcmWriter {
+public:
+    WavWriter(const std::string& path, const PcmFormat& format,
+              size_t buffer_bytes = DEFAULT_IO_BUFFER_BYTES);
+
+    ~WavWriter() override;
+
+protected:
+    void finalize() override;
+};
+
+} // namespace io
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_IO_PCM_FILE_H
@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <cmath>
 
+#include "protocol/codec.h"
+
 /**
  * @file main.cpp
  * @brief Harmonic IoT Protocol - Proof of Concept Implementation
@@ -18,107 +20,15 @@
 
 namespace HarmonicProtocol {
     
-    /**
-     * @brief Base frequency for the harmonic series (in Hz)
-     * In a real implementation, this would be configurable and synchronized
-     * across all devices in the network.
-     */
-    constexpr double FUNDAMENTAL_FREQUENCY = 1000.0; // 1 kHz
-    
-    /**
-     * @brief Maximum number of harmonic channels supported
-     */
-    constexpr int MAX_HARMONICS = 256;
-    
-    /**
-     * @brief Harmonic channel assignments for different device functions
-     */
-    enum class HarmonicChannel : int {
-        CONTROL = 2,        // H2: 2 * f₀ = 2 kHz
-        SENSOR_TEMP = 3,    // H3: 3 * f₀ = 3 kHz
-        SENSOR_HUMIDITY = 4, // H4: 4 * f₀ = 4 kHz
-        ACTUATOR_LED = 5,   // H5: 5 * f₀ = 5 kHz
-        SECURITY = 7,       // H7: 7 * f₀ = 7 kHz
-        DATA_STREAM = 8     // H8: 8 * f₀ = 8 kHz
-    };
-    
-    /**
-     * @brief Calculate the actual frequency for a given harmonic number
-     * @param harmonic_number The harmonic multiplier (H1, H2, H3, etc.)
-     * @return The calculated frequency in Hz
-     */
-    double calculateHarmonicFrequency(int harmonic_number) {
-        return FUNDAMENTAL_FREQUENCY * harmonic_number;
-    }
-    
-    /**
-     * @brief Encode a message into harmonic frequency representations
-     * @param message The input message to encode
-     * @param channel The harmonic channel to use for encoding
-     * @return Vector of encoded harmonic frequencies
-     */
-    std::vector<int> encodeMessage(const std::string& message, HarmonicChannel channel) {
-        std::vector<int> encoded_frequencies;
-        int base_harmonic = static_cast<int>(channel);
-        
-        for (size_t i = 0; i < message.length(); ++i) {
-            char c = message[i];
-            // Encode character using harmonic offset from base channel
-            // This creates a unique harmonic signature for each character
-            int harmonic_offset = static_cast<int>(c) % 32; // Limit offset range
-            int encoded_harmonic = base_harmonic + harmonic_offset;
-            
-            // Ensure we don't exceed maximum harmonics
-            if (encoded_harmonic > MAX_HARMONICS) {
-                encoded_harmonic = base_harmonic + (harmonic_offset % 16);
-            }
-            
-            encoded_frequencies.push_back(encoded_harmonic);
-        }
-        
-        return encoded_frequencies;
-    }
-    
-    /**
-     * @brief Decode harmonic frequencies back into the original message
-     * @param encoded_frequencies Vector of encoded harmonic frequencies
-     * @param channel The harmonic channel used for encoding
-     * @return The decoded message string
-     */
-    std::string decodeMessage(const std::vector<int>& encoded_frequencies, HarmonicChannel channel) {
-        std::string decoded_message;
-        int base_harmonic = static_cast<int>(channel);
-        
-        for (int encoded_harmonic : encoded_frequencies) {
-            // Extract the harmonic offset and reconstruct the character
-            int harmonic_offset = encoded_harmonic - base_harmonic;
-            
-            // Reconstruct character from harmonic offset
-            // This is a simplified approach; real implementation would use
-            // more sophisticated frequency analysis
-            char decoded_char = static_cast<char>(harmonic_offset + 32); // Offset for printable ASCII
-            
-            // Handle edge cases for character reconstruction
-            if (decoded_char < 32 || decoded_char > 126) {
-                // Use a more robust reconstruction method
-                decoded_char = static_cast<char>((harmonic_offset % 95) + 32);
-            }
-            
-            decoded_message += decoded_char;
-        }
-        
-        return decoded_message;
-    }
-    
     /**
      * @brief Display harmonic frequency information
-     * @param harmonics Vector of harmonic numbers
+     * @param harmonics Encoded harmonic numbers
      * @param channel The harmonic channel being used
      */
-    void displayHarmonicInfo(const std::vector<int>& harmonics, HarmonicChannel channel) {
-        std::cout << "\n=== Harmonic Analysis ===" << std::endl;
+    void displayHarmonicInfo(const EncodedFrame& harmonics, HarmonicChannel channel) {
+        std::cout << "\n=== Harmonic Analysis ===\n";
         std::cout << "Base Channel: H" << static_cast<int>(channel) 
-                  << " (" << calculateHarmonicFrequency(static_cast<int>(channel)) << " Hz)" << std::endl;
+                  << " (" << calculateHarmonicFrequency(static_cast<int>(channel)) << " Hz)\n";
         std::cout << "Encoded Harmonics: ";
         
         for (size_t i = 0; i < harmonics.size(); ++i) {
@@ -127,7 +37,7 @@ namespace HarmonicProtocol {
                       << " (" << std::fixed << std::setprecision(1) 
                       << calculateHarmonicFrequency(harmonics[i]) << " Hz)";
         }
-        std::cout << std::endl;
+        std::cout << '\n';
     }
 }
 
@@ -138,8 +48,8 @@ namespace HarmonicProtocol {
 int main() {
     using namespace HarmonicProtocol;
     
-    std::cout << "=== Harmonic IoT Protocol - Proof of Concept ===" << std::endl;
-    std::cout << "Fundamental Frequency (f₀): " << FUNDAMENTAL_FREQUENCY << " Hz" << std::endl;
+    std::cout << "=== Harmonic IoT Protocol - Proof of Concept ===\n";
+    std::cout << "Fundamental Frequency (f₀): " << FUNDAMENTAL_FREQUENCY << " Hz\n";
     
     // Test messages for different scenarios
     std::vector<std::pair<std::string, HarmonicChannel>> test_cases = {
@@ -153,38 +63,38 @@ int main() {
         const std::string& message = test_case.first;
         HarmonicChannel channel = test_case.second;
         
-        std::cout << "\n" << std::string(50, '=') << std::endl;
+        std::cout << "\n" << std::string(50, '=') << '\n';
         std::cout << "Testing Channel: H" << static_cast<int>(channel) 
-                  << " (" << calculateHarmonicFrequency(static_cast<int>(channel)) << " Hz)" << std::endl;
-        std::cout << "Original Message: \"" << message << "\"" << std::endl;
+                  << " (" << calculateHarmonicFrequency(static_cast<int>(channel)) << " Hz)\n";
+        std::cout << "Original Message: \"" << message << "\"\n";
         
         // Encode the message
-        std::vector<int> encoded = encodeMessage(message, channel);
+        EncodedFrame encoded = encodeMessage(message, channel);
         displayHarmonicInfo(encoded, channel);
         
         // Decode the message
         std::string decoded = decodeMessage(encoded, channel);
-        std::cout << "Decoded Message: \"" << decoded << "\"" << std::endl;
+        std::cout << "Decoded Message: \"" << decoded << "\"\n";
         
         // Verify encoding/decoding integrity
         bool success = (message.length() == decoded.length());
-        std::cout << "Status: " << (success ? "✓ SUCCESS" : "✗ FAILED") << std::endl;
+        std::cout << "Status: " << (success ? "✓ SUCCESS" : "✗ FAILED") << '\n';
         
         if (!success) {
             std::cout << "Length mismatch - Original: " << message.length() 
-                      << ", Decoded: " << decoded.length() << std::endl;
+                      << ", Decoded: " << decoded.length() << '\n';
         }
     }
     
-    std::cout << "\n" << std::string(50, '=') << std::endl;
-    std::cout << "=== Protocol Demonstration Complete ===" << std::endl;
-    std::cout << "\nNote: This is a simplified proof-of-concept." << std::endl;
-    std::cout << "Real implementation would include:" << std::endl;
-    std::cout << "• Actual frequency modulation and demodulation" << std::endl;
-    std::cout << "• FFT-based signal processing" << std::endl;
-    std::cout << "• Network synchronization protocols" << std::endl;
-    std::cout << "• Error correction and detection" << std::endl;
-    std::cout << "• Multi-device coordination" << std::endl;
+    std::cout << "\n" << std::string(50, '=') << '\n';
+    std::cout << "=== Protocol Demonstration Complete ===\n";
+    std::cout << "\nNote: This is a simplified proof-of-concept.\n";
+    std::cout << "Real implementation would include:\n";
+    std::cout << "• Actual frequency modulation and demodulation\n";
+    std::cout << "• FFT-based signal processing\n";
+    std::cout << "• Network synchronization protocols\n";
+    std::cout << "• Error correction and detection\n";
+    std::cout << "• Multi-device coordination\n";
     
     return 0;
 }
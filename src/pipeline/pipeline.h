@@ -0,0 +1,365 @@
+/**
+ * Staged Dataflow Pipeline for Harmonic IoT Protocol
+ *
+ * A linear chain of stages connected by bounded lock-free queues. Each
+ * stage processes items in batches and may run on several cores at once;
+ * stage instances are scheduled as tasks on the shared work-stealing pool,
+ * so an idle stage costs nothing and a busy one scales up to its
+ * configured parallelism. When a downstream queue is full the producing
+ * stage helps run pending tasks instead of blocking, which propagates
+ * back-pressure to the source without deadlock.
+ *
+ * Per-stage counters (items, batches, busy time, queue depth, stalls)
+ * identify the bottleneck, and setParallelism() scales it at run time.
+ * collectMetrics() exports the same counters to a metrics registry.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_PIPELINE_PIPELINE_H
+#define HARMONIC_IOT_PIPELINE_PIPELINE_H
+
+#include "runtime/mpmc_queue.h"
+#include "runtime/thread_pool.h"
+#include "telemetry/alloc_accounting.h"
+#include "telemetry/metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace harmonic_iot {
+namespace pipeline {
+
+/**
+ * Per-stage execution parameters
+ */
+struct StageConfig {
+    size_t parallelism = 1;        ///< Maximum concurrent instances of the stage
+    size_t batch_size = 32;        ///< Items handed to one stage call
+    size_t queue_capacity = 1024;  ///< Bound of the stage's input queue
+};
+
+/**
+ * Counters for one stage
+ */
+struct StageStats {
+    std::string name;
+    size_t parallelism = 0;
+    uint64_t items = 0;            ///< Items processed
+    uint64_t dropped = 0;          ///< Items filtered out by the stage
+    uint64_t batches = 0;
+    double busy_seconds = 0.0;     ///< Summed over all instances
+    double max_batch_seconds = 0.0;
+    size_t queue_depth = 0;        ///< Items waiting at the stage's input
+    uint64_t stalls = 0;           ///< Times the stage found the next queue full
+    double mean_item_us = 0.0;     ///< busy_seconds / items
+    double utilization = 0.0;      ///< busy / (wall time × parallelism)
+};
+
+/**
+ * Chain of batch stages over items of type Item
+ *
+ * A stage function receives a batch of item pointers, processes them in
+ * place and returns how many to forward. Items to forward must be moved
+ * to the front of the array; the remainder are dropped. Items leaving the
+ * last stage, and dropped items, are handed to the release function (for
+ * example to return them to a pool).
+ *
+ * Stages must be added before the first push() and must not throw. With
+ * parallelism > 1 a stage may reorder items.
+ */
+template <typename Item>
+class Pipeline {
+public:
+    using StageFunction = std::function<size_t(Item** items, size_t count)>;
+    using ReleaseFunction = std::function<void(Item* item)>;
+
+    explicit Pipeline(ReleaseFunction release,
+                      runtime::ThreadPool& pool = runtime::ThreadPool::shared(),
+                      runtime::TaskPriority priority = runtime::TaskPriority::High)
+        : release_(std::move(release)), pool_(pool), priority_(priority) {}
+
+    /** Waits for every item in flight */
+    ~Pipeline() { drain(); }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * Append a stage
+     *
+     * @return Stage index
+     * @throws std::logic_error once items have been pushed
+     */
+    size_t addStage(std::string name, StageFunction function, const StageConfig& config = StageConfig()) {
+        if (started_.load(std::memory_order_relaxed)) {
+            throw std::logic_error("Pipeline stages must be added before the first push");
+        }
+        if (config.parallelism == 0 || config.batch_size == 0) {
+            throw std::invalid_argument("Stage parallelism and batch size must be positive");
+        }
+        stages_.emplace_back(new Stage(std::move(name), std::move(function), config));
+        return stages_.size() - 1;
+    }
+
+    size_t stageCount() const { return stages_.size(); }
+
+    /** Items pushed and not yet released */
+    size_t inFlight() const { return static_cast<size_t>(in_flight_.load(std::memory_order_acquire)); }
+
+    /**
+     * Offer an item to the first stage
+     *
+     * @return False if the first stage's queue is full
+     */
+    bool tryPush(Item* item) {
+        if (stages_.empty()) {
+            throw std::logic_error("Pipeline has no stages");
+        }
+        markStarted();
+        in_flight_.fetch_add(1, std::memory_order_relaxed);
+        if (!stages_[0]->input.tryPush(item)) {
+            in_flight_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        schedule(0);
+        return true;
+    }
+
+    /**
+     * Push an item, helping the pool while the first queue is full
+     */
+    void push(Item* item) {
+        while (!tryPush(item)) {
+            stages_[0]->stalls.fetch_add(1, std::memory_order_relaxed);
+            backOff();
+        }
+    }
+
+    /**
+     * Wait until every pushed item has been released
+     */
+    void drain() {
+        while (in_flight_.load(std::memory_order_acquire) != 0) {
+            backOff();
+        }
+    }
+
+    /**
+     * Change a stage's maximum concurrency while running
+     */
+    void setParallelism(size_t stage, size_t parallelism) {
+        if (parallelism == 0) {
+            throw std::invalid_argument("Stage parallelism must be positive");
+        }
+        stages_.at(stage)->parallelism.store(parallelism, std::memory_order_relaxed);
+        schedule(stage);
+    }
+
+    std::vector<StageStats> stats() const {
+        std::vector<StageStats> result;
+        int64_t started = started_ns_.load(std::memory_order_relaxed);
+        double wall = started != 0 ? static_cast<double>(nowNs() - started) * 1e-9 : 0.0;
+        for (const auto& stage : stages_) {
+            StageStats s;
+            s.name = stage->name;
+            s.parallelism = stage->parallelism.load(std::memory_order_relaxed);
+            s.items = stage->items.load(std::memory_order_relaxed);
+            s.dropped = stage->dropped.load(std::memory_order_relaxed);
+            s.batches = stage->batches.load(std::memory_order_relaxed);
+            s.busy_seconds = static_cast<double>(stage->busy_ns.load(std::memory_order_relaxed)) * 1e-9;
+            s.max_batch_seconds = static_cast<double>(stage->max_batch_ns.load(std::memory_order_relaxed)) * 1e-9;
+            s.queue_depth = stage->input.sizeApprox();
+            s.stalls = stage->stalls.load(std::memory_order_relaxed);
+            if (s.items > 0) {
+                s.mean_item_us = s.busy_seconds * 1e6 / static_cast<double>(s.items);
+            }
+            if (wall > 0.0) {
+                s.utilization = s.busy_seconds / (wall * static_cast<double>(s.parallelism));
+            }
+            result.push_back(s);
+        }
+        return result;
+    }
+
+    /**
+     * Write per-stage counters and queue depths, labeled by stage
+     *
+     * Meant for a metrics collector; the values are read at scrape time.
+     */
+    void collectMetrics(telemetry::MetricsWriter& writer, const telemetry::MetricLabels& labels) const {
+        for (const StageStats& s : stats()) {
+            telemetry::MetricLabels stage_labels = labels;
+            stage_labels.emplace_back("stage", s.name);
+            writer.counter("harmonic_pipeline_items_total", "Items processed by the stage",
+                           stage_labels, static_cast<double>(s.items));
+            writer.counter("harmonic_pipeline_dropped_total", "Items shed by the stage",
+                           stage_labels, static_cast<double>(s.dropped));
+            writer.counter("harmonic_pipeline_stalls_total", "Times the stage found the next queue full",
+                           stage_labels, static_cast<double>(s.stalls));
+            writer.counter("harmonic_pipeline_busy_seconds_total", "Time spent in the stage function",
+                           stage_labels, s.busy_seconds);
+            writer.gauge("harmonic_pipeline_queue_depth", "Items waiting at the stage input",
+                         stage_labels, static_cast<double>(s.queue_depth));
+            writer.gauge("harmonic_pipeline_parallelism", "Maximum concurrent stage instances",
+                         stage_labels, static_cast<double>(s.parallelism));
+        }
+    }
+
+private:
+    /** Batches one stage task processes before yielding its worker */
+    static constexpr size_t BATCHES_PER_TASK = 16;
+    static constexpr size_t INLINE_BATCH = 64;
+
+    struct Stage {
+        Stage(std::string stage_name, StageFunction fn, const StageConfig& config)
+            : name(std::move(stage_name)), function(std::move(fn)),
+              batch_size(config.batch_size), input(config.queue_capacity),
+              parallelism(config.parallelism),
+              alloc_site(telemetry::allocationAccountingEnabled()
+                             ? telemetry::allocSite("stage:" + name) : nullptr) {}
+
+        std::string name;
+        StageFunction function;
+        size_t batch_size;
+        runtime::MpmcQueue<Item*> input;
+        std::atomic<size_t> parallelism;
+        alignas(runtime::CACHE_LINE_SIZE) std::atomic<size_t> active{0};
+        alignas(runtime::CACHE_LINE_SIZE) std::atomic<uint64_t> items{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<int64_t> busy_ns{0};
+        std::atomic<int64_t> max_batch_ns{0};
+        std::atomic<uint64_t> stalls{0};
+        telemetry::AllocSite* alloc_site;      // Accounting builds only
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void markStarted() {
+        if (!started_.load(std::memory_order_relaxed) && !started_.exchange(true)) {
+            started_ns_.store(nowNs(), std::memory_order_relaxed);
+        }
+    }
+
+    void backOff() {
+        if (!pool_.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Start another instance of a stage if it has input and spare parallelism
+     */
+    void schedule(size_t index) {
+        Stage& stage = *stages_[index];
+        // Pairs with the fence in runStage(): either this thread sees the
+        // instance retire, or the instance sees this thread's item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t active = stage.active.load(std::memory_order_relaxed);
+        while (active < stage.parallelism.load(std::memory_order_relaxed)) {
+            if (stage.input.sizeApprox() == 0) {
+                return;
+            }
+            if (stage.active.compare_exchange_weak(active, active + 1, std::memory_order_seq_cst)) {
+                pool_.submit([this, index] { runStage(index); }, priority_);
+                return;
+            }
+        }
+    }
+
+    void runStage(size_t index) {
+        Stage& stage = *stages_[index];
+        // Typical batches live on the stack; only oversized ones allocate
+        Item* inline_batch[INLINE_BATCH];
+        std::vector<Item*> large_batch;
+        Item** batch = inline_batch;
+        if (stage.batch_size > INLINE_BATCH) {
+            large_batch.resize(stage.batch_size);
+            batch = large_batch.data();
+        }
+
+        for (size_t round = 0; round < BATCHES_PER_TASK; ++round) {
+            size_t count = stage.input.tryPopBatch(batch, stage.batch_size);
+            if (count == 0) {
+                break;
+            }
+            int64_t start = nowNs();
+            size_t kept;
+            {
+#if HARMONIC_IOT_ALLOC_ACCOUNTING
+                telemetry::AllocScope accounting(stage.alloc_site);
+#endif
+                kept = stage.function(batch, count);
+            }
+            int64_t elapsed = nowNs() - start;
+
+            kept = std::min(kept, count);
+            stage.items.fetch_add(count, std::memory_order_relaxed);
+            stage.dropped.fetch_add(count - kept, std::memory_order_relaxed);
+            stage.batches.fetch_add(1, std::memory_order_relaxed);
+            stage.busy_ns.fetch_add(elapsed, std::memory_order_relaxed);
+            int64_t max = stage.max_batch_ns.load(std::memory_order_relaxed);
+            while (elapsed > max && !stage.max_batch_ns.compare_exchange_weak(max, elapsed,
+                                                                              std::memory_order_relaxed)) {
+            }
+
+            for (size_t i = kept; i < count; ++i) {
+                retire(batch[i]);
+            }
+            forward(index, batch, kept);
+        }
+
+        stage.active.fetch_sub(1, std::memory_order_seq_cst);
+        schedule(index);
+    }
+
+    void forward(size_t index, Item** items, size_t count) {
+        if (index + 1 == stages_.size()) {
+            for (size_t i = 0; i < count; ++i) {
+                retire(items[i]);
+            }
+            return;
+        }
+        Stage& next = *stages_[index + 1];
+        for (size_t i = 0; i < count; ++i) {
+            while (!next.input.tryPush(items[i])) {
+                stages_[index]->stalls.fetch_add(1, std::memory_order_relaxed);
+                schedule(index + 1);
+                backOff();
+            }
+        }
+        if (count > 0) {
+            schedule(index + 1);
+        }
+    }
+
+    void retire(Item* item) {
+        release_(item);
+        in_flight_.fetch_sub(1, std::memory_order_release);
+    }
+
+    ReleaseFunction release_;
+    runtime::ThreadPool& pool_;
+    runtime::TaskPriority priority_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::atomic<bool> started_{false};
+    std::atomic<int64_t> started_ns_{0};
+    alignas(runtime::CACHE_LINE_SIZE) std::atomic<int64_t> in_flight_{0};
+};
+
+} // namespace pipeline
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_PIPELINE_PIPELINE_H
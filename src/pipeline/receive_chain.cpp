@@ -0,0 +1,200 @@
+/**
+ * Native Receive Chain for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "receive_chain.h"
+#include "telemetry/probes.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace harmonic_iot {
+namespace pipeline {
+
+namespace {
+
+dsp::PeakDetectorConfig detectorConfig(const ReceiveChainConfig& config) {
+    dsp::PeakDetectorConfig detector;
+    detector.sample_rate = config.sample_rate;
+    detector.f0 = config.integrity.f0;
+    detector.threshold_db = config.threshold_db;
+    return detector;
+}
+
+} // namespace
+
+void ReceiveFrame::reset() {
+    sequence = 0;
+    received_ns = 0;
+    samples.clear();
+    // Drop the containers' arena memory before rewinding the arena
+    components = std::pmr::vector<dsp::DetectedComponent>(&arena);
+    symbols = HarmonicProtocol::EncodedFrame(&arena);
+    message = std::pmr::string(&arena);
+    arena.reset();
+}
+
+ReceiveChain::ReceiveChain(const ReceiveChainConfig& config, Sink sink, runtime::ThreadPool& pool)
+    : config_(config),
+      sink_(std::move(sink)),
+      pool_(pool),
+      detector_(config.symbol_samples, detectorConfig(config)),
+      verifier_(config.integrity),
+      chunk_pool_(FRAME_ARENA_BYTES),
+      chunk_resource_(chunk_pool_),
+      free_(config.frame_pool),
+      pipeline_([this](ReceiveFrame* frame) { recycle(frame); }, pool) {
+    frames_.reserve(config_.frame_pool);
+    for (size_t i = 0; i < config_.frame_pool; ++i) {
+        frames_.emplace_back(new ReceiveFrame(&chunk_resource_));
+        free_.tryPush(frames_.back().get());
+    }
+    if (config_.metrics) {
+        registerMetrics(*config_.metrics);
+    }
+
+    pipeline_.addStage("detect", [this](ReceiveFrame** f, size_t n) { return detectStage(f, n); },
+                       config_.detect);
+    pipeline_.addStage("decode", [this](ReceiveFrame** f, size_t n) { return decodeStage(f, n); },
+                       config_.decode);
+    pipeline_.addStage("verify", [this](ReceiveFrame** f, size_t n) { return verifyStage(f, n); },
+                       config_.verify);
+    pipeline_.addStage("sink", [this](ReceiveFrame** f, size_t n) { return sinkStage(f, n); },
+                       config_.sink);
+}
+
+ReceiveChain::~ReceiveChain() {
+    collector_.reset();
+    pipeline_.drain();
+}
+
+void ReceiveChain::registerMetrics(telemetry::MetricsRegistry& registry) {
+    const telemetry::MetricLabels labels = {
+        {"pipeline", config_.name},
+        {"channel", std::to_string(static_cast<int>(config_.channel))}
+    };
+    frames_total_ = &registry.counter("harmonic_frames_total", "Frames decoded", labels);
+    decode_errors_ = &registry.counter("harmonic_decode_errors_total",
+                                       "Symbol slots outside the channel's harmonic range", labels);
+    integrity_failures_ = &registry.counter("harmonic_integrity_failures_total",
+                                            "Frames below the rational integrity threshold", labels);
+    integrity_score_ = &registry.histogram("harmonic_integrity_score",
+                                           "Rational integrity score per frame (percent)",
+                                           {50.0, 75.0, 90.0, 95.0, 99.0, 100.0}, labels);
+
+    // Same labels as the hot-path counters: one chain per channel on a shared
+    // registry must export distinct series
+    collector_ = telemetry::CollectorRegistration(registry, [this, labels](telemetry::MetricsWriter& writer) {
+        pipeline_.collectMetrics(writer, labels);
+        writer.gauge("harmonic_receive_frames_free", "Pooled frames available to the source",
+                     labels, static_cast<double>(free_.sizeApprox()));
+    });
+}
+
+ReceiveFrame* ReceiveChain::acquire() {
+    ReceiveFrame* frame = nullptr;
+    while (!free_.tryPop(frame)) {
+        if (!pool_.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+    frame->reset();
+    return frame;
+}
+
+void ReceiveChain::submit(ReceiveFrame* frame) {
+    HIOT_PROBE2(frame_received, frame->sequence, frame->samples.size());
+    pipeline_.push(frame);
+}
+
+void ReceiveChain::recycle(ReceiveFrame* frame) {
+    free_.tryPush(frame);    // Cannot fail: the queue holds every frame
+}
+
+// ─── Stages ──────────────────────────────────────────────────────────────
+
+size_t ReceiveChain::detectStage(ReceiveFrame** frames, size_t count) {
+    thread_local std::vector<dsp::DetectedComponent> slot_components;
+    const size_t slot = config_.symbol_samples;
+    const double f0 = config_.integrity.f0;
+
+    for (size_t i = 0; i < count; ++i) {
+        ReceiveFrame* frame = frames[i];
+        const size_t slots = (frame->samples.size() + slot - 1) / slot;
+        frame->symbols.clear();
+        frame->symbols.resize(slots, 0);
+
+        for (size_t s = 0; s < slots; ++s) {
+            size_t offset = s * slot;
+            size_t length = std::min(slot, frame->samples.size() - offset);
+            detector_.detect(dsp::SampleSpan(frame->samples.data() + offset, length), slot_components);
+            if (!slot_components.empty()) {
+                // Strongest peak carries the symbol
+                frame->symbols[s] = static_cast<int>(std::lround(slot_components.front().frequency / f0));
+                frame->components.insert(frame->components.end(),
+                                         slot_components.begin(), slot_components.end());
+            }
+        }
+    }
+
+    // Silent frames stop here. Swap compaction keeps the survivors in order
+    // and, unlike std::stable_partition, never allocates a buffer; the
+    // dropped frames end up in [kept, count) for the pipeline to recycle.
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!frames[i]->components.empty()) {
+            std::swap(frames[kept++], frames[i]);
+        }
+    }
+    return kept;
+}
+
+size_t ReceiveChain::decodeStage(ReceiveFrame** frames, size_t count) {
+    const int base = static_cast<int>(config_.channel);
+    uint64_t errors = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ReceiveFrame* frame = frames[i];
+        for (int symbol : frame->symbols) {
+            errors += (symbol < base || symbol > base + HarmonicProtocol::MAX_SYMBOL_OFFSET) ? 1 : 0;
+        }
+        frame->message = HarmonicProtocol::decodeMessage(frame->symbols.data(), frame->symbols.size(),
+                                                         config_.channel, &frame->arena);
+        HIOT_PROBE3(symbol_decoded, frame->sequence, frame->symbols.size(), base);
+    }
+    if (frames_total_) {
+        frames_total_->inc(count);
+        if (errors > 0) {
+            decode_errors_->inc(errors);
+        }
+    }
+    return count;
+}
+
+size_t ReceiveChain::verifyStage(ReceiveFrame** frames, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        ReceiveFrame* frame = frames[i];
+        verifier_.verify(frame->components.data(), frame->components.size(), frame->report);
+        if (integrity_score_) {
+            integrity_score_->observe(frame->report.integrity_score);
+            if (!frame->report.passed()) {
+                integrity_failures_->inc();
+            }
+        }
+    }
+    return count;
+}
+
+size_t ReceiveChain::sinkStage(ReceiveFrame** frames, size_t count) {
+    if (sink_) {
+        for (size_t i = 0; i < count; ++i) {
+            sink_(*frames[i]);
+        }
+    }
+    return count;
+}
+
+} // namespace pipeline
+} // namespace harmonic_iot
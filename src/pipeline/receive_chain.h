@@ -0,0 +1,175 @@
+/**
+ * Native Receive Chain for Harmonic IoT Protocol
+ *
+ * The receive path as a pipeline: the caller (capture thread, file reader
+ * or socket) is the source, then
+ *
+ *   detect  – FFT peak detection per symbol slot (decode_fft)
+ *   decode  – strongest harmonic per slot → decodeMessage()
+ *   verify  – rational integrity of every component (verify_rational_integrity)
+ *   sink    – user callback
+ *
+ * Frames come from a fixed pool, so the number in flight is bounded.
+ * Decode output goes to per-frame arenas whose chunks come from a per-core
+ * slab pool, so steady-state operation performs no global-heap allocation.
+ *
+ * With a metrics registry configured, the chain counts frames, decode
+ * errors and integrity results per channel on sharded counters and
+ * exports its stage counters and queue depths at scrape time.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_PIPELINE_RECEIVE_CHAIN_H
+#define HARMONIC_IOT_PIPELINE_RECEIVE_CHAIN_H
+
+#include "dsp/peak_detector.h"
+#include "dsp/sample.h"
+#include "dsp/spectral_verification.h"
+#include "pipeline/pipeline.h"
+#include "protocol/codec.h"
+#include "runtime/batch_arena.h"
+#include "runtime/mpmc_queue.h"
+#include "runtime/slab_pool.h"
+#include "telemetry/metrics.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace harmonic_iot {
+namespace pipeline {
+
+/** Arena chunk per frame; holds the decode output of typical messages */
+constexpr size_t FRAME_ARENA_BYTES = 16384;
+
+/**
+ * One received message and everything derived from it
+ *
+ * Variable-size decode output lives in the frame's arena and is released
+ * in one step when the frame returns to the pool; the sample buffer keeps
+ * its capacity across uses.
+ */
+struct ReceiveFrame {
+    explicit ReceiveFrame(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : arena(FRAME_ARENA_BYTES, upstream), components(&arena), symbols(&arena), message(&arena) {}
+
+    ReceiveFrame(const ReceiveFrame&) = delete;
+    ReceiveFrame& operator=(const ReceiveFrame&) = delete;
+
+    /** Empty the frame and rewind its arena */
+    void reset();
+
+    uint64_t sequence = 0;                         ///< Set by the source
+    int64_t received_ns = 0;                       ///< Set by the source
+    std::vector<dsp::Sample> samples;              ///< One symbol slot after another
+    runtime::BatchArena arena;
+    std::pmr::vector<dsp::DetectedComponent> components;
+    HarmonicProtocol::EncodedFrame symbols;        ///< Harmonic number per slot (0 = silent)
+    std::pmr::string message;
+    dsp::SpectralReport report;
+};
+
+/**
+ * Receive chain parameters
+ */
+struct ReceiveChainConfig {
+    double sample_rate = 96000.0;       ///< Must cover the highest encoded harmonic
+    size_t symbol_samples = 1024;       ///< Samples per symbol slot (power of two)
+    HarmonicProtocol::HarmonicChannel channel = HarmonicProtocol::HarmonicChannel::DATA_STREAM;
+    float threshold_db = -40.0f;
+    dsp::IntegrityConfig integrity = defaultIntegrity();
+    size_t frame_pool = 256;            ///< Frames that may be in flight
+    std::string name = "receive";       ///< "pipeline" label on exported metrics (with "channel")
+    telemetry::MetricsRegistry* metrics = &telemetry::MetricsRegistry::global();  ///< nullptr: none
+
+    StageConfig detect{4, 8, 256};
+    StageConfig decode{1, 32, 256};
+    StageConfig verify{2, 16, 256};
+    StageConfig sink{1, 32, 256};
+
+    /** Codec f₀ and an H_N wide enough for base + 31 harmonics */
+    static dsp::IntegrityConfig defaultIntegrity() {
+        dsp::IntegrityConfig config;
+        config.f0 = HarmonicProtocol::FUNDAMENTAL_FREQUENCY;
+        config.max_denominator = 64;
+        return config;
+    }
+};
+
+/**
+ * Pooled source → detect → decode → verify → sink chain
+ */
+class ReceiveChain {
+public:
+    enum StageIndex : size_t { DETECT = 0, DECODE = 1, VERIFY = 2, SINK = 3 };
+
+    /** Called for every frame that contained signal; the frame is recycled afterwards */
+    using Sink = std::function<void(const ReceiveFrame& frame)>;
+
+    ReceiveChain(const ReceiveChainConfig& config, Sink sink,
+                 runtime::ThreadPool& pool = runtime::ThreadPool::shared());
+
+    /** Drains frames still in flight */
+    ~ReceiveChain();
+
+    ReceiveChain(const ReceiveChain&) = delete;
+    ReceiveChain& operator=(const ReceiveChain&) = delete;
+
+    const ReceiveChainConfig& config() const { return config_; }
+
+    /**
+     * Take an empty frame from the pool, helping the pipeline while none is free
+     */
+    ReceiveFrame* acquire();
+
+    /**
+     * Hand a filled frame to the detect stage
+     */
+    void submit(ReceiveFrame* frame);
+
+    /** Wait for every submitted frame to reach the sink */
+    void drain() { pipeline_.drain(); }
+
+    std::vector<StageStats> stats() const { return pipeline_.stats(); }
+
+    /** Source of frame arena chunks */
+    const runtime::SlabPool& chunkPool() const { return chunk_pool_; }
+
+    /** Underlying pipeline, e.g. to setParallelism() on the bottleneck */
+    Pipeline<ReceiveFrame>& pipeline() { return pipeline_; }
+
+private:
+    size_t detectStage(ReceiveFrame** frames, size_t count);
+    size_t decodeStage(ReceiveFrame** frames, size_t count);
+    size_t verifyStage(ReceiveFrame** frames, size_t count);
+    size_t sinkStage(ReceiveFrame** frames, size_t count);
+    void recycle(ReceiveFrame* frame);
+    void registerMetrics(telemetry::MetricsRegistry& registry);
+
+    ReceiveChainConfig config_;
+    Sink sink_;
+    runtime::ThreadPool& pool_;
+    dsp::PeakDetector detector_;
+    dsp::IntegrityVerifier verifier_;
+    runtime::SlabPool chunk_pool_;
+    runtime::SlabResource chunk_resource_;
+    std::vector<std::unique_ptr<ReceiveFrame>> frames_;
+    runtime::MpmcQueue<ReceiveFrame*> free_;
+    Pipeline<ReceiveFrame> pipeline_;    // Drained before the frames go away
+
+    // Hot-path metrics; null without a registry
+    telemetry::Counter* frames_total_ = nullptr;
+    telemetry::Counter* decode_errors_ = nullptr;
+    telemetry::Counter* integrity_failures_ = nullptr;
+    telemetry::Histogram* integrity_score_ = nullptr;
+    telemetry::CollectorRegistration collector_;    // Reads pipeline_; removed first
+};
+
+} // namespace pipeline
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_PIPELINE_RECEIVE_CHAIN_H
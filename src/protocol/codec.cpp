@@ -0,0 +1,127 @@
+/**
+ * Harmonic Message Codec for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "protocol/codec.h"
+#include "telemetry/alloc_accounting.h"
+#include "telemetry/latency.h"
+
+namespace HarmonicProtocol {
+
+    namespace {
+
+        /**
+         * @brief Harmonic number for one character on a base channel
+         */
+        inline int encodeSymbol(char c, int base_harmonic) {
+            // Encode character using harmonic offset from base channel
+            // This creates a unique harmonic signature for each character
+            int harmonic_offset = static_cast<int>(c) % (MAX_SYMBOL_OFFSET + 1); // Limit offset range
+            int encoded_harmonic = base_harmonic + harmonic_offset;
+
+            // Ensure we don't exceed maximum harmonics
+            if (encoded_harmonic > MAX_HARMONICS) {
+                encoded_harmonic = base_harmonic + (harmonic_offset % 16);
+            }
+            return encoded_harmonic;
+        }
+
+        /**
+         * @brief Character for one harmonic number on a base channel
+         */
+        inline char decodeSymbol(int encoded_harmonic, int base_harmonic) {
+            // Extract the harmonic offset and reconstruct the character
+            int harmonic_offset = encoded_harmonic - base_harmonic;
+
+            // Reconstruct character from harmonic offset
+            // This is a simplified approach; real implementation would use
+            // more sophisticated frequency analysis
+            char decoded_char = static_cast<char>(harmonic_offset + 32); // Offset for printable ASCII
+
+            // Handle edge cases for character reconstruction
+            if (decoded_char < 32 || decoded_char > 126) {
+                // Use a more robust reconstruction method
+                decoded_char = static_cast<char>((harmonic_offset % 95) + 32);
+            }
+            return decoded_char;
+        }
+    }
+    
+    /**
+     * @brief Calculate the actual frequency for a given harmonic number
+     * @param harmonic_number The harmonic multiplier (H1, H2, H3, etc.)
+     * @return The calculated frequency in Hz
+     */
+    double calculateHarmonicFrequency(int harmonic_number) {
+        return FUNDAMENTAL_FREQUENCY * harmonic_number;
+    }
+
+    void calculateHarmonicFrequencies(const int* harmonic_numbers, size_t count, double* frequencies) {
+        for (size_t i = 0; i < count; ++i) {
+            frequencies[i] = FUNDAMENTAL_FREQUENCY * harmonic_numbers[i];
+        }
+    }
+    
+    /**
+     * @brief Encode a message into harmonic frequency representations
+     * @param message The input message to encode
+     * @param channel The harmonic channel to use for encoding
+     * @param resource Allocation source if the message exceeds the inline capacity
+     * @return Encoded harmonic frequencies
+     */
+    EncodedFrame encodeMessage(std::string_view message, HarmonicChannel channel,
+                               std::pmr::memory_resource* resource) {
+        HIOT_LATENCY_SCOPE(Encode);
+        HIOT_ALLOC_SCOPE("encode");
+        EncodedFrame encoded_frequencies(resource);
+        encoded_frequencies.resize(message.length());
+        int base_harmonic = static_cast<int>(channel);
+        
+        for (size_t i = 0; i < message.length(); ++i) {
+            encoded_frequencies[i] = encodeSymbol(message[i], base_harmonic);
+        }
+        
+        return encoded_frequencies;
+    }
+    
+    /**
+     * @brief Decode harmonic frequencies back into the original message
+     * @param encoded_frequencies Vector of encoded harmonic frequencies
+     * @param channel The harmonic channel used for encoding
+     * @return The decoded message string
+     */
+    std::string decodeMessage(const std::vector<int>& encoded_frequencies, HarmonicChannel channel) {
+        return decodeMessage(encoded_frequencies.data(), encoded_frequencies.size(), channel);
+    }
+
+    std::string decodeMessage(const int* encoded_frequencies, size_t count, HarmonicChannel channel) {
+        HIOT_LATENCY_SCOPE(Decode);
+        HIOT_ALLOC_SCOPE("decode");
+        std::string decoded_message(count, '\0');
+        int base_harmonic = static_cast<int>(channel);
+
+        for (size_t i = 0; i < count; ++i) {
+            decoded_message[i] = decodeSymbol(encoded_frequencies[i], base_harmonic);
+        }
+
+        return decoded_message;
+    }
+
+    std::pmr::string decodeMessage(const int* encoded_frequencies, size_t count, HarmonicChannel channel,
+                                   std::pmr::memory_resource* resource) {
+        HIOT_LATENCY_SCOPE(Decode);
+        HIOT_ALLOC_SCOPE("decode");
+        std::pmr::string decoded_message(resource);
+        decoded_message.resize(count);
+        int base_harmonic = static_cast<int>(channel);
+
+        for (size_t i = 0; i < count; ++i) {
+            decoded_message[i] = decodeSymbol(encoded_frequencies[i], base_harmonic);
+        }
+
+        return decoded_message;
+    }
+}
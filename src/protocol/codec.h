@@ -0,0 +1,114 @@
+/**
+ * Harmonic Message Codec for Harmonic IoT Protocol
+ *
+ * Maps message characters to harmonic numbers on a device channel and
+ * back. Shared by the proof-of-concept demo and the native receive chain.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_PROTOCOL_CODEC_H
+#define HARMONIC_IOT_PROTOCOL_CODEC_H
+
+#include "protocol/symbol_buffer.h"
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HarmonicProtocol {
+
+    /**
+     * @brief Base frequency for the harmonic series (in Hz)
+     * In a real implementation, this would be configurable and synchronized
+     * across all devices in the network.
+     */
+    constexpr double FUNDAMENTAL_FREQUENCY = 1000.0; // 1 kHz
+
+    /**
+     * @brief Maximum number of harmonic channels supported
+     */
+    constexpr int MAX_HARMONICS = 256;
+
+    /**
+     * @brief Largest harmonic offset a symbol adds to its channel's base harmonic
+     */
+    constexpr int MAX_SYMBOL_OFFSET = 31;
+
+    /**
+     * @brief Harmonic channel assignments for different device functions
+     */
+    enum class HarmonicChannel : int {
+        CONTROL = 2,        // H2: 2 * f₀ = 2 kHz
+        SENSOR_TEMP = 3,    // H3: 3 * f₀ = 3 kHz
+        SENSOR_HUMIDITY = 4, // H4: 4 * f₀ = 4 kHz
+        ACTUATOR_LED = 5,   // H5: 5 * f₀ = 5 kHz
+        SECURITY = 7,       // H7: 7 * f₀ = 7 kHz
+        DATA_STREAM = 8     // H8: 8 * f₀ = 8 kHz
+    };
+
+    /**
+     * @brief Calculate the actual frequency for a given harmonic number
+     * @param harmonic_number The harmonic multiplier (H1, H2, H3, etc.)
+     * @return The calculated frequency in Hz
+     */
+    double calculateHarmonicFrequency(int harmonic_number);
+
+    /**
+     * @brief Calculate the frequencies of many harmonics at once
+     * @param harmonic_numbers Harmonic multipliers (e.g. an encoded frame)
+     * @param count Number of harmonics
+     * @param frequencies Output, count frequencies in Hz
+     */
+    void calculateHarmonicFrequencies(const int* harmonic_numbers, size_t count, double* frequencies);
+
+    /**
+     * @brief Encode a message into harmonic frequency representations
+     * @param message The input message to encode
+     * @param channel The harmonic channel to use for encoding
+     * @param resource Allocation source if the message exceeds the inline capacity
+     * @return Encoded harmonic frequencies, inline for messages up to 64 characters
+     */
+    EncodedFrame encodeMessage(std::string_view message, HarmonicChannel channel,
+                               std::pmr::memory_resource* resource = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Decode harmonic frequencies back into the original message
+     * @param encoded_frequencies Vector of encoded harmonic frequencies
+     * @param channel The harmonic channel used for encoding
+     * @return The decoded message string
+     */
+    std::string decodeMessage(const std::vector<int>& encoded_frequencies, HarmonicChannel channel);
+
+    /**
+     * @brief Decode harmonic frequencies back into the original message
+     * @param encoded_frequencies Encoded harmonics
+     * @param count Number of harmonics
+     * @param channel The harmonic channel used for encoding
+     * @return The decoded message string
+     */
+    std::string decodeMessage(const int* encoded_frequencies, size_t count, HarmonicChannel channel);
+
+    /**
+     * @brief Decode an encoded frame back into the original message
+     */
+    template <size_t N>
+    std::string decodeMessage(const SymbolBuffer<N>& encoded_frequencies, HarmonicChannel channel) {
+        return decodeMessage(encoded_frequencies.data(), encoded_frequencies.size(), channel);
+    }
+
+    /**
+     * @brief Decode into memory from the given resource (e.g. a per-frame arena)
+     * @param encoded_frequencies Encoded harmonics
+     * @param count Number of harmonics
+     * @param channel The harmonic channel used for encoding
+     * @param resource Allocation source for the result
+     * @return Decoded message, same text as decodeMessage()
+     */
+    std::pmr::string decodeMessage(const int* encoded_frequencies, size_t count, HarmonicChannel channel,
+                                   std::pmr::memory_resource* resource);
+}
+
+#endif // HARMONIC_IOT_PROTOCOL_CODEC_H
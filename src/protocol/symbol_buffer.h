@@ -0,0 +1,195 @@
+/**
+ * Inline Symbol Storage for Harmonic IoT Protocol
+ *
+ * Encoded frames are short: the demo messages are 6–17 characters and
+ * sensor readings such as "Temp: 25.3C" are similar. SymbolBuffer keeps
+ * up to N symbols inside the object itself and only spills to a memory
+ * resource beyond that, so a typical frame lives on the stack or inside
+ * a queue slot without touching the heap.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_PROTOCOL_SYMBOL_BUFFER_H
+#define HARMONIC_IOT_PROTOCOL_SYMBOL_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+namespace HarmonicProtocol {
+
+    /**
+     * @brief Vector of harmonic numbers with N elements of inline capacity
+     *
+     * Interface follows std::vector where it matters to callers (size,
+     * data, iteration, push_back, resize, reserve). Storage beyond N comes
+     * from the memory resource given at construction (global heap by
+     * default); the resource is kept by copies and moves.
+     */
+    template <size_t N>
+    class SymbolBuffer {
+        static_assert(N > 0, "SymbolBuffer needs inline capacity");
+
+    public:
+        using value_type = int;
+        using iterator = int*;
+        using const_iterator = const int*;
+
+        static constexpr size_t inline_capacity = N;
+
+        explicit SymbolBuffer(std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+            : data_(inline_), resource_(resource) {}
+
+        SymbolBuffer(std::initializer_list<int> values,
+                     std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+            : SymbolBuffer(resource) {
+            assign(values.begin(), values.size());
+        }
+
+        SymbolBuffer(const SymbolBuffer& other) : SymbolBuffer(other.resource_) {
+            assign(other.data_, other.size_);
+        }
+
+        SymbolBuffer(SymbolBuffer&& other) noexcept : SymbolBuffer(other.resource_) {
+            take(other);
+        }
+
+        SymbolBuffer& operator=(const SymbolBuffer& other) {
+            if (this != &other) {
+                assign(other.data_, other.size_);
+            }
+            return *this;
+        }
+
+        SymbolBuffer& operator=(SymbolBuffer&& other) noexcept {
+            if (this != &other) {
+                if (resource_->is_equal(*other.resource_)) {
+                    release();
+                    take(other);
+                } else {
+                    assign(other.data_, other.size_);
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        ~SymbolBuffer() { release(); }
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        /** @brief True while the symbols fit in the object itself */
+        bool isInline() const { return data_ == inline_; }
+
+        int* data() { return data_; }
+        const int* data() const { return data_; }
+        int* begin() { return data_; }
+        int* end() { return data_ + size_; }
+        const int* begin() const { return data_; }
+        const int* end() const { return data_ + size_; }
+
+        int& operator[](size_t i) { return data_[i]; }
+        const int& operator[](size_t i) const { return data_[i]; }
+
+        void clear() { size_ = 0; }
+
+        void push_back(int value) {
+            if (size_ == capacity_) {
+                grow(capacity_ * 2);
+            }
+            data_[size_++] = value;
+        }
+
+        void reserve(size_t count) {
+            if (count > capacity_) {
+                grow(count);
+            }
+        }
+
+        void resize(size_t count, int value = 0) {
+            reserve(count);
+            if (count > size_) {
+                std::fill(data_ + size_, data_ + count, value);
+            }
+            size_ = count;
+        }
+
+        void assign(const int* values, size_t count) {
+            size_ = 0;
+            reserve(count);
+            if (count > 0) {
+                std::memcpy(data_, values, count * sizeof(int));
+            }
+            size_ = count;
+        }
+
+        /** @brief Copy into a std::vector for APIs that need one */
+        std::vector<int> toVector() const { return std::vector<int>(begin(), end()); }
+
+        friend bool operator==(const SymbolBuffer& a, const SymbolBuffer& b) {
+            return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+        }
+        friend bool operator!=(const SymbolBuffer& a, const SymbolBuffer& b) { return !(a == b); }
+
+    private:
+        void grow(size_t min_capacity) {
+            size_t capacity = std::max(min_capacity, capacity_ * 2);
+            int* heap = static_cast<int*>(resource_->allocate(capacity * sizeof(int), alignof(int)));
+            if (size_ > 0) {
+                std::memcpy(heap, data_, size_ * sizeof(int));
+            }
+            release();
+            data_ = heap;
+            capacity_ = capacity;
+        }
+
+        void release() {
+            if (data_ != inline_) {
+                resource_->deallocate(data_, capacity_ * sizeof(int), alignof(int));
+                data_ = inline_;
+                capacity_ = N;
+            }
+        }
+
+        /** @brief Steal other's contents; requires an empty, inline *this */
+        void take(SymbolBuffer& other) {
+            if (other.data_ == other.inline_) {
+                std::memcpy(inline_, other.inline_, other.size_ * sizeof(int));
+            } else {
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_;
+                other.capacity_ = N;
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+        int* data_;
+        size_t size_ = 0;
+        size_t capacity_ = N;
+        std::pmr::memory_resource* resource_;
+        int inline_[N];
+    };
+
+    /**
+     * @brief Symbols held inline by an encoded frame before spilling
+     */
+    constexpr size_t INLINE_FRAME_SYMBOLS = 64;
+
+    /**
+     * @brief Codec return type: one encoded message
+     */
+    using EncodedFrame = SymbolBuffer<INLINE_FRAME_SYMBOLS>;
+}
+
+#endif // HARMONIC_IOT_PROTOCOL_SYMBOL_BUFFER_H
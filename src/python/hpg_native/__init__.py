@@ -0,0 +1,162 @@
+"""Native backend for hpg_core.
+
+Drop-in replacements for the hpg_core signal processing entry points,
+computed by the C++ DSP library with the GIL released:
+
+    import hpg_native as hpg
+    t, signal, harmonics = hpg.generate_composite_signal()
+    peaks = hpg.decode_fft(signal)
+    report = hpg.verify_rational_integrity(peaks)
+
+Same signatures, defaults and result shapes as hpg_core. Contiguous
+float64/float32 arrays are read in place; array results are numpy arrays
+over native buffers (no copy), or Buffer objects exposing the buffer
+protocol when numpy is not installed.
+
+Extras without an hpg_core counterpart: goertzel() for per-channel
+magnitudes and match_ratios() for bulk nearest-ratio lookup.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+from fractions import Fraction
+from typing import Dict, List, Optional, Set, Tuple
+
+from . import _native
+from ._native import Buffer
+
+try:
+    import numpy as _np
+except ImportError:  # pragma: no cover - numpy is optional
+    _np = None
+
+try:
+    from hpg_core.spectral_verification import SpectralReport
+except ImportError:  # hpg_core (or its numpy dependency) is not installed
+
+    @dataclass
+    class SpectralReport:
+        """Result of spectral integrity verification (as in hpg_core)."""
+
+        total_components: int = 0
+        valid_components: int = 0
+        invalid_components: int = 0
+        integrity_score: float = 0.0
+        violations: List[Dict] = field(default_factory=list)
+        threshold: float = 100.0
+
+        @property
+        def passed(self) -> bool:
+            return self.integrity_score >= self.threshold
+
+
+# First six HPM 1.0 channels, the hpg_core default
+_DEFAULT_RATIOS = [(1, 1), (2, 1), (3, 2), (4, 3), (5, 4), (3, 1)]
+
+
+def _array(buffer, dtype="float64"):
+    """Wrap a native Buffer as a numpy array without copying, if numpy is available."""
+    if _np is None:
+        return buffer
+    return _np.frombuffer(buffer, dtype=dtype)
+
+
+def generate_composite_signal(
+    f0: float = 16384.0,
+    harmonics: Optional[List[Dict]] = None,
+    duration: float = 0.01,
+    sample_rate: float = 44100.0,
+) -> Tuple[object, object, List[Dict]]:
+    """Generate a composite harmonic signal s(t) = Σ Aₖ sin(2π(aₖ/bₖ)f₀t + φₖ).
+
+    See hpg_core.generate_composite_signal. Returns (time, signal, harmonics).
+    """
+    if harmonics is None:
+        harmonics = [
+            {"a": a, "b": b, "amplitude": 1.0, "phase": 0.0} for a, b in _DEFAULT_RATIOS
+        ]
+
+    n = int(sample_rate * duration)
+    step = duration / n if n > 0 else 0.0
+    components = [
+        (h["a"], h["b"], h.get("amplitude", 1.0), h.get("phase", 0.0)) for h in harmonics
+    ]
+    # t = i·step as numpy.linspace(0, duration, n, endpoint=False) computes it
+    signal = _native.synthesize(components, f0, n, 1.0 / step if step > 0 else sample_rate)
+    if _np is not None:
+        t = _np.arange(n) * step
+    else:
+        t = [i * step for i in range(n)]
+    return t, _array(signal), harmonics
+
+
+def decode_fft(
+    signal,
+    sample_rate: float = 44100.0,
+    f0: float = 16384.0,
+    threshold_db: float = -40.0,
+) -> List[Dict]:
+    """Detect harmonic components with a len(signal)-point FFT, strongest first.
+
+    See hpg_core.decode_fft.
+    """
+    return _native.decode_fft(signal, sample_rate, f0, threshold_db)
+
+
+def verify_rational_integrity(
+    detected_components,
+    f0: float = 16384.0,
+    max_denominator: int = 32,
+    tolerance_hz: float = 50.0,
+    threshold: float = 100.0,
+) -> SpectralReport:
+    """Check that every component lies within tolerance_hz of f0 · H_N.
+
+    See hpg_core.verify_rational_integrity. detected_components may also be
+    an array of frequencies, which is read in place.
+    """
+    if isinstance(detected_components, (list, tuple)):
+        frequencies = [c["frequency"] for c in detected_components]
+    else:
+        frequencies = detected_components
+    total, valid, invalid, score, violations = _native.verify_frequencies(
+        frequencies, f0, max_denominator, tolerance_hz, threshold
+    )
+    return SpectralReport(
+        total_components=total,
+        valid_components=valid,
+        invalid_components=invalid,
+        integrity_score=score,
+        violations=violations,
+        threshold=threshold,
+    )
+
+
+def compute_hn(N: int = 16) -> Set[Fraction]:
+    """Compute H_N = {a/b : gcd(a, b) = 1, a ≤ N, b ≤ N}. See hpg_core.compute_hn."""
+    a, b = _native.harmonic_set(N)
+    return {Fraction(x, y) for x, y in zip(a, b)}
+
+
+def goertzel(signal, frequencies, sample_rate: float = 44100.0):
+    """|X(f)| of the whole signal at each frequency, scaled like numpy.fft.rfft."""
+    return _array(_native.goertzel(signal, frequencies, sample_rate))
+
+
+def match_ratios(frequencies, f0: float = 16384.0, max_denominator: int = 32):
+    """Nearest member a/b of H_N for each frequency: returns (a, b, deviation_hz)."""
+    a, b, deviation = _native.match_ratios(frequencies, f0, max_denominator)
+    return _array(a, "uint32"), _array(b, "uint32"), _array(deviation)
+
+
+__all__ = [
+    "Buffer",
+    "SpectralReport",
+    "generate_composite_signal",
+    "decode_fft",
+    "verify_rational_integrity",
+    "compute_hn",
+    "goertzel",
+    "match_ratios",
+]
@@ -0,0 +1,614 @@
+/**
+ * Python Extension for Harmonic IoT Protocol
+ *
+ * hpg_native._native: the native synthesizer, DFT and Goertzel detectors,
+ * ratio matcher and H_N index behind the hpg_native package, which keeps
+ * the hpg_core function signatures.
+ *
+ * Signals come in through the buffer protocol, so contiguous float64 or
+ * float32 arrays (numpy, array.array, memoryview) are read in place;
+ * anything else is converted once as a sequence of floats. Results are
+ * returned in Buffer objects that numpy wraps without copying. The GIL is
+ * released for every computation.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "dsp/dft.h"
+#include "dsp/goertzel.h"
+#include "dsp/harmonic_set.h"
+#include "dsp/peak_detector.h"
+#include "dsp/spectral_verification.h"
+#include "dsp/synthesizer.h"
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace harmonic_iot;
+
+namespace {
+
+// ─── Buffer type ─────────────────────────────────────────────────────────────
+
+/**
+ * Owned 1-D array of doubles ('d') or uint32 ('I') exporting the buffer
+ * protocol
+ */
+struct BufferObject {
+    PyObject_HEAD
+    char* data;
+    Py_ssize_t length;
+    Py_ssize_t itemsize;
+    Py_ssize_t shape[1];
+    Py_ssize_t strides[1];
+    char format[2];
+};
+
+int bufferGet(PyObject* self, Py_buffer* view, int flags) {
+    BufferObject* b = reinterpret_cast<BufferObject*>(self);
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = b->data;
+    view->len = b->length * b->itemsize;
+    view->readonly = 0;
+    view->itemsize = b->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? b->format : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? b->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? b->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+PyTypeObject* buffer_type = nullptr;
+
+void bufferDealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    PyMem_Free(reinterpret_cast<BufferObject*>(self)->data);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+Py_ssize_t bufferLength(PyObject* self) {
+    return reinterpret_cast<BufferObject*>(self)->length;
+}
+
+PyObject* bufferItem(PyObject* self, Py_ssize_t i) {
+    BufferObject* b = reinterpret_cast<BufferObject*>(self);
+    if (i < 0 || i >= b->length) {
+        PyErr_SetString(PyExc_IndexError, "Buffer index out of range");
+        return nullptr;
+    }
+    if (b->format[0] == 'd') {
+        return PyFloat_FromDouble(reinterpret_cast<double*>(b->data)[i]);
+    }
+    return PyLong_FromUnsignedLong(reinterpret_cast<uint32_t*>(b->data)[i]);
+}
+
+PyObject* bufferRepr(PyObject* self) {
+    BufferObject* b = reinterpret_cast<BufferObject*>(self);
+    return PyUnicode_FromFormat("<hpg_native.Buffer format='%s' length=%zd>", b->format, b->length);
+}
+
+PyType_Slot buffer_slots[] = {
+    {Py_tp_doc, const_cast<char*>("Native array; exports the buffer protocol (numpy.frombuffer wraps it in place)")},
+    {Py_tp_dealloc, reinterpret_cast<void*>(bufferDealloc)},
+    {Py_tp_repr, reinterpret_cast<void*>(bufferRepr)},
+    {Py_sq_length, reinterpret_cast<void*>(bufferLength)},
+    {Py_sq_item, reinterpret_cast<void*>(bufferItem)},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(bufferGet)},
+    {0, nullptr},
+};
+
+PyType_Spec buffer_spec = {
+    "hpg_native._native.Buffer",
+    sizeof(BufferObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    buffer_slots,
+};
+
+/** New zero-filled Buffer of length elements of the given format */
+BufferObject* newBuffer(char format, size_t length) {
+    BufferObject* b = PyObject_New(BufferObject, buffer_type);
+    if (b == nullptr) {
+        return nullptr;
+    }
+    b->itemsize = format == 'd' ? sizeof(double) : sizeof(uint32_t);
+    b->length = static_cast<Py_ssize_t>(length);
+    b->shape[0] = b->length;
+    b->strides[0] = b->itemsize;
+    b->format[0] = format;
+    b->format[1] = '\0';
+    b->data = static_cast<char*>(PyMem_Calloc(length > 0 ? length : 1, static_cast<size_t>(b->itemsize)));
+    if (b->data == nullptr) {
+        Py_DECREF(b);
+        PyErr_NoMemory();
+        return nullptr;
+    }
+    return b;
+}
+
+// ─── Input signals ───────────────────────────────────────────────────────────
+
+/**
+ * Read-only view of a 1-D signal argument
+ *
+ * Contiguous float64/float32 buffers are used in place; the export is held
+ * until destruction, which keeps the memory valid while the GIL is
+ * released. Other objects are converted to doubles.
+ */
+class SignalArg {
+public:
+    SignalArg() { std::memset(&view_, 0, sizeof(view_)); }
+    ~SignalArg() {
+        if (view_.obj != nullptr) {
+            PyBuffer_Release(&view_);
+        }
+    }
+
+    SignalArg(const SignalArg&) = delete;
+    SignalArg& operator=(const SignalArg&) = delete;
+
+    /** @return false with a Python exception set on failure */
+    bool load(PyObject* obj, const char* name) {
+        if (PyObject_CheckBuffer(obj) &&
+            PyObject_GetBuffer(obj, &view_, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0) {
+            const char type = nativeType(view_.format);
+            if (view_.ndim <= 1 && type == 'd' && view_.itemsize == sizeof(double)) {
+                doubles_ = static_cast<const double*>(view_.buf);
+                size_ = static_cast<size_t>(view_.len) / sizeof(double);
+                return true;
+            }
+            if (view_.ndim <= 1 && type == 'f' && view_.itemsize == sizeof(float)) {
+                floats_ = static_cast<const float*>(view_.buf);
+                size_ = static_cast<size_t>(view_.len) / sizeof(float);
+                return true;
+            }
+            PyBuffer_Release(&view_);
+            view_.obj = nullptr;
+        }
+        PyErr_Clear();
+
+        // Strided arrays, other dtypes, lists: one conversion pass
+        PyObject* seq = PySequence_Fast(obj, name);
+        if (seq == nullptr) {
+            return false;
+        }
+        const Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+        PyObject** items = PySequence_Fast_ITEMS(seq);
+        copy_.resize(static_cast<size_t>(n));
+        for (Py_ssize_t i = 0; i < n; ++i) {
+            copy_[static_cast<size_t>(i)] = PyFloat_AsDouble(items[i]);
+        }
+        Py_DECREF(seq);
+        if (PyErr_Occurred()) {
+            return false;
+        }
+        doubles_ = copy_.data();
+        size_ = copy_.size();
+        return true;
+    }
+
+    size_t size() const { return size_; }
+    const double* doubles() const { return doubles_; }
+    const float* floats() const { return floats_; }
+
+private:
+    /** Element type of a struct-module format if it is native-endian 'd' or 'f', else 0 */
+    static char nativeType(const char* format) {
+        if (format == nullptr) {
+            return 0;
+        }
+        if (format[0] == '@' || format[0] == '=' ||
+            (format[0] == (PY_LITTLE_ENDIAN ? '<' : '>'))) {
+            ++format;
+        }
+        return (format[0] == 'd' || format[0] == 'f') && format[1] == '\0' ? format[0] : 0;
+    }
+
+    Py_buffer view_;
+    const double* doubles_ = nullptr;
+    const float* floats_ = nullptr;
+    size_t size_ = 0;
+    std::vector<double> copy_;
+};
+
+// ─── Running without the GIL ─────────────────────────────────────────────────
+
+/**
+ * Run fn with the GIL released, translating C++ exceptions
+ *
+ * @return false with a Python exception set if fn threw
+ */
+template <typename Fn>
+bool withoutGil(Fn&& fn) {
+    std::exception_ptr error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        fn();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Py_END_ALLOW_THREADS
+    if (!error) {
+        return true;
+    }
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::bad_alloc&) {
+        PyErr_NoMemory();
+    } catch (const std::invalid_argument& e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    } catch (const std::length_error& e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    } catch (const std::exception& e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+    }
+    return false;
+}
+
+/** Plan for the last transform size used on this thread */
+const dsp::DftPlan& dftPlan(size_t size) {
+    thread_local std::unique_ptr<dsp::DftPlan> plan;
+    if (!plan || plan->size() != size) {
+        plan.reset(new dsp::DftPlan(size));
+    }
+    return *plan;
+}
+
+bool checkMaxDenominator(long value) {
+    if (value < 1 || value > 65535) {
+        PyErr_SetString(PyExc_ValueError, "max_denominator must be in [1, 65535]");
+        return false;
+    }
+    return true;
+}
+
+// ─── Functions ───────────────────────────────────────────────────────────────
+
+PyObject* synthesize(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"components", "f0", "samples", "sample_rate", nullptr};
+    PyObject* components_obj;
+    double f0;
+    Py_ssize_t samples;
+    double sample_rate;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Odnd:synthesize", const_cast<char**>(keywords),
+                                     &components_obj, &f0, &samples, &sample_rate)) {
+        return nullptr;
+    }
+    if (samples < 0) {
+        PyErr_SetString(PyExc_ValueError, "samples must not be negative");
+        return nullptr;
+    }
+
+    PyObject* seq = PySequence_Fast(components_obj, "components must be a sequence of (a, b, amplitude, phase)");
+    if (seq == nullptr) {
+        return nullptr;
+    }
+    std::vector<dsp::ToneComponent> components(static_cast<size_t>(PySequence_Fast_GET_SIZE(seq)));
+    for (size_t i = 0; i < components.size(); ++i) {
+        unsigned int a;
+        unsigned int b;
+        double amplitude;
+        double phase;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, static_cast<Py_ssize_t>(i)), "IIdd:component",
+                              &a, &b, &amplitude, &phase)) {
+            Py_DECREF(seq);
+            return nullptr;
+        }
+        if (b == 0) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_ZeroDivisionError, "harmonic denominator b is 0");
+            return nullptr;
+        }
+        components[i].ratio = dsp::HarmonicRatio{a, b};
+        components[i].amplitude = amplitude;
+        components[i].phase = phase;
+    }
+    Py_DECREF(seq);
+
+    BufferObject* out = newBuffer('d', static_cast<size_t>(samples));
+    if (out == nullptr) {
+        return nullptr;
+    }
+    double* data = reinterpret_cast<double*>(out->data);
+    if (!withoutGil([&] {
+            dsp::synthesizeComposite(components.data(), components.size(), f0, sample_rate, data,
+                                     static_cast<size_t>(samples));
+        })) {
+        Py_DECREF(out);
+        return nullptr;
+    }
+    return reinterpret_cast<PyObject*>(out);
+}
+
+PyObject* decodeFft(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"signal", "sample_rate", "f0", "threshold_db", nullptr};
+    PyObject* signal_obj;
+    double sample_rate = 44100.0;
+    double f0 = 16384.0;
+    double threshold_db = -40.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|ddd:decode_fft", const_cast<char**>(keywords),
+                                     &signal_obj, &sample_rate, &f0, &threshold_db)) {
+        return nullptr;
+    }
+    SignalArg signal;
+    if (!signal.load(signal_obj, "signal must be a sequence of numbers")) {
+        return nullptr;
+    }
+
+    dsp::PeakDetectorConfig config;
+    config.sample_rate = sample_rate;
+    config.f0 = f0;
+    config.threshold_db = static_cast<float>(threshold_db);
+    std::vector<dsp::DetectedComponent> detected;
+    if (!withoutGil([&] {
+            const dsp::DftPlan& plan = dftPlan(signal.size());
+            std::vector<double> magnitudes(plan.bins());
+            if (signal.doubles() != nullptr) {
+                plan.magnitudes(signal.doubles(), magnitudes.data());
+            } else {
+                plan.magnitudes(signal.floats(), magnitudes.data());
+            }
+            dsp::pickPeaks(magnitudes.data(), magnitudes.size(), plan.binSpacing(sample_rate), config, detected);
+        })) {
+        return nullptr;
+    }
+
+    PyObject* list = PyList_New(static_cast<Py_ssize_t>(detected.size()));
+    if (list == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < detected.size(); ++i) {
+        const dsp::DetectedComponent& c = detected[i];
+        const std::string ratio = std::to_string(c.ratio.a) + "/" + std::to_string(c.ratio.b);
+        PyObject* item = Py_BuildValue("{s:d,s:d,s:I,s:I,s:s,s:d}",
+                                       "frequency", c.frequency,
+                                       "amplitude_db", c.amplitude_db,
+                                       "ratio_a", c.ratio.a,
+                                       "ratio_b", c.ratio.b,
+                                       "closest_ratio", ratio.c_str(),
+                                       "deviation_hz", c.deviation_hz);
+        if (item == nullptr) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), item);
+    }
+    return list;
+}
+
+PyObject* goertzel(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"signal", "frequencies", "sample_rate", nullptr};
+    PyObject* signal_obj;
+    PyObject* frequencies_obj;
+    double sample_rate = 44100.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|d:goertzel", const_cast<char**>(keywords),
+                                     &signal_obj, &frequencies_obj, &sample_rate)) {
+        return nullptr;
+    }
+    SignalArg signal;
+    SignalArg frequencies;
+    if (!signal.load(signal_obj, "signal must be a sequence of numbers") ||
+        !frequencies.load(frequencies_obj, "frequencies must be a sequence of numbers")) {
+        return nullptr;
+    }
+    std::vector<double> widened;
+    if (frequencies.doubles() == nullptr) {
+        widened.assign(frequencies.floats(), frequencies.floats() + frequencies.size());
+    }
+    const double* freqs = frequencies.doubles() != nullptr ? frequencies.doubles() : widened.data();
+
+    BufferObject* out = newBuffer('d', frequencies.size());
+    if (out == nullptr) {
+        return nullptr;
+    }
+    double* data = reinterpret_cast<double*>(out->data);
+    if (!withoutGil([&] {
+            const dsp::GoertzelBank bank(freqs, frequencies.size(), sample_rate);
+            if (signal.doubles() != nullptr) {
+                bank.magnitudes(signal.doubles(), signal.size(), data);
+            } else {
+                bank.magnitudes(signal.floats(), signal.size(), data);
+            }
+        })) {
+        Py_DECREF(out);
+        return nullptr;
+    }
+    return reinterpret_cast<PyObject*>(out);
+}
+
+PyObject* matchRatios(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"frequencies", "f0", "max_denominator", nullptr};
+    PyObject* frequencies_obj;
+    double f0 = 16384.0;
+    long max_denominator = 32;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|dl:match_ratios", const_cast<char**>(keywords),
+                                     &frequencies_obj, &f0, &max_denominator)) {
+        return nullptr;
+    }
+    if (!checkMaxDenominator(max_denominator)) {
+        return nullptr;
+    }
+    SignalArg frequencies;
+    if (!frequencies.load(frequencies_obj, "frequencies must be a sequence of numbers")) {
+        return nullptr;
+    }
+
+    const size_t n = frequencies.size();
+    BufferObject* a = newBuffer('I', n);
+    BufferObject* b = a != nullptr ? newBuffer('I', n) : nullptr;
+    BufferObject* deviation = b != nullptr ? newBuffer('d', n) : nullptr;
+    if (deviation == nullptr) {
+        Py_XDECREF(a);
+        Py_XDECREF(b);
+        return nullptr;
+    }
+    uint32_t* out_a = reinterpret_cast<uint32_t*>(a->data);
+    uint32_t* out_b = reinterpret_cast<uint32_t*>(b->data);
+    double* out_dev = reinterpret_cast<double*>(deviation->data);
+    if (!withoutGil([&] {
+            const dsp::RatioMatcher matcher(f0, static_cast<uint32_t>(max_denominator));
+            for (size_t i = 0; i < n; ++i) {
+                const double f = frequencies.doubles() != nullptr ? frequencies.doubles()[i]
+                                                                  : frequencies.floats()[i];
+                const dsp::RatioMatcher::Match m = matcher.match(f);
+                out_a[i] = m.ratio.a;
+                out_b[i] = m.ratio.b;
+                out_dev[i] = m.deviation_hz;
+            }
+        })) {
+        Py_DECREF(a);
+        Py_DECREF(b);
+        Py_DECREF(deviation);
+        return nullptr;
+    }
+    return Py_BuildValue("(NNN)", a, b, deviation);
+}
+
+PyObject* verifyFrequencies(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"frequencies", "f0", "max_denominator", "tolerance_hz", "threshold", nullptr};
+    PyObject* frequencies_obj;
+    dsp::IntegrityConfig config;
+    long max_denominator = 32;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|dldd:verify_frequencies", const_cast<char**>(keywords),
+                                     &frequencies_obj, &config.f0, &max_denominator, &config.tolerance_hz,
+                                     &config.threshold)) {
+        return nullptr;
+    }
+    if (!checkMaxDenominator(max_denominator)) {
+        return nullptr;
+    }
+    config.max_denominator = static_cast<uint32_t>(max_denominator);
+    SignalArg frequencies;
+    if (!frequencies.load(frequencies_obj, "frequencies must be a sequence of numbers")) {
+        return nullptr;
+    }
+
+    dsp::SpectralReport report;
+    if (!withoutGil([&] {
+            std::vector<double> widened;
+            const double* freqs = frequencies.doubles();
+            if (freqs == nullptr) {
+                widened.assign(frequencies.floats(), frequencies.floats() + frequencies.size());
+                freqs = widened.data();
+            }
+            dsp::IntegrityVerifier(config).verify(freqs, frequencies.size(), report);
+        })) {
+        return nullptr;
+    }
+
+    PyObject* violations = PyList_New(static_cast<Py_ssize_t>(report.violations.size()));
+    if (violations == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < report.violations.size(); ++i) {
+        const dsp::IntegrityViolation& v = report.violations[i];
+        PyObject* item = Py_BuildValue("{s:d,s:d,s:d}", "frequency", v.frequency, "ratio", v.ratio,
+                                       "deviation_hz", v.deviation_hz);
+        if (item == nullptr) {
+            Py_DECREF(violations);
+            return nullptr;
+        }
+        PyList_SET_ITEM(violations, static_cast<Py_ssize_t>(i), item);
+    }
+    return Py_BuildValue("(nnndN)", static_cast<Py_ssize_t>(report.total_components),
+                         static_cast<Py_ssize_t>(report.valid_components),
+                         static_cast<Py_ssize_t>(report.invalid_components), report.integrity_score, violations);
+}
+
+PyObject* harmonicSet(PyObject*, PyObject* args) {
+    long n;
+    if (!PyArg_ParseTuple(args, "l:harmonic_set", &n)) {
+        return nullptr;
+    }
+    if (n < 0 || n > 65535) {
+        PyErr_SetString(PyExc_ValueError, "N must be in [0, 65535]");
+        return nullptr;
+    }
+    std::vector<dsp::HarmonicRatio> members;
+    if (!withoutGil([&] { members = dsp::computeHarmonicSet(static_cast<uint32_t>(n)); })) {
+        return nullptr;
+    }
+
+    BufferObject* a = newBuffer('I', members.size());
+    BufferObject* b = a != nullptr ? newBuffer('I', members.size()) : nullptr;
+    if (b == nullptr) {
+        Py_XDECREF(a);
+        return nullptr;
+    }
+    uint32_t* out_a = reinterpret_cast<uint32_t*>(a->data);
+    uint32_t* out_b = reinterpret_cast<uint32_t*>(b->data);
+    for (size_t i = 0; i < members.size(); ++i) {
+        out_a[i] = members[i].a;
+        out_b[i] = members[i].b;
+    }
+    return Py_BuildValue("(NN)", a, b);
+}
+
+PyMethodDef methods[] = {
+    {"synthesize", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(synthesize)),
+     METH_VARARGS | METH_KEYWORDS,
+     "synthesize(components, f0, samples, sample_rate) -> Buffer\n\n"
+     "Composite signal sum(A sin(2*pi*(a/b)*f0*i/sample_rate + phase)) for i < samples;\n"
+     "components is a sequence of (a, b, amplitude, phase)."},
+    {"decode_fft", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(decodeFft)),
+     METH_VARARGS | METH_KEYWORDS,
+     "decode_fft(signal, sample_rate=44100.0, f0=16384.0, threshold_db=-40.0) -> list\n\n"
+     "Same result as hpg_core.decode_fft: a len(signal)-point spectrum, peaks strongest first."},
+    {"goertzel", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(goertzel)),
+     METH_VARARGS | METH_KEYWORDS,
+     "goertzel(signal, frequencies, sample_rate=44100.0) -> Buffer\n\n"
+     "|X(f)| of the whole signal at each frequency (unnormalized, like rfft)."},
+    {"match_ratios", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(matchRatios)),
+     METH_VARARGS | METH_KEYWORDS,
+     "match_ratios(frequencies, f0=16384.0, max_denominator=32) -> (a, b, deviation_hz)\n\n"
+     "Nearest member of f0 * H_N for each frequency, as three Buffers."},
+    {"verify_frequencies", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(verifyFrequencies)),
+     METH_VARARGS | METH_KEYWORDS,
+     "verify_frequencies(frequencies, f0=16384.0, max_denominator=32, tolerance_hz=50.0, threshold=100.0)\n"
+     "-> (total, valid, invalid, integrity_score, violations)"},
+    {"harmonic_set", harmonicSet, METH_VARARGS,
+     "harmonic_set(N) -> (a, b)\n\nMembers a/b of H_N in ascending order, as two Buffers."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef module = {
+    PyModuleDef_HEAD_INIT,
+    "hpg_native._native",
+    "Native DSP kernels behind hpg_native",
+    -1,
+    methods,
+    nullptr, nullptr, nullptr, nullptr,
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__native(void) {
+    PyObject* m = PyModule_Create(&module);
+    if (m == nullptr) {
+        return nullptr;
+    }
+    buffer_type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&buffer_spec));
+    if (buffer_type == nullptr) {
+        Py_DECREF(m);
+        return nullptr;
+    }
+    Py_INCREF(buffer_type);
+    if (PyModule_AddObject(m, "Buffer", reinterpret_cast<PyObject*>(buffer_type)) < 0) {
+        Py_DECREF(buffer_type);
+        Py_DECREF(m);
+        return nullptr;
+    }
+    return m;
+}
@@ -0,0 +1,90 @@
+/**
+ * Batch Arena for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "batch_arena.h"
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace runtime {
+
+namespace {
+
+constexpr size_t CHUNK_ALIGNMENT = alignof(std::max_align_t);
+
+inline uint8_t* alignUp(uint8_t* p, size_t alignment) {
+    uintptr_t value = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<uint8_t*>((value + alignment - 1) & ~(uintptr_t(alignment) - 1));
+}
+
+} // namespace
+
+BatchArena::BatchArena(size_t chunk_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), chunk_size_(chunk_size) {
+    if (chunk_size <= sizeof(Chunk)) {
+        throw std::invalid_argument("Arena chunk size too small");
+    }
+}
+
+BatchArena::~BatchArena() {
+    while (head_) {
+        Chunk* next = head_->next;
+        upstream_->deallocate(head_, head_->size, CHUNK_ALIGNMENT);
+        head_ = next;
+    }
+}
+
+void BatchArena::addChunk(size_t min_payload, size_t alignment) {
+    size_t size = chunk_size_;
+    size_t needed = sizeof(Chunk) + min_payload + alignment;
+    if (needed > size) {
+        size = needed;
+    }
+    Chunk* chunk = static_cast<Chunk*>(upstream_->allocate(size, CHUNK_ALIGNMENT));
+    ++upstream_allocations_;
+    chunk->next = head_;
+    chunk->size = size;
+    head_ = chunk;
+    cursor_ = reinterpret_cast<uint8_t*>(chunk + 1);
+    end_ = reinterpret_cast<uint8_t*>(chunk) + size;
+}
+
+void* BatchArena::do_allocate(size_t bytes, size_t alignment) {
+    uint8_t* p = cursor_ ? alignUp(cursor_, alignment) : nullptr;
+    if (!p || p + bytes > end_) {
+        addChunk(bytes, alignment);
+        p = alignUp(cursor_, alignment);
+    }
+    cursor_ = p + bytes;
+    used_ += bytes;
+    return p;
+}
+
+void BatchArena::reset() {
+    if (!head_) {
+        return;
+    }
+    // Return every chunk but the first
+    while (head_->next) {
+        Chunk* next = head_->next;
+        upstream_->deallocate(head_, head_->size, CHUNK_ALIGNMENT);
+        head_ = next;
+    }
+    cursor_ = reinterpret_cast<uint8_t*>(head_ + 1);
+    end_ = reinterpret_cast<uint8_t*>(head_) + head_->size;
+    used_ = 0;
+}
+
+size_t BatchArena::chunkCount() const {
+    size_t count = 0;
+    for (const Chunk* c = head_; c; c = c->next) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
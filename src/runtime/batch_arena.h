@@ -0,0 +1,87 @@
+/**
+ * Batch Arena for Harmonic IoT Protocol
+ *
+ * Monotonic bump allocator for short-lived, variable-size decode output
+ * (symbol vectors, decoded strings, detected components). Everything
+ * allocated for one batch or frame is released at once by reset(); the
+ * first chunk is kept, so once warmed up a frame's allocations never
+ * leave the arena.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_BATCH_ARENA_H
+#define HARMONIC_IOT_RUNTIME_BATCH_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Single-threaded monotonic std::pmr resource with cheap reset
+ *
+ * deallocate() is a no-op. Chunks come from the upstream resource (for
+ * example a SlabResource); requests larger than a chunk get a dedicated
+ * one. Not thread-safe: one arena per frame, batch or thread.
+ */
+class BatchArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @param chunk_size Bytes per chunk, including a small header
+     * @param upstream Source of chunks
+     */
+    explicit BatchArena(size_t chunk_size = 16384,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    ~BatchArena() override;
+
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    /**
+     * Release every allocation; the first chunk is retained
+     *
+     * Containers using the arena must be destroyed or emptied first.
+     */
+    void reset();
+
+    /** Bytes handed out since the last reset */
+    size_t bytesUsed() const { return used_; }
+
+    /** Chunks currently held (1 after a reset, once warmed up) */
+    size_t chunkCount() const;
+
+    /** Chunks requested from upstream since construction */
+    uint64_t upstreamAllocations() const { return upstream_allocations_; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;        // Total bytes including this header
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void addChunk(size_t min_payload, size_t alignment);
+
+    std::pmr::memory_resource* upstream_;
+    size_t chunk_size_;
+    Chunk* head_ = nullptr;        // Most recent chunk; the first one is at the tail
+    uint8_t* cursor_ = nullptr;
+    uint8_t* end_ = nullptr;
+    size_t used_ = 0;
+    uint64_t upstream_allocations_ = 0;
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_BATCH_ARENA_H
@@ -0,0 +1,39 @@
+/**
+ * Cache Line Constants for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_CACHE_LINE_H
+#define HARMONIC_IOT_RUNTIME_CACHE_LINE_H
+
+#include <cstddef>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Destructive interference size used to pad shared counters
+ *
+ * 64 bytes on x86-64 and most ARMv8 cores. Fixed rather than taken from
+ * std::hardware_destructive_interference_size so the layout does not
+ * change with compiler flags.
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Spin-wait hint for busy loops
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_CACHE_LINE_H
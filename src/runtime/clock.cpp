@@ -0,0 +1,128 @@
+/**
+ * Pluggable Clock for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "clock.h"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace harmonic_iot {
+namespace runtime {
+
+namespace {
+
+/** VirtualClock the calling thread is attached to, if any */
+thread_local VirtualClock* attached_clock = nullptr;
+
+} // namespace
+
+Clock& Clock::system() {
+    static SystemClock clock;
+    return clock;
+}
+
+// ─── SystemClock ─────────────────────────────────────────────────────────────
+
+int64_t SystemClock::monotonicNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t SystemClock::wallNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void SystemClock::sleepUntil(int64_t deadline_ns) {
+    const int64_t wait_ns = deadline_ns - monotonicNs();
+    if (wait_ns > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+    }
+}
+
+// ─── VirtualClock ────────────────────────────────────────────────────────────
+
+VirtualClock::VirtualClock(int64_t start_wall_ns) : start_wall_ns_(start_wall_ns) {}
+
+VirtualClock::~VirtualClock() = default;
+
+VirtualClock::Participant::Participant(VirtualClock& clock) : clock_(clock), previous_(attached_clock) {
+    std::lock_guard<std::mutex> lock(clock_.mutex_);
+    ++clock_.attached_;
+    attached_clock = &clock_;
+}
+
+VirtualClock::Participant::~Participant() {
+    std::lock_guard<std::mutex> lock(clock_.mutex_);
+    --clock_.attached_;
+    attached_clock = previous_;
+    clock_.advanceIfIdle();
+}
+
+size_t VirtualClock::participants() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attached_;
+}
+
+void VirtualClock::sleepUntil(int64_t deadline_ns) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (deadline_ns <= now_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const bool participant = attached_clock == this;
+    sleepers_.push({deadline_ns, participant});
+    if (participant) {
+        ++waiting_;
+    }
+    advanceIfIdle();
+    // moveTo() already took this thread out of waiting_ when it released it
+    wake_.wait(lock, [&] { return now_.load(std::memory_order_relaxed) >= deadline_ns; });
+}
+
+void VirtualClock::hold() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++held_;
+}
+
+void VirtualClock::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (held_ == 0) {
+        throw std::logic_error("VirtualClock::release() without hold()");
+    }
+    --held_;
+    advanceIfIdle();
+}
+
+void VirtualClock::advanceTo(int64_t ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ns > now_.load(std::memory_order_relaxed)) {
+        moveTo(ns);
+    }
+}
+
+void VirtualClock::advanceIfIdle() {
+    if (waiting_ == attached_ && held_ == 0 && !sleepers_.empty()) {
+        moveTo(sleepers_.top().deadline);
+        advances_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void VirtualClock::moveTo(int64_t ns) {
+    now_.store(ns, std::memory_order_release);
+    // Released participants count as running from here, before they get the
+    // mutex back, so a concurrent advanceIfIdle() cannot jump past them
+    while (!sleepers_.empty() && sleepers_.top().deadline <= ns) {
+        if (sleepers_.top().participant) {
+            --waiting_;
+        }
+        sleepers_.pop();
+    }
+    wake_.notify_all();
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
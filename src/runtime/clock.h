@@ -0,0 +1,167 @@
+/**
+ * Pluggable Clock for Harmonic IoT Protocol
+ *
+ * Timer-driven engine code (gateway liveness, token issue and expiry,
+ * fleet simulation) reads time and sleeps through a Clock instead of
+ * std::chrono directly. Production uses SystemClock. Benchmarks and
+ * simulations can use VirtualClock, a discrete-event clock that stands
+ * still while any participant thread is working and jumps straight to the
+ * next deadline once all of them are waiting. Hours of fleet behavior
+ * then run in seconds, and a run does not depend on how fast the host
+ * happens to be.
+ *
+ * Measurement code (latency histograms, busy time, benchmark harness)
+ * keeps using real time on purpose.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_CLOCK_H
+#define HARMONIC_IOT_RUNTIME_CLOCK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Time source and sleeper
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    /** Monotonic time for intervals and deadlines, ns (arbitrary origin) */
+    virtual int64_t monotonicNs() const = 0;
+
+    /** Calendar time, Unix epoch ns; moves in step with monotonicNs() */
+    virtual int64_t wallNs() const = 0;
+
+    /** Block until monotonicNs() >= deadline_ns */
+    virtual void sleepUntil(int64_t deadline_ns) = 0;
+
+    /**
+     * Mark work in flight that must finish before time may advance
+     *
+     * Executors call hold() when a task is queued and release() when it
+     * has run. No-ops on a real clock.
+     */
+    virtual void hold() {}
+    virtual void release() {}
+
+    int64_t wallMs() const { return wallNs() / 1000000; }
+    int64_t wallSeconds() const { return wallNs() / 1000000000; }
+    void sleepFor(int64_t ns) { sleepUntil(monotonicNs() + ns); }
+
+    /** Process-wide real clock */
+    static Clock& system();
+};
+
+/**
+ * std::chrono::steady_clock and system_clock
+ */
+class SystemClock final : public Clock {
+public:
+    int64_t monotonicNs() const override;
+    int64_t wallNs() const override;
+    void sleepUntil(int64_t deadline_ns) override;
+};
+
+/**
+ * Discrete-event clock
+ *
+ * Threads that drive the simulation attach as participants. Time only
+ * moves when every participant is blocked in sleepUntil() and no work is
+ * held; it then jumps to the earliest pending deadline and wakes the
+ * threads waiting for it. With no participants attached, any sleeper
+ * advances time. advanceTo() moves time by hand for single-threaded
+ * drivers.
+ *
+ * Threads must not block on anything but the clock while attached, or on
+ * work handed to another participant without hold()/release(): time
+ * would advance under them. Deadlines that fall on the same instant wake
+ * together, so participants that must run after the others at an instant
+ * should wait one nanosecond later.
+ */
+class VirtualClock final : public Clock {
+public:
+    /**
+     * @param start_wall_ns wallNs() at monotonic time 0
+     */
+    explicit VirtualClock(int64_t start_wall_ns = 0);
+
+    ~VirtualClock() override;
+
+    VirtualClock(const VirtualClock&) = delete;
+    VirtualClock& operator=(const VirtualClock&) = delete;
+
+    int64_t monotonicNs() const override { return now_.load(std::memory_order_acquire); }
+    int64_t wallNs() const override { return start_wall_ns_ + monotonicNs(); }
+    void sleepUntil(int64_t deadline_ns) override;
+    void hold() override;
+    void release() override;
+
+    /**
+     * Move time forward, waking every sleeper whose deadline has passed
+     *
+     * Earlier times are ignored; time never goes backwards.
+     */
+    void advanceTo(int64_t ns);
+
+    /**
+     * Scoped registration of the calling thread as a participant
+     */
+    class Participant {
+    public:
+        explicit Participant(VirtualClock& clock);
+        ~Participant();
+
+        Participant(const Participant&) = delete;
+        Participant& operator=(const Participant&) = delete;
+
+    private:
+        VirtualClock& clock_;
+        VirtualClock* previous_;
+    };
+
+    size_t participants() const;
+
+    /** Times the clock jumped forward */
+    uint64_t advances() const { return advances_.load(std::memory_order_relaxed); }
+
+private:
+    struct Sleeper {
+        int64_t deadline;
+        bool participant;
+        bool operator>(const Sleeper& other) const { return deadline > other.deadline; }
+    };
+
+    /** Jump to the next deadline if nothing can run; caller holds mutex_ */
+    void advanceIfIdle();
+
+    /** Set the time and release due sleepers; caller holds mutex_ */
+    void moveTo(int64_t ns);
+
+    const int64_t start_wall_ns_;
+    std::atomic<int64_t> now_{0};
+    std::atomic<uint64_t> advances_{0};
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::priority_queue<Sleeper, std::vector<Sleeper>, std::greater<Sleeper>> sleepers_;
+    size_t attached_ = 0;
+    size_t waiting_ = 0;         // Attached participants blocked in sleepUntil()
+    size_t held_ = 0;
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_CLOCK_H
@@ -0,0 +1,90 @@
+/**
+ * Double-Mapped Ring Memory for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "double_mapped_buffer.h"
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace harmonic_iot {
+namespace runtime {
+
+namespace {
+
+int createSharedMemory() {
+#if defined(__linux__)
+    int fd = ::memfd_create("harmonic-ring", MFD_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("memfd_create failed: ") + std::strerror(errno));
+    }
+    return fd;
+#else
+    static std::atomic<unsigned> counter{0};
+    std::string name = "/harmonic-ring-" + std::to_string(::getpid()) + "-" +
+                       std::to_string(counter.fetch_add(1));
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("shm_open failed: ") + std::strerror(errno));
+    }
+    // Only the descriptor is needed from here on
+    ::shm_unlink(name.c_str());
+    return fd;
+#endif
+}
+
+} // namespace
+
+DoubleMappedBuffer::DoubleMappedBuffer(size_t min_bytes) {
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_ = page;
+    while (size_ < min_bytes) {
+        size_ <<= 1;
+    }
+
+    int fd = createSharedMemory();
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("Failed to size ring memory: ") + std::strerror(err));
+    }
+
+    // Reserve a 2× range first so both halves land at adjacent addresses
+    void* reserved = ::mmap(nullptr, 2 * size_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("Failed to reserve ring address space: ") + std::strerror(err));
+    }
+
+    uint8_t* base = static_cast<uint8_t*>(reserved);
+    void* first = ::mmap(base, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void* second = first == MAP_FAILED ? MAP_FAILED
+                 : ::mmap(base + size_, size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    int err = errno;
+    ::close(fd);
+
+    if (first == MAP_FAILED || second == MAP_FAILED) {
+        ::munmap(base, 2 * size_);
+        throw std::runtime_error(std::string("Failed to double-map ring memory: ") + std::strerror(err));
+    }
+
+    data_ = base;
+}
+
+DoubleMappedBuffer::~DoubleMappedBuffer() {
+    if (data_) {
+        ::munmap(data_, 2 * size_);
+    }
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
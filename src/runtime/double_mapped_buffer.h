@@ -0,0 +1,54 @@
+/**
+ * Double-Mapped Ring Memory for Harmonic IoT Protocol
+ *
+ * Maps the same physical pages twice, back to back, so a ring buffer's
+ * wrap-around is invisible: a read or write of up to capacity bytes
+ * starting anywhere in the first mapping is contiguous in virtual memory.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_DOUBLE_MAPPED_BUFFER_H
+#define HARMONIC_IOT_RUNTIME_DOUBLE_MAPPED_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Anonymous shared memory mapped twice at adjacent addresses
+ *
+ * Backed by memfd_create(2) on Linux and an unlinked shm_open(3) object
+ * elsewhere.
+ */
+class DoubleMappedBuffer {
+public:
+    /**
+     * @param min_bytes Requested size; rounded up to a power-of-two number of pages
+     * @throws std::runtime_error if the mappings cannot be created
+     */
+    explicit DoubleMappedBuffer(size_t min_bytes);
+
+    ~DoubleMappedBuffer();
+
+    DoubleMappedBuffer(const DoubleMappedBuffer&) = delete;
+    DoubleMappedBuffer& operator=(const DoubleMappedBuffer&) = delete;
+
+    /** Start of the first mapping; data()[i] aliases data()[i + size()] */
+    uint8_t* data() const { return data_; }
+
+    /** Size of one mapping in bytes (a power of two) */
+    size_t size() const { return size_; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_DOUBLE_MAPPED_BUFFER_H
@@ -0,0 +1,139 @@
+/**
+ * Bounded Lock-Free MPMC Queue for Harmonic IoT Protocol
+ *
+ * Fixed-capacity array queue after Dmitry Vyukov's design: each cell
+ * carries a sequence number that tells producers and consumers whether
+ * it is free for their lap, so an enqueue or dequeue is one CAS on the
+ * shared position plus one store to the cell. Used between pipeline
+ * stages, where several workers may produce into and consume from the
+ * same queue.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_MPMC_QUEUE_H
+#define HARMONIC_IOT_RUNTIME_MPMC_QUEUE_H
+
+#include "runtime/cache_line.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Bounded multi-producer / multi-consumer queue
+ *
+ * Never blocks: tryPush() fails when full and tryPop() when empty, leaving
+ * the back-off policy to the caller.
+ */
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_assignable<T>::value, "Queue elements must be nothrow-movable");
+
+public:
+    /**
+     * @param capacity Rounded up to a power of two (minimum 2)
+     */
+    explicit MpmcQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        cells_.reset(new Cell[rounded]);
+        for (size_t i = 0; i < rounded; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    bool tryPush(T value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop up to max_count elements
+     *
+     * @return Number popped
+     */
+    size_t tryPopBatch(T* out, size_t max_count) {
+        size_t n = 0;
+        while (n < max_count && tryPop(out[n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    /** Approximate number of queued elements */
+    size_t sizeApprox() const {
+        size_t enq = enqueue_pos_.load(std::memory_order_seq_cst);
+        size_t deq = dequeue_pos_.load(std::memory_order_seq_cst);
+        return enq > deq ? enq - deq : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_MPMC_QUEUE_H
@@ -0,0 +1,144 @@
+/**
+ * Per-Core Slab Pool for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "slab_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace harmonic_iot {
+namespace runtime {
+
+void SlabPool::Shard::lock() {
+    int spins = 0;
+    while (locked.exchange(true, std::memory_order_acquire)) {
+        // The holder may have been preempted on this very core
+        if (++spins < 64) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+SlabPool::SlabPool(size_t block_size, size_t blocks_per_slab)
+    : block_size_((std::max(block_size, sizeof(FreeBlock)) + CACHE_LINE_SIZE - 1) &
+                  ~(CACHE_LINE_SIZE - 1)),
+      blocks_per_slab_(blocks_per_slab) {
+    if (block_size == 0 || blocks_per_slab == 0) {
+        throw std::invalid_argument("Slab pool block size and slab length must be positive");
+    }
+    shard_count_ = std::max(1u, std::thread::hardware_concurrency());
+    shards_.reset(new Shard[shard_count_]);
+}
+
+SlabPool::~SlabPool() {
+    for (void* slab : slabs_) {
+        std::free(slab);
+    }
+}
+
+SlabPool::Shard& SlabPool::localShard() {
+#if defined(__linux__)
+    int cpu = ::sched_getcpu();
+    if (cpu >= 0) {
+        return shards_[static_cast<size_t>(cpu) % shard_count_];
+    }
+#endif
+    thread_local size_t hashed = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return shards_[hashed % shard_count_];
+}
+
+void SlabPool::refill(Shard& shard) {
+    void* slab = nullptr;
+    if (::posix_memalign(&slab, CACHE_LINE_SIZE, block_size_ * blocks_per_slab_) != 0) {
+        throw std::bad_alloc();
+    }
+    {
+        std::lock_guard<std::mutex> lock(slab_mutex_);
+        slabs_.push_back(slab);
+    }
+    uint8_t* bytes = static_cast<uint8_t*>(slab);
+    for (size_t i = blocks_per_slab_; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(bytes + i * block_size_);
+        block->next = shard.head;
+        shard.head = block;
+    }
+}
+
+void* SlabPool::allocate() {
+    Shard& shard = localShard();
+    shard.lock();
+    if (!shard.head) {
+        try {
+            refill(shard);
+        } catch (...) {
+            shard.unlock();
+            throw;
+        }
+    }
+    FreeBlock* block = shard.head;
+    shard.head = block->next;
+    shard.unlock();
+
+    shard.allocations.fetch_add(1, std::memory_order_relaxed);
+    shard.in_use.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+void SlabPool::deallocate(void* p) {
+    if (!p) {
+        return;
+    }
+    Shard& shard = localShard();
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    shard.lock();
+    block->next = shard.head;
+    shard.head = block;
+    shard.unlock();
+    shard.in_use.fetch_sub(1, std::memory_order_relaxed);
+}
+
+SlabPoolStats SlabPool::stats() const {
+    SlabPoolStats result;
+    result.block_size = block_size_;
+    {
+        std::lock_guard<std::mutex> lock(slab_mutex_);
+        result.slabs = slabs_.size();
+    }
+    result.blocks_total = result.slabs * blocks_per_slab_;
+    int64_t in_use = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        result.allocations += shards_[i].allocations.load(std::memory_order_relaxed);
+        in_use += shards_[i].in_use.load(std::memory_order_relaxed);
+    }
+    result.blocks_in_use = in_use > 0 ? static_cast<uint64_t>(in_use) : 0;
+    return result;
+}
+
+// ─── SlabResource ────────────────────────────────────────────────────────
+
+void* SlabResource::do_allocate(size_t bytes, size_t alignment) {
+    return fits(bytes, alignment) ? pool_.allocate() : upstream_->allocate(bytes, alignment);
+}
+
+void SlabResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (fits(bytes, alignment)) {
+        pool_.deallocate(p);
+    } else {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
@@ -0,0 +1,126 @@
+/**
+ * Per-Core Slab Pool for Harmonic IoT Protocol
+ *
+ * Fixed-size block allocator for hot-path buffers (frame payloads, arena
+ * chunks, datagrams). Blocks are carved from large slabs and kept on
+ * per-CPU free lists, so allocation and release are a few instructions
+ * under an uncontended per-core lock instead of a trip through malloc's
+ * shared arenas. Memory is returned to the system only when the pool is
+ * destroyed.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_SLAB_POOL_H
+#define HARMONIC_IOT_RUNTIME_SLAB_POOL_H
+
+#include "runtime/cache_line.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace harmonic_iot {
+namespace runtime {
+
+struct SlabPoolStats {
+    size_t block_size = 0;
+    size_t slabs = 0;
+    uint64_t blocks_total = 0;
+    uint64_t allocations = 0;
+    uint64_t blocks_in_use = 0;
+};
+
+/**
+ * Thread-safe pool of equally sized blocks
+ *
+ * Blocks are cache-line aligned. A block may be released from any thread;
+ * it joins the free list of the CPU doing the release.
+ */
+class SlabPool {
+public:
+    /**
+     * @param block_size Bytes per block (rounded up to a cache line)
+     * @param blocks_per_slab Blocks obtained from the system at a time
+     */
+    explicit SlabPool(size_t block_size, size_t blocks_per_slab = 64);
+
+    /** Frees every slab; outstanding blocks become invalid */
+    ~SlabPool();
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    size_t blockSize() const { return block_size_; }
+
+    /**
+     * @throws std::bad_alloc if a new slab cannot be obtained
+     */
+    void* allocate();
+
+    void deallocate(void* block);
+
+    SlabPoolStats stats() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<bool> locked{false};
+        FreeBlock* head = nullptr;
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<int64_t> in_use{0};
+
+        void lock();
+        void unlock() { locked.store(false, std::memory_order_release); }
+    };
+
+    Shard& localShard();
+    void refill(Shard& shard);
+
+    size_t block_size_;
+    size_t blocks_per_slab_;
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+
+    mutable std::mutex slab_mutex_;
+    std::vector<void*> slabs_;
+};
+
+/**
+ * std::pmr adapter: requests that fit a block come from the pool, larger
+ * or over-aligned ones go to the upstream resource
+ */
+class SlabResource : public std::pmr::memory_resource {
+public:
+    explicit SlabResource(SlabPool& pool,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : pool_(pool), upstream_(upstream) {}
+
+    SlabPool& pool() const { return pool_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    bool fits(size_t bytes, size_t alignment) const {
+        return bytes <= pool_.blockSize() && alignment <= CACHE_LINE_SIZE;
+    }
+
+    SlabPool& pool_;
+    std::pmr::memory_resource* upstream_;
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_SLAB_POOL_H
@@ -0,0 +1,198 @@
+/**
+ * Lock-Free SPSC Ring for Harmonic IoT Protocol
+ *
+ * Single-producer / single-consumer ring that hands sample blocks from a
+ * capture thread to the DSP thread without locks or copies. The storage is
+ * double-mapped, so every readable or writable region is contiguous even
+ * across the wrap point: the DSP can run FFT windows directly on ring
+ * memory, and the capture driver can DMA or read() straight into it.
+ *
+ * Producer and consumer positions live on separate cache lines, and each
+ * side keeps a private copy of the other's position so the shared line is
+ * only re-read when the cached value says the ring looks full (or empty).
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_SPSC_RING_H
+#define HARMONIC_IOT_RUNTIME_SPSC_RING_H
+
+#include "dsp/sample.h"
+#include "runtime/cache_line.h"
+#include "runtime/double_mapped_buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Bounded SPSC ring of trivially copyable elements
+ *
+ * Exactly one thread may call the producer methods (prepare, publish,
+ * write, recordOverrun) and exactly one thread the consumer methods
+ * (readable, window, consume). The statistics may be read from anywhere.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "Ring elements must be trivially copyable");
+
+public:
+    /**
+     * @param min_capacity Minimum number of elements; rounded up so the
+     *        ring spans a power-of-two number of pages
+     */
+    explicit SpscRing(size_t min_capacity)
+        : memory_(min_capacity * sizeof(T)),
+          data_(reinterpret_cast<T*>(memory_.data())),
+          capacity_(memory_.size() / sizeof(T)) {
+        if (memory_.size() % sizeof(T) != 0) {
+            throw std::invalid_argument("Ring element size must divide the page size");
+        }
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    /** Elements currently readable (approximate from a third thread) */
+    size_t size() const {
+        return static_cast<size_t>(head_.value.load(std::memory_order_acquire) -
+                                   tail_.value.load(std::memory_order_acquire));
+    }
+
+    // ─── Producer ────────────────────────────────────────────────────────
+
+    /**
+     * Contiguous writable region of up to max_count elements
+     *
+     * Fill it, then publish() how many were written. The span may be
+     * shorter than requested (or empty) when the consumer is behind.
+     */
+    dsp::Span<T> prepare(size_t max_count) {
+        uint64_t head = head_.value.load(std::memory_order_relaxed);
+        size_t free = capacity_ - static_cast<size_t>(head - producer_tail_cache_);
+        if (free < max_count) {
+            producer_tail_cache_ = tail_.value.load(std::memory_order_acquire);
+            free = capacity_ - static_cast<size_t>(head - producer_tail_cache_);
+        }
+        return dsp::Span<T>(data_ + (head & (capacity_ - 1)), std::min(free, max_count));
+    }
+
+    /**
+     * Make count prepared elements visible to the consumer
+     */
+    void publish(size_t count) {
+        uint64_t head = head_.value.load(std::memory_order_relaxed);
+        head_.value.store(head + count, std::memory_order_release);
+        published_.value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * Copy a block in; whatever does not fit is dropped and counted as overrun
+     *
+     * A capture thread must never block on a slow consumer, so a full ring
+     * loses the newest samples rather than stalling the driver.
+     *
+     * @return Elements written
+     */
+    size_t write(const T* data, size_t count) {
+        dsp::Span<T> span = prepare(count);
+        if (!span.empty()) {
+            std::memcpy(span.data(), data, span.size() * sizeof(T));
+            publish(span.size());
+        }
+        if (span.size() < count) {
+            recordOverrun(count - span.size());
+        }
+        return span.size();
+    }
+
+    /**
+     * Account for elements the producer had to drop
+     */
+    void recordOverrun(size_t dropped) {
+        overrun_elements_.value.fetch_add(dropped, std::memory_order_relaxed);
+        overrun_events_.value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ─── Consumer ────────────────────────────────────────────────────────
+
+    /**
+     * Everything currently readable, as one contiguous span
+     */
+    dsp::Span<const T> readable() {
+        uint64_t tail = tail_.value.load(std::memory_order_relaxed);
+        consumer_head_cache_ = head_.value.load(std::memory_order_acquire);
+        return dsp::Span<const T>(data_ + (tail & (capacity_ - 1)),
+                                  static_cast<size_t>(consumer_head_cache_ - tail));
+    }
+
+    /**
+     * Contiguous window of exactly count elements, or an empty span if
+     * fewer are available. Does not consume, so overlapping analysis
+     * windows are window(N) followed by consume(hop).
+     */
+    dsp::Span<const T> window(size_t count) {
+        uint64_t tail = tail_.value.load(std::memory_order_relaxed);
+        if (consumer_head_cache_ - tail < count) {
+            consumer_head_cache_ = head_.value.load(std::memory_order_acquire);
+            if (consumer_head_cache_ - tail < count) {
+                return dsp::Span<const T>();
+            }
+        }
+        return dsp::Span<const T>(data_ + (tail & (capacity_ - 1)), count);
+    }
+
+    /**
+     * Release count elements back to the producer
+     */
+    void consume(size_t count) {
+        uint64_t tail = tail_.value.load(std::memory_order_relaxed);
+        tail_.value.store(tail + count, std::memory_order_release);
+    }
+
+    // ─── Statistics ──────────────────────────────────────────────────────
+
+    /** Elements published since construction */
+    uint64_t published() const { return published_.value.load(std::memory_order_relaxed); }
+
+    /** Elements dropped because the ring was full */
+    uint64_t overrunElements() const { return overrun_elements_.value.load(std::memory_order_relaxed); }
+
+    /** Number of writes that dropped at least one element */
+    uint64_t overrunEvents() const { return overrun_events_.value.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) PaddedCounter {
+        std::atomic<uint64_t> value{0};
+    };
+
+    DoubleMappedBuffer memory_;
+    T* data_;
+    size_t capacity_;
+
+    // Producer-owned line
+    PaddedCounter head_;
+    alignas(CACHE_LINE_SIZE) uint64_t producer_tail_cache_ = 0;
+    // Consumer-owned line
+    PaddedCounter tail_;
+    alignas(CACHE_LINE_SIZE) uint64_t consumer_head_cache_ = 0;
+    // Statistics, off the hot lines
+    PaddedCounter published_;
+    PaddedCounter overrun_elements_;
+    PaddedCounter overrun_events_;
+};
+
+/**
+ * Ring of DSP samples between the capture and detection threads
+ */
+using SampleRing = SpscRing<dsp::Sample>;
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_SPSC_RING_H
@@ -0,0 +1,413 @@
+/**
+ * Work-Stealing Thread Pool for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "thread_pool.h"
+#include <chrono>
+#include <new>
+#include <string>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace harmonic_iot {
+namespace runtime {
+
+namespace {
+
+/** Empty scans a worker makes (yielding in between) before it sleeps */
+constexpr int IDLE_SPINS = 64;
+
+int64_t monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+bool pinCurrentThread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+void nameCurrentThread(size_t index) {
+#if defined(__linux__)
+    std::string name = "hiot-worker-" + std::to_string(index);
+    ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+#else
+    (void)index;
+#endif
+}
+
+} // namespace
+
+// ─── Worker state ────────────────────────────────────────────────────────
+
+struct alignas(CACHE_LINE_SIZE) ThreadPool::Worker {
+    WorkStealingDeque<QueuedTask> deques[TASK_PRIORITY_LEVELS];
+    uint64_t rng = 0;                        ///< Victim selection (xorshift)
+    int cpu = -1;
+    int64_t started_ns = 0;
+
+    // Written by the worker, read by stats()
+    std::atomic<uint64_t> tasks_executed{0};
+    std::atomic<uint64_t> steals{0};
+    std::atomic<uint64_t> steal_attempts{0};
+    std::atomic<int64_t> idle_ns{0};
+    std::atomic<int64_t> idle_since_ns{0};   ///< 0 while busy
+};
+
+namespace {
+
+struct CurrentWorker {
+    const ThreadPool* pool = nullptr;
+    size_t index = 0;
+};
+
+thread_local CurrentWorker current_worker;
+
+} // namespace
+
+// ─── Construction ────────────────────────────────────────────────────────
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config) : clock_(config.clock) {
+    std::vector<int> cpus = allowedCpus();
+    size_t count = config.workers != 0 ? config.workers : cpus.size();
+
+    for (auto& level : queued_) {
+        level.store(0, std::memory_order_relaxed);
+    }
+
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(new Worker());
+        workers_.back()->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+        if (config.pin_workers) {
+            workers_.back()->cpu = cpus[(config.first_cpu + i) % cpus.size()];
+        }
+    }
+    threads_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_.store(true, std::memory_order_seq_cst);
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    // Pool without workers: run leftovers on the destroying thread
+    while (runPendingTask()) {
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+int ThreadPool::currentWorker() const {
+    return current_worker.pool == this ? static_cast<int>(current_worker.index) : -1;
+}
+
+// ─── Submission ──────────────────────────────────────────────────────────
+
+void ThreadPool::submit(Task task, TaskPriority priority) {
+    const size_t level = static_cast<size_t>(priority);
+    QueuedTask* queued = new (task_pool_.allocate()) QueuedTask{std::move(task)};
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    if (clock_) {
+        clock_->hold();
+    }
+
+    // Count before publishing: a worker that sees the count but not yet the
+    // task keeps scanning instead of sleeping
+    queued_[level].fetch_add(1, std::memory_order_seq_cst);
+    if (current_worker.pool == this) {
+        workers_[current_worker.index]->deques[level].push(queued);
+    } else {
+        InjectionQueue& queue = injected_[level];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.push(queued);
+    }
+
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        wakeOne();
+    }
+}
+
+void ThreadPool::wakeOne() {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_.notify_one();
+}
+
+bool ThreadPool::hasQueuedWork() const {
+    for (const auto& level : queued_) {
+        if (level.load(std::memory_order_seq_cst) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::localQueueEmpty(TaskPriority priority) const {
+    if (current_worker.pool != this) {
+        return true;
+    }
+    return workers_[current_worker.index]->deques[static_cast<size_t>(priority)].empty();
+}
+
+size_t ThreadPool::defaultGrain(size_t count) const {
+    // Enough chunks for stealing to balance uneven work, few enough that
+    // per-chunk overhead stays negligible
+    size_t participants = workers_.size() + 1;
+    return std::max<size_t>(1, count / (participants * 64));
+}
+
+// ─── Scheduling ──────────────────────────────────────────────────────────
+
+ThreadPool::QueuedTask* ThreadPool::popInjected(size_t level) {
+    InjectionQueue& queue = injected_[level];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    return queue.pop();
+}
+
+ThreadPool::QueuedTask* ThreadPool::stealTask(size_t level, Worker* self) {
+    const size_t count = workers_.size();
+    if (count == 0) {
+        return nullptr;
+    }
+    size_t start = 0;
+    if (self) {
+        self->rng ^= self->rng << 13;
+        self->rng ^= self->rng >> 7;
+        self->rng ^= self->rng << 17;
+        start = static_cast<size_t>(self->rng % count);
+    }
+
+    uint64_t attempts = 0;
+    QueuedTask* task = nullptr;
+    for (size_t n = 0; n < count && !task; ++n) {
+        Worker* victim = workers_[(start + n) % count].get();
+        if (victim == self) {
+            continue;
+        }
+        StealResult result;
+        do {
+            ++attempts;
+            result = victim->deques[level].steal(task);
+        } while (result == StealResult::Contended);
+    }
+    if (self) {
+        self->steal_attempts.fetch_add(attempts, std::memory_order_relaxed);
+        if (task) {
+            self->steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return task;
+}
+
+ThreadPool::QueuedTask* ThreadPool::findTask(Worker* self) {
+    for (size_t level = 0; level < TASK_PRIORITY_LEVELS; ++level) {
+        if (queued_[level].load(std::memory_order_relaxed) <= 0) {
+            continue;
+        }
+        QueuedTask* task = self ? self->deques[level].pop() : nullptr;
+        if (!task) {
+            task = popInjected(level);
+        }
+        if (!task) {
+            task = stealTask(level, self);
+        }
+        if (task) {
+            queued_[level].fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::execute(QueuedTask* task, Worker* self) {
+    task->fn();
+    task->~QueuedTask();
+    task_pool_.deallocate(task);
+    if (self) {
+        self->tasks_executed.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (clock_) {
+        clock_->release();
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    Worker* self = current_worker.pool == this ? workers_[current_worker.index].get() : nullptr;
+    QueuedTask* task = findTask(self);
+    if (!task) {
+        return false;
+    }
+    execute(task, self);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    Worker* self = workers_[index].get();
+    current_worker.pool = this;
+    current_worker.index = index;
+    nameCurrentThread(index);
+    if (self->cpu >= 0 && !pinCurrentThread(self->cpu)) {
+        self->cpu = -1;
+    }
+    self->started_ns = monotonicNs();
+
+    int misses = 0;
+    for (;;) {
+        QueuedTask* task = findTask(self);
+        if (task) {
+            int64_t idle_since = self->idle_since_ns.load(std::memory_order_relaxed);
+            if (idle_since != 0) {
+                self->idle_ns.fetch_add(monotonicNs() - idle_since, std::memory_order_relaxed);
+                self->idle_since_ns.store(0, std::memory_order_relaxed);
+            }
+            misses = 0;
+            execute(task, self);
+            continue;
+        }
+
+        if (self->idle_since_ns.load(std::memory_order_relaxed) == 0) {
+            self->idle_since_ns.store(monotonicNs(), std::memory_order_relaxed);
+        }
+        if (++misses < IDLE_SPINS) {
+            // Yield rather than spin: workers may outnumber cores
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        while (!hasQueuedWork() && !stopping_.load(std::memory_order_relaxed)) {
+            wake_.wait(lock);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        if (!hasQueuedWork() && stopping_.load(std::memory_order_relaxed)) {
+            break;
+        }
+        misses = 0;
+    }
+
+    current_worker.pool = nullptr;
+}
+
+// ─── Statistics ──────────────────────────────────────────────────────────
+
+ThreadPoolStats ThreadPool::stats() const {
+    ThreadPoolStats result;
+    result.tasks_submitted = submitted_.load(std::memory_order_relaxed);
+    const int64_t now = monotonicNs();
+    double busy_total = 0.0;
+    double idle_total = 0.0;
+
+    for (const auto& worker : workers_) {
+        WorkerStats ws;
+        ws.cpu = worker->cpu;
+        ws.tasks_executed = worker->tasks_executed.load(std::memory_order_relaxed);
+        ws.steals = worker->steals.load(std::memory_order_relaxed);
+        ws.steal_attempts = worker->steal_attempts.load(std::memory_order_relaxed);
+
+        int64_t started = worker->started_ns;
+        int64_t idle = worker->idle_ns.load(std::memory_order_relaxed);
+        int64_t idle_since = worker->idle_since_ns.load(std::memory_order_relaxed);
+        if (idle_since != 0) {
+            idle += now - idle_since;
+        }
+        int64_t elapsed = started != 0 ? now - started : 0;
+        ws.idle_seconds = static_cast<double>(idle) * 1e-9;
+        ws.busy_seconds = static_cast<double>(std::max<int64_t>(0, elapsed - idle)) * 1e-9;
+
+        result.tasks_executed += ws.tasks_executed;
+        result.steals += ws.steals;
+        busy_total += ws.busy_seconds;
+        idle_total += ws.idle_seconds;
+        result.workers.push_back(ws);
+    }
+    if (busy_total + idle_total > 0.0) {
+        result.utilization = busy_total / (busy_total + idle_total);
+    }
+    return result;
+}
+
+// ─── TaskGroup ───────────────────────────────────────────────────────────
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::run(ThreadPool::Task task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit([this, task = std::move(task)] {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+        pending_.fetch_sub(1, std::memory_order_release);
+    }, priority_);
+}
+
+void TaskGroup::wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
@@ -0,0 +1,364 @@
+/**
+ * Work-Stealing Thread Pool for Harmonic IoT Protocol
+ *
+ * The engine's shared parallel runtime. Each worker owns one Chase–Lev
+ * deque per priority level; tasks spawned by a worker go to its own deque
+ * and idle workers steal from the others, so load balances itself without
+ * a central queue. Tasks submitted from outside the pool enter through a
+ * small per-priority injection queue.
+ *
+ * Batch codec, batch FFT, crypto batches and queries should all run here
+ * (ThreadPool::shared()) rather than spawning their own threads, so the
+ * subsystems share cores instead of oversubscribing them.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_THREAD_POOL_H
+#define HARMONIC_IOT_RUNTIME_THREAD_POOL_H
+
+#include "runtime/cache_line.h"
+#include "runtime/clock.h"
+#include "runtime/slab_pool.h"
+#include "runtime/work_stealing_deque.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Scheduling priority; a worker drains every higher level before
+ * touching a lower one
+ */
+enum class TaskPriority : uint8_t {
+    High = 0,      ///< Latency-sensitive (live receive path)
+    Normal = 1,
+    Low = 2        ///< Background (snapshots, compaction, exports)
+};
+
+constexpr size_t TASK_PRIORITY_LEVELS = 3;
+
+/**
+ * Pool construction options
+ */
+struct ThreadPoolConfig {
+    size_t workers = 0;        ///< 0 = one per available CPU
+    bool pin_workers = false;  ///< Pin worker i to the i-th allowed CPU (Linux)
+    size_t first_cpu = 0;      ///< Offset into the allowed CPU list when pinning
+    Clock* clock = nullptr;    ///< Held from submit until the task has run (see VirtualClock)
+};
+
+/**
+ * Counters for one worker
+ */
+struct WorkerStats {
+    int cpu = -1;                  ///< Pinned CPU, or -1
+    uint64_t tasks_executed = 0;
+    uint64_t steals = 0;           ///< Tasks taken from another worker
+    uint64_t steal_attempts = 0;   ///< Victims probed, successful or not
+    double busy_seconds = 0.0;
+    double idle_seconds = 0.0;
+};
+
+/**
+ * Pool-wide counters
+ */
+struct ThreadPoolStats {
+    std::vector<WorkerStats> workers;
+    uint64_t tasks_submitted = 0;
+    uint64_t tasks_executed = 0;
+    uint64_t steals = 0;
+    double utilization = 0.0;      ///< busy / (busy + idle) across workers
+};
+
+/**
+ * Work-stealing executor
+ *
+ * All methods are thread-safe. A task submitted with submit() must not
+ * throw (an escaping exception terminates the process, as with
+ * std::thread); use TaskGroup to propagate exceptions to a waiter.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(const ThreadPoolConfig& config = ThreadPoolConfig());
+
+    /**
+     * Runs every task still queued, then joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Process-wide pool with one worker per available CPU
+     */
+    static ThreadPool& shared();
+
+    size_t workerCount() const { return workers_.size(); }
+
+    /**
+     * Index of the calling worker in this pool, or -1 for other threads
+     */
+    int currentWorker() const;
+
+    /**
+     * Queue a task (fire and forget)
+     */
+    void submit(Task task, TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * Run one queued task on the calling thread, if any is available
+     *
+     * Used by waiters so that blocking on a result never idles a core.
+     *
+     * @return True if a task was run
+     */
+    bool runPendingTask();
+
+    /**
+     * Apply body(chunk_begin, chunk_end) over [begin, end) in parallel
+     *
+     * Ranges are split lazily: a participant keeps processing grain-sized
+     * chunks and only splits off half of its remaining range when its own
+     * deque is empty, i.e. when another worker may be looking for work. Few
+     * tasks are created when the pool is busy, many when it is idle.
+     *
+     * @param grain Smallest chunk handed to body; 0 picks one from the range
+     *        size and worker count
+     * @throws Rethrows the first exception thrown by body
+     */
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, Body&& body, size_t grain = 0,
+                     TaskPriority priority = TaskPriority::Normal);
+
+    /**
+     * Map-reduce over [begin, end)
+     *
+     * The range is cut into blocks, map(block_begin, block_end) runs in
+     * parallel and results are combined left to right, so the result is
+     * deterministic for non-associative types such as float sums.
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine,
+                     size_t grain = 0, TaskPriority priority = TaskPriority::Normal);
+
+    ThreadPoolStats stats() const;
+
+private:
+    struct Worker;
+    struct QueuedTask {
+        Task fn;
+    };
+
+    void workerLoop(size_t index);
+    QueuedTask* findTask(Worker* self);
+    QueuedTask* stealTask(size_t level, Worker* self);
+    QueuedTask* popInjected(size_t level);
+    void execute(QueuedTask* task, Worker* self);
+    void wakeOne();
+    bool hasQueuedWork() const;
+    bool localQueueEmpty(TaskPriority priority) const;
+    size_t defaultGrain(size_t count) const;
+
+    template <typename Body>
+    friend class ParallelRange;
+    friend class TaskGroup;
+
+    SlabPool task_pool_{sizeof(QueuedTask), 256};   ///< Task nodes; no malloc per submit
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    /**
+     * Tasks submitted from outside the pool, FIFO
+     *
+     * A ring that only grows when full, so steady-state submission does not
+     * allocate (std::deque allocates a node every few dozen pushes).
+     */
+    struct alignas(CACHE_LINE_SIZE) InjectionQueue {
+        std::mutex mutex;
+        std::vector<QueuedTask*> ring;   ///< Power-of-two size
+        size_t head = 0;
+        size_t count = 0;
+
+        void push(QueuedTask* task) {
+            if (count == ring.size()) {
+                std::vector<QueuedTask*> larger(std::max<size_t>(64, ring.size() * 2));
+                for (size_t i = 0; i < count; ++i) {
+                    larger[i] = ring[(head + i) & (ring.size() - 1)];
+                }
+                ring.swap(larger);
+                head = 0;
+            }
+            ring[(head + count) & (ring.size() - 1)] = task;
+            ++count;
+        }
+
+        QueuedTask* pop() {
+            if (count == 0) {
+                return nullptr;
+            }
+            QueuedTask* task = ring[head];
+            head = (head + 1) & (ring.size() - 1);
+            --count;
+            return task;
+        }
+    };
+    InjectionQueue injected_[TASK_PRIORITY_LEVELS];
+
+    /** Tasks sitting in any queue, per level; lets workers skip empty levels */
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> queued_[TASK_PRIORITY_LEVELS];
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> submitted_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<int> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+    Clock* clock_ = nullptr;
+};
+
+/**
+ * A set of tasks that can be waited on together
+ *
+ * wait() helps execute pending tasks while it waits, so groups may be
+ * nested inside pool tasks without deadlock. The first exception thrown
+ * by a task is rethrown from wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool, TaskPriority priority = TaskPriority::Normal)
+        : pool_(pool), priority_(priority) {}
+
+    /** Waits for outstanding tasks; exceptions are discarded */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(ThreadPool::Task task);
+
+    /**
+     * Block until every task run() so far has finished
+     *
+     * @throws The first exception raised by a task in this group
+     */
+    void wait();
+
+private:
+    ThreadPool& pool_;
+    TaskPriority priority_;
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+// ─── Template implementation ─────────────────────────────────────────────
+
+/**
+ * Lazily split range shared by the participants of one parallelFor
+ */
+template <typename Body>
+class ParallelRange {
+public:
+    ParallelRange(ThreadPool& pool, TaskGroup& group, Body& body, size_t grain, TaskPriority priority)
+        : pool_(pool), group_(group), body_(body), grain_(grain), priority_(priority) {}
+
+    void execute(size_t begin, size_t end) {
+        while (end - begin > grain_) {
+            if (end - begin >= 2 * grain_ && pool_.localQueueEmpty(priority_)) {
+                size_t mid = begin + (end - begin) / 2;
+                group_.run([this, mid, end] { execute(mid, end); });
+                end = mid;
+            } else {
+                body_(begin, begin + grain_);
+                begin += grain_;
+            }
+        }
+        body_(begin, end);
+    }
+
+private:
+    ThreadPool& pool_;
+    TaskGroup& group_;
+    Body& body_;
+    size_t grain_;
+    TaskPriority priority_;
+};
+
+template <typename Body>
+void ThreadPool::parallelFor(size_t begin, size_t end, Body&& body, size_t grain,
+                             TaskPriority priority) {
+    if (begin >= end) {
+        return;
+    }
+    const size_t count = end - begin;
+    if (grain == 0) {
+        grain = defaultGrain(count);
+    }
+    if (count <= grain || workers_.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this, priority);
+    ParallelRange<typename std::remove_reference<Body>::type> range(*this, group, body, grain, priority);
+    try {
+        range.execute(begin, end);
+    } catch (...) {
+        // Let spawned halves finish before their captured state goes away
+        try { group.wait(); } catch (...) {}
+        throw;
+    }
+    group.wait();
+}
+
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine,
+                             size_t grain, TaskPriority priority) {
+    if (begin >= end) {
+        return identity;
+    }
+    const size_t count = end - begin;
+    if (grain == 0) {
+        grain = defaultGrain(count);
+    }
+    const size_t blocks = std::min((count + grain - 1) / grain, (workers_.size() + 1) * 8);
+    if (blocks <= 1) {
+        return combine(identity, map(begin, end));
+    }
+
+    std::vector<T> partial(blocks, identity);
+    const size_t block_size = (count + blocks - 1) / blocks;
+    parallelFor(0, blocks, [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; ++b) {
+            size_t lo = begin + b * block_size;
+            size_t hi = std::min(end, lo + block_size);
+            if (lo < hi) {
+                partial[b] = map(lo, hi);
+            }
+        }
+    }, 1, priority);
+
+    T result = identity;
+    for (const T& value : partial) {
+        result = combine(result, value);
+    }
+    return result;
+}
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_THREAD_POOL_H
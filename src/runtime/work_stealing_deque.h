@@ -0,0 +1,160 @@
+/**
+ * Chase–Lev Work-Stealing Deque for Harmonic IoT Protocol
+ *
+ * The owner pushes and pops at the bottom without contention; any number
+ * of thieves steal from the top with a single CAS. The buffer grows on
+ * demand and retired buffers are kept until the deque is destroyed, so a
+ * thief holding an old buffer pointer never reads freed memory.
+ *
+ * Memory orderings follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_RUNTIME_WORK_STEALING_DEQUE_H
+#define HARMONIC_IOT_RUNTIME_WORK_STEALING_DEQUE_H
+
+#include "runtime/cache_line.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace harmonic_iot {
+namespace runtime {
+
+/**
+ * Outcome of a steal attempt
+ */
+enum class StealResult {
+    Success,
+    Empty,
+    Contended    ///< Lost the race to the owner or another thief; worth retrying
+};
+
+/**
+ * Single-owner, multi-thief deque of pointers
+ *
+ * push() and pop() may only be called by the owning thread; steal() and
+ * empty() by any thread.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t initial_capacity = 256) {
+        size_t capacity = 1;
+        while (capacity < initial_capacity) {
+            capacity <<= 1;
+        }
+        retired_.emplace_back(new Buffer(capacity));
+        buffer_.store(retired_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * Owner: push onto the bottom
+     */
+    void push(T* item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Owner: pop from the bottom (LIFO, cache-warm)
+     *
+     * @return Item, or nullptr if empty
+     */
+    T* pop() {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = buffer->get(bottom);
+        if (top == bottom) {
+            // Last element: race any thief for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * Any thread: steal from the top (FIFO, oldest and usually largest work)
+     */
+    StealResult steal(T*& item) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return StealResult::Empty;
+        }
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T* candidate = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return StealResult::Contended;
+        }
+        item = candidate;
+        return StealResult::Success;
+    }
+
+    /** Approximate; exact only when called by the owner with no thieves */
+    bool empty() const {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity) : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+
+        T* get(int64_t index) const {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+        void put(int64_t index, T* item) {
+            slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old, int64_t top, int64_t bottom) {
+        retired_.emplace_back(new Buffer((old->mask + 1) * 2));
+        Buffer* grown = retired_.back().get();
+        for (int64_t i = top; i < bottom; ++i) {
+            grown->put(i, old->get(i));
+        }
+        buffer_.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> retired_;   ///< Owner only
+};
+
+} // namespace runtime
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_RUNTIME_WORK_STEALING_DEQUE_H
@@ -9,6 +9,11 @@
  */
 
 #include "secure_config.h"
+#include "telemetry/alloc_accounting.h"
+#include "telemetry/latency.h"
+#include "telemetry/log.h"
+#include "telemetry/metrics.h"
+#include "telemetry/probes.h"
 #include <argon2.h>
 #include <jwt-cpp/jwt.h>
 #include <openssl/rand.h>
@@ -16,11 +21,31 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <chrono>
-#include <iostream>
 
 namespace harmonic_iot {
 namespace security {
 
+namespace {
+
+/** harmonic_crypto_operations_total{op=...} */
+telemetry::Counter& cryptoOps(const char* op) {
+    return telemetry::MetricsRegistry::global().counter(
+        "harmonic_crypto_operations_total", "Cryptographic operations performed", {{"op", op}});
+}
+
+/** jwt-cpp timestamp for the clock's current wall time */
+jwt::date clockDate(const runtime::Clock& clock) {
+    return jwt::date(std::chrono::duration_cast<jwt::date::duration>(std::chrono::nanoseconds(clock.wallNs())));
+}
+
+/** jwt-cpp verifier clock: expiry checks follow the configured clock */
+struct VerifyClock {
+    const runtime::Clock* clock;
+    jwt::date now() const { return clockDate(*clock); }
+};
+
+} // namespace
+
 SecureConfig::SecureConfig() {
     // Initialize OpenSSL
     if (!RAND_status()) {
@@ -44,7 +69,7 @@ void SecureConfig::loadEnvironmentConfig() {
     } else {
         // Generate random JWT secret if not provided
         jwt_secret_ = generateRandomString(64);
-        std::cerr << "WARNING: JWT_SECRET not set, using generated secret" << std::endl;
+        HIOT_LOG_WARN("JWT_SECRET not set, using generated secret");
     }
 
     const char* jwt_private_key = std::getenv("JWT_PRIVATE_KEY");
@@ -71,11 +96,15 @@ void SecureConfig::loadEnvironmentConfig() {
         encryption_key_ = std::string(encryption_key);
     } else {
         encryption_key_ = generateRandomString(32);
-        std::cerr << "WARNING: ENCRYPTION_KEY not set, using generated key" << std::endl;
+        HIOT_LOG_WARN("ENCRYPTION_KEY not set, using generated key");
     }
 }
 
 std::string SecureConfig::hashPassword(const std::string& password, const std::string& salt) {
+    HIOT_LATENCY_SCOPE(Crypto);
+    HIOT_ALLOC_SCOPE("hash_password");
+    static telemetry::Counter& ops = cryptoOps("hash_password");
+    ops.inc();
     if (password.empty()) {
         throw std::invalid_argument("Password cannot be empty");
     }
@@ -93,6 +122,7 @@ std::string SecureConfig::hashPassword(const std::string& password, const std::s
 
     std::vector<uint8_t> hash(hash_len);
 
+    HIOT_PROBE2(argon2_start, m_cost, t_cost);
     int result = argon2id_hash_raw(
         t_cost, m_cost, parallelism,
         password.c_str(), password.length(),
@@ -100,6 +130,8 @@ std::string SecureConfig::hashPassword(const std::string& password, const std::s
         hash.data(), hash_len
     );
 
+    HIOT_PROBE1(argon2_end, result);
+
     if (result != ARGON2_OK) {
         throw std::runtime_error("Argon2id hashing failed: " + std::string(argon2_error_message(result)));
     }
@@ -109,6 +141,10 @@ std::string SecureConfig::hashPassword(const std::string& password, const std::s
 }
 
 bool SecureConfig::verifyPassword(const std::string& password, const std::string& hash) {
+    HIOT_LATENCY_SCOPE(Crypto);
+    HIOT_ALLOC_SCOPE("verify_password");
+    static telemetry::Counter& ops = cryptoOps("verify_password");
+    ops.inc();
     if (password.empty() || hash.empty()) {
         return false;
     }
@@ -136,7 +172,8 @@ bool SecureConfig::verifyPassword(const std::string& password, const std::string
 }
 
 std::string SecureConfig::generateJWTToken(const std::string& user_id, const std::string& role, int expires_in_minutes) {
-    auto now = std::chrono::system_clock::now();
+    HIOT_ALLOC_SCOPE("generate_jwt");
+    auto now = clockDate(*clock_);
     auto exp = now + std::chrono::minutes(expires_in_minutes);
 
     auto token = jwt::create()
@@ -154,7 +191,7 @@ std::string SecureConfig::generateJWTToken(const std::string& user_id, const std
 }
 
 std::string SecureConfig::generateRefreshToken(const std::string& user_id) {
-    auto now = std::chrono::system_clock::now();
+    auto now = clockDate(*clock_);
     auto exp = now + std::chrono::hours(24 * 7); // 7 days
 
     auto token = jwt::create()
@@ -171,8 +208,13 @@ std::string SecureConfig::generateRefreshToken(const std::string& user_id) {
 }
 
 bool SecureConfig::verifyJWTToken(const std::string& token, std::string& user_id, std::string& role) {
+    HIOT_LATENCY_SCOPE(Crypto);
+    HIOT_ALLOC_SCOPE("verify_jwt");
+    static telemetry::Counter& ops = cryptoOps("verify_jwt");
+    ops.inc();
+    HIOT_PROBE(jwt_verify_start);
     try {
-        auto verifier = jwt::verify()
+        auto verifier = jwt::verify<VerifyClock, jwt::traits::kazuho_picojson>(VerifyClock{clock_})
             .allow_algorithm(jwt::algorithm::hs256{jwt_secret_})
             .with_issuer("harmonic-iot-protocol");
 
@@ -188,14 +230,20 @@ bool SecureConfig::verifyJWTToken(const std::string& token, std::string& user_id
             role = decoded.get_payload_claim("role").as_string();
         }
 
+        HIOT_PROBE1(jwt_verify_end, 1);
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "JWT verification failed: " << e.what() << std::endl;
+        HIOT_PROBE1(jwt_verify_end, 0);
+        HIOT_LOG_LIMITED(Warn, 10, "JWT verification failed: {}", e.what());
         return false;
     }
 }
 
 std::string SecureConfig::encryptData(const std::string& plaintext) {
+    HIOT_LATENCY_SCOPE(Crypto);
+    HIOT_ALLOC_SCOPE("encrypt");
+    static telemetry::Counter& ops = cryptoOps("encrypt");
+    ops.inc();
     if (plaintext.empty()) {
         return "";
     }
@@ -257,29 +305,41 @@ std::string SecureConfig::encryptData(const std::string& plaintext) {
 
     // Combine IV + ciphertext + tag and encode as base64
     std::vector<uint8_t> result;
+    result.reserve(iv.size() + ciphertext_len + tag.size());
     result.insert(result.end(), iv.begin(), iv.end());
     result.insert(result.end(), ciphertext.begin(), ciphertext.begin() + ciphertext_len);
     result.insert(result.end(), tag.begin(), tag.end());
+    HIOT_COUNT_COPY(result.size());
 
-    return encodeBase64(result);
+    std::string encoded = encodeBase64(result);
+    HIOT_COUNT_COPY(encoded.size());
+    return encoded;
 }
 
 std::string SecureConfig::decryptData(const std::string& ciphertext_b64) {
+    HIOT_LATENCY_SCOPE(Crypto);
+    HIOT_ALLOC_SCOPE("decrypt");
+    static telemetry::Counter& ops = cryptoOps("decrypt");
+    ops.inc();
     if (ciphertext_b64.empty()) {
         return "";
     }
 
     // Decode from base64
     std::vector<uint8_t> data = decodeBase64(ciphertext_b64);
+    HIOT_COUNT_COPY(data.size());
 
     if (data.size() < 32) { // IV (16) + tag (16) minimum
         throw std::runtime_error("Invalid ciphertext length");
     }
 
-    // Extract IV, ciphertext, and tag
+    // Extract IV, ciphertext, and tag (one copy each)
     std::vector<uint8_t> iv(data.begin(), data.begin() + 16);
+    HIOT_COUNT_COPY(iv.size());
     std::vector<uint8_t> tag(data.end() - 16, data.end());
+    HIOT_COUNT_COPY(tag.size());
     std::vector<uint8_t> ciphertext(data.begin() + 16, data.end() - 16);
+    HIOT_COUNT_COPY(ciphertext.size());
 
     // Initialize decryption context
     EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
@@ -326,6 +386,7 @@ std::string SecureConfig::decryptData(const std::string& ciphertext_b64) {
     plaintext_len += len;
     EVP_CIPHER_CTX_free(ctx);
 
+    HIOT_COUNT_COPY(plaintext_len);
     return std::string(plaintext.begin(), plaintext.begin() + plaintext_len);
 }
 
@@ -11,6 +11,7 @@
 #ifndef HARMONIC_IOT_SECURE_CONFIG_H
 #define HARMONIC_IOT_SECURE_CONFIG_H
 
+#include "runtime/clock.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -108,6 +109,15 @@ public:
      */
     std::string generateRandomString(size_t length);
 
+    /**
+     * Time source for token issue and expiry checks (default: Clock::system())
+     *
+     * Simulations pass a VirtualClock so tokens expire in simulated time.
+     *
+     * @param clock Must outlive this object
+     */
+    void setClock(runtime::Clock& clock) { clock_ = &clock; }
+
     // Getters for configuration
     const std::string& getDatabaseUrl() const { return database_url_; }
     const std::string& getEncryptionKey() const { return encryption_key_; }
@@ -120,6 +130,7 @@ private:
     std::string jwt_secret_;
     std::string jwt_private_key_;
     std::string jwt_public_key_;
+    runtime::Clock* clock_ = &runtime::Clock::system();
 
     /**
      * Load configuration from environment variables
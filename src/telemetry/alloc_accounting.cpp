@@ -0,0 +1,353 @@
+/**
+ * Allocation and Copy Accounting for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "alloc_accounting.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace {
+
+// Everything below is touched from operator new, so it must be constant
+// initialized and must not allocate.
+thread_local AllocSite* current_site = nullptr;
+thread_local uint64_t thread_allocations = 0;
+thread_local uint64_t thread_bytes = 0;
+thread_local uint64_t thread_copies = 0;
+
+std::atomic<uint64_t> unscoped_allocations{0};
+std::atomic<uint64_t> unscoped_bytes{0};
+std::atomic<uint64_t> unscoped_frees{0};
+std::atomic<uint64_t> unscoped_copies{0};
+std::atomic<uint64_t> unscoped_copy_bytes{0};
+
+struct SiteTable {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<AllocSite>> sites;
+};
+
+/**
+ * Stored just before every counted block, so its free is charged to the
+ * site that allocated it rather than to the scope active at the free
+ */
+struct AllocHeader {
+    AllocSite* site;
+    void* base;         // Start of the underlying allocation
+};
+
+/** Bytes reserved in front of a block; a multiple of the block's alignment */
+constexpr size_t headerSpace(size_t alignment) {
+    return alignment > sizeof(AllocHeader) ? alignment : sizeof(AllocHeader);
+}
+
+void* attachHeader(void* base, size_t offset, AllocSite* site) {
+    if (!base) {
+        return nullptr;
+    }
+    char* block = static_cast<char*>(base) + offset;
+    AllocHeader* header = reinterpret_cast<AllocHeader*>(block) - 1;
+    header->site = site;
+    header->base = base;
+    return block;
+}
+
+const AllocHeader& headerOf(void* block) {
+    return *(reinterpret_cast<const AllocHeader*>(block) - 1);
+}
+
+SiteTable& siteTable() {
+    // Never destroyed: scopes may close during static destruction
+    static SiteTable* table = new SiteTable();
+    return *table;
+}
+
+AllocStats snapshot(const AllocSite& site) {
+    AllocStats s;
+    s.name = site.name;
+    s.calls = site.calls.load(std::memory_order_relaxed);
+    s.allocations = site.allocations.load(std::memory_order_relaxed);
+    s.bytes = site.bytes.load(std::memory_order_relaxed);
+    s.frees = site.frees.load(std::memory_order_relaxed);
+    s.copies = site.copies.load(std::memory_order_relaxed);
+    s.copy_bytes = site.copy_bytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace
+
+AllocSite* allocSite(const std::string& name) {
+    SiteTable& table = siteTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    for (const auto& site : table.sites) {
+        if (site->name == name) {
+            return site.get();
+        }
+    }
+    table.sites.emplace_back(new AllocSite(name));
+    return table.sites.back().get();
+}
+
+AllocScope::AllocScope(AllocSite* site) : previous_(current_site) {
+    if (site) {
+        current_site = site;
+        site->calls.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+AllocScope::~AllocScope() {
+    current_site = previous_;
+}
+
+AllocSite* countAllocation(size_t bytes) {
+    ++thread_allocations;
+    thread_bytes += bytes;
+    AllocSite* site = current_site;
+    if (site) {
+        site->allocations.fetch_add(1, std::memory_order_relaxed);
+        site->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        unscoped_allocations.fetch_add(1, std::memory_order_relaxed);
+        unscoped_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    return site;
+}
+
+void countFree(AllocSite* owner) {
+    if (owner) {
+        owner->frees.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        unscoped_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void countCopy(size_t bytes) {
+    ++thread_copies;
+    if (AllocSite* site = current_site) {
+        site->copies.fetch_add(1, std::memory_order_relaxed);
+        site->copy_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        unscoped_copies.fetch_add(1, std::memory_order_relaxed);
+        unscoped_copy_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+std::vector<AllocStats> allocationReport() {
+    std::vector<AllocStats> report;
+    {
+        SiteTable& table = siteTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        report.reserve(table.sites.size() + 1);
+        for (const auto& site : table.sites) {
+            report.push_back(snapshot(*site));
+        }
+    }
+    AllocStats unscoped;
+    unscoped.name = "(unscoped)";
+    unscoped.allocations = unscoped_allocations.load(std::memory_order_relaxed);
+    unscoped.bytes = unscoped_bytes.load(std::memory_order_relaxed);
+    unscoped.frees = unscoped_frees.load(std::memory_order_relaxed);
+    unscoped.copies = unscoped_copies.load(std::memory_order_relaxed);
+    unscoped.copy_bytes = unscoped_copy_bytes.load(std::memory_order_relaxed);
+    report.push_back(unscoped);
+
+    std::stable_sort(report.begin(), report.end(), [](const AllocStats& a, const AllocStats& b) {
+        return a.bytes > b.bytes;
+    });
+    return report;
+}
+
+std::string formatAllocationReport() {
+    std::vector<AllocStats> report = allocationReport();
+    size_t width = 9;
+    for (const AllocStats& s : report) {
+        width = std::max(width, s.name.size());
+    }
+
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-*s %10s %10s %12s %10s %12s %8s %12s\n",
+                  static_cast<int>(width), "operation", "calls", "allocs", "bytes",
+                  "allocs/op", "bytes/op", "copies", "copy bytes");
+    out += line;
+    for (const AllocStats& s : report) {
+        std::snprintf(line, sizeof(line), "%-*s %10llu %10llu %12llu %10.2f %12.1f %8llu %12llu\n",
+                      static_cast<int>(width), s.name.c_str(),
+                      static_cast<unsigned long long>(s.calls),
+                      static_cast<unsigned long long>(s.allocations),
+                      static_cast<unsigned long long>(s.bytes),
+                      s.allocationsPerCall(), s.bytesPerCall(),
+                      static_cast<unsigned long long>(s.copies),
+                      static_cast<unsigned long long>(s.copy_bytes));
+        out += line;
+    }
+    return out;
+}
+
+void resetAllocationCounters() {
+    {
+        SiteTable& table = siteTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (const auto& site : table.sites) {
+            site->calls.store(0, std::memory_order_relaxed);
+            site->allocations.store(0, std::memory_order_relaxed);
+            site->bytes.store(0, std::memory_order_relaxed);
+            site->frees.store(0, std::memory_order_relaxed);
+            site->copies.store(0, std::memory_order_relaxed);
+            site->copy_bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+    unscoped_allocations.store(0, std::memory_order_relaxed);
+    unscoped_bytes.store(0, std::memory_order_relaxed);
+    unscoped_frees.store(0, std::memory_order_relaxed);
+    unscoped_copies.store(0, std::memory_order_relaxed);
+    unscoped_copy_bytes.store(0, std::memory_order_relaxed);
+}
+
+// ─── AllocationDelta / CountingResource ──────────────────────────────────
+
+AllocationDelta::AllocationDelta()
+    : allocations_(thread_allocations), bytes_(thread_bytes), copies_(thread_copies) {}
+
+uint64_t AllocationDelta::allocations() const { return thread_allocations - allocations_; }
+uint64_t AllocationDelta::bytes() const { return thread_bytes - bytes_; }
+uint64_t AllocationDelta::copies() const { return thread_copies - copies_; }
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+#if HARMONIC_IOT_ALLOC_ACCOUNTING
+    void* p = upstream_->allocate(bytes, alignment);    // The upstream's operator new counts it
+#else
+    const size_t offset = headerSpace(alignment);
+    void* p = attachHeader(upstream_->allocate(bytes + offset, std::max(alignment, alignof(AllocHeader))),
+                           offset, countAllocation(bytes));
+#endif
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+#if HARMONIC_IOT_ALLOC_ACCOUNTING
+    upstream_->deallocate(p, bytes, alignment);
+#else
+    const AllocHeader header = headerOf(p);
+    countFree(header.site);
+    upstream_->deallocate(header.base, bytes + headerSpace(alignment), std::max(alignment, alignof(AllocHeader)));
+#endif
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+// ─── Counting operator new / delete ──────────────────────────────────────
+
+#if HARMONIC_IOT_ALLOC_ACCOUNTING
+
+namespace {
+
+using harmonic_iot::telemetry::headerOf;
+using harmonic_iot::telemetry::headerSpace;
+
+void* countedMalloc(std::size_t size) {
+    const std::size_t offset = headerSpace(alignof(std::max_align_t));
+    return harmonic_iot::telemetry::attachHeader(std::malloc(size + offset), offset,
+                                                 harmonic_iot::telemetry::countAllocation(size));
+}
+
+void* countedAlignedMalloc(std::size_t size, std::size_t alignment) {
+    const std::size_t offset = headerSpace(alignment);
+    alignment = std::max(alignment, sizeof(void*));
+#if defined(_MSC_VER)
+    void* p = _aligned_malloc(size + offset, alignment);
+#else
+    void* p = nullptr;
+    if (::posix_memalign(&p, alignment, size + offset) != 0) {
+        p = nullptr;
+    }
+#endif
+    return harmonic_iot::telemetry::attachHeader(p, offset, harmonic_iot::telemetry::countAllocation(size));
+}
+
+void countedFree(void* p) noexcept {
+    if (p) {
+        harmonic_iot::telemetry::countFree(headerOf(p).site);
+        std::free(headerOf(p).base);
+    }
+}
+
+void countedAlignedFree(void* p) noexcept {
+    if (p) {
+        harmonic_iot::telemetry::countFree(headerOf(p).site);
+#if defined(_MSC_VER)
+        _aligned_free(headerOf(p).base);
+#else
+        std::free(headerOf(p).base);
+#endif
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = countedMalloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedMalloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* p = countedAlignedMalloc(size, static_cast<std::size_t>(alignment));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedMalloc(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedMalloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedAlignedFree(p); }
+
+#endif // HARMONIC_IOT_ALLOC_ACCOUNTING
@@ -0,0 +1,43 @@
+/**
+ * Cycle Clock for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "cycle_clock.h"
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace {
+
+double calibrate() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) || defined(__aarch64__)
+    using Clock = std::chrono::steady_clock;
+    const auto wall_start = Clock::now();
+    const uint64_t tick_start = CycleClock::now();
+    Clock::time_point wall_end;
+    do {
+        wall_end = Clock::now();
+    } while (wall_end - wall_start < std::chrono::milliseconds(5));
+    const uint64_t tick_end = CycleClock::now();
+
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count());
+    uint64_t ticks = tick_end - tick_start;
+    return ticks > 0 ? ns / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;   // Already nanoseconds
+#endif
+}
+
+} // namespace
+
+double CycleClock::nanosecondsPerTick() {
+    static const double ns_per_tick = calibrate();
+    return ns_per_tick;
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
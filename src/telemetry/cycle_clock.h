@@ -0,0 +1,65 @@
+/**
+ * Cycle Clock for Harmonic IoT Protocol
+ *
+ * Cheapest available monotonic timestamp for hot-path timing: the time
+ * stamp counter on x86 (rdtsc, ~7 ns), the virtual counter on ARMv8, and
+ * clock_gettime(CLOCK_MONOTONIC) elsewhere. Ticks are converted to
+ * nanoseconds only when results are reported.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_CYCLE_CLOCK_H
+#define HARMONIC_IOT_TELEMETRY_CYCLE_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+namespace harmonic_iot {
+namespace telemetry {
+
+class CycleClock {
+public:
+    /** Current tick count; monotonic on a given machine */
+    static inline uint64_t now() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#elif defined(__unix__) || defined(__APPLE__)
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * Nanoseconds per tick, calibrated against steady_clock on first use
+     * (a few milliseconds, once per process)
+     */
+    static double nanosecondsPerTick();
+
+    static double toNanoseconds(uint64_t ticks) {
+        return static_cast<double>(ticks) * nanosecondsPerTick();
+    }
+};
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_TELEMETRY_CYCLE_CLOCK_H
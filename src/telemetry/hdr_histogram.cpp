@@ -0,0 +1,94 @@
+/**
+ * HDR Latency Histogram for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+HdrHistogram& HdrHistogram::operator=(const HdrHistogram& other) {
+    if (this != &other) {
+        reset();
+        merge(other);
+    }
+    return *this;
+}
+
+void HdrHistogram::reset() {
+    for (auto& c : counts_) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    total_count_.store(0, std::memory_order_relaxed);
+    total_sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void HdrHistogram::merge(const HdrHistogram& other) {
+    for (size_t i = 0; i < COUNTS; ++i) {
+        uint64_t n = other.counts_[i].load(std::memory_order_relaxed);
+        if (n != 0) {
+            bump(counts_[i], n);
+        }
+    }
+    bump(total_count_, other.total_count_.load(std::memory_order_relaxed));
+    bump(total_sum_, other.total_sum_.load(std::memory_order_relaxed));
+    uint64_t other_min = other.min_.load(std::memory_order_relaxed);
+    if (other_min < min_.load(std::memory_order_relaxed)) {
+        min_.store(other_min, std::memory_order_relaxed);
+    }
+    uint64_t other_max = other.max_.load(std::memory_order_relaxed);
+    if (other_max > max_.load(std::memory_order_relaxed)) {
+        max_.store(other_max, std::memory_order_relaxed);
+    }
+}
+
+uint64_t HdrHistogram::min() const {
+    return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+double HdrHistogram::mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(n);
+}
+
+uint64_t HdrHistogram::highestEquivalent(size_t index) {
+    uint64_t bucket = index / HALF;
+    bucket = bucket > 0 ? bucket - 1 : 0;
+    uint64_t sub = index - bucket * HALF;
+    return ((sub + 1) << bucket) - 1;
+}
+
+uint64_t HdrHistogram::valueAtPercentile(double percentile) const {
+    // Counts are summed directly rather than trusting total_count_, which a
+    // concurrent writer may have bumped ahead of the bucket
+    uint64_t total = 0;
+    for (const auto& c : counts_) {
+        total += c.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < COUNTS; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(highestEquivalent(i), max());
+        }
+    }
+    return max();
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
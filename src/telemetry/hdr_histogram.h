@@ -0,0 +1,126 @@
+/**
+ * HDR Latency Histogram for Harmonic IoT Protocol
+ *
+ * High-dynamic-range histogram with log-linear buckets: values are grouped
+ * by power of two and each power of two is split into 128 linear
+ * sub-buckets, so every recorded value is kept to within 1/128 (<0.8%)
+ * from single nanoseconds up to minutes, in a fixed 34 KiB array.
+ * Recording is a bit scan, a shift and one counter update.
+ *
+ * Counters are atomics so a scraper may read a histogram while its owner
+ * records into it; each histogram must have a single writer.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_HDR_HISTOGRAM_H
+#define HARMONIC_IOT_TELEMETRY_HDR_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace harmonic_iot {
+namespace telemetry {
+
+/**
+ * Log-linear histogram of non-negative integer values
+ */
+class HdrHistogram {
+public:
+    /** log2 of the sub-buckets per power of two */
+    static constexpr unsigned SUB_BUCKET_BITS = 8;
+    /** Values above 2^MAX_VALUE_BITS are clamped */
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+
+    HdrHistogram() { reset(); }
+
+    HdrHistogram(const HdrHistogram& other) { reset(); merge(other); }
+    HdrHistogram& operator=(const HdrHistogram& other);
+
+    /**
+     * Record one value (single writer)
+     */
+    void record(uint64_t value) {
+        if (value > MAX_VALUE) {
+            value = MAX_VALUE;
+        }
+        bump(counts_[indexOf(value)], 1);
+        bump(total_count_, 1);
+        bump(total_sum_, value);
+        if (value < min_.load(std::memory_order_relaxed)) {
+            min_.store(value, std::memory_order_relaxed);
+        }
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Add another histogram's counts (the destination must not be recorded
+     * into concurrently)
+     */
+    void merge(const HdrHistogram& other);
+
+    void reset();
+
+    uint64_t count() const { return total_count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return total_sum_.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    double mean() const;
+
+    /**
+     * Smallest recorded value v such that percentile% of values are ≤ v,
+     * reported as the upper bound of its bucket
+     *
+     * @param percentile In [0, 100]
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /** Number of counters */
+    static constexpr size_t bucketCount() { return COUNTS; }
+
+    /** Recorded values in counter index (for exporters) */
+    uint64_t countAt(size_t index) const { return counts_[index].load(std::memory_order_relaxed); }
+
+    /** Largest value that maps to counter index */
+    static uint64_t highestEquivalent(size_t index);
+
+private:
+    static constexpr uint64_t HALF = uint64_t(1) << (SUB_BUCKET_BITS - 1);
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+    static constexpr size_t COUNTS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * HALF;
+
+    static size_t indexOf(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long msb_index;
+        _BitScanReverse64(&msb_index, value | 1);
+        unsigned msb = static_cast<unsigned>(msb_index);
+#else
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value | 1));
+#endif
+        unsigned bucket = msb >= SUB_BUCKET_BITS ? msb - (SUB_BUCKET_BITS - 1) : 0;
+        return static_cast<size_t>(bucket * HALF + (value >> bucket));
+    }
+
+    /** Single-writer increment: plain load and store, no locked RMW */
+    static void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> counts_[COUNTS];
+    std::atomic<uint64_t> total_count_;
+    std::atomic<uint64_t> total_sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_TELEMETRY_HDR_HISTOGRAM_H
@@ -0,0 +1,132 @@
+/**
+ * Hot-Path Latency Instrumentation for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "latency.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+thread_local ThreadLatency* current_thread_latency = nullptr;
+
+namespace {
+
+const char* const STAGE_NAMES[LATENCY_STAGE_COUNT] = {
+    "encode", "decode", "fft", "detect", "verify", "crypto"
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadLatency*> live;
+    ThreadLatency retired;          // Merged histograms of exited threads
+};
+
+Registry& registry() {
+    // Never destroyed: threads may exit after static destruction begins
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+/**
+ * Folds a thread's histograms into the retired set when the thread exits
+ */
+struct ThreadGuard {
+    ThreadLatency* data = nullptr;
+
+    ~ThreadGuard() {
+        if (!data) {
+            return;
+        }
+        Registry& r = registry();
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+                r.retired.stages[i].merge(data->stages[i]);
+            }
+            r.live.erase(std::remove(r.live.begin(), r.live.end(), data), r.live.end());
+        }
+        current_thread_latency = nullptr;
+        delete data;
+    }
+};
+
+thread_local ThreadGuard thread_guard;
+
+} // namespace
+
+const char* latencyStageName(LatencyStage stage) {
+    size_t index = static_cast<size_t>(stage);
+    return index < LATENCY_STAGE_COUNT ? STAGE_NAMES[index] : "unknown";
+}
+
+ThreadLatency* registerLatencyThread() {
+    std::unique_ptr<ThreadLatency> data(new ThreadLatency());
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(data.get());
+    }
+    thread_guard.data = data.get();
+    current_thread_latency = data.release();
+    return current_thread_latency;
+}
+
+HdrHistogram latencySnapshot(LatencyStage stage) {
+    const size_t index = static_cast<size_t>(stage);
+    HdrHistogram merged;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    merged.merge(r.retired.stages[index]);
+    for (const ThreadLatency* t : r.live) {
+        merged.merge(t->stages[index]);
+    }
+    return merged;
+}
+
+std::vector<LatencySummary> latencySummaries() {
+    std::vector<LatencySummary> result;
+    result.reserve(LATENCY_STAGE_COUNT);
+    for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        HdrHistogram h = latencySnapshot(stage);
+
+        LatencySummary s;
+        s.stage = stage;
+        s.name = STAGE_NAMES[i];
+        s.count = h.count();
+        if (s.count > 0) {
+            const double scale = CycleClock::nanosecondsPerTick();
+            s.mean_ns = h.mean() * scale;
+            s.min_ns = static_cast<double>(h.min()) * scale;
+            s.p50_ns = static_cast<double>(h.valueAtPercentile(50.0)) * scale;
+            s.p90_ns = static_cast<double>(h.valueAtPercentile(90.0)) * scale;
+            s.p99_ns = static_cast<double>(h.valueAtPercentile(99.0)) * scale;
+            s.p999_ns = static_cast<double>(h.valueAtPercentile(99.9)) * scale;
+            s.max_ns = static_cast<double>(h.max()) * scale;
+        }
+        result.push_back(s);
+    }
+    return result;
+}
+
+void resetLatency() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& h : r.retired.stages) {
+        h.reset();
+    }
+    for (ThreadLatency* t : r.live) {
+        for (auto& h : t->stages) {
+            h.reset();
+        }
+    }
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
@@ -0,0 +1,135 @@
+/**
+ * Hot-Path Latency Instrumentation for Harmonic IoT Protocol
+ *
+ * Per-thread HDR histograms for each processing stage (encode, decode,
+ * FFT, detect, verify, crypto). A scoped timer reads the cycle clock on
+ * entry and exit and records the difference into the calling thread's
+ * own histogram, so recording never contends; scrapes merge all threads.
+ *
+ * Instrumentation compiles away entirely when HARMONIC_IOT_TELEMETRY is 0
+ * (CMake: -DENABLE_TELEMETRY=OFF).
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_LATENCY_H
+#define HARMONIC_IOT_TELEMETRY_LATENCY_H
+
+#include "telemetry/cycle_clock.h"
+#include "telemetry/hdr_histogram.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef HARMONIC_IOT_TELEMETRY
+#define HARMONIC_IOT_TELEMETRY 1
+#endif
+
+namespace harmonic_iot {
+namespace telemetry {
+
+/**
+ * Instrumented stages
+ */
+enum class LatencyStage : uint8_t {
+    Encode = 0,
+    Decode,
+    Fft,
+    Detect,
+    Verify,
+    Crypto
+};
+
+constexpr size_t LATENCY_STAGE_COUNT = 6;
+
+/** Lower-case stage name ("encode", "fft", ...) */
+const char* latencyStageName(LatencyStage stage);
+
+/**
+ * One thread's histograms (values in cycle-clock ticks)
+ */
+struct ThreadLatency {
+    HdrHistogram stages[LATENCY_STAGE_COUNT];
+};
+
+/** Calling thread's histograms, created on first use */
+ThreadLatency* registerLatencyThread();
+
+extern thread_local ThreadLatency* current_thread_latency;
+
+/**
+ * Record a duration in ticks for the calling thread
+ */
+inline void recordLatency(LatencyStage stage, uint64_t ticks) {
+    ThreadLatency* local = current_thread_latency;
+    if (!local) {
+        local = registerLatencyThread();
+    }
+    local->stages[static_cast<size_t>(stage)].record(ticks);
+}
+
+/**
+ * Times the enclosing scope into a stage histogram
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(LatencyStage stage) : stage_(stage), start_(CycleClock::now()) {}
+    ~ScopedTimer() { recordLatency(stage_, CycleClock::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyStage stage_;
+    uint64_t start_;
+};
+
+/**
+ * Merged percentiles of one stage, in nanoseconds
+ */
+struct LatencySummary {
+    LatencyStage stage = LatencyStage::Encode;
+    const char* name = "";
+    uint64_t count = 0;
+    double mean_ns = 0.0;
+    double min_ns = 0.0;
+    double p50_ns = 0.0;
+    double p90_ns = 0.0;
+    double p99_ns = 0.0;
+    double p999_ns = 0.0;
+    double max_ns = 0.0;
+};
+
+/**
+ * All threads' histograms for a stage merged into one (ticks), including
+ * threads that have exited
+ */
+HdrHistogram latencySnapshot(LatencyStage stage);
+
+/** Summaries for every stage */
+std::vector<LatencySummary> latencySummaries();
+
+/**
+ * Clear all histograms (counts recorded concurrently may be partially kept)
+ */
+void resetLatency();
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#define HIOT_TELEMETRY_CONCAT_(a, b) a##b
+#define HIOT_TELEMETRY_CONCAT(a, b) HIOT_TELEMETRY_CONCAT_(a, b)
+
+/**
+ * Time the rest of the enclosing scope, e.g. HIOT_LATENCY_SCOPE(Fft);
+ */
+#if HARMONIC_IOT_TELEMETRY
+#define HIOT_LATENCY_SCOPE(stage)                                                  \
+    ::harmonic_iot::telemetry::ScopedTimer HIOT_TELEMETRY_CONCAT(hiot_latency_, __LINE__)( \
+        ::harmonic_iot::telemetry::LatencyStage::stage)
+#else
+#define HIOT_LATENCY_SCOPE(stage) static_cast<void>(0)
+#endif
+
+#endif // HARMONIC_IOT_TELEMETRY_LATENCY_H
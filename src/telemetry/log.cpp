@@ -0,0 +1,533 @@
+/**
+ * Asynchronous Binary Logger for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "log.h"
+#include "log_reader.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace detail {
+thread_local LogBuffer* current_log_buffer = nullptr;
+} // namespace detail
+
+namespace {
+
+const char* const LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+
+size_t roundUpPowerOfTwo(size_t n) {
+    size_t p = 4096;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+const char* baseName(const char* path) {
+    const char* base = path;
+    for (const char* p = path; *p; ++p) {
+        if (*p == '/' || *p == '\\') {
+            base = p + 1;
+        }
+    }
+    return base;
+}
+
+int64_t unixNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+template<typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void putText(std::string& out, const char* text) {
+    std::string_view s(text ? text : "");
+    if (s.size() > UINT16_MAX) {
+        s = s.substr(0, UINT16_MAX);
+    }
+    put(out, static_cast<uint16_t>(s.size()));
+    out.append(s.data(), s.size());
+}
+
+/**
+ * Marks the thread's ring retired when the thread exits
+ */
+struct RingGuard {
+    LogBuffer* buffer = nullptr;
+
+    ~RingGuard() {
+        if (buffer) {
+            detail::current_log_buffer = nullptr;
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local RingGuard ring_guard;
+
+} // namespace
+
+const char* logLevelName(LogLevel level) {
+    size_t index = static_cast<size_t>(level);
+    return index < sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]) ? LEVEL_NAMES[index] : "?";
+}
+
+LogLevel parseLogLevel(std::string_view name) {
+    std::string upper(name);
+    for (char& c : upper) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    if (upper == "WARNING") {
+        return LogLevel::Warn;
+    }
+    for (size_t i = 0; i < sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]); ++i) {
+        if (upper == LEVEL_NAMES[i]) {
+            return static_cast<LogLevel>(i);
+        }
+    }
+    throw std::invalid_argument("Unknown log level: " + std::string(name));
+}
+
+// ─── Formatting ──────────────────────────────────────────────────────────
+
+std::string formatLogMessage(const char* format, const char* payload, size_t size) {
+    std::string out;
+    const char* end = payload + size;
+    const char* p = payload;
+    size_t remaining = size > 0 ? static_cast<uint8_t>(*p++) : 0;
+
+    auto appendArg = [&]() -> bool {
+        if (remaining == 0 || p >= end) {
+            return false;
+        }
+        --remaining;
+        const char tag = *p++;
+        char buffer[32];
+        switch (tag) {
+            case detail::LOG_ARG_INT: {
+                int64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                p += sizeof(v);
+                out += std::to_string(v);
+                return true;
+            }
+            case detail::LOG_ARG_UINT: {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                p += sizeof(v);
+                out += std::to_string(v);
+                return true;
+            }
+            case detail::LOG_ARG_DOUBLE: {
+                double v;
+                std::memcpy(&v, p, sizeof(v));
+                p += sizeof(v);
+                std::snprintf(buffer, sizeof(buffer), "%g", v);
+                out += buffer;
+                return true;
+            }
+            case detail::LOG_ARG_POINTER: {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                p += sizeof(v);
+                std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(v));
+                out += buffer;
+                return true;
+            }
+            case detail::LOG_ARG_BOOL:
+                out += *p++ ? "true" : "false";
+                return true;
+            case detail::LOG_ARG_CHAR:
+                out += *p++;
+                return true;
+            case detail::LOG_ARG_STRING: {
+                uint16_t length;
+                std::memcpy(&length, p, sizeof(length));
+                p += sizeof(length);
+                length = static_cast<uint16_t>(std::min<size_t>(length, static_cast<size_t>(end - p)));
+                out.append(p, length);
+                p += length;
+                return true;
+            }
+            default:
+                remaining = 0;      // Unknown tag: stop decoding this payload
+                return false;
+        }
+    };
+
+    for (const char* f = format; *f; ++f) {
+        if (f[0] == '{' && f[1] == '{') {
+            out += '{';
+            ++f;
+        } else if (f[0] == '}' && f[1] == '}') {
+            out += '}';
+            ++f;
+        } else if (f[0] == '{' && f[1] == '}') {
+            if (!appendArg()) {
+                out += "{}";
+            }
+            ++f;
+        } else {
+            out += *f;
+        }
+    }
+    return out;
+}
+
+std::string formatLogLine(LogLevel level, int64_t unix_ns, uint32_t thread, const char* file, int line,
+                          const std::string& message) {
+    std::time_t seconds = static_cast<std::time_t>(unix_ns / 1000000000);
+    long micros = static_cast<long>((unix_ns % 1000000000) / 1000);
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &seconds);
+#else
+    gmtime_r(&seconds, &tm);
+#endif
+    char prefix[96];
+    std::snprintf(prefix, sizeof(prefix), "%04d-%02d-%02dT%02d:%02d:%02d.%06ldZ %-5s [t%u] %s:%d ",
+                  tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                  micros, logLevelName(level), thread, baseName(file), line);
+    std::string out(prefix);
+    out += message;
+    return out;
+}
+
+// ─── LogBuffer ───────────────────────────────────────────────────────────
+
+LogBuffer::LogBuffer(size_t capacity, uint32_t thread_id)
+    : capacity_(roundUpPowerOfTwo(capacity)), mask_(capacity_ - 1), thread_id_(thread_id) {
+    data_.reset(new char[capacity_]);
+}
+
+// ─── Logger ──────────────────────────────────────────────────────────────
+
+struct Logger::Impl {
+    // Thread rings
+    mutable std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<LogBuffer>> buffers;
+    uint32_t next_thread = 1;
+    size_t buffer_bytes = LoggerConfig().thread_buffer_bytes;
+
+    // Call sites, id - 1 indexed
+    mutable std::mutex sites_mutex;
+    std::vector<LogSite*> sites;
+    uint32_t default_rate = LoggerConfig().default_rate_limit;
+
+    // Sink; writer_mutex serializes drains
+    std::mutex writer_mutex;
+    std::FILE* out = stderr;
+    bool binary = false;
+    std::vector<bool> emitted;          // Site definitions already in the file
+    std::string batch;
+
+    // Clock anchor for wall-clock timestamps
+    double ns_per_tick = 1.0;
+    uint64_t anchor_ticks = 0;
+    int64_t anchor_unix_ns = 0;
+
+    std::atomic<uint64_t> records{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> suppressed{0};
+    std::atomic<uint64_t> bytes{0};
+
+    // Background writer
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    uint32_t interval_ms = LoggerConfig().flush_interval_ms;
+    std::thread thread;
+
+    int64_t unixNs(uint64_t ticks) const {
+        double delta = (static_cast<double>(ticks) - static_cast<double>(anchor_ticks)) * ns_per_tick;
+        return anchor_unix_ns + static_cast<int64_t>(delta);
+    }
+
+    void writeHeader() {
+        batch.append(LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC));
+        put(batch, ns_per_tick);
+        put(batch, anchor_ticks);
+        put(batch, anchor_unix_ns);
+    }
+
+    void defineSite(uint32_t id, const LogSite& site) {
+        if (emitted.size() <= id) {
+            emitted.resize(id + 1, false);
+        }
+        if (emitted[id]) {
+            return;
+        }
+        emitted[id] = true;
+        put(batch, LOG_ENTRY_SITE);
+        put(batch, id);
+        put(batch, static_cast<uint8_t>(site.level));
+        put(batch, static_cast<uint32_t>(site.line));
+        putText(batch, site.file);
+        putText(batch, site.format);
+    }
+
+    void record(const LogSite& site, uint32_t id, uint32_t thread_id, uint64_t ticks,
+                const char* payload, size_t size) {
+        if (binary) {
+            defineSite(id, site);
+            put(batch, LOG_ENTRY_RECORD);
+            put(batch, id);
+            put(batch, thread_id);
+            put(batch, ticks);
+            put(batch, static_cast<uint32_t>(size));
+            batch.append(payload, size);
+        } else {
+            batch += formatLogLine(site.level, unixNs(ticks), thread_id, site.file, site.line,
+                                   formatLogMessage(site.format, payload, size));
+            batch += '\n';
+        }
+    }
+
+    void suppressedNote(const LogSite& site, uint32_t id, uint64_t ticks, uint64_t count) {
+        if (binary) {
+            defineSite(id, site);
+            put(batch, LOG_ENTRY_SUPPRESSED);
+            put(batch, id);
+            put(batch, ticks);
+            put(batch, count);
+        } else {
+            batch += formatLogLine(LogLevel::Warn, unixNs(ticks), 0, site.file, site.line,
+                                   std::to_string(count) + " records suppressed by rate limit");
+            batch += '\n';
+        }
+    }
+
+    void droppedNote(uint32_t thread_id, uint64_t ticks, uint64_t count) {
+        if (binary) {
+            put(batch, LOG_ENTRY_DROPPED);
+            put(batch, thread_id);
+            put(batch, ticks);
+            put(batch, count);
+        } else {
+            batch += formatLogLine(LogLevel::Warn, unixNs(ticks), thread_id, "log", 0,
+                                   std::to_string(count) + " records dropped (thread ring full)");
+            batch += '\n';
+        }
+    }
+
+    std::vector<LogSite*> siteTable() const {
+        std::lock_guard<std::mutex> lock(sites_mutex);
+        return sites;
+    }
+
+    /** Move everything published so far to the sink; writer_mutex held */
+    void drain() {
+        std::vector<std::pair<LogBuffer*, bool>> rings;
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            for (const auto& b : buffers) {
+                rings.emplace_back(b.get(), b->retired.load(std::memory_order_acquire));
+            }
+        }
+
+        std::vector<LogSite*> table = siteTable();
+        const uint64_t now = CycleClock::now();
+        uint64_t written = 0;
+        bool retired_empty = false;
+
+        for (const auto& ring : rings) {
+            LogBuffer* buffer = ring.first;
+            written += buffer->consume([&](uint32_t id, uint64_t ticks, const char* payload, size_t size) {
+                if (id > table.size()) {
+                    table = siteTable();    // Registered after the snapshot
+                }
+                record(*table[id - 1], id, buffer->threadId(), ticks, payload, size);
+            });
+            uint64_t lost = buffer->takeDropped();
+            if (lost > 0) {
+                dropped.fetch_add(lost, std::memory_order_relaxed);
+                droppedNote(buffer->threadId(), now, lost);
+            }
+            retired_empty = retired_empty || (ring.second && buffer->empty());
+        }
+
+        for (size_t i = 0; i < table.size(); ++i) {
+            uint64_t count = table[i]->suppressed.exchange(0, std::memory_order_relaxed);
+            if (count > 0) {
+                suppressed.fetch_add(count, std::memory_order_relaxed);
+                suppressedNote(*table[i], static_cast<uint32_t>(i + 1), now, count);
+            }
+        }
+
+        if (!batch.empty()) {
+            std::fwrite(batch.data(), 1, batch.size(), out);
+            std::fflush(out);
+            bytes.fetch_add(batch.size(), std::memory_order_relaxed);
+            batch.clear();
+        }
+        records.fetch_add(written, std::memory_order_relaxed);
+
+        if (retired_empty) {
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                         [](const std::unique_ptr<LogBuffer>& b) {
+                                             return b->retired.load(std::memory_order_acquire) && b->empty();
+                                         }),
+                          buffers.end());
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        while (!stopping) {
+            wake.wait_for(lock, std::chrono::milliseconds(interval_ms));
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> writer(writer_mutex);
+                drain();
+            }
+            lock.lock();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        drain();
+    }
+};
+
+Logger& Logger::instance() {
+    // Never destroyed: threads may log during static destruction
+    static Logger* logger = new Logger();
+    return *logger;
+}
+
+Logger::Logger() : impl_(new Impl()) {
+    impl_->ns_per_tick = CycleClock::nanosecondsPerTick();
+    impl_->anchor_ticks = CycleClock::now();
+    impl_->anchor_unix_ns = unixNowNs();
+    ticks_per_second_ = std::max<uint64_t>(1, static_cast<uint64_t>(1e9 / impl_->ns_per_tick));
+
+    impl_->thread = std::thread([this] { impl_->run(); });
+    std::atexit([] { Logger::instance().impl_->stop(); });
+
+    MetricsRegistry::global().addCollector([this](MetricsWriter& writer) {
+        LoggerStats s = stats();
+        writer.counter("harmonic_log_records_total", "Log records written", {}, static_cast<double>(s.records));
+        writer.counter("harmonic_log_dropped_total", "Log records lost to full thread rings", {},
+                       static_cast<double>(s.dropped));
+        writer.counter("harmonic_log_suppressed_total", "Log records refused by call-site rate limits", {},
+                       static_cast<double>(s.suppressed));
+    });
+}
+
+void Logger::configure(const LoggerConfig& config) {
+    std::FILE* file = stderr;
+    if (!config.path.empty()) {
+        file = std::fopen(config.path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Failed to open log file " + config.path);
+        }
+    }
+
+    std::lock_guard<std::mutex> writer(impl_->writer_mutex);
+    impl_->drain();
+    if (impl_->out != stderr) {
+        std::fclose(impl_->out);
+    }
+    impl_->out = file;
+    impl_->binary = !config.path.empty();
+    impl_->emitted.clear();
+    if (impl_->binary) {
+        impl_->writeHeader();
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->buffers_mutex);
+        impl_->buffer_bytes = config.thread_buffer_bytes;
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->sites_mutex);
+        impl_->default_rate = config.default_rate_limit;
+        for (LogSite* site : impl_->sites) {
+            if (site->rate == LOG_DEFAULT_RATE) {
+                site->limit.store(config.default_rate_limit, std::memory_order_relaxed);
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->wake_mutex);
+        impl_->interval_ms = std::max<uint32_t>(1, config.flush_interval_ms);
+    }
+    setLevel(config.min_level);
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> writer(impl_->writer_mutex);
+    impl_->drain();
+}
+
+LoggerStats Logger::stats() const {
+    LoggerStats s;
+    s.records = impl_->records.load(std::memory_order_relaxed);
+    s.dropped = impl_->dropped.load(std::memory_order_relaxed);
+    s.suppressed = impl_->suppressed.load(std::memory_order_relaxed);
+    s.bytes = impl_->bytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(impl_->sites_mutex);
+        s.sites = impl_->sites.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->buffers_mutex);
+        s.threads = impl_->buffers.size();
+    }
+    return s;
+}
+
+uint32_t Logger::registerSite(LogSite& site) {
+    std::lock_guard<std::mutex> lock(impl_->sites_mutex);
+    uint32_t id = site.id.load(std::memory_order_relaxed);
+    if (id != 0) {
+        return id;      // Another thread won the race
+    }
+    site.limit.store(site.rate == LOG_DEFAULT_RATE ? impl_->default_rate : site.rate, std::memory_order_relaxed);
+    impl_->sites.push_back(&site);
+    id = static_cast<uint32_t>(impl_->sites.size());
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+LogBuffer* Logger::threadBuffer() {
+    if (detail::current_log_buffer) {
+        return detail::current_log_buffer;
+    }
+    std::lock_guard<std::mutex> lock(impl_->buffers_mutex);
+    impl_->buffers.emplace_back(new LogBuffer(impl_->buffer_bytes, impl_->next_thread++));
+    LogBuffer* buffer = impl_->buffers.back().get();
+    ring_guard.buffer = buffer;
+    detail::current_log_buffer = buffer;
+    return buffer;
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
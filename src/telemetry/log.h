@@ -0,0 +1,444 @@
+/**
+ * Asynchronous Binary Logger for Harmonic IoT Protocol
+ *
+ * Structured logging that keeps formatting and I/O off the hot path. Each
+ * call site is described once by a static LogSite (level, file, line,
+ * format string); a log call only copies the arguments, tagged by type,
+ * into the calling thread's own lock-free ring. A background writer
+ * drains every ring in batches and either appends the binary records to
+ * a log file, to be formatted later by harmonic_logdump, or formats them
+ * as text on stderr.
+ *
+ *   HIOT_LOG_INFO("Device {} joined on H{}", device_id, channel);
+ *   HIOT_LOG_LIMITED(Warn, 10, "JWT verification failed: {}", e.what());
+ *
+ * Formats use "{}" placeholders ("{{" and "}}" for literal braces).
+ * Arguments may be integers, enums, floating point, bool, char, strings
+ * (copied, up to LOG_MAX_STRING bytes) and pointers. Every call site is
+ * rate limited, and a full ring drops records rather than blocking; both
+ * are counted and reported in the log.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_LOG_H
+#define HARMONIC_IOT_TELEMETRY_LOG_H
+
+#include "runtime/cache_line.h"
+#include "telemetry/cycle_clock.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+enum class LogLevel : uint8_t {
+    Trace = 0,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+/** Upper-case level name ("INFO", ...) */
+const char* logLevelName(LogLevel level);
+
+/**
+ * Parse a level name, case-insensitive
+ * @throws std::invalid_argument for an unknown name
+ */
+LogLevel parseLogLevel(std::string_view name);
+
+/** Strings longer than this are truncated in the record */
+constexpr size_t LOG_MAX_STRING = 1024;
+
+/** Rate limit placeholder meaning "use LoggerConfig::default_rate_limit" */
+constexpr uint32_t LOG_DEFAULT_RATE = 0xffffffffu;
+
+/**
+ * Logger parameters
+ */
+struct LoggerConfig {
+    std::string path;                       ///< Binary log file; empty: text on stderr
+    LogLevel min_level = LogLevel::Info;
+    size_t thread_buffer_bytes = 64 * 1024; ///< Ring per logging thread (rounded to a power of two)
+    uint32_t flush_interval_ms = 50;        ///< Writer wake-up period
+    uint32_t default_rate_limit = 1000;     ///< Records per second per call site without its own
+                                            ///< rate, including sites already registered (0 = unlimited)
+};
+
+/**
+ * Static description of one call site, created by the logging macros
+ */
+struct LogSite {
+    constexpr LogSite(LogLevel site_level, const char* site_file, int site_line,
+                      const char* site_format, uint32_t site_rate)
+        : level(site_level), file(site_file), line(site_line), format(site_format), rate(site_rate) {}
+
+    const LogLevel level;
+    const char* const file;
+    const int line;
+    const char* const format;
+    const uint32_t rate;
+
+    // Set on registration; limit is also reset by Logger::configure() for
+    // sites using the default rate
+    std::atomic<uint32_t> id{0};
+    std::atomic<uint32_t> limit{0};         ///< Effective records per second (0 = unlimited)
+
+    // Per-second rate window
+    std::atomic<uint64_t> window{0};
+    std::atomic<uint32_t> in_window{0};
+    std::atomic<uint64_t> suppressed{0};
+};
+
+/**
+ * Per-thread byte ring: the owning thread produces, the writer consumes
+ *
+ * Records are 8-byte multiples and never straddle the end of the ring; a
+ * padding record fills the gap when one would.
+ */
+class LogBuffer {
+public:
+    /** Record header: size, site id (0 = padding), cycle-clock timestamp */
+    static constexpr size_t HEADER_BYTES = 16;
+
+    LogBuffer(size_t capacity, uint32_t thread_id);
+
+    LogBuffer(const LogBuffer&) = delete;
+    LogBuffer& operator=(const LogBuffer&) = delete;
+
+    uint32_t threadId() const { return thread_id_; }
+
+    /**
+     * Space for a record of size bytes, or nullptr (counted as dropped) if
+     * the ring is full; finish with commit(size)
+     */
+    char* reserve(size_t size) {
+        const size_t offset = static_cast<size_t>(head_) & mask_;
+        const size_t contiguous = capacity_ - offset;
+        const size_t needed = size <= contiguous ? size : contiguous + size;
+        if (head_ + needed - cached_tail_ > capacity_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head_ + needed - cached_tail_ > capacity_ || size > capacity_ / 2) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        if (size > contiguous) {
+            const uint32_t pad = static_cast<uint32_t>(contiguous);
+            const uint32_t padding_site = 0;
+            std::memcpy(data_.get() + offset, &pad, sizeof(pad));
+            std::memcpy(data_.get() + offset + 4, &padding_site, sizeof(padding_site));
+            head_ += contiguous;
+            return data_.get();
+        }
+        return data_.get() + offset;
+    }
+
+    void commit(size_t size) {
+        head_ += size;
+        published_.store(head_, std::memory_order_release);
+    }
+
+    /**
+     * Consumer: call fn(site_id, ticks, payload, payload_size) for every
+     * published record, then release their space
+     *
+     * @return Records consumed
+     */
+    template<typename Fn>
+    size_t consume(Fn&& fn) {
+        const uint64_t head = published_.load(std::memory_order_acquire);
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        size_t records = 0;
+        while (tail != head) {
+            const char* record = data_.get() + (static_cast<size_t>(tail) & mask_);
+            uint32_t size;
+            uint32_t site;
+            std::memcpy(&size, record, sizeof(size));
+            std::memcpy(&site, record + 4, sizeof(site));
+            if (site != 0) {
+                uint64_t ticks;
+                std::memcpy(&ticks, record + 8, sizeof(ticks));
+                fn(site, ticks, record + HEADER_BYTES, size - HEADER_BYTES);
+                ++records;
+            }
+            tail += size;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return records;
+    }
+
+    bool empty() const {
+        return published_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /** Drops since the last call */
+    uint64_t takeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+    /** Set when the owning thread exits; the writer frees the ring once drained */
+    std::atomic<bool> retired{false};
+
+private:
+    std::unique_ptr<char[]> data_;
+    size_t capacity_;
+    size_t mask_;
+    uint32_t thread_id_;
+
+    // Producer side
+    alignas(runtime::CACHE_LINE_SIZE) uint64_t head_ = 0;
+    uint64_t cached_tail_ = 0;
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    // Consumer side
+    alignas(runtime::CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+};
+
+/**
+ * Logger counters
+ */
+struct LoggerStats {
+    uint64_t records = 0;           ///< Records written out
+    uint64_t dropped = 0;           ///< Records lost to full thread rings
+    uint64_t suppressed = 0;        ///< Records refused by call-site rate limits
+    uint64_t bytes = 0;             ///< Bytes written to the sink
+    size_t sites = 0;               ///< Registered call sites
+    size_t threads = 0;             ///< Live thread rings
+};
+
+/**
+ * Process-wide logger and its background writer
+ */
+class Logger {
+public:
+    static Logger& instance();
+
+    /**
+     * Flush pending records to the current sink and switch to a new
+     * configuration; rings created earlier keep their size
+     *
+     * @throws std::runtime_error if the log file cannot be opened
+     */
+    void configure(const LoggerConfig& config);
+
+    /** Write every record logged before the call */
+    void flush();
+
+    void setLevel(LogLevel level) { min_level_.store(level, std::memory_order_relaxed); }
+    LogLevel level() const { return min_level_.load(std::memory_order_relaxed); }
+
+    LoggerStats stats() const;
+
+    // Used by the logging macros
+    uint32_t registerSite(LogSite& site);
+    LogBuffer* threadBuffer();
+    uint64_t ticksPerSecond() const { return ticks_per_second_; }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    Logger();
+    ~Logger() = delete;     // Lives until exit; the writer is stopped by an atexit hook
+
+    struct Impl;
+    std::atomic<LogLevel> min_level_{LogLevel::Info};
+    uint64_t ticks_per_second_;
+    Impl* impl_;
+};
+
+/** Whether a record at this level would be kept */
+inline bool logEnabled(LogLevel level) {
+    return level >= Logger::instance().level();
+}
+
+namespace detail {
+
+/** Calling thread's ring once created */
+extern thread_local LogBuffer* current_log_buffer;
+
+enum LogArgTag : uint8_t {
+    LOG_ARG_INT = 'i',
+    LOG_ARG_UINT = 'u',
+    LOG_ARG_DOUBLE = 'd',
+    LOG_ARG_BOOL = 'b',
+    LOG_ARG_CHAR = 'c',
+    LOG_ARG_STRING = 's',
+    LOG_ARG_POINTER = 'p'
+};
+
+template<typename T>
+struct IsLogString
+    : std::integral_constant<bool, std::is_convertible<const T&, std::string_view>::value> {};
+
+inline std::string_view logString(std::string_view s) {
+    return s.size() > LOG_MAX_STRING ? s.substr(0, LOG_MAX_STRING) : s;
+}
+
+inline std::string_view logString(const char* s) {
+    return logString(s ? std::string_view(s) : std::string_view("(null)"));
+}
+
+template<typename T>
+size_t logArgSize(const T& value) {
+    using U = typename std::decay<T>::type;
+    if constexpr (std::is_same<U, bool>::value || std::is_same<U, char>::value) {
+        return 2;
+    } else if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value) {
+        return 3 + logString(static_cast<const char*>(value)).size();
+    } else if constexpr (IsLogString<U>::value) {
+        return 3 + logString(std::string_view(value)).size();
+    } else {
+        static_assert(std::is_arithmetic<U>::value || std::is_enum<U>::value || std::is_pointer<U>::value,
+                      "Unsupported log argument type");
+        return 9;
+    }
+}
+
+template<typename Scalar>
+char* putLogScalar(char* out, uint8_t tag, Scalar value) {
+    *out = static_cast<char>(tag);
+    std::memcpy(out + 1, &value, sizeof(value));
+    return out + 1 + sizeof(value);
+}
+
+inline char* putLogString(char* out, std::string_view s) {
+    const uint16_t length = static_cast<uint16_t>(s.size());
+    *out = static_cast<char>(LOG_ARG_STRING);
+    std::memcpy(out + 1, &length, sizeof(length));
+    std::memcpy(out + 3, s.data(), s.size());
+    return out + 3 + s.size();
+}
+
+template<typename T>
+char* putLogArg(char* out, const T& value) {
+    using U = typename std::decay<T>::type;
+    if constexpr (std::is_same<U, bool>::value) {
+        return putLogScalar(out, LOG_ARG_BOOL, static_cast<uint8_t>(value ? 1 : 0));
+    } else if constexpr (std::is_same<U, char>::value) {
+        return putLogScalar(out, LOG_ARG_CHAR, value);
+    } else if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value) {
+        return putLogString(out, logString(static_cast<const char*>(value)));
+    } else if constexpr (IsLogString<U>::value) {
+        return putLogString(out, logString(std::string_view(value)));
+    } else if constexpr (std::is_enum<U>::value) {
+        return putLogScalar(out, LOG_ARG_INT, static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point<U>::value) {
+        return putLogScalar(out, LOG_ARG_DOUBLE, static_cast<double>(value));
+    } else if constexpr (std::is_pointer<U>::value) {
+        return putLogScalar(out, LOG_ARG_POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    } else if constexpr (std::is_signed<U>::value) {
+        return putLogScalar(out, LOG_ARG_INT, static_cast<int64_t>(value));
+    } else {
+        return putLogScalar(out, LOG_ARG_UINT, static_cast<uint64_t>(value));
+    }
+}
+
+/**
+ * Per-second window check; racy across threads by design (a window may
+ * admit a few extra records when it turns over)
+ */
+inline bool admitLogRecord(LogSite& site, uint64_t ticks, uint64_t ticks_per_second) {
+    const uint32_t limit = site.limit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+    const uint64_t window = ticks / ticks_per_second + 1;
+    if (site.window.load(std::memory_order_relaxed) != window) {
+        site.window.store(window, std::memory_order_relaxed);
+        site.in_window.store(0, std::memory_order_relaxed);
+    }
+    if (site.in_window.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+template<typename... Args>
+void logRecord(LogSite& site, const char* /*format: already in site*/, const Args&... args) {
+    Logger& logger = Logger::instance();
+    uint32_t id = site.id.load(std::memory_order_acquire);
+    if (id == 0) {
+        id = logger.registerSite(site);
+    }
+    const uint64_t ticks = CycleClock::now();
+    if (!admitLogRecord(site, ticks, logger.ticksPerSecond())) {
+        return;
+    }
+
+    size_t size = LogBuffer::HEADER_BYTES + 1;
+    using Expand = int[];
+    (void)Expand{0, (size += logArgSize(args), 0)...};
+    size = (size + 7) & ~static_cast<size_t>(7);
+
+    LogBuffer* buffer = current_log_buffer ? current_log_buffer : logger.threadBuffer();
+    char* out = buffer->reserve(size);
+    if (!out) {
+        return;
+    }
+    const uint32_t record_size = static_cast<uint32_t>(size);
+    std::memcpy(out, &record_size, sizeof(record_size));
+    std::memcpy(out + 4, &id, sizeof(id));
+    std::memcpy(out + 8, &ticks, sizeof(ticks));
+    char* p = out + LogBuffer::HEADER_BYTES;
+    *p++ = static_cast<char>(sizeof...(Args));
+    (void)Expand{0, (p = putLogArg(p, args), 0)...};
+    buffer->commit(size);
+}
+
+} // namespace detail
+
+/**
+ * Expand a "{}" format against an encoded argument payload
+ */
+std::string formatLogMessage(const char* format, const char* payload, size_t size);
+
+/**
+ * One text log line: "2025-01-01T12:00:00.000000Z WARN  [t3] file.cpp:42 message"
+ */
+std::string formatLogLine(LogLevel level, int64_t unix_ns, uint32_t thread, const char* file, int line,
+                          const std::string& message);
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#define HIOT_LOG_EXPAND_(x) x
+#define HIOT_LOG_FIRST_(first, ...) first
+#define HIOT_LOG_FORMAT_(...) HIOT_LOG_EXPAND_(HIOT_LOG_FIRST_(__VA_ARGS__, 0))
+
+/**
+ * Log at a level with a per-second limit for this call site
+ * HIOT_LOG_LIMITED(Warn, 10, "format {}", args...)
+ */
+#define HIOT_LOG_LIMITED(level_name, per_second, ...)                                             \
+    do {                                                                                          \
+        static ::harmonic_iot::telemetry::LogSite hiot_log_site_(                                 \
+            ::harmonic_iot::telemetry::LogLevel::level_name, __FILE__, __LINE__,                  \
+            HIOT_LOG_FORMAT_(__VA_ARGS__), per_second);                                           \
+        if (::harmonic_iot::telemetry::logEnabled(hiot_log_site_.level)) {                        \
+            ::harmonic_iot::telemetry::detail::logRecord(hiot_log_site_, __VA_ARGS__);            \
+        }                                                                                         \
+    } while (0)
+
+#define HIOT_LOG(level_name, ...) \
+    HIOT_LOG_LIMITED(level_name, ::harmonic_iot::telemetry::LOG_DEFAULT_RATE, __VA_ARGS__)
+
+#define HIOT_LOG_TRACE(...) HIOT_LOG(Trace, __VA_ARGS__)
+#define HIOT_LOG_DEBUG(...) HIOT_LOG(Debug, __VA_ARGS__)
+#define HIOT_LOG_INFO(...) HIOT_LOG(Info, __VA_ARGS__)
+#define HIOT_LOG_WARN(...) HIOT_LOG(Warn, __VA_ARGS__)
+#define HIOT_LOG_ERROR(...) HIOT_LOG(Error, __VA_ARGS__)
+
+#endif // HARMONIC_IOT_TELEMETRY_LOG_H
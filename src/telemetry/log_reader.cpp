@@ -0,0 +1,146 @@
+/**
+ * Binary Log Reader for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "log_reader.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace {
+
+template<typename T>
+void read(std::istream& in, T& value) {
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+        throw std::runtime_error("Truncated log entry");
+    }
+}
+
+std::string readText(std::istream& in) {
+    uint16_t length;
+    read(in, length);
+    std::string text(length, '\0');
+    if (length > 0 && !in.read(&text[0], length)) {
+        throw std::runtime_error("Truncated log entry");
+    }
+    return text;
+}
+
+} // namespace
+
+std::string LogEntry::toString() const {
+    return formatLogLine(level, unix_ns, thread, file.c_str(), line, message);
+}
+
+LogReader::LogReader(std::istream& in) : in_(in) {
+    char magic[sizeof(LOG_FILE_MAGIC)];
+    if (!in_.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_FILE_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a Harmonic IoT binary log");
+    }
+    read(in_, ns_per_tick_);
+    read(in_, anchor_ticks_);
+    read(in_, anchor_unix_ns_);
+}
+
+const LogReader::Site& LogReader::site(uint32_t id) const {
+    if (id >= sites_.size() || !sites_[id].defined) {
+        throw std::runtime_error("Log entry references undefined call site " + std::to_string(id));
+    }
+    return sites_[id];
+}
+
+int64_t LogReader::unixNs(uint64_t ticks) const {
+    double delta = (static_cast<double>(ticks) - static_cast<double>(anchor_ticks_)) * ns_per_tick_;
+    return anchor_unix_ns_ + static_cast<int64_t>(delta);
+}
+
+bool LogReader::next(LogEntry& entry) {
+    for (;;) {
+        uint8_t kind;
+        if (!in_.read(reinterpret_cast<char*>(&kind), 1)) {
+            return false;
+        }
+
+        switch (kind) {
+            case LOG_ENTRY_SITE: {
+                uint32_t id;
+                uint8_t level;
+                uint32_t line;
+                read(in_, id);
+                read(in_, level);
+                read(in_, line);
+                if (id >= sites_.size()) {
+                    sites_.resize(id + 1);
+                }
+                Site& s = sites_[id];
+                s.defined = true;
+                s.level = static_cast<LogLevel>(level);
+                s.line = static_cast<int>(line);
+                s.file = readText(in_);
+                s.format = readText(in_);
+                continue;       // Definitions are not entries
+            }
+            case LOG_ENTRY_RECORD: {
+                uint32_t id;
+                uint64_t ticks;
+                uint32_t size;
+                read(in_, id);
+                read(in_, entry.thread);
+                read(in_, ticks);
+                read(in_, size);
+                payload_.resize(size);
+                if (size > 0 && !in_.read(payload_.data(), size)) {
+                    throw std::runtime_error("Truncated log entry");
+                }
+                const Site& s = site(id);
+                entry.kind = LogEntry::Kind::Message;
+                entry.level = s.level;
+                entry.unix_ns = unixNs(ticks);
+                entry.file = s.file;
+                entry.line = s.line;
+                entry.message = formatLogMessage(s.format.c_str(), payload_.data(), size);
+                entry.count = 0;
+                return true;
+            }
+            case LOG_ENTRY_SUPPRESSED: {
+                uint32_t id;
+                uint64_t ticks;
+                read(in_, id);
+                read(in_, ticks);
+                read(in_, entry.count);
+                const Site& s = site(id);
+                entry.kind = LogEntry::Kind::Suppressed;
+                entry.level = LogLevel::Warn;
+                entry.unix_ns = unixNs(ticks);
+                entry.thread = 0;
+                entry.file = s.file;
+                entry.line = s.line;
+                entry.message = std::to_string(entry.count) + " records suppressed by rate limit";
+                return true;
+            }
+            case LOG_ENTRY_DROPPED: {
+                uint64_t ticks;
+                read(in_, entry.thread);
+                read(in_, ticks);
+                read(in_, entry.count);
+                entry.kind = LogEntry::Kind::Dropped;
+                entry.level = LogLevel::Warn;
+                entry.unix_ns = unixNs(ticks);
+                entry.file = "log";
+                entry.line = 0;
+                entry.message = std::to_string(entry.count) + " records dropped (thread ring full)";
+                return true;
+            }
+            default:
+                throw std::runtime_error("Unknown log entry type " + std::to_string(kind));
+        }
+    }
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
@@ -0,0 +1,96 @@
+/**
+ * Binary Log Reader for Harmonic IoT Protocol
+ *
+ * Decodes files written by the asynchronous logger. A file starts with a
+ * header (magic, nanoseconds per tick, clock anchor) followed by entries:
+ *
+ *   SITE       id, level, line, file, format        (once per call site)
+ *   RECORD     site id, thread, ticks, argument payload
+ *   SUPPRESSED site id, ticks, count                (rate limit)
+ *   DROPPED    thread, ticks, count                 (ring full)
+ *
+ * Integers are in host byte order; strings are u16 length + bytes.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_LOG_READER_H
+#define HARMONIC_IOT_TELEMETRY_LOG_READER_H
+
+#include "telemetry/log.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+constexpr char LOG_FILE_MAGIC[8] = {'H', 'I', 'O', 'T', 'L', 'O', 'G', '1'};
+
+constexpr uint8_t LOG_ENTRY_SITE = 1;
+constexpr uint8_t LOG_ENTRY_RECORD = 2;
+constexpr uint8_t LOG_ENTRY_SUPPRESSED = 3;
+constexpr uint8_t LOG_ENTRY_DROPPED = 4;
+
+/**
+ * One decoded entry
+ */
+struct LogEntry {
+    enum class Kind : uint8_t { Message, Suppressed, Dropped };
+
+    Kind kind = Kind::Message;
+    LogLevel level = LogLevel::Info;
+    int64_t unix_ns = 0;
+    uint32_t thread = 0;
+    std::string file;
+    int line = 0;
+    std::string message;        ///< Formatted text (also for notes)
+    uint64_t count = 0;         ///< Suppressed / dropped records
+
+    /** Text line as the stderr sink would print it */
+    std::string toString() const;
+};
+
+/**
+ * Sequential reader over a binary log stream
+ */
+class LogReader {
+public:
+    /**
+     * @throws std::runtime_error if the stream is not a Harmonic log
+     */
+    explicit LogReader(std::istream& in);
+
+    /**
+     * Next entry
+     * @return False at end of stream
+     * @throws std::runtime_error on a corrupt or truncated entry
+     */
+    bool next(LogEntry& entry);
+
+private:
+    struct Site {
+        bool defined = false;
+        LogLevel level = LogLevel::Info;
+        int line = 0;
+        std::string file;
+        std::string format;
+    };
+
+    const Site& site(uint32_t id) const;
+    int64_t unixNs(uint64_t ticks) const;
+
+    std::istream& in_;
+    double ns_per_tick_ = 1.0;
+    uint64_t anchor_ticks_ = 0;
+    int64_t anchor_unix_ns_ = 0;
+    std::vector<Site> sites_;
+    std::vector<char> payload_;
+};
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_TELEMETRY_LOG_READER_H
@@ -0,0 +1,472 @@
+/**
+ * Metrics Registry for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "metrics.h"
+#include "latency.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace {
+
+std::atomic<size_t> next_shard{0};
+
+uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool validName(const std::string& name) {
+    if (name.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+        bool digit = c >= '0' && c <= '9';
+        if (!alpha && !(digit && i > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* typeName(MetricType type) {
+    switch (type) {
+        case MetricType::Counter: return "counter";
+        case MetricType::Gauge: return "gauge";
+        case MetricType::Histogram: return "histogram";
+        case MetricType::Summary: return "summary";
+    }
+    return "untyped";
+}
+
+std::string formatValue(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    char buffer[32];
+    if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+    } else {
+        // Shortest of %.15g / %.17g that reads back exactly
+        std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+        if (std::strtod(buffer, nullptr) != value) {
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        }
+    }
+    return buffer;
+}
+
+void appendEscaped(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c;
+        }
+    }
+}
+
+/**
+ * {a="b",c="d"} with an optional extra label appended; empty if no labels
+ */
+std::string renderLabels(const MetricLabels& labels, const char* extra_name = nullptr,
+                         const std::string& extra_value = std::string()) {
+    if (labels.empty() && !extra_name) {
+        return std::string();
+    }
+    std::string out = "{";
+    bool first = true;
+    for (const auto& label : labels) {
+        if (!validName(label.first)) {
+            throw std::invalid_argument("Invalid metric label name: " + label.first);
+        }
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        out += label.first;
+        out += "=\"";
+        appendEscaped(out, label.second);
+        out += '"';
+    }
+    if (extra_name) {
+        if (!first) {
+            out += ',';
+        }
+        out += extra_name;
+        out += "=\"";
+        appendEscaped(out, extra_value);
+        out += '"';
+    }
+    out += '}';
+    return out;
+}
+
+/** Insert an extra label into an already rendered label set */
+std::string withLabel(const std::string& labels, const char* name, const std::string& value) {
+    std::string extra = std::string(name) + "=\"";
+    appendEscaped(extra, value);
+    extra += '"';
+    if (labels.empty()) {
+        return "{" + extra + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + extra + "}";
+}
+
+/**
+ * Families gathered during one scrape, rendered in name order
+ */
+class ExpositionWriter : public MetricsWriter {
+public:
+    struct Family {
+        std::string help;
+        MetricType type = MetricType::Gauge;
+        std::string lines;
+    };
+
+    Family& family(const std::string& name, const std::string& help, MetricType type) {
+        if (!validName(name)) {
+            throw std::invalid_argument("Invalid metric name: " + name);
+        }
+        auto it = families_.find(name);
+        if (it == families_.end()) {
+            it = families_.emplace(name, Family{help, type, std::string()}).first;
+        }
+        return it->second;
+    }
+
+    static void sample(Family& family, const std::string& name, const std::string& labels, double value) {
+        family.lines += name;
+        family.lines += labels;
+        family.lines += ' ';
+        family.lines += formatValue(value);
+        family.lines += '\n';
+    }
+
+    void counter(const std::string& name, const std::string& help,
+                 const MetricLabels& labels, double value) override {
+        sample(family(name, help, MetricType::Counter), name, renderLabels(labels), value);
+    }
+
+    void gauge(const std::string& name, const std::string& help,
+               const MetricLabels& labels, double value) override {
+        sample(family(name, help, MetricType::Gauge), name, renderLabels(labels), value);
+    }
+
+    void summary(const std::string& name, const std::string& help, const MetricLabels& labels,
+                 const std::vector<std::pair<double, double>>& quantiles,
+                 uint64_t count, double sum) override {
+        Family& f = family(name, help, MetricType::Summary);
+        for (const auto& q : quantiles) {
+            sample(f, name, renderLabels(labels, "quantile", formatValue(q.first)), q.second);
+        }
+        std::string rendered = renderLabels(labels);
+        sample(f, name + "_sum", rendered, sum);
+        sample(f, name + "_count", rendered, static_cast<double>(count));
+    }
+
+    std::string render() const {
+        std::string out;
+        for (const auto& entry : families_) {
+            out += "# HELP ";
+            out += entry.first;
+            out += ' ';
+            for (char c : entry.second.help) {
+                if (c == '\\') {
+                    out += "\\\\";
+                } else if (c == '\n') {
+                    out += "\\n";
+                } else {
+                    out += c;
+                }
+            }
+            out += "\n# TYPE ";
+            out += entry.first;
+            out += ' ';
+            out += typeName(entry.second.type);
+            out += '\n';
+            out += entry.second.lines;
+        }
+        return out;
+    }
+
+private:
+    std::map<std::string, Family> families_;
+};
+
+/**
+ * Stage latency percentiles from the per-thread HDR histograms
+ */
+void collectLatency(MetricsWriter& writer) {
+    static const std::vector<double> QUANTILES = {0.5, 0.9, 0.99, 0.999};
+    const double seconds_per_tick = CycleClock::nanosecondsPerTick() * 1e-9;
+
+    for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        HdrHistogram h = latencySnapshot(stage);
+        std::vector<std::pair<double, double>> quantiles;
+        quantiles.reserve(QUANTILES.size());
+        for (double q : QUANTILES) {
+            double value = h.count() > 0 ? static_cast<double>(h.valueAtPercentile(q * 100.0)) : 0.0;
+            quantiles.emplace_back(q, value * seconds_per_tick);
+        }
+        writer.summary("harmonic_stage_latency_seconds", "Hot-path stage latency",
+                       {{"stage", latencyStageName(stage)}}, quantiles, h.count(),
+                       static_cast<double>(h.sum()) * seconds_per_tick);
+    }
+}
+
+} // namespace
+
+size_t metricShard() {
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+// ─── Counter / Gauge ─────────────────────────────────────────────────────
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Gauge::add(double delta) {
+    double current = value_.load(std::memory_order_relaxed);
+    while (!value_.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+    }
+}
+
+// ─── Histogram ───────────────────────────────────────────────────────────
+
+Histogram::Histogram(std::vector<double> upper_bounds) : bounds_(std::move(upper_bounds)) {
+    if (bounds_.empty()) {
+        throw std::invalid_argument("Histogram needs at least one bucket bound");
+    }
+    for (size_t i = 1; i < bounds_.size(); ++i) {
+        if (!(bounds_[i] > bounds_[i - 1])) {
+            throw std::invalid_argument("Histogram bucket bounds must be strictly increasing");
+        }
+    }
+    if (std::isinf(bounds_.back())) {
+        bounds_.pop_back();     // +Inf is implicit
+    }
+
+    const size_t slots = FIRST_BUCKET + bounds_.size() + 1;
+    lines_per_shard_ = (slots + SLOTS_PER_LINE - 1) / SLOTS_PER_LINE;
+    lines_.reset(new Line[METRIC_SHARDS * lines_per_shard_]);
+    for (size_t i = 0; i < METRIC_SHARDS * lines_per_shard_; ++i) {
+        for (auto& s : lines_[i].slots) {
+            s.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Histogram::observe(double value) {
+    const size_t bucket = static_cast<size_t>(
+        std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+    const size_t shard = metricShard();
+
+    slot(shard, FIRST_BUCKET + bucket).fetch_add(1, std::memory_order_relaxed);
+
+    // Threads sharing a shard may race on the sum; CAS keeps it exact
+    std::atomic<uint64_t>& sum = slot(shard, SUM_SLOT);
+    uint64_t current = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(current, toBits(fromBits(current) + value),
+                                      std::memory_order_relaxed)) {
+    }
+    slot(shard, COUNT_SLOT).fetch_add(1, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snap;
+    snap.upper_bounds = bounds_;
+    snap.cumulative.assign(bounds_.size() + 1, 0);
+    for (size_t shard = 0; shard < METRIC_SHARDS; ++shard) {
+        for (size_t b = 0; b <= bounds_.size(); ++b) {
+            snap.cumulative[b] += slot(shard, FIRST_BUCKET + b).load(std::memory_order_relaxed);
+        }
+        snap.sum += fromBits(slot(shard, SUM_SLOT).load(std::memory_order_relaxed));
+    }
+    for (size_t b = 1; b < snap.cumulative.size(); ++b) {
+        snap.cumulative[b] += snap.cumulative[b - 1];
+    }
+    // Derive the count from the buckets so +Inf and _count always agree
+    snap.count = snap.cumulative.back();
+    return snap;
+}
+
+std::vector<double> exponentialBuckets(double start, double factor, size_t count) {
+    if (start <= 0.0 || factor <= 1.0) {
+        throw std::invalid_argument("Exponential buckets need start > 0 and factor > 1");
+    }
+    std::vector<double> bounds(count);
+    double value = start;
+    for (size_t i = 0; i < count; ++i) {
+        bounds[i] = value;
+        value *= factor;
+    }
+    return bounds;
+}
+
+std::vector<double> linearBuckets(double start, double width, size_t count) {
+    if (width <= 0.0) {
+        throw std::invalid_argument("Linear buckets need a positive width");
+    }
+    std::vector<double> bounds(count);
+    for (size_t i = 0; i < count; ++i) {
+        bounds[i] = start + width * static_cast<double>(i);
+    }
+    return bounds;
+}
+
+// ─── Registry ────────────────────────────────────────────────────────────
+
+MetricsRegistry& MetricsRegistry::global() {
+    // Never destroyed: instrumented code may run during static destruction
+    static MetricsRegistry* instance = [] {
+        auto* registry = new MetricsRegistry();
+        registry->addCollector(collectLatency);
+        return registry;
+    }();
+    return *instance;
+}
+
+MetricsRegistry::Child& MetricsRegistry::child(const std::string& name, const std::string& help,
+                                               MetricType type, const MetricLabels& labels) {
+    if (!validName(name)) {
+        throw std::invalid_argument("Invalid metric name: " + name);
+    }
+    std::string rendered = renderLabels(labels);
+
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, Family{help, type, {}}).first;
+    } else if (it->second.type != type) {
+        throw std::invalid_argument("Metric " + name + " already registered as " +
+                                    typeName(it->second.type));
+    }
+    Child& c = it->second.children[rendered];
+    c.labels = rendered;
+    return c;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Child& c = child(name, help, MetricType::Counter, labels);
+    if (!c.counter) {
+        c.counter.reset(new Counter());
+    }
+    return *c.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Child& c = child(name, help, MetricType::Gauge, labels);
+    if (!c.gauge) {
+        c.gauge.reset(new Gauge());
+    }
+    return *c.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& upper_bounds,
+                                      const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Child& c = child(name, help, MetricType::Histogram, labels);
+    if (!c.histogram) {
+        c.histogram.reset(new Histogram(upper_bounds));
+    }
+    return *c.histogram;
+}
+
+MetricsRegistry::CollectorId MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CollectorId id = next_collector_++;
+    collectors_.emplace_back(id, std::move(collector));
+    return id;
+}
+
+void MetricsRegistry::removeCollector(CollectorId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors_.erase(std::remove_if(collectors_.begin(), collectors_.end(),
+                                     [id](const std::pair<CollectorId, Collector>& entry) {
+                                         return entry.first == id;
+                                     }),
+                      collectors_.end());
+}
+
+std::string MetricsRegistry::render() const {
+    ExpositionWriter writer;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& entry : families_) {
+        const std::string& name = entry.first;
+        const Family& family = entry.second;
+        ExpositionWriter::Family& out = writer.family(name, family.help, family.type);
+
+        for (const auto& c : family.children) {
+            const Child& child = c.second;
+            switch (family.type) {
+                case MetricType::Counter:
+                    ExpositionWriter::sample(out, name, child.labels,
+                                             static_cast<double>(child.counter->value()));
+                    break;
+                case MetricType::Gauge:
+                    ExpositionWriter::sample(out, name, child.labels, child.gauge->value());
+                    break;
+                case MetricType::Histogram: {
+                    Histogram::Snapshot snap = child.histogram->snapshot();
+                    for (size_t b = 0; b < snap.upper_bounds.size(); ++b) {
+                        ExpositionWriter::sample(out, name + "_bucket",
+                                                 withLabel(child.labels, "le", formatValue(snap.upper_bounds[b])),
+                                                 static_cast<double>(snap.cumulative[b]));
+                    }
+                    ExpositionWriter::sample(out, name + "_bucket", withLabel(child.labels, "le", "+Inf"),
+                                             static_cast<double>(snap.count));
+                    ExpositionWriter::sample(out, name + "_sum", child.labels, snap.sum);
+                    ExpositionWriter::sample(out, name + "_count", child.labels,
+                                             static_cast<double>(snap.count));
+                    break;
+                }
+                case MetricType::Summary:
+                    break;
+            }
+        }
+    }
+
+    for (const auto& collector : collectors_) {
+        collector.second(writer);
+    }
+    return writer.render();
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
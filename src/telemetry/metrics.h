@@ -0,0 +1,277 @@
+/**
+ * Metrics Registry for Harmonic IoT Protocol
+ *
+ * Counters, gauges and histograms in the Prometheus data model. Counters
+ * and histograms are sharded: each thread updates its own cache-line
+ * padded shard with a relaxed atomic add, and shards are summed only when
+ * the registry is rendered, so instrumenting a hot path adds no
+ * cross-core cache-line traffic. Values that already live elsewhere
+ * (queue depths, pool statistics) are exported by collectors that run at
+ * scrape time.
+ *
+ * render() produces the text exposition format (version 0.0.4); the
+ * engine's MetricsServer serves it on /metrics.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_METRICS_H
+#define HARMONIC_IOT_TELEMETRY_METRICS_H
+
+#include "runtime/cache_line.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+/** Shards per counter; threads beyond this share shards round-robin */
+constexpr size_t METRIC_SHARDS = 16;
+
+/**
+ * Shard of the calling thread, assigned round-robin on first use
+ */
+size_t metricShard();
+
+/** Label name/value pairs, e.g. {{"channel", "8"}} */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+enum class MetricType : uint8_t {
+    Counter,
+    Gauge,
+    Histogram,
+    Summary
+};
+
+/**
+ * Monotonic counter
+ */
+class Counter {
+public:
+    void inc(uint64_t n = 1) {
+        shards_[metricShard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** Sum over all shards */
+    uint64_t value() const;
+
+private:
+    struct alignas(runtime::CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Shard shards_[METRIC_SHARDS];
+};
+
+/**
+ * Value that can go up and down
+ *
+ * Not sharded: a gauge is usually set from one place, and set() has no
+ * meaningful per-shard merge.
+ */
+class Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double delta);
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * Fixed-bucket histogram (cumulative "le" buckets on export)
+ */
+class Histogram {
+public:
+    /**
+     * @param upper_bounds Strictly increasing bucket bounds; +Inf is implicit
+     * @throws std::invalid_argument if the bounds are empty or not increasing
+     */
+    explicit Histogram(std::vector<double> upper_bounds);
+
+    void observe(double value);
+
+    struct Snapshot {
+        std::vector<double> upper_bounds;
+        std::vector<uint64_t> cumulative;   ///< One per bound, then +Inf
+        uint64_t count = 0;
+        double sum = 0.0;
+    };
+
+    /** Shards merged into cumulative bucket counts */
+    Snapshot snapshot() const;
+
+    const std::vector<double>& upperBounds() const { return bounds_; }
+
+private:
+    // Per shard: count, sum (double bits), then one slot per bucket
+    static constexpr size_t COUNT_SLOT = 0;
+    static constexpr size_t SUM_SLOT = 1;
+    static constexpr size_t FIRST_BUCKET = 2;
+    static constexpr size_t SLOTS_PER_LINE = runtime::CACHE_LINE_SIZE / sizeof(uint64_t);
+
+    struct alignas(runtime::CACHE_LINE_SIZE) Line {
+        std::atomic<uint64_t> slots[SLOTS_PER_LINE];
+    };
+
+    std::atomic<uint64_t>& slot(size_t shard, size_t index) {
+        return lines_[shard * lines_per_shard_ + index / SLOTS_PER_LINE].slots[index % SLOTS_PER_LINE];
+    }
+    const std::atomic<uint64_t>& slot(size_t shard, size_t index) const {
+        return lines_[shard * lines_per_shard_ + index / SLOTS_PER_LINE].slots[index % SLOTS_PER_LINE];
+    }
+
+    std::vector<double> bounds_;
+    size_t lines_per_shard_;
+    std::unique_ptr<Line[]> lines_;
+};
+
+/** Exponential bucket bounds: start, start·factor, ... (count bounds) */
+std::vector<double> exponentialBuckets(double start, double factor, size_t count);
+
+/** Linear bucket bounds: start, start+width, ... (count bounds) */
+std::vector<double> linearBuckets(double start, double width, size_t count);
+
+/**
+ * Sink for values exported by a collector at scrape time
+ */
+class MetricsWriter {
+public:
+    virtual ~MetricsWriter() = default;
+
+    virtual void counter(const std::string& name, const std::string& help,
+                         const MetricLabels& labels, double value) = 0;
+    virtual void gauge(const std::string& name, const std::string& help,
+                       const MetricLabels& labels, double value) = 0;
+
+    /**
+     * Summary with precomputed quantiles (quantile label added per entry)
+     */
+    virtual void summary(const std::string& name, const std::string& help, const MetricLabels& labels,
+                         const std::vector<std::pair<double, double>>& quantiles,
+                         uint64_t count, double sum) = 0;
+};
+
+/**
+ * Named metric families and their labeled children
+ *
+ * Registration takes a lock and allocates; do it once, keep the returned
+ * reference (stable for the registry's lifetime) and update that on the
+ * hot path.
+ */
+class MetricsRegistry {
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+    using CollectorId = uint64_t;
+
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * Process-wide registry; also exports the stage latency histograms
+     */
+    static MetricsRegistry& global();
+
+    /**
+     * Counter for name + labels, created on first call
+     * @throws std::invalid_argument on an invalid name or a type clash
+     */
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /** @copydoc counter */
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * Histogram for name + labels; the bounds of the first call win
+     * @throws std::invalid_argument on an invalid name or a type clash
+     */
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<double>& upper_bounds, const MetricLabels& labels = {});
+
+    /**
+     * Run a callback on every scrape
+     *
+     * Collectors run with the registry locked: they must not register
+     * metrics, and removeCollector() waits for a running scrape.
+     */
+    CollectorId addCollector(Collector collector);
+    void removeCollector(CollectorId id);
+
+    /**
+     * Text exposition of every metric and collector output
+     */
+    std::string render() const;
+
+private:
+    struct Child {
+        std::string labels;     ///< Rendered {a="b",...} or empty
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        std::string help;
+        MetricType type;
+        std::map<std::string, Child> children;
+    };
+
+    Child& child(const std::string& name, const std::string& help, MetricType type,
+                 const MetricLabels& labels);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    std::vector<std::pair<CollectorId, Collector>> collectors_;
+    CollectorId next_collector_ = 1;
+};
+
+/**
+ * Removes a collector when it goes out of scope
+ */
+class CollectorRegistration {
+public:
+    CollectorRegistration() = default;
+    CollectorRegistration(MetricsRegistry& registry, MetricsRegistry::Collector collector)
+        : registry_(&registry), id_(registry.addCollector(std::move(collector))) {}
+    ~CollectorRegistration() { reset(); }
+
+    CollectorRegistration(CollectorRegistration&& other) noexcept
+        : registry_(other.registry_), id_(other.id_) { other.registry_ = nullptr; }
+    CollectorRegistration& operator=(CollectorRegistration&& other) noexcept {
+        if (this != &other) {
+            reset();
+            registry_ = other.registry_;
+            id_ = other.id_;
+            other.registry_ = nullptr;
+        }
+        return *this;
+    }
+
+    void reset() {
+        if (registry_) {
+            registry_->removeCollector(id_);
+            registry_ = nullptr;
+        }
+    }
+
+private:
+    MetricsRegistry* registry_ = nullptr;
+    MetricsRegistry::CollectorId id_ = 0;
+};
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_TELEMETRY_METRICS_H
@@ -0,0 +1,216 @@
+/**
+ * Prometheus Metrics Endpoint for Harmonic IoT Protocol
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "metrics_server.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+namespace harmonic_iot {
+namespace telemetry {
+
+namespace {
+
+constexpr size_t MAX_REQUEST_BYTES = 8192;
+
+#if defined(MSG_NOSIGNAL)
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;    // A scraper hanging up must not raise SIGPIPE
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+void setCloseOnExec(int fd) {
+    ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+void respond(int fd, const char* status, const char* content_type, const std::string& body) {
+    std::string head = std::string("HTTP/1.1 ") + status + "\r\n"
+                       "Content-Type: " + content_type + "\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n";
+    if (sendAll(fd, head.data(), head.size())) {
+        sendAll(fd, body.data(), body.size());
+    }
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(const MetricsServerConfig& config, MetricsRegistry& registry)
+    : config_(config), registry_(registry) {
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bind_address.c_str(), &addr.sin_addr) != 1) {
+        throw std::runtime_error("Invalid metrics bind address: " + config_.bind_address);
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error(std::string("Failed to create metrics socket: ") + std::strerror(errno));
+    }
+    setCloseOnExec(listen_fd_);
+    int reuse = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 16) != 0) {
+        int err = errno;
+        closeFd(listen_fd_);
+        throw std::runtime_error("Failed to listen on " + config_.bind_address + ":" +
+                                 std::to_string(config_.port) + ": " + std::strerror(err));
+    }
+
+    socklen_t length = sizeof(addr);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &length);
+    port_ = ntohs(addr.sin_port);
+
+    if (::pipe(wake_fds_) != 0) {
+        int err = errno;
+        closeFd(listen_fd_);
+        throw std::runtime_error(std::string("Failed to create metrics wake pipe: ") + std::strerror(err));
+    }
+    setCloseOnExec(wake_fds_[0]);
+    setCloseOnExec(wake_fds_[1]);
+
+    thread_ = std::thread([this] { run(); });
+}
+
+MetricsServer::~MetricsServer() {
+    char byte = 0;
+    ssize_t ignored = ::write(wake_fds_[1], &byte, 1);
+    (void)ignored;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeFd(listen_fd_);
+    closeFd(wake_fds_[0]);
+    closeFd(wake_fds_[1]);
+}
+
+void MetricsServer::run() {
+#if defined(__linux__)
+    ::pthread_setname_np(::pthread_self(), "hiot-metrics");
+#endif
+    pollfd fds[2];
+    fds[0].fd = listen_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wake_fds_[0];
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if (fds[0].revents & POLLIN) {
+            int client = ::accept(listen_fd_, nullptr, nullptr);
+            if (client >= 0) {
+                setCloseOnExec(client);
+                serve(client);
+                ::close(client);
+            }
+        }
+    }
+}
+
+void MetricsServer::serve(int client) {
+    timeval timeout;
+    timeout.tv_sec = config_.client_timeout_ms / 1000;
+    timeout.tv_usec = (config_.client_timeout_ms % 1000) * 1000;
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#if defined(SO_NOSIGPIPE)
+    int no_sigpipe = 1;
+    ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = ::recv(client, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    size_t line_end = request.find("\r\n");
+    if (line_end == std::string::npos) {
+        respond(client, "400 Bad Request", "text/plain", "Bad request\n");
+        return;
+    }
+    std::string line = request.substr(0, line_end);
+    size_t method_end = line.find(' ');
+    size_t path_end = method_end == std::string::npos ? std::string::npos : line.find(' ', method_end + 1);
+    if (path_end == std::string::npos) {
+        respond(client, "400 Bad Request", "text/plain", "Bad request\n");
+        return;
+    }
+    std::string method = line.substr(0, method_end);
+    std::string path = line.substr(method_end + 1, path_end - method_end - 1);
+    size_t query = path.find('?');
+    if (query != std::string::npos) {
+        path.resize(query);
+    }
+
+    if (path != "/metrics") {
+        respond(client, "404 Not Found", "text/plain", "Not found\n");
+    } else if (method != "GET") {
+        respond(client, "405 Method Not Allowed", "text/plain", "Method not allowed\n");
+    } else {
+        respond(client, "200 OK", "text/plain; version=0.0.4; charset=utf-8", registry_.render());
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace telemetry
+} // namespace harmonic_iot
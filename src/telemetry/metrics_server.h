@@ -0,0 +1,73 @@
+/**
+ * Prometheus Metrics Endpoint for Harmonic IoT Protocol
+ *
+ * Minimal HTTP/1.1 server that answers GET /metrics with the registry's
+ * text exposition. It runs on one background thread and serves one
+ * connection at a time, which is plenty for a scraper polling every few
+ * seconds; rendering happens on that thread, never on the hot path.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_METRICS_SERVER_H
+#define HARMONIC_IOT_TELEMETRY_METRICS_SERVER_H
+
+#include "telemetry/metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace harmonic_iot {
+namespace telemetry {
+
+/**
+ * Listening address; port 0 picks a free port (see MetricsServer::port())
+ */
+struct MetricsServerConfig {
+    std::string bind_address = "0.0.0.0";
+    uint16_t port = 9464;
+    int client_timeout_ms = 2000;       ///< Per-connection read/write timeout
+};
+
+/**
+ * Background /metrics endpoint, listening from construction to destruction
+ */
+class MetricsServer {
+public:
+    /**
+     * @throws std::runtime_error if the address cannot be bound
+     */
+    explicit MetricsServer(const MetricsServerConfig& config = MetricsServerConfig(),
+                           MetricsRegistry& registry = MetricsRegistry::global());
+
+    /** Stops accepting and joins the server thread */
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /** Bound port */
+    uint16_t port() const { return port_; }
+
+    /** Successful /metrics responses so far */
+    uint64_t scrapes() const { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void serve(int client);
+
+    MetricsServerConfig config_;
+    MetricsRegistry& registry_;
+    int listen_fd_ = -1;
+    int wake_fds_[2] = {-1, -1};        // Self-pipe that interrupts poll() on shutdown
+    uint16_t port_ = 0;
+    std::atomic<uint64_t> scrapes_{0};
+    std::thread thread_;
+};
+
+} // namespace telemetry
+} // namespace harmonic_iot
+
+#endif // HARMONIC_IOT_TELEMETRY_METRICS_SERVER_H
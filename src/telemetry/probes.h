@@ -0,0 +1,54 @@
+/**
+ * USDT Static Probes for Harmonic IoT Protocol
+ *
+ * Statically defined tracepoints in the systemtap <sys/sdt.h> format. Each
+ * probe compiles to a single nop plus an ELF note describing where its
+ * arguments live; bpftrace, perf and SystemTap patch the nop only while
+ * attached, so an unused probe costs one nop on a live gateway.
+ *
+ * Provider "harmonic_iot":
+ *
+ *   frame_received      (sequence, sample_count)
+ *   symbol_decoded      (sequence, symbol_count, channel)
+ *   fft_start           (fft_size)
+ *   fft_end             (fft_size)
+ *   integrity_violation (frequency_mhz, deviation_mhz)
+ *   argon2_start        (m_cost_kib, t_cost)
+ *   argon2_end          (result)
+ *   jwt_verify_start    ()
+ *   jwt_verify_end      (ok)
+ *
+ *   bpftrace -e 'usdt:./harmonic_protocol:harmonic_iot:fft_start { @s[tid] = nsecs; }
+ *                usdt:./harmonic_protocol:harmonic_iot:fft_end   { @ns = hist(nsecs - @s[tid]); }'
+ *
+ * Probes are compiled in when HARMONIC_IOT_USDT is 1 (CMake ENABLE_USDT,
+ * on by default where <sys/sdt.h> exists). Otherwise the macros expand to
+ * nothing and their arguments are not evaluated. Arguments must be
+ * integers or pointers, so frequencies are passed in millihertz.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#ifndef HARMONIC_IOT_TELEMETRY_PROBES_H
+#define HARMONIC_IOT_TELEMETRY_PROBES_H
+
+#ifndef HARMONIC_IOT_USDT
+#define HARMONIC_IOT_USDT 0
+#endif
+
+#if HARMONIC_IOT_USDT
+#include <sys/sdt.h>
+
+#define HIOT_PROBE(name) DTRACE_PROBE(harmonic_iot, name)
+#define HIOT_PROBE1(name, a) DTRACE_PROBE1(harmonic_iot, name, a)
+#define HIOT_PROBE2(name, a, b) DTRACE_PROBE2(harmonic_iot, name, a, b)
+#define HIOT_PROBE3(name, a, b, c) DTRACE_PROBE3(harmonic_iot, name, a, b, c)
+#else
+#define HIOT_PROBE(name) static_cast<void>(0)
+#define HIOT_PROBE1(name, a) static_cast<void>(0)
+#define HIOT_PROBE2(name, a, b) static_cast<void>(0)
+#define HIOT_PROBE3(name, a, b, c) static_cast<void>(0)
+#endif
+
+#endif // HARMONIC_IOT_TELEMETRY_PROBES_H
@@ -0,0 +1,159 @@
+/**
+ * Native UDP Gateway for Harmonic IoT Protocol
+ *
+ * Runs the gateway event loop until SIGINT/SIGTERM, printing receive
+ * rates once per interval:
+ *
+ *   harmonic_gateway [--bind ADDR] [--port N] [--devices N] [--liveness S]
+ *                    [--metrics-port N] [--interval S] [--record FILE]
+ *
+ * --record writes every received datagram with its arrival time to a
+ * trace file (gateway/datagram_trace.h) for harmonic_replay.
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "gateway/datagram_trace.h"
+#include "gateway/device_registry.h"
+#include "gateway/udp_gateway.h"
+#include "telemetry/metrics_server.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace harmonic_iot;
+
+namespace {
+
+std::atomic<bool> stop_requested{false};
+
+void onSignal(int) {
+    stop_requested.store(true);
+}
+
+void usage() {
+    std::cerr << "Usage: harmonic_gateway [options]\n"
+              << "  --bind ADDR          IPv4 address to listen on (default 127.0.0.1)\n"
+              << "  --port N             UDP port (default 5684)\n"
+              << "  --devices N          Registry capacity (default 1000000)\n"
+              << "  --liveness S         Report devices silent for S seconds as offline (default: off)\n"
+              << "  --metrics-port N     Serve /metrics on this TCP port (default: off)\n"
+              << "  --interval S         Seconds between rate reports (default 1)\n"
+              << "  --record FILE        Record received datagrams to a trace file\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    gateway::UdpGatewayConfig config;
+    size_t devices = 1000000;
+    long metrics_port = 0;
+    double interval = 1.0;
+    std::string record_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--bind" && has_value) {
+            config.bind_address = argv[++i];
+        } else if (arg == "--port" && has_value) {
+            config.port = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--devices" && has_value) {
+            devices = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--liveness" && has_value) {
+            config.liveness_timeout = std::chrono::milliseconds(
+                static_cast<int64_t>(std::strtod(argv[++i], nullptr) * 1000.0));
+        } else if (arg == "--metrics-port" && has_value) {
+            metrics_port = std::strtol(argv[++i], nullptr, 10);
+        } else if (arg == "--interval" && has_value) {
+            interval = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--record" && has_value) {
+            record_path = argv[++i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (devices == 0 || interval <= 0.0) {
+        usage();
+        return 2;
+    }
+
+    try {
+        gateway::DeviceRegistry registry(devices);
+        gateway::UdpGateway gw(config, registry);
+        std::unique_ptr<gateway::TraceWriter> trace;
+        std::string record_error;
+        if (!record_path.empty()) {
+            trace.reset(new gateway::TraceWriter(record_path));
+            // A failed write stops the recording, not the gateway
+            gw.setDatagramTap([&trace, &record_error](const uint8_t* data, size_t size, int64_t received_ns) {
+                if (!record_error.empty()) {
+                    return;
+                }
+                try {
+                    trace->append(data, size, received_ns);
+                } catch (const std::exception& e) {
+                    record_error = e.what();
+                }
+            });
+        }
+        std::unique_ptr<telemetry::MetricsServer> metrics;
+        if (metrics_port > 0) {
+            telemetry::MetricsServerConfig metrics_config;
+            metrics_config.port = static_cast<uint16_t>(metrics_port);
+            metrics.reset(new telemetry::MetricsServer(metrics_config));
+        }
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        gw.start();
+        std::fprintf(stderr, "Listening on %s:%u\n", config.bind_address.c_str(), static_cast<unsigned>(gw.port()));
+
+        gateway::GatewayStats last = gw.stats();
+        auto last_time = std::chrono::steady_clock::now();
+        while (!stop_requested.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            const auto now = std::chrono::steady_clock::now();
+            const double elapsed = std::chrono::duration<double>(now - last_time).count();
+            if (elapsed < interval) {
+                continue;
+            }
+            const gateway::GatewayStats stats = gw.stats();
+            std::printf("%10.0f rx/s %10.0f accepted/s  shed %llu  gaps %llu  malformed %llu  unauthorized %llu  "
+                        "devices %zu  transit p99 %.3f ms\n",
+                        static_cast<double>(stats.datagrams - last.datagrams) / elapsed,
+                        static_cast<double>(stats.accepted - last.accepted) / elapsed,
+                        static_cast<unsigned long long>(stats.shed),
+                        static_cast<unsigned long long>(stats.sequence_gaps),
+                        static_cast<unsigned long long>(stats.malformed),
+                        static_cast<unsigned long long>(stats.unauthorized), registry.size(),
+                        static_cast<double>(gw.transitLatency().valueAtPercentile(99)) / 1e6);
+            std::fflush(stdout);
+            last = stats;
+            last_time = now;
+        }
+        gw.stop();
+        if (trace) {
+            if (!record_error.empty()) {
+                std::cerr << "Recording stopped: " << record_error << '\n';
+            }
+            trace->close();
+            std::fprintf(stderr, "Recorded %llu datagrams (%llu bytes) to %s\n",
+                         static_cast<unsigned long long>(trace->recordsWritten()),
+                         static_cast<unsigned long long>(trace->bytesWritten()), record_path.c_str());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * Binary Log Decoder for Harmonic IoT Protocol
+ *
+ * Formats logs written by the asynchronous logger:
+ *
+ *   harmonic_logdump [--level LEVEL] [--thread N] FILE...
+ *
+ * Copyright (c) 2025 Guilherme Gonçalves Machado
+ * Licensed under CC BY-NC-SA 4.0
+ */
+
+#include "telemetry/log_reader.h"
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using harmonic_iot::telemetry::LogEntry;
+using harmonic_iot::telemetry::LogLevel;
+using harmonic_iot::telemetry::LogReader;
+
+namespace {
+
+void usage() {
+    std::cerr << "Usage: harmonic_logdump [--level LEVEL] [--thread N] FILE...\n"
+              << "  --level LEVEL  Only entries at LEVEL or above (trace, debug, info, warn, error)\n"
+              << "  --thread N     Only records from logger thread N\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LogLevel min_level = LogLevel::Trace;
+    long thread = -1;
+    std::vector<std::string> files;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--level" && i + 1 < argc) {
+                min_level = harmonic_iot::telemetry::parseLogLevel(argv[++i]);
+            } else if (arg == "--thread" && i + 1 < argc) {
+                thread = std::strtol(argv[++i], nullptr, 10);
+            } else if (arg == "-h" || arg == "--help") {
+                usage();
+                return 0;
+            } else if (!arg.empty() && arg[0] == '-') {
+                usage();
+                return 2;
+            } else {
+                files.push_back(arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 2;
+    }
+    if (files.empty()) {
+        usage();
+        return 2;
+    }
+
+    int status = 0;
+    for (const std::string& path : files) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Cannot open " << path << '\n';
+            status = 1;
+            continue;
+        }
+        try {
+            LogReader reader(in);
+            LogEntry entry;
+            while (reader.next(entry)) {
+                if (entry.level < min_level) {
+                    continue;
+                }
+                if (thread >= 0 && entry.thread != static_cast<uint32_t>(thread)) {
+                    continue;
+                }
+                std::cout << entry.toString() << '\n';
+            }
+        } catch (const std::exception& e) {
+            std::cerr << path << ": " << e.what() << '\n';
+            status = 1;
+        }
+    }
+    return status;
+}